@@ -0,0 +1,112 @@
+/**
+ * Orderbook frame parsing benchmark
+ *
+ * Compares the nlohmann::json DOM path (json::parse + std::stod per level, as
+ * OrderbookManager used to do) against BookFrameParser on synthetic
+ * agg_orderbook frames of varying depth.
+ *
+ * Build: cmake -S . -B build -DPOLYMARKET_CLIENT_BUILD_BENCHMARKS=ON && cmake --build build --target book_parser_bench
+ * Run: ./build/book_parser_bench [iterations]
+ */
+
+#include "book_parser.hpp"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using json = nlohmann::json;
+using namespace polymarket;
+
+namespace
+{
+    const std::string kAssetId = "28537688195618790236576003993608298766895159067143553592678106718799385303898";
+
+    std::string make_frame(int depth)
+    {
+        std::string frame = R"({"topic":"clob_market","type":"agg_orderbook","timestamp":1753314064237,"payload":{"asset_id":")" +
+                            kAssetId + R"(","market":"0x5f65177b394277fd294cd75650044e32ba009a95022d88a0c1d565897d72f8f1","asks":[)";
+        for (int i = 0; i < depth; i++)
+        {
+            if (i > 0)
+                frame += ",";
+            frame += R"({"price":"0.)" + std::to_string(99 - i % 45) + R"(","size":")" + std::to_string(100 + i * 7) + ".25\"}";
+        }
+        frame += R"(],"bids":[)";
+        for (int i = 0; i < depth; i++)
+        {
+            if (i > 0)
+                frame += ",";
+            frame += R"({"price":"0.)" + std::to_string(10 + i % 44) + R"(","size":")" + std::to_string(50 + i * 3) + ".5\"}";
+        }
+        frame += R"(],"hash":"0a1b2c3d4e5f","timestamp":"1753314064212"}})";
+        return frame;
+    }
+
+    // Previous OrderbookManager::handle_message parse path
+    double parse_dom(const std::string &message, Orderbook &book)
+    {
+        auto j = json::parse(message);
+        std::string topic = j["topic"].get<std::string>();
+        std::string type = j["type"].get<std::string>();
+        auto &payload = j["payload"];
+        book.asset_id = payload["asset_id"].get<std::string>();
+        book.asks.clear();
+        book.bids.clear();
+        for (const auto &ask : payload["asks"])
+        {
+            book.asks.push_back({std::stod(ask["price"].get<std::string>()), std::stod(ask["size"].get<std::string>())});
+        }
+        for (const auto &bid : payload["bids"])
+        {
+            book.bids.push_back({std::stod(bid["price"].get<std::string>()), std::stod(bid["size"].get<std::string>())});
+        }
+        return book.best_ask();
+    }
+
+    template <typename Fn>
+    double time_ns_per_frame(int iterations, Fn &&fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            fn();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+    std::cout << "Orderbook frame parsing (" << iterations << " iterations per case)\n\n";
+    std::cout << std::left << std::setw(8) << "depth" << std::setw(10) << "bytes"
+              << std::setw(14) << "dom ns" << std::setw(14) << "scanner ns" << "speedup\n";
+
+    volatile double sink = 0.0;
+    for (int depth : {5, 20, 50, 100})
+    {
+        std::string frame = make_frame(depth);
+
+        Orderbook dom_book;
+        double dom_ns = time_ns_per_frame(iterations, [&]()
+                                          { sink = sink + parse_dom(frame, dom_book); });
+
+        BookFrameParser parser;
+        double scan_ns = time_ns_per_frame(iterations, [&]()
+                                           {
+            parser.parse(frame);
+            sink = sink + parser.event(0).book.best_ask(); });
+
+        std::cout << std::left << std::setw(8) << depth << std::setw(10) << frame.size()
+                  << std::fixed << std::setprecision(0)
+                  << std::setw(14) << dom_ns << std::setw(14) << scan_ns
+                  << std::setprecision(1) << dom_ns / scan_ns << "x\n";
+    }
+
+    return 0;
+}
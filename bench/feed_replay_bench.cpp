@@ -0,0 +1,136 @@
+/**
+ * Market data replay benchmark
+ *
+ * Replays a feed capture through OrderbookManager (parse, book apply, top of
+ * book, snapshot publish, arb checks) on one thread as fast as possible and
+ * reports frames per second per core. Without a capture file a synthetic one
+ * is generated: snapshots for every token followed by price_change deltas.
+ * Record a real one with `polymarket_arb --record <path>`; its markets are not
+ * subscribed here, so routing and arb checks are skipped for them.
+ *
+ * Build: cmake -S . -B build -DPOLYMARKET_CLIENT_BUILD_BENCHMARKS=ON && cmake --build build --target feed_replay_bench
+ * Run: ./build/feed_replay_bench [capture.bin] [passes]
+ */
+
+#include "feed_log.hpp"
+#include "orderbook.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace polymarket;
+
+namespace
+{
+    constexpr int kMarkets = 50;
+    constexpr int kDeltasPerMarket = 2000;
+
+    std::string token_id(int market, bool yes)
+    {
+        return std::to_string(1000000 + market * 2 + (yes ? 0 : 1));
+    }
+
+    std::string snapshot_frame(const std::string &token, int depth, uint64_t ts)
+    {
+        std::string frame = R"({"topic":"clob_market","type":"agg_orderbook","timestamp":)" + std::to_string(ts) +
+                            R"(,"payload":{"asset_id":")" + token + R"(","market":"0xm","asks":[)";
+        for (int i = 0; i < depth; i++)
+        {
+            if (i > 0)
+                frame += ",";
+            frame += R"({"price":"0.)" + std::to_string(99 - i) + R"(","size":")" + std::to_string(100 + i * 7) + "\"}";
+        }
+        frame += R"(],"bids":[)";
+        for (int i = 0; i < depth; i++)
+        {
+            if (i > 0)
+                frame += ",";
+            frame += R"({"price":"0.)" + std::to_string(40 - i) + R"(","size":")" + std::to_string(50 + i * 3) + "\"}";
+        }
+        frame += R"(],"hash":"0a1b2c","timestamp":")" + std::to_string(ts) + "\"}}";
+        return frame;
+    }
+
+    std::string delta_frame(const std::string &yes, const std::string &no, int step, uint64_t ts)
+    {
+        // Move a level on each leg, away from the top so the books stay uncrossed
+        std::string price = "0." + std::to_string(60 + step % 20);
+        std::string size = step % 3 == 0 ? "0" : std::to_string(10 + step % 90);
+        return R"({"market":"0xm","price_changes":[{"asset_id":")" + yes + R"(","price":")" + price + R"(","size":")" +
+               size + R"(","side":"SELL"},{"asset_id":")" + no + R"(","price":")" + price + R"(","size":")" + size +
+               R"(","side":"SELL"}],"timestamp":")" + std::to_string(ts) + R"(","event_type":"price_change"})";
+    }
+
+    void write_synthetic(const std::string &path, std::vector<MarketState> &markets)
+    {
+        FeedRecorder recorder(path);
+        uint64_t ts = 1753314064000;
+        for (int m = 0; m < kMarkets; m++)
+        {
+            MarketState market;
+            market.condition_id = "0xcond" + std::to_string(m);
+            market.token_yes = token_id(m, true);
+            market.token_no = token_id(m, false);
+            markets.push_back(market);
+            recorder.append(0, ts * 1000000, snapshot_frame(market.token_yes, 20, ts));
+            recorder.append(0, ts * 1000000, snapshot_frame(market.token_no, 20, ts));
+        }
+        for (int step = 0; step < kDeltasPerMarket; step++)
+        {
+            for (int m = 0; m < kMarkets; m++)
+            {
+                ts++;
+                recorder.append(0, ts * 1000000, delta_frame(token_id(m, true), token_id(m, false), step, ts));
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string path = argc > 1 ? argv[1] : "";
+    int passes = argc > 2 ? std::atoi(argv[2]) : 5;
+
+    std::vector<MarketState> markets;
+    bool synthetic = path.empty();
+    if (synthetic)
+    {
+        path = "/tmp/feed_replay_bench_" + std::to_string(::getpid()) + ".bin";
+        write_synthetic(path, markets);
+    }
+
+    FeedReader reader(path);
+    std::cout << "Feed replay (" << (synthetic ? "synthetic" : path) << ", " << reader.size_bytes() << " bytes, "
+              << passes << " passes)\n\n";
+    std::cout << std::left << std::setw(8) << "pass" << std::setw(12) << "frames" << std::setw(12) << "ms"
+              << std::setw(14) << "frames/s" << "MB/s\n";
+
+    Config config;
+    config.ws_shards = 1;
+    OrderbookManager mgr(config);
+    mgr.subscribe(markets);
+
+    for (int pass = 0; pass < passes; pass++)
+    {
+        reader.rewind();
+        ReplayStats stats = mgr.replay(reader);
+        std::cout << std::left << std::setw(8) << pass << std::setw(12) << stats.frames << std::fixed
+                  << std::setprecision(1) << std::setw(12) << stats.seconds * 1000.0 << std::setprecision(0)
+                  << std::setw(14) << stats.frames_per_sec << std::setprecision(1)
+                  << stats.bytes / stats.seconds / 1e6 << "\n";
+    }
+
+    LatencyStats latency = mgr.get_latency_stats();
+    std::cout << "\nparse p50 " << latency.parse.p50_ns << " ns, apply p50 " << latency.apply.p50_ns
+              << " ns, internal p99 " << latency.internal.p99_ns << " ns\n";
+
+    if (synthetic)
+    {
+        std::remove(path.c_str());
+    }
+    return 0;
+}
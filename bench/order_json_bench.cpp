@@ -0,0 +1,160 @@
+/**
+ * Order body serialization benchmark
+ *
+ * Compares building an nlohmann::ordered_json tree per order and dump()ing it
+ * (as ClobClient::post_order / post_orders used to do) against the direct
+ * append_order_payload() writer into a reused buffer, for a single order and
+ * a 15-order batch.
+ *
+ * Build: cmake -S . -B build -DPOLYMARKET_CLIENT_BUILD_BENCHMARKS=ON && cmake --build build --target order_json_bench
+ * Run: ./build/order_json_bench [iterations]
+ */
+
+#include "order_json.hpp"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace polymarket;
+
+namespace
+{
+    const std::string kOwner = "00000000-1111-2222-3333-444444444444";
+
+    SignedOrder make_order(int i)
+    {
+        SignedOrder order;
+        order.salt = std::to_string(123456789012LL + i);
+        order.maker = "0x90F79bf6EB2c4f870365E785982E1f101E93b906";
+        order.signer = order.maker;
+        order.taker = "0x0000000000000000000000000000000000000000";
+        order.token_id = "28537688195618790236576003993608298766895159067143553592678106718799385303898";
+        order.maker_amount = std::to_string(2300000 + i * 10000);
+        order.taker_amount = "5000000";
+        order.expiration = "0";
+        order.nonce = "0";
+        order.fee_rate_bps = "0";
+        order.side = i % 2;
+        order.signature_type = 0;
+        order.signature = "0x5d0e4b8b3f2a1c0d9e8f7a6b5c4d3e2f1a0b9c8d7e6f5a4b3c2d1e0f9a8b7c6d"
+                          "5e4f3a2b1c0d9e8f7a6b5c4d3e2f1a0b9c8d7e6f5a4b3c2d1e0f9a8b7c6d5e4f1b";
+        return order;
+    }
+
+    // Previous ClobClient body construction
+    nlohmann::ordered_json dom_payload(const SignedOrder &order)
+    {
+        nlohmann::ordered_json body;
+        nlohmann::ordered_json order_json;
+        order_json["salt"] = std::stoll(order.salt);
+        order_json["maker"] = order.maker;
+        order_json["signer"] = order.signer;
+        order_json["taker"] = order.taker;
+        order_json["tokenId"] = order.token_id;
+        order_json["makerAmount"] = order.maker_amount;
+        order_json["takerAmount"] = order.taker_amount;
+        order_json["side"] = order.side == 0 ? "BUY" : "SELL";
+        order_json["expiration"] = order.expiration;
+        order_json["nonce"] = order.nonce;
+        order_json["feeRateBps"] = order.fee_rate_bps;
+        order_json["signatureType"] = order.signature_type;
+        order_json["signature"] = order.signature;
+        body["order"] = order_json;
+        body["owner"] = kOwner;
+        body["orderType"] = "GTC";
+        body["deferExec"] = false;
+        return body;
+    }
+
+    std::string dom_body(const std::vector<SignedOrder> &orders)
+    {
+        if (orders.size() == 1)
+        {
+            return dom_payload(orders[0]).dump();
+        }
+        nlohmann::ordered_json body = nlohmann::ordered_json::array();
+        for (const auto &order : orders)
+        {
+            body.push_back(dom_payload(order));
+        }
+        return body.dump();
+    }
+
+    void direct_body(const std::vector<SignedOrder> &orders, std::string &out)
+    {
+        out.clear();
+        if (orders.size() == 1)
+        {
+            append_order_payload(out, orders[0], kOwner, "GTC", false);
+            return;
+        }
+        out += '[';
+        for (size_t i = 0; i < orders.size(); i++)
+        {
+            if (i > 0)
+            {
+                out += ',';
+            }
+            append_order_payload(out, orders[i], kOwner, "GTC", false);
+        }
+        out += ']';
+    }
+
+    template <typename Fn>
+    double time_ns_per_body(int iterations, Fn &&fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            fn();
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+    std::cout << "Order body serialization (" << iterations << " iterations per case)\n\n";
+    std::cout << std::left << std::setw(8) << "orders" << std::setw(10) << "bytes"
+              << std::setw(14) << "dom ns" << std::setw(14) << "direct ns" << "speedup\n";
+
+    volatile size_t sink = 0;
+    for (int count : {1, 15})
+    {
+        std::vector<SignedOrder> orders;
+        for (int i = 0; i < count; i++)
+        {
+            orders.push_back(make_order(i));
+        }
+
+        std::string buffer;
+        buffer.reserve(16 * 1024);
+        direct_body(orders, buffer);
+        if (buffer != dom_body(orders))
+        {
+            std::cerr << "direct writer output differs from dump()\n";
+            return 1;
+        }
+
+        double dom_ns = time_ns_per_body(iterations, [&]()
+                                         { sink = sink + dom_body(orders).size(); });
+        double direct_ns = time_ns_per_body(iterations, [&]()
+                                            {
+            direct_body(orders, buffer);
+            sink = sink + buffer.size(); });
+
+        std::cout << std::left << std::setw(8) << count << std::setw(10) << buffer.size()
+                  << std::fixed << std::setprecision(0)
+                  << std::setw(14) << dom_ns << std::setw(14) << direct_ns
+                  << std::setprecision(1) << dom_ns / direct_ns << "x\n";
+    }
+
+    return 0;
+}
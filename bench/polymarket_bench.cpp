@@ -0,0 +1,452 @@
+/**
+ * Hot path microbenchmark suite
+ *
+ * Times the per-operation cost of the library's latency-critical paths on fixed
+ * fixtures, so runs can be compared across changes:
+ *   parse/...       BookFrameParser on agg_orderbook and price_change frames
+ *   feed/...        OrderbookManager frame handling (parse, apply, dispatch) via replay()
+ *   book/...        Orderbook best price scans and OrderbookManager top of book reads
+ *   dispatch/...    UpdateConsumer ring publish + poll of one UpdateEvent
+ *   sign/...        OrderSigner::sign_order_with_salt and generate_l2_headers
+ *   serialize/...   POST /order(s) body construction (append_order_payload)
+ *
+ * Each case runs in timed batches for --min-ms; ns/op is reported as the mean,
+ * the median batch and the fastest batch. --json prints one JSON document for
+ * regression tracking; --feed replays a capture recorded with
+ * `polymarket_arb --record` in place of the synthetic feed.
+ *
+ * Build: cmake -S . -B build -DPOLYMARKET_CLIENT_BUILD_BENCHMARKS=ON && cmake --build build --target polymarket_bench
+ * Run: ./build/polymarket_bench [--json] [--filter substr] [--min-ms N] [--feed capture.bin]
+ */
+
+#include "book_parser.hpp"
+#include "clob_client.hpp"
+#include "feed_log.hpp"
+#include "order_json.hpp"
+#include "order_signer.hpp"
+#include "orderbook.hpp"
+#include "polymarket/version.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace polymarket;
+
+namespace
+{
+    // Well-known test key (Hardhat account #0), never funded on Polygon
+    const std::string kPrivateKey = "0xac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80";
+    const std::string kTokenId = "28537688195618790236576003993608298766895159067143553592678106718799385303898";
+    const std::string kOwner = "00000000-1111-2222-3333-444444444444";
+
+    struct Result
+    {
+        std::string name;
+        uint64_t ops{0};
+        double mean_ns{0.0};
+        double p50_ns{0.0};
+        double min_ns{0.0};
+    };
+
+    struct Options
+    {
+        bool json{false};
+        std::string filter;
+        double min_ms{200.0};
+        std::string feed_path;
+    };
+
+    // Run fn(batch) in growing batches until the batch takes ~1ms, then keep timing batches for min_ms.
+    // fn returns the number of operations it performed (usually batch).
+    Result measure(const std::string &name, double min_ms, const std::function<uint64_t(uint64_t)> &fn)
+    {
+        using clock = std::chrono::steady_clock;
+        uint64_t batch = 1;
+        while (batch < (1u << 24))
+        {
+            auto start = clock::now();
+            fn(batch);
+            if (clock::now() - start >= std::chrono::milliseconds(1))
+            {
+                break;
+            }
+            batch *= 2;
+        }
+
+        Result result;
+        result.name = name;
+        std::vector<double> per_batch;
+        double total_ns = 0.0;
+        while (total_ns < min_ms * 1e6 || per_batch.size() < 5)
+        {
+            auto start = clock::now();
+            uint64_t ops = fn(batch);
+            double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+            total_ns += ns;
+            result.ops += ops;
+            per_batch.push_back(ns / std::max<uint64_t>(ops, 1));
+        }
+        std::sort(per_batch.begin(), per_batch.end());
+        result.mean_ns = total_ns / std::max<uint64_t>(result.ops, 1);
+        result.p50_ns = per_batch[per_batch.size() / 2];
+        result.min_ns = per_batch.front();
+        return result;
+    }
+
+    // "0.ddd" for a price in thousandths (0 < ticks < 1000)
+    std::string tick_price(int ticks)
+    {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "0.%03d", ticks);
+        return buf;
+    }
+
+    // Asks 0.990 down and bids 0.400 down in 0.005 steps; valid up to depth 80
+    std::string agg_orderbook_frame(const std::string &token, int depth)
+    {
+        std::string frame = R"({"topic":"clob_market","type":"agg_orderbook","timestamp":1753314064237,"payload":{"asset_id":")" +
+                            token + R"(","market":"0x5f65177b394277fd294cd75650044e32ba009a95022d88a0c1d565897d72f8f1","asks":[)";
+        for (int i = 0; i < depth; i++)
+        {
+            if (i > 0)
+                frame += ",";
+            frame += R"({"price":")" + tick_price(990 - i * 5) + R"(","size":")" + std::to_string(100 + i * 7) + ".25\"}";
+        }
+        frame += R"(],"bids":[)";
+        for (int i = 0; i < depth; i++)
+        {
+            if (i > 0)
+                frame += ",";
+            frame += R"({"price":")" + tick_price(400 - i * 5) + R"(","size":")" + std::to_string(50 + i * 3) + ".5\"}";
+        }
+        frame += R"(],"hash":"0a1b2c3d4e5f","timestamp":"1753314064212"}})";
+        return frame;
+    }
+
+    std::string price_change_frame(const std::string &yes, const std::string &no, int step)
+    {
+        std::string price = "0." + std::to_string(60 + step % 20);
+        std::string size = step % 3 == 0 ? "0" : std::to_string(10 + step % 90);
+        return R"({"market":"0x5f65177b394277fd294cd75650044e32ba009a95022d88a0c1d565897d72f8f1","price_changes":[{"asset_id":")" +
+               yes + R"(","price":")" + price + R"(","size":")" + size + R"(","side":"SELL","hash":"h1"},{"asset_id":")" +
+               no + R"(","price":")" + price + R"(","size":")" + size + R"(","side":"SELL","hash":"h2"}],)" +
+               R"("timestamp":"1757908892351","event_type":"price_change"})";
+    }
+
+    // Best-price scans walk the whole vector, so use the API's ordering (asks descending)
+    Orderbook make_book(int depth)
+    {
+        Orderbook book;
+        book.asset_id = kTokenId;
+        for (int i = 0; i < depth; i++)
+        {
+            book.asks.push_back({0.99 - i * 0.01, 100.0 + i});
+            book.bids.push_back({0.01 + i * 0.01, 50.0 + i});
+        }
+        return book;
+    }
+
+    OrderData make_order_data(const std::string &maker)
+    {
+        OrderData order;
+        order.maker = maker;
+        order.taker = "0x0000000000000000000000000000000000000000";
+        order.token_id = kTokenId;
+        order.maker_amount = "2300000";
+        order.taker_amount = "5000000";
+        order.side = OrderSide::BUY;
+        order.fee_rate_bps = "0";
+        order.nonce = "0";
+        order.signer = maker;
+        order.expiration = "0";
+        order.signature_type = SignatureType::EOA;
+        return order;
+    }
+
+    // Synthetic capture: a snapshot per token, then deltas round-robin over the markets
+    void write_feed(const std::string &path, std::vector<MarketState> &markets)
+    {
+        FeedRecorder recorder(path);
+        for (int m = 0; m < 20; m++)
+        {
+            MarketState market;
+            market.condition_id = "0xcond" + std::to_string(m);
+            market.token_yes = std::to_string(1000000 + m * 2);
+            market.token_no = std::to_string(1000001 + m * 2);
+            markets.push_back(market);
+            recorder.append(0, 0, agg_orderbook_frame(market.token_yes, 20));
+            recorder.append(0, 0, agg_orderbook_frame(market.token_no, 20));
+        }
+        for (int step = 0; step < 500; step++)
+        {
+            for (const auto &market : markets)
+            {
+                recorder.append(0, 0, price_change_frame(market.token_yes, market.token_no, step));
+            }
+        }
+    }
+
+    void print_table(const std::vector<Result> &results)
+    {
+        std::cout << std::left << std::setw(32) << "case" << std::setw(12) << "ops" << std::setw(12) << "mean ns"
+                  << std::setw(12) << "p50 ns" << std::setw(12) << "min ns" << "ops/s\n";
+        for (const auto &r : results)
+        {
+            std::cout << std::left << std::setw(32) << r.name << std::setw(12) << r.ops << std::fixed
+                      << std::setprecision(1) << std::setw(12) << r.mean_ns << std::setw(12) << r.p50_ns
+                      << std::setw(12) << r.min_ns << std::setprecision(0) << 1e9 / r.mean_ns << "\n";
+        }
+    }
+
+    void print_json(const std::vector<Result> &results, const Options &options)
+    {
+        nlohmann::ordered_json doc;
+        doc["suite"] = "polymarket_bench";
+        doc["version"] = version_string;
+        doc["timestamp"] = static_cast<uint64_t>(std::time(nullptr));
+        doc["min_ms"] = options.min_ms;
+        doc["feed"] = options.feed_path.empty() ? "synthetic" : options.feed_path;
+        doc["results"] = nlohmann::ordered_json::array();
+        for (const auto &r : results)
+        {
+            doc["results"].push_back({{"name", r.name},
+                                      {"ops", r.ops},
+                                      {"mean_ns", r.mean_ns},
+                                      {"p50_ns", r.p50_ns},
+                                      {"min_ns", r.min_ns},
+                                      {"ops_per_sec", 1e9 / r.mean_ns}});
+        }
+        std::cout << doc.dump(2) << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--json")
+            options.json = true;
+        else if (arg == "--filter" && i + 1 < argc)
+            options.filter = argv[++i];
+        else if (arg == "--min-ms" && i + 1 < argc)
+            options.min_ms = std::atof(argv[++i]);
+        else if (arg == "--feed" && i + 1 < argc)
+            options.feed_path = argv[++i];
+        else
+        {
+            std::cerr << "Usage: polymarket_bench [--json] [--filter substr] [--min-ms N] [--feed capture.bin]\n";
+            return 1;
+        }
+    }
+
+    // Library logging goes to stdout; keep it out of the results
+    std::streambuf *out = std::cout.rdbuf(nullptr);
+
+    std::vector<Result> results;
+    auto run = [&](const std::string &name, const std::function<uint64_t(uint64_t)> &fn)
+    {
+        if (options.filter.empty() || name.find(options.filter) != std::string::npos)
+        {
+            results.push_back(measure(name, options.min_ms, fn));
+        }
+    };
+    volatile double sink = 0.0;
+
+    // parse/...
+    BookFrameParser parser;
+    for (int depth : {5, 50})
+    {
+        std::string frame = agg_orderbook_frame(kTokenId, depth);
+        if (!parser.parse(frame) || parser.size() != 1 || parser.event(0).book.bids.size() != static_cast<size_t>(depth))
+        {
+            std::cerr << "agg_orderbook_" << depth << " frame does not parse: " << parser.error() << "\n";
+            return 1;
+        }
+        run("parse/agg_orderbook_" + std::to_string(depth), [&](uint64_t n)
+            {
+            for (uint64_t i = 0; i < n; i++)
+            {
+                if (parser.parse(frame) && parser.size() > 0)
+                {
+                    sink = sink + parser.event(0).book.bids.size();
+                }
+            }
+            return n; });
+    }
+    std::string delta = price_change_frame("1000000", "1000001", 1);
+    run("parse/price_change", [&](uint64_t n)
+        {
+        for (uint64_t i = 0; i < n; i++)
+        {
+            parser.parse(delta);
+            sink = sink + parser.size();
+        }
+        return n; });
+
+    // feed/...: per-frame cost of the full handle_message path
+    {
+        std::vector<MarketState> markets;
+        std::string path = options.feed_path;
+        if (path.empty())
+        {
+            path = "/tmp/polymarket_bench_" + std::to_string(::getpid()) + ".bin";
+            write_feed(path, markets);
+        }
+        FeedReader reader(path);
+        Config config;
+        config.ws_shards = 1;
+        OrderbookManager mgr(config);
+        mgr.subscribe(markets);
+        run("feed/handle_message", [&](uint64_t n)
+            {
+            // Whole passes over the capture, at least n frames
+            uint64_t frames = 0;
+            do
+            {
+                reader.rewind();
+                uint64_t replayed = mgr.replay(reader).frames;
+                if (replayed == 0)
+                {
+                    break;
+                }
+                frames += replayed;
+            } while (frames < n);
+            return frames; });
+        if (options.feed_path.empty())
+        {
+            std::remove(path.c_str());
+        }
+
+        // book/... on the books the synthetic feed left behind
+        if (!markets.empty())
+        {
+            TokenHandle token = mgr.token_handle(markets[0].token_yes);
+            run("book/top_of_book", [&](uint64_t n)
+                {
+                for (uint64_t i = 0; i < n; i++)
+                {
+                    sink = sink + mgr.get_top_of_book(token)->best_ask;
+                }
+                return n; });
+            const BookSnapshotSlot &slot = mgr.snapshot_slot(token);
+            BookSnapshot snap;
+            run("book/snapshot_read", [&](uint64_t n)
+                {
+                for (uint64_t i = 0; i < n; i++)
+                {
+                    slot.read(snap);
+                    sink = sink + snap.top.best_ask;
+                }
+                return n; });
+
+            // ClobClient::get_midpoint() served from the same book (an unreachable host, so a fallback can't hide)
+            ClobClient client("http://127.0.0.1:1", 137);
+            client.attach_orderbook(&mgr, std::chrono::hours(1));
+            const std::string token_id = markets[0].token_yes;
+            run("book/local_midpoint", [&](uint64_t n)
+                {
+                for (uint64_t i = 0; i < n; i++)
+                {
+                    sink = sink + client.get_midpoint(token_id)->mid;
+                }
+                return n; });
+        }
+    }
+    for (int depth : {5, 50})
+    {
+        Orderbook book = make_book(depth);
+        run("book/best_bid_ask_" + std::to_string(depth), [&](uint64_t n)
+            {
+            for (uint64_t i = 0; i < n; i++)
+            {
+                sink = sink + book.best_bid() + book.best_ask();
+            }
+            return n; });
+    }
+
+    // dispatch/... (one thread, so this is the ring's own cost without cache line transfers)
+    {
+        UpdateConsumer consumer(UpdateConsumerConfig{}, 2);
+        UpdateEvent event;
+        event.top.best_ask = 0.5;
+        run("dispatch/ring_publish_poll", [&](uint64_t n)
+            {
+            UpdateEvent out;
+            for (uint64_t i = 0; i < n; i++)
+            {
+                consumer.publish(0, event);
+                consumer.poll(out);
+                sink = sink + out.top.best_ask;
+            }
+            return n; });
+    }
+
+    // sign/...
+    OrderSigner signer(kPrivateKey);
+    OrderData order = make_order_data(signer.address());
+    run("sign/sign_order_with_salt", [&](uint64_t n)
+        {
+        for (uint64_t i = 0; i < n; i++)
+        {
+            sink = sink + signer.sign_order_with_salt(order, EXCHANGE_ADDRESS, std::to_string(123456789 + i)).signature.size();
+        }
+        return n; });
+    ApiCredentials creds{kOwner, "c2VjcmV0LXNlY3JldC1zZWNyZXQtc2VjcmV0LXNlY3JldA==", "passphrase"};
+    SignedOrder signed_order = signer.sign_order_with_salt(order, EXCHANGE_ADDRESS, "123456789");
+    std::string body;
+    body.reserve(16 * 1024);
+    append_order_payload(body, signed_order, kOwner, "GTC", false);
+    run("sign/l2_headers", [&](uint64_t n)
+        {
+        for (uint64_t i = 0; i < n; i++)
+        {
+            sink = sink + signer.generate_l2_headers(creds, "POST", "/order", body).poly_signature.size();
+        }
+        return n; });
+
+    // serialize/...
+    for (int count : {1, 15})
+    {
+        run("serialize/order_body_" + std::to_string(count), [&](uint64_t n)
+            {
+            for (uint64_t i = 0; i < n; i++)
+            {
+                body.clear();
+                if (count > 1)
+                    body += '[';
+                for (int k = 0; k < count; k++)
+                {
+                    if (k > 0)
+                        body += ',';
+                    append_order_payload(body, signed_order, kOwner, "GTC", false);
+                }
+                if (count > 1)
+                    body += ']';
+                sink = sink + body.size();
+            }
+            return n; });
+    }
+
+    std::cout.rdbuf(out);
+    if (options.json)
+    {
+        print_json(results, options);
+    }
+    else
+    {
+        std::cout << "polymarket_bench " << version_string << " (" << options.min_ms << " ms per case)\n\n";
+        print_table(results);
+    }
+    return 0;
+}
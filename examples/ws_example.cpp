@@ -3,7 +3,6 @@
 #include <iostream>
 #include <thread>
 #include <chrono>
-#include <atomic>
 
 using json = nlohmann::json;
 
@@ -16,17 +15,13 @@ int main()
     const std::string token_yes = "28537688195618790236576003993608298766895159067143553592678106718799385303898";
     const std::string token_no = "57878493050148425637822780001963685814731344602319345842647239312888833935027";
 
-    std::atomic<bool> connected{false};
-
     WebSocketClient ws;
     ws.set_url("wss://ws-subscriptions-clob.polymarket.com/ws/market");
     ws.set_ping_interval_ms(10000);
     ws.set_auto_reconnect(false);
 
-    ws.on_connect([&connected]()
-                  {
-        std::cout << "[ws] connected\n";
-        connected = true; });
+    ws.on_connect([]()
+                  { std::cout << "[ws] connected\n"; });
     ws.on_disconnect([]()
                      { std::cout << "[ws] disconnected\n"; });
     ws.on_error([](const std::string &err)
@@ -53,12 +48,7 @@ int main()
     }
 
     // Wait for connection to establish
-    for (int i = 0; i < 20 && !connected; ++i)
-    {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    }
-
-    if (!connected)
+    if (!ws.wait_connected(std::chrono::seconds(2)))
     {
         std::cerr << "connection timeout" << std::endl;
         return 1;
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "http_client.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace polymarket
+{
+
+    // Order traffic goes first; background queries fill whatever is left
+    enum class HttpPriority
+    {
+        HIGH,
+        NORMAL
+    };
+
+    using HttpCallback = std::function<void(HttpResponse response)>;
+
+    struct AsyncHttpStats
+    {
+        uint64_t submitted{0};
+        uint64_t completed{0};
+        uint64_t failed{0};      // Transport errors (no HTTP status)
+        uint64_t http2{0};       // Completed over HTTP/2
+        uint64_t connects{0};    // New connections opened
+        size_t queued{0};        // Waiting for a transfer slot
+        size_t in_flight{0};
+    };
+
+    // Non-blocking HTTP client on one curl_multi handle driven by its own thread.
+    //
+    // Requests to the same host are multiplexed as HTTP/2 streams over a single kept-alive TLS connection (curl
+    // waits for the first connection to confirm HTTP/2 rather than opening parallel ones). submit() only queues
+    // and wakes the loop, so a slow request never holds up the caller or the requests behind it. HIGH requests
+    // are always started first and get the highest HTTP/2 stream weight; NORMAL ones are capped at
+    // max_background in flight so bulk queries cannot crowd the connection out.
+    //
+    // Completion callbacks run on the loop thread and should return quickly. All methods are thread-safe;
+    // configure before the first request, later changes only apply to requests submitted afterwards.
+    class AsyncHttpClient
+    {
+    public:
+        AsyncHttpClient();
+        ~AsyncHttpClient();
+
+        AsyncHttpClient(const AsyncHttpClient &) = delete;
+        AsyncHttpClient &operator=(const AsyncHttpClient &) = delete;
+
+        // Configuration
+        void set_base_url(const std::string &base_url);
+        void set_timeout_ms(long timeout_ms);
+        void set_proxy(const std::string &proxy_url);
+        void set_user_agent(const std::string &user_agent);
+        void add_header(const std::string &header);
+        void set_max_background(size_t count); // NORMAL requests in flight at once (default 8)
+        void set_http2(bool enabled);          // Default on; off forces HTTP/1.1
+        void set_share(CURLSH *share);         // Shared DNS/TLS session cache (see HttpPool)
+
+        // Queue a request; the callback receives the response (or error) on the loop thread
+        void submit(const std::string &method, const std::string &path, std::string body,
+                    const std::map<std::string, std::string> &headers, HttpPriority priority, HttpCallback callback);
+
+        std::future<HttpResponse> submit(const std::string &method, const std::string &path, std::string body = "",
+                                         const std::map<std::string, std::string> &headers = {},
+                                         HttpPriority priority = HttpPriority::NORMAL);
+
+        std::future<HttpResponse> get(const std::string &path, const std::map<std::string, std::string> &headers = {},
+                                      HttpPriority priority = HttpPriority::NORMAL);
+        std::future<HttpResponse> post(const std::string &path, std::string body,
+                                       const std::map<std::string, std::string> &headers = {},
+                                       HttpPriority priority = HttpPriority::HIGH);
+        std::future<HttpResponse> del(const std::string &path, std::string body = "",
+                                      const std::map<std::string, std::string> &headers = {},
+                                      HttpPriority priority = HttpPriority::HIGH);
+
+        // Open the TCP/TLS (and HTTP/2) connection ahead of the first real request; blocks up to the timeout
+        bool warm_connection();
+
+        // Fail everything still queued or in flight and join the loop thread (also done by the destructor)
+        void stop();
+
+        AsyncHttpStats get_stats() const;
+
+    private:
+        struct Transfer;
+
+        void *multi_; // CURLM*
+        std::thread loop_;
+
+        mutable std::mutex mutex_;
+        std::string base_url_;
+        std::string proxy_url_;
+        std::string user_agent_;
+        std::vector<std::string> default_headers_;
+        long timeout_ms_{5000};
+        size_t max_background_{8};
+        bool http2_{true};
+        CURLSH *share_{nullptr};
+        bool stopping_{false};
+        std::deque<std::unique_ptr<Transfer>> high_queue_;
+        std::deque<std::unique_ptr<Transfer>> normal_queue_;
+
+        // Loop thread only
+        std::map<void *, std::unique_ptr<Transfer>> active_; // CURL* -> transfer
+        size_t active_normal_{0};
+        std::vector<void *> idle_handles_; // Easy handles kept for reuse
+        std::vector<std::unique_ptr<Transfer>> rejected_; // Failed to start, completed outside mutex_
+
+        std::atomic<uint64_t> submitted_{0};
+        std::atomic<uint64_t> completed_{0};
+        std::atomic<uint64_t> failed_{0};
+        std::atomic<uint64_t> http2_count_{0};
+        std::atomic<uint64_t> connects_{0};
+        std::atomic<size_t> queued_{0};
+        std::atomic<size_t> in_flight_{0};
+
+        void run();
+        void start_queued();
+        void start_transfer(std::unique_ptr<Transfer> transfer);
+        void finish_transfer(void *easy, int result);
+        void fail_all(const std::string &error);
+        static void complete(Transfer &transfer);
+    };
+
+} // namespace polymarket
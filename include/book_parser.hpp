@@ -0,0 +1,76 @@
+#pragma once
+
+#include "types.hpp"
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace polymarket
+{
+
+    // Single level delta from a price_change event (size 0 removes the level)
+    struct LevelChange
+    {
+        std::string_view asset_id; // Points into the parsed frame
+        BookSide side;
+        double price;
+        double size;
+        std::string_view hash; // Server book hash after this change, if sent
+
+        // Server top of book after this change, if sent
+        bool has_top_of_book;
+        double best_bid;
+        double best_ask;
+    };
+
+    // One orderbook event decoded from a WebSocket frame
+    struct BookEvent
+    {
+        WsMessageType type = WsMessageType::UNKNOWN;
+        Orderbook book;                  // Snapshots: asset_id, bids and asks sorted best-first (buffers are reused between frames)
+        std::vector<LevelChange> changes; // Updates: level deltas in arrival order
+        std::string_view hash;           // Server book hash, if sent (points into the parsed frame)
+        uint64_t server_timestamp_ms{0}; // "timestamp" field of the frame, 0 if absent
+        std::string_view old_tick_size;  // tick_size_change only (points into the parsed frame)
+        std::string_view new_tick_size;
+    };
+
+    // Allocation-free scanner for orderbook WebSocket frames.
+    //
+    // Understands the real-time data format
+    //   {"topic": "clob_market", "type": "agg_orderbook", "payload": {"asset_id": "...", "asks": [...], "bids": [...]}}
+    // and the CLOB market channel format
+    //   {"event_type": "book", "asset_id": "...", "bids": [...], "asks": [...]}
+    //   {"event_type": "price_change", "price_changes": [{"asset_id": "...", "price": "...", "size": "...", "side": "BUY", ...}]}
+    //   {"event_type": "tick_size_change", "asset_id": "...", "old_tick_size": "0.01", "new_tick_size": "0.001"}
+    // including top-level arrays of events. price_change events are decoded into level deltas, also from the
+    // older "changes" list and from bids/asks lists. Only the fields the orderbook needs are decoded; everything
+    // else is skipped without being materialised. Prices and sizes are converted with std::from_chars.
+    //
+    // Events are owned by the parser and keep their vector/string capacity, so once the buffers have
+    // grown to the working depth, parsing does not touch the heap. Events stay valid until the next parse(),
+    // and string views in them only as long as the frame buffer.
+    class BookFrameParser
+    {
+    public:
+        BookFrameParser();
+
+        // Parse a frame. Returns false if it is malformed, in which case size() is 0 and error() is set.
+        bool parse(std::string_view frame);
+
+        // Orderbook events found in the last parsed frame
+        size_t size() const { return count_; }
+        const BookEvent &event(size_t index) const { return events_[index]; }
+
+        const char *error() const { return error_; }
+
+    private:
+        std::vector<BookEvent> events_;
+        size_t count_;
+        const char *error_;
+
+        BookEvent &next_event();
+    };
+
+} // namespace polymarket
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "types.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace polymarket
+{
+
+    // Levels per side kept in a BookSnapshot
+    constexpr size_t kSnapshotDepth = 10;
+
+    // Fixed-size top-N view of one book (trivially copyable, no heap)
+    struct BookSnapshot
+    {
+        TopOfBook top;
+        uint32_t bid_count{0};            // Valid entries in bids
+        uint32_t ask_count{0};            // Valid entries in asks
+        PriceLevel bids[kSnapshotDepth]{}; // Best-first
+        PriceLevel asks[kSnapshotDepth]{}; // Best-first
+        uint64_t timestamp_ns{0};          // Local time of the update
+        uint64_t server_ts_ms{0};          // Server timestamp of the update, 0 if unknown
+        uint64_t needs_resync{0};          // Non-zero if the book is out of sync with the server
+    };
+
+    // Single-writer, multi-reader seqlock around a BookSnapshot.
+    //
+    // The writer bumps the sequence to odd, stores the snapshot and bumps it back to even; readers copy the
+    // snapshot and retry if the sequence was odd or moved. Readers never block the writer and never allocate.
+    // The payload is stored as relaxed atomic words so concurrent copies are well-defined.
+    class BookSnapshotSlot
+    {
+    public:
+        // Publish a new snapshot. Callers must serialise writers.
+        void write(const BookSnapshot &snapshot)
+        {
+            uint64_t words[kWords];
+            std::memcpy(words, &snapshot, sizeof(BookSnapshot));
+
+            uint64_t seq = seq_.load(std::memory_order_relaxed);
+            seq_.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < kWords; i++)
+            {
+                words_[i].store(words[i], std::memory_order_relaxed);
+            }
+            seq_.store(seq + 2, std::memory_order_release);
+        }
+
+        // Copy the latest snapshot into out. Returns false if nothing has been published yet.
+        bool read(BookSnapshot &out) const
+        {
+            uint64_t words[kWords];
+            for (;;)
+            {
+                uint64_t before = seq_.load(std::memory_order_acquire);
+                if (before & 1)
+                {
+                    continue; // Write in progress
+                }
+                for (size_t i = 0; i < kWords; i++)
+                {
+                    words[i] = words_[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq_.load(std::memory_order_relaxed) == before)
+                {
+                    if (before == 0)
+                    {
+                        return false;
+                    }
+                    std::memcpy(&out, words, sizeof(BookSnapshot));
+                    return true;
+                }
+            }
+        }
+
+        // Number of snapshots published (cheap change check for pollers)
+        uint64_t version() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+    private:
+        static_assert(std::is_trivially_copyable_v<BookSnapshot>, "BookSnapshot must be trivially copyable");
+        static_assert(sizeof(BookSnapshot) % sizeof(uint64_t) == 0, "BookSnapshot must be a whole number of words");
+        static constexpr size_t kWords = sizeof(BookSnapshot) / sizeof(uint64_t);
+
+        alignas(64) std::atomic<uint64_t> seq_{0};
+        std::atomic<uint64_t> words_[kWords]{};
+    };
+
+} // namespace polymarket
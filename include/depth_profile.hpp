@@ -0,0 +1,53 @@
+#pragma once
+
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace polymarket
+{
+
+    // Levels per side kept in a DepthProfile
+    constexpr size_t kDepthLevels = 32;
+
+    // Cumulative depth of one book side (best-first), as prefix sums in fixed arrays.
+    // Rebuilt in O(levels) per update without allocating; size and cost queries are then O(log levels).
+    struct DepthProfile
+    {
+        uint32_t count{0};
+        double price[kDepthLevels]{};        // Level price
+        double cum_size[kDepthLevels]{};     // Shares through this level
+        double cum_notional[kDepthLevels]{}; // Sum of price * size through this level
+
+        // Take the first kDepthLevels of a best-first side
+        void build(const std::vector<PriceLevel> &levels);
+
+        double total_size() const { return count ? cum_size[count - 1] : 0.0; }
+
+        // Level that fills the size-th share (count if size exceeds the known depth)
+        uint32_t level_for(double size) const;
+
+        // Cost of the first size shares (capped at the known depth), their VWAP and the worst level price reached
+        double cost(double size) const;
+        double vwap(double size) const;
+        double limit_price(double size) const;
+    };
+
+    // Both legs of a YES + NO purchase at a given size
+    struct ArbSizing
+    {
+        double size{0.0};       // Shares of each leg
+        double vwap_yes{0.0};
+        double vwap_no{0.0};
+        double limit_yes{0.0};  // Worst ask reached on each leg (limit price for the order)
+        double limit_no{0.0};
+        double cost{0.0};       // Total USDC for both legs
+        double edge{0.0};       // size - cost: profit at resolution (one leg pays 1)
+    };
+
+    // Largest size at which every share of YES + NO can be bought with the marginal pair price below threshold,
+    // walking both ask profiles together (O(levels), no allocation)
+    ArbSizing size_pair_arb(const DepthProfile &yes_asks, const DepthProfile &no_asks, double threshold);
+
+} // namespace polymarket
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "types.hpp"
+#include "book_snapshot.hpp"
+#include "token_registry.hpp"
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace polymarket
+{
+
+    // Fill of one leg of an event basket
+    struct EventLegFill
+    {
+        TokenHandle token;
+        double best_price;  // Best ask (buy) / bid (sell)
+        double limit_price; // Worst level the basket size reaches on this leg
+    };
+
+    // Basket opportunity across all outcomes of a neg-risk event
+    struct EventArbOpportunity
+    {
+        std::string_view event_id;
+        size_t event_index;
+        bool buy;        // true: buy YES on every leg (sum of asks below trigger); false: sell YES on every leg
+        double sum_best; // Sum of best asks (buy) / bids (sell)
+        double size;     // Shares per leg executable while the basket stays past the trigger
+        double notional; // Total cost (buy) / proceeds (sell) of size shares on every leg
+        double edge;     // Profit locked in at resolution: size - notional (buy), notional - size (sell)
+        const std::vector<EventLegFill> &legs;
+    };
+
+    using EventArbCallback = std::function<void(const EventArbOpportunity &opportunity)>;
+
+    // Event-level arbitrage scanner for neg-risk events (N mutually exclusive outcomes, exactly one resolves YES).
+    //
+    // Keeps the sum of best YES asks and best YES bids of every event, updated in O(1) per leg update from the
+    // difference to the leg's previous best price (in integer micro-units, so the sums never drift). Only when a
+    // sum crosses its trigger does it walk the legs' depth to find how many baskets are executable.
+    //
+    // Every outcome of an event must be registered, otherwise the basket does not pay out. Not thread-safe.
+    class EventArbScanner
+    {
+    public:
+        // Buy baskets while the summed asks are below buy_trigger, sell while the summed bids are above sell_trigger
+        explicit EventArbScanner(double buy_trigger = 0.98, double sell_trigger = 1.02);
+
+        // Returned by add_event for an event that was not registered
+        static constexpr size_t kRejectedEvent = static_cast<size_t>(-1);
+
+        // Register an event from the YES token of each outcome; returns its index. A basket with a leg missing does
+        // not pay out, so an event with no legs, a kInvalidToken leg or a leg already in an event (or listed twice)
+        // is rejected as a whole: nothing is registered and kRejectedEvent is returned.
+        size_t add_event(const std::string &event_id, const std::vector<TokenHandle> &yes_tokens);
+        void clear();
+
+        // Feed a book update for a token (levels sorted best-first); tokens outside any event are ignored
+        void update(TokenHandle token, const Orderbook &book);
+
+        void on_opportunity(EventArbCallback callback) { on_opportunity_cb_ = std::move(callback); }
+        void set_triggers(double buy_trigger, double sell_trigger);
+
+        // Current sums (0 until every leg has quoted that side)
+        size_t event_count() const { return events_.size(); }
+        double sum_asks(size_t event) const;
+        double sum_bids(size_t event) const;
+
+        uint64_t opportunities() const { return opportunities_; }
+
+    private:
+        static constexpr uint32_t kNoLeg = 0xFFFFFFFF;
+
+        // Top levels of one outcome's YES book
+        struct Leg
+        {
+            TokenHandle token;
+            uint32_t event;
+            uint32_t ask_count{0};
+            uint32_t bid_count{0};
+            PriceLevel asks[kSnapshotDepth]{};
+            PriceLevel bids[kSnapshotDepth]{};
+            int64_t best_ask_micros{0}; // 0 when there is no ask
+            int64_t best_bid_micros{0}; // 0 when there is no bid
+        };
+
+        struct Event
+        {
+            std::string id;
+            std::vector<uint32_t> legs; // Indices into legs_
+            int64_t sum_ask_micros{0};
+            int64_t sum_bid_micros{0};
+            uint32_t legs_without_ask{0};
+            uint32_t legs_without_bid{0};
+        };
+
+        int64_t buy_trigger_micros_;
+        int64_t sell_trigger_micros_;
+        std::vector<Leg> legs_;
+        std::vector<Event> events_;
+        std::vector<uint32_t> leg_by_token_; // Token handle -> leg index (kNoLeg if none)
+
+        EventArbCallback on_opportunity_cb_;
+        uint64_t opportunities_{0};
+
+        // Reused for every check: callback fills and depth walk state, per leg of the event
+        std::vector<EventLegFill> fills_;
+        std::vector<uint32_t> walk_level_;
+        std::vector<double> walk_left_;
+
+        void check(uint32_t event_index, bool buy);
+    };
+
+} // namespace polymarket
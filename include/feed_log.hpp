@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace polymarket
+{
+
+    // One captured WebSocket frame
+    struct FeedFrame
+    {
+        size_t shard{0};
+        uint64_t receive_ns{0};
+        std::string_view data; // Points into the mapped file
+    };
+
+    // Append-only capture of raw market data frames, memory-mapped so an append is a copy into the page cache.
+    //
+    // Layout: a 16-byte file header ("PMFEED01", reserved), then one record per frame: a 16-byte header with the
+    // frame length, shard and socket receive time, followed by the frame bytes padded to 8 bytes. The file grows
+    // in chunk_bytes steps and is trimmed to the written size on close; a file left behind by a crash ends in
+    // zeroed space, which readers treat as the end. Frames are stored as received (JSON), so a replay goes
+    // through the same parser as the live feed.
+    //
+    // append() is thread-safe, so all shards of an OrderbookManager can share one recorder. File space is allocated
+    // chunk by chunk before it is mapped; if that fails (e.g. the disk is full) recording stops and later frames
+    // are dropped, rather than the feed thread faulting on a write into the mapping.
+    class FeedRecorder
+    {
+    public:
+        explicit FeedRecorder(const std::string &path, size_t chunk_bytes = 64 << 20); // Truncates; throws on I/O errors
+        ~FeedRecorder();
+
+        FeedRecorder(const FeedRecorder &) = delete;
+        FeedRecorder &operator=(const FeedRecorder &) = delete;
+
+        void append(size_t shard, uint64_t receive_ns, std::string_view frame);
+
+        // Write mapped pages back to the file (the kernel does this on its own eventually)
+        void flush();
+
+        uint64_t frames() const;
+        size_t bytes() const;     // File bytes written so far, headers included
+        bool failed() const;      // Recording stopped after the file could not be extended
+        uint64_t dropped() const; // Frames not recorded since then
+
+    private:
+        int fd_{-1};
+        char *base_{nullptr};
+        size_t capacity_{0};
+        size_t size_{0};
+        size_t chunk_bytes_;
+        uint64_t frames_{0};
+        bool failed_{false};
+        uint64_t dropped_{0};
+        mutable std::mutex mutex_;
+
+        void grow(size_t needed);
+    };
+
+    // Sequential reader over a FeedRecorder file, mapped read-only
+    class FeedReader
+    {
+    public:
+        explicit FeedReader(const std::string &path); // Throws if the file can't be opened or isn't a feed log
+        ~FeedReader();
+
+        FeedReader(const FeedReader &) = delete;
+        FeedReader &operator=(const FeedReader &) = delete;
+
+        // Next frame in capture order; false at the end. out.data stays valid for the reader's lifetime.
+        bool next(FeedFrame &out);
+        void rewind();
+
+        size_t size_bytes() const { return size_; }
+
+    private:
+        int fd_{-1};
+        const char *base_{nullptr};
+        size_t size_{0};
+        size_t offset_{0};
+    };
+
+} // namespace polymarket
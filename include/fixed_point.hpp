@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace polymarket
+{
+
+    enum class Rounding
+    {
+        DOWN,   // Toward negative infinity
+        UP,     // Toward positive infinity
+        NEAREST // Half away from zero
+    };
+
+    // Decimal with 6 fractional digits, stored as an integer count of millionths. That is the on-chain unit of
+    // both USDC and outcome shares, so an order amount's wei string is just raw(), and prices, sizes and
+    // notionals can be rounded exactly instead of through double and ostringstream round trips.
+    // Products and quotients use a 128-bit intermediate, so they are exact up to the final rounding.
+    class Fixed6
+    {
+    public:
+        static constexpr int kDecimals = 6;
+        static constexpr int64_t kScale = 1000000;
+
+        constexpr Fixed6() = default;
+        static constexpr Fixed6 from_raw(int64_t micros) { return Fixed6(micros); }
+
+        // Binary noise is ignored: a double within a few ulps of a micro boundary counts as on it, so
+        // from_double(1.23, Rounding::DOWN) is 1.230000, not 1.229999.
+        static Fixed6 from_double(double value, Rounding rounding = Rounding::NEAREST);
+
+        // Plain decimal ("0.55", "-3", "12.5000001"); digits past the sixth decimal are rounded. nullopt if the
+        // text isn't a decimal number or doesn't fit.
+        static std::optional<Fixed6> parse(std::string_view text, Rounding rounding = Rounding::NEAREST);
+
+        constexpr int64_t raw() const { return micros_; }
+        double to_double() const { return static_cast<double>(micros_) / kScale; }
+
+        std::string to_string() const; // Shortest form: "0.55", "3", "-0.000001"
+        std::string to_wei() const { return std::to_string(micros_); }
+
+        // Fractional digits actually used (0..6)
+        int decimals() const;
+
+        // Rounded to a number of decimals (0..6)
+        Fixed6 round(int decimals, Rounding rounding) const;
+
+        // a * b and a / b, rounded once from the exact result to a number of decimals (a micro by default)
+        static Fixed6 mul(Fixed6 a, Fixed6 b, Rounding rounding = Rounding::DOWN, int decimals = kDecimals);
+        static Fixed6 div(Fixed6 a, Fixed6 b, Rounding rounding = Rounding::DOWN,
+                          int decimals = kDecimals); // b must not be zero
+
+        // numerator / denominator rounded to a micro; the general form of mul and div
+        static Fixed6 ratio(__int128 numerator, __int128 denominator, Rounding rounding);
+
+        constexpr Fixed6 operator+(Fixed6 other) const { return Fixed6(micros_ + other.micros_); }
+        constexpr Fixed6 operator-(Fixed6 other) const { return Fixed6(micros_ - other.micros_); }
+        constexpr auto operator<=>(const Fixed6 &) const = default;
+
+    private:
+        constexpr explicit Fixed6(int64_t micros) : micros_(micros) {}
+        int64_t micros_{0};
+    };
+
+} // namespace polymarket
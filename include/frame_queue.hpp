@@ -0,0 +1,107 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace polymarket
+{
+
+    // Hand-off of raw frames from a socket thread to one worker thread.
+    //
+    // The producer copies each frame into a recycled entry, and the worker takes the whole pending batch in one
+    // swap. The two vectors trade places on every batch and handled entries are never cleared, so the frame
+    // buffers go back to the producer with their capacity: once frames have reached their usual size, neither side
+    // allocates. Any number of producers, one consumer.
+    class FrameQueue
+    {
+    public:
+        FrameQueue() = default;
+        FrameQueue(const FrameQueue &) = delete;
+        FrameQueue &operator=(const FrameQueue &) = delete;
+
+        void push(std::string_view frame, uint64_t receive_ns)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (count_ == pending_.size())
+                {
+                    pending_.emplace_back();
+                }
+                Entry &entry = pending_[count_++];
+                entry.data.assign(frame.data(), frame.size());
+                entry.receive_ns = receive_ns;
+            }
+            cv_.notify_one();
+        }
+
+        // Consumer: wait for frames and hand each to fn(std::string_view data, uint64_t receive_ns), in arrival
+        // order. The views are valid during the call only. False once stop() was called and everything pushed
+        // before it has been handed out.
+        template <typename Fn>
+        bool drain(Fn &&fn)
+        {
+            size_t count = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this]()
+                         { return stopping_ || count_ > 0; });
+                if (count_ == 0)
+                {
+                    return false;
+                }
+                batch_.swap(pending_);
+                count = count_;
+                count_ = 0;
+            }
+            for (size_t i = 0; i < count; i++)
+            {
+                fn(std::string_view(batch_[i].data), batch_[i].receive_ns);
+            }
+            return true;
+        }
+
+        // Wake the consumer; drain() returns false once the queue is empty
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            cv_.notify_all();
+        }
+
+        // Accept a new consumer after stop()
+        void restart()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = false;
+        }
+
+        // Frames pushed and not yet taken by drain()
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return count_;
+        }
+
+    private:
+        struct Entry
+        {
+            std::string data;
+            uint64_t receive_ns{0};
+        };
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        std::vector<Entry> pending_; // First count_ entries are waiting; the rest keep their buffers for reuse
+        size_t count_{0};
+        bool stopping_{false};
+        std::vector<Entry> batch_; // Consumer only
+    };
+
+} // namespace polymarket
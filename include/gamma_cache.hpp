@@ -0,0 +1,66 @@
+#pragma once
+
+#include "async_http_client.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace polymarket
+{
+
+    // Slug-keyed cache in front of Gamma /events?slug= lookups.
+    //
+    // Found markets are kept hit_ttl_sec and slugs Gamma does not list yet miss_ttl_sec, both counted from the
+    // lookup that requested them. Transport and HTTP errors are not cached, so the next lookup retries. A slug
+    // that is already in flight is not requested again: later lookups share its result. Thread-safe.
+    class GammaCache
+    {
+    public:
+        // Sends GET path and hands the response to callback (on any thread, possibly before returning)
+        using Submit = std::function<void(const std::string &path, HttpCallback callback)>;
+
+        // Market for ticker in an /events response body, if it lists one
+        using Parse = std::function<std::optional<MarketState>(const std::string &body, const std::string &ticker)>;
+
+        // (slug, ticker) pairs to look up
+        using Query = std::vector<std::pair<std::string, std::string>>;
+
+        GammaCache(Submit submit, Parse parse, int hit_ttl_sec, int miss_ttl_sec);
+
+        // Markets found for the query, in query order (now in unix seconds). Cached slugs are served from the
+        // cache, the rest are requested at once; with wait false this only starts the requests.
+        std::vector<MarketState> lookup(const Query &query, bool wait, uint64_t now);
+
+        // Drop finished lookups (in-flight ones still complete and are kept)
+        void clear();
+
+        // Cached slugs, in flight included
+        size_t size() const;
+
+    private:
+        // Lookup result for one slug; pending is valid while the request is in flight
+        struct Entry
+        {
+            std::optional<MarketState> market;
+            uint64_t expires_sec{0};
+            std::shared_future<std::optional<MarketState>> pending;
+        };
+
+        Submit submit_;
+        Parse parse_;
+        int hit_ttl_sec_;
+        int miss_ttl_sec_;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, Entry> entries_;
+    };
+
+} // namespace polymarket
@@ -46,6 +46,7 @@ namespace polymarket
         void set_user_agent(const std::string &user_agent);
         void set_dns_cache_timeout(long seconds);  // DNS cache TTL (default: 60s)
         void set_keepalive_interval(long seconds); // TCP keepalive probe interval
+        void set_share(CURLSH *share);             // Shared DNS/TLS session cache (see HttpPool)
 
         // HTTP methods
         HttpResponse get(const std::string &path);
@@ -84,7 +85,7 @@ namespace polymarket
         // Heartbeat thread
         std::atomic<bool> heartbeat_running_;
         std::thread heartbeat_thread_;
-        mutable std::mutex curl_mutex_;
+        mutable std::recursive_mutex curl_mutex_; // One request at a time on curl_ (heartbeat included)
 
         // Connection stats
         mutable std::mutex stats_mutex_;
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "async_http_client.hpp"
+#include "http_client.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace polymarket
+{
+
+    // Connection state shared by every HttpClient and AsyncHttpClient that talks to Polymarket.
+    //
+    // All attached clients sit on one CURLSH handle. It shares the DNS cache and TLS session tickets, so once
+    // one component has resolved and handshaked with a host, the others skip the lookup and resume the TLS
+    // session. Connections are not shared: libcurl's connection cache can't be used from several threads at
+    // once, so each client keeps its own handles with their own open connections. client() also hands out
+    // one persistent HttpClient per base URL (Data API, Gamma, ...) for components that used to create a
+    // throwaway client per call.
+    //
+    // Because connections are per client, warm_all() and the heartbeat go through every attached client (and
+    // the client() ones), so the connections that carry the traffic are the ones opened and kept alive.
+    class HttpPool
+    {
+    public:
+        HttpPool();
+        ~HttpPool(); // Attached clients must be detached first
+
+        HttpPool(const HttpPool &) = delete;
+        HttpPool &operator=(const HttpPool &) = delete;
+
+        // Process-wide pool used by ClobClient and MarketFetcher (never destroyed; see http_global_cleanup)
+        static HttpPool &global();
+
+        // Put an existing client on the shared DNS/TLS session cache and have warm() and the heartbeat open and
+        // keep alive its own connection. The client must be detached before it is destroyed; detach() waits for
+        // a warm-up or heartbeat request on it to finish and forgets the host once none of its clients is left.
+        void attach(HttpClient &client, const std::string &base_url);
+        void attach(AsyncHttpClient &client, const std::string &base_url);
+        void detach(HttpClient &client);
+        void detach(AsyncHttpClient &client);
+
+        // Persistent client for a base URL, created on first use with the given timeout. The reference stays
+        // valid until shutdown(); calls on it are serialized, so long-running callers should attach their own.
+        HttpClient &client(const std::string &base_url, long timeout_ms = 10000);
+
+        // Open TCP/TLS on every client of every known host; number of hosts where a client answered. A host
+        // with no attached client gets a client() one.
+        size_t warm_all();
+        bool warm(const std::string &base_url);
+
+        // Keep every client's connection alive with a cheap GET each interval (warm() on every host)
+        void start_heartbeat(long interval_seconds = 25);
+        void stop_heartbeat();
+        bool is_heartbeat_running() const { return heartbeat_running_.load(); }
+
+        std::vector<std::string> hosts() const;
+
+        // Stop the heartbeat and drop the client() clients
+        void shutdown();
+
+        // shutdown() on the global pool if it was ever used (called from http_global_cleanup)
+        static void shutdown_global();
+
+    private:
+        void *share_; // CURLSH*
+        std::array<std::mutex, CURL_LOCK_DATA_LAST> share_locks_;
+
+        mutable std::mutex mutex_;
+        std::map<std::string, std::unique_ptr<HttpClient>> clients_; // client() clients by base URL
+        std::vector<std::string> attached_hosts_;                    // Base URLs of attach()ed clients
+
+        // attach()ed clients, one of the two pointers set. attached_mutex_ is held while they are warmed, so
+        // detach() can't return while a request on the client is running. Taken before mutex_, never after.
+        struct Attached
+        {
+            std::string base_url;
+            HttpClient *http{nullptr};
+            AsyncHttpClient *async{nullptr};
+        };
+        std::mutex attached_mutex_;
+        std::vector<Attached> attached_;
+
+        std::atomic<bool> heartbeat_running_{false};
+        std::thread heartbeat_thread_;
+        std::mutex heartbeat_mutex_;
+        std::condition_variable heartbeat_cv_;
+
+        void add_host(const std::string &base_url);
+        void remove_attached(const void *client);
+
+        static void lock_share(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr);
+        static void unlock_share(CURL *handle, curl_lock_data data, void *userptr);
+    };
+
+} // namespace polymarket
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace polymarket
+{
+
+    // Percentiles of one latency histogram, in nanoseconds
+    struct LatencySummary
+    {
+        uint64_t count{0};
+        uint64_t min_ns{0};
+        uint64_t max_ns{0};
+        double mean_ns{0.0};
+        uint64_t p50_ns{0};
+        uint64_t p99_ns{0};
+        uint64_t p999_ns{0};
+    };
+
+    // Lock-free log-linear (HDR-style) histogram of nanosecond values.
+    //
+    // Values below 64 get exact buckets. Above that, each power of two is split into 32 buckets, so any reported
+    // percentile is within ~3% of the true value. That covers the full uint64_t range in 1920 counters.
+    // record() is a few relaxed atomic adds and is safe from any number of threads. summary() may run
+    // concurrently with writers; it then sees a slightly stale but consistent-enough view.
+    class LatencyHistogram
+    {
+    public:
+        static constexpr uint32_t kSubBucketBits = 5;
+        static constexpr uint32_t kSubBuckets = 1u << kSubBucketBits;
+        static constexpr size_t kBuckets = (65 - kSubBucketBits) * kSubBuckets;
+
+        void record(uint64_t value_ns);
+        void reset();
+
+        uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+        // Highest value equivalent to the q-quantile sample (q in [0, 1]); 0 when empty
+        uint64_t percentile(double q) const;
+        LatencySummary summary() const;
+
+        static size_t bucket_for(uint64_t value);
+        static uint64_t bucket_upper(size_t bucket);
+
+    private:
+        std::atomic<uint64_t> buckets_[kBuckets]{};
+        std::atomic<uint64_t> count_{0};
+        std::atomic<uint64_t> sum_{0};
+        std::atomic<uint64_t> min_{UINT64_MAX};
+        std::atomic<uint64_t> max_{0};
+    };
+
+} // namespace polymarket
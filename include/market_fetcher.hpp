@@ -2,6 +2,13 @@
 
 #include "types.hpp"
 #include "http_client.hpp"
+#include "async_http_client.hpp"
+#include "gamma_cache.hpp"
+#include "market_pager.hpp"
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 #include <optional>
 
@@ -13,32 +20,64 @@ namespace polymarket
     {
     public:
         explicit MarketFetcher(const Config &config);
-        ~MarketFetcher() = default;
+        ~MarketFetcher();
 
-        // Fetch markets from CLOB API
+        // Fetch markets from CLOB API. Pages are streamed through a MarketPager, so the next page is already on
+        // its way while the current one is parsed.
         std::vector<ClobMarket> fetch_all_markets(int max_markets = 100);
-        std::vector<ClobMarket> fetch_neg_risk_markets(int max_markets = 50);
+        std::vector<ClobMarket> fetch_markets(const MarketFilter &filter, int max_markets = 100);
+        std::vector<ClobMarket> fetch_neg_risk_markets(int max_markets = 50); // Tradable Yes/No markets
         std::optional<ClobMarket> fetch_market(const std::string &condition_id);
 
         // Fetch orderbook
         std::optional<Orderbook> fetch_orderbook(const std::string &token_id);
 
-        // Fetch crypto up/down markets from Gamma API
+        // Fetch crypto up/down markets from Gamma API. Slug lookups run concurrently and are cached by slug
+        // (see Config::gamma_cache_ttl_sec), so a call whose windows were already fetched or prefetched makes no
+        // network round trip.
         std::vector<MarketState> fetch_crypto_15m_markets();
         std::vector<MarketState> fetch_crypto_4h_markets();
         std::vector<MarketState> fetch_crypto_1h_markets();
 
+        // Start looking up the markets the next window's fetch_crypto_*() will ask for and return immediately.
+        // Call it some time before rollover; results land in the cache.
+        void prefetch_crypto_15m_markets();
+        void prefetch_crypto_4h_markets();
+        void prefetch_crypto_1h_markets();
+
+        // Drop cached Gamma lookups (in-flight ones still complete)
+        void clear_gamma_cache();
+
         // Convert ClobMarket to MarketState
         static MarketState to_market_state(const ClobMarket &market);
 
+        // Group neg-risk markets into events by neg_risk_market_id (first-seen order, events with 2+ open outcomes).
+        // Only events whose markets are all in the input are complete; fetch every market of an event before trading it.
+        static std::vector<NegRiskEvent> group_neg_risk_events(const std::vector<ClobMarket> &markets);
+
     private:
         Config config_;
         HttpClient http_;
 
-        // Timestamp generation for crypto markets
-        std::vector<uint64_t> get_15m_timestamps(int count);
-        std::vector<uint64_t> get_4h_timestamps(int count);
-        std::vector<std::string> generate_1h_slugs(int count);
+        GammaCache gamma_;
+        std::mutex gamma_mutex_;                       // Guards creating gamma_async_; gamma_ has its own lock
+        std::unique_ptr<AsyncHttpClient> gamma_async_; // Stopped first in the destructor: its callbacks touch gamma_
+
+        std::mutex clob_async_mutex_;
+        std::unique_ptr<AsyncHttpClient> clob_async_; // CLOB listing pages (prefetched while parsing)
+
+        // Timestamp generation for crypto markets (windows around now)
+        std::vector<uint64_t> get_15m_timestamps(int count, uint64_t now);
+        std::vector<uint64_t> get_4h_timestamps(int count, uint64_t now);
+        std::vector<std::string> generate_1h_slugs(int count, time_t now);
+
+        GammaCache::Query crypto_15m_query(uint64_t now);
+        GammaCache::Query crypto_4h_query(uint64_t now);
+        GammaCache::Query crypto_1h_query(uint64_t now);
+
+        // Created on first use and put on the shared DNS/TLS session cache (HttpPool::global())
+        AsyncHttpClient &gamma_http();
+        AsyncHttpClient &clob_http();
 
         // Parse JSON responses
         std::vector<ClobMarket> parse_markets_response(const std::string &json);
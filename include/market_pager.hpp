@@ -0,0 +1,121 @@
+#pragma once
+
+#include "http_client.hpp"
+#include "types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace polymarket
+{
+
+    // Which markets a page listing keeps. Markets that fail are dropped while the page is parsed.
+    struct MarketFilter
+    {
+        bool active_only = false;       // active and not closed
+        std::optional<bool> neg_risk;   // Only neg-risk (true) or only plain (false) markets
+        std::string tag;                // Market must carry this tag
+        bool tradable_only = false;     // Has a condition id and exactly a Yes and a No token
+
+        // Checked last, on the parsed market
+        std::function<bool(const ClobMarket &)> predicate;
+
+        bool matches(const ClobMarket &market) const;
+    };
+
+    struct MarketPagerStats
+    {
+        uint64_t pages{0};      // Responses parsed
+        uint64_t markets{0};    // Markets seen in them
+        uint64_t skipped{0};    // Dropped by the filter
+        uint64_t prefetched{0}; // Pages already requested while the previous one was parsed
+        uint64_t refetched{0};  // Prefetches thrown away because the parsed cursor differed from the scanned one
+    };
+
+    // Walks a cursor-paginated market listing (/markets, /sampling-markets, /simplified-markets,
+    // /sampling-simplified-markets) one page at a time.
+    //
+    // As soon as a page arrives its next_cursor is picked out with a quick scan and the following page is
+    // requested, so the round trip for page N+1 overlaps parsing page N. Pages are parsed with a SAX handler
+    // straight into ClobMarket; markets the filter rejects are never added to the output (and once a field has
+    // ruled one out, its remaining strings aren't copied). Stops at the server's end cursor ("LTE="), after
+    // `limit` matching markets, or on the first failed request (see error()).
+    //
+    // Not thread-safe; one pager per walk. Only one request is ever in flight.
+    class MarketPager
+    {
+    public:
+        // Starts the request for `path` and returns its response
+        using Fetch = std::function<std::future<HttpResponse>(const std::string &path)>;
+
+        MarketPager(Fetch fetch, std::string endpoint, MarketFilter filter = {},
+                    size_t limit = std::numeric_limits<size_t>::max(), std::string cursor = "");
+
+        MarketPager(MarketPager &&) = default;
+        MarketPager &operator=(MarketPager &&) = default;
+
+        // Matching markets of the next page into out (cleared first; may be empty when a whole page is filtered
+        // out). False once the listing is exhausted or a request failed.
+        bool next(std::vector<ClobMarket> &out);
+
+        // Call fn(ClobMarket &&) for every remaining matching market; returns how many there were
+        template <typename Fn>
+        size_t for_each(Fn &&fn)
+        {
+            size_t count = 0;
+            std::vector<ClobMarket> page;
+            while (next(page))
+            {
+                for (auto &market : page)
+                {
+                    fn(std::move(market));
+                    count++;
+                }
+            }
+            return count;
+        }
+
+        // Everything that is left, in listing order
+        std::vector<ClobMarket> collect();
+
+        bool done() const { return done_; }
+        const std::string &cursor() const { return cursor_; } // Cursor of the page next() fetches next
+        const std::string &error() const { return error_; }
+        const MarketPagerStats &stats() const { return stats_; }
+
+        // Parse one listing response ({"data": [...], "next_cursor": "..."} or a bare array) into out (cleared
+        // first), keeping only markets the filter matches. False if the body is malformed, in which case out is
+        // empty. skipped, if given, receives how many markets were filtered out.
+        static bool parse_page(std::string_view body, const MarketFilter &filter, std::vector<ClobMarket> &out,
+                               std::string &next_cursor, size_t *skipped = nullptr);
+
+        // next_cursor of a response without parsing it; nullopt if there is none
+        static std::optional<std::string> scan_cursor(std::string_view body);
+
+        // True for the cursor the server returns after the last page
+        static bool is_end_cursor(std::string_view cursor) { return cursor.empty() || cursor == "LTE="; }
+
+    private:
+        Fetch fetch_;
+        std::string endpoint_;
+        MarketFilter filter_;
+        size_t limit_;
+        size_t matched_{0};
+
+        std::string cursor_;
+        std::future<HttpResponse> pending_; // Request for cursor_, if already sent
+        size_t last_page_matched_{0};
+        bool done_{false};
+        std::string error_;
+        MarketPagerStats stats_;
+
+        void request(const std::string &cursor);
+    };
+
+} // namespace polymarket
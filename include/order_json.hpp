@@ -0,0 +1,23 @@
+#pragma once
+
+#include "order_signer.hpp"
+#include <string>
+#include <string_view>
+
+namespace polymarket
+{
+
+    // Direct writers for the fixed-shape order payloads of POST /order and POST /orders.
+    //
+    // They append into a caller-owned buffer (keep one around and clear() it between requests so it stays
+    // reserved) and produce exactly the bytes nlohmann::ordered_json::dump() gave for the same fields, so the
+    // signed HMAC message does not change. The finished buffer goes to the L2 HMAC and to curl as is.
+
+    // {"order":{...},"owner":"...","orderType":"...","deferExec":false[,"postOnly":true]}
+    void append_order_payload(std::string &out, const SignedOrder &order, std::string_view owner,
+                              std::string_view order_type, bool post_only);
+
+    // JSON string literal (quotes included) with dump()'s escaping
+    void append_json_string(std::string &out, std::string_view value);
+
+} // namespace polymarket
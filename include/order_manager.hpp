@@ -0,0 +1,159 @@
+#pragma once
+
+#include "clob_client.hpp"
+#include "user_stream.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace polymarket
+{
+
+    struct OrderManagerConfig
+    {
+        std::chrono::microseconds coalesce_window{500}; // How long the first queued request waits for company
+        size_t max_post_batch = 15;                     // POST /orders limit
+        size_t max_cancel_batch = 500;
+        bool post_only = false;
+        std::chrono::seconds retain_dead{60};           // Filled / canceled orders are remembered this long
+    };
+
+    enum class OrderState
+    {
+        LIVE,
+        CANCEL_PENDING, // Cancel queued or in flight
+        FILLED,
+        CANCELED,
+        UNKNOWN // Cancel refused for a reason we don't recognise and the status query failed: not assumed dead
+    };
+
+    // Our view of one order, keyed by the server order id
+    struct TrackedOrder
+    {
+        std::string id;
+        std::string market;
+        std::string token_id;
+        OrderSide side{OrderSide::BUY};
+        double price{0.0};
+        double original_size{0.0};
+        double size_matched{0.0};
+        OrderState state{OrderState::LIVE};
+        uint64_t updated_ns{0};
+    };
+
+    struct OrderManagerStats
+    {
+        uint64_t posts{0};             // post() / replace() calls
+        uint64_t posts_superseded{0};  // Replacements overtaken by a newer replace() before they were sent
+        uint64_t posts_rejected{0};    // replace() of an order already known dead
+        uint64_t replaces_aborted{0};  // Replacements not posted because the old order's cancel wasn't confirmed
+        uint64_t post_requests{0};     // POST /orders calls
+        uint64_t cancels{0};           // cancel() calls, including those from replace()
+        uint64_t cancels_suppressed{0}; // Already dead or already being canceled
+        uint64_t cancel_requests{0};   // DELETE /orders calls
+        uint64_t cancel_errors{0};     // Cancel batches that failed in transport
+        size_t live_orders{0};
+    };
+
+    // Order routing layer over ClobClient that mirrors our live orders and batches what strategy code sends.
+    //
+    // post(), cancel() and replace() only queue. A flush thread waits coalesce_window after the first queued
+    // request (or until a full POST batch is ready), then sends every queued cancel as DELETE /orders and every
+    // queued post() as POST /orders, both at once on the client's async HTTP/2 engine. Replacements go out as a
+    // second POST /orders once the DELETE has answered, and only for orders it confirmed canceled, so an old and a
+    // new order are never live together. Requests queued while a flush is in flight go out together in the next
+    // one. Redundant work is dropped before it reaches the wire: cancels for orders already filled, canceled or
+    // being canceled, and replacements overtaken by a newer replace() of the same order.
+    //
+    // Order state comes from post and cancel responses and from the user channel: feed
+    // UserStreamManager::on_order into on_user_order(). A cancel refused for a reason the manager doesn't know
+    // is settled with a get_order() status query, never assumed. Thread-safe.
+    class OrderManager
+    {
+    public:
+        explicit OrderManager(ClobClient &client, OrderManagerConfig config = {});
+        ~OrderManager(); // Sends whatever is still queued
+
+        OrderManager(const OrderManager &) = delete;
+        OrderManager &operator=(const OrderManager &) = delete;
+
+        std::future<OrderResponse> post(const SignedOrder &order, OrderType order_type = OrderType::GTC);
+
+        // False if the cancel was dropped as redundant; otherwise it goes out with the next flush
+        bool cancel(const std::string &order_id);
+
+        // Cancel order_id and post order in the same flush, after the cancel is confirmed. Fails right away if
+        // order_id is known to be filled or canceled, and without posting if the cancel fails or the order filled
+        // first; a later replace() of the same order_id before the flush supersedes this one.
+        std::future<OrderResponse> replace(const std::string &order_id, const SignedOrder &order,
+                                           OrderType order_type = OrderType::GTC);
+
+        // Send what is queued without waiting for the rest of the window
+        void flush();
+
+        // Block until nothing is queued or in flight (false on timeout)
+        bool wait_idle(std::chrono::milliseconds timeout);
+
+        // User channel order events (PLACEMENT / UPDATE / CANCELLATION)
+        void on_user_order(const UserOrderEvent &event);
+
+        // Start tracking an order placed elsewhere, e.g. from ClobClient::get_open_orders() after a restart
+        void track(const OpenOrder &order);
+
+        std::optional<TrackedOrder> order(const std::string &order_id) const;
+        std::vector<TrackedOrder> live_orders() const; // LIVE and CANCEL_PENDING
+        OrderManagerStats stats() const;
+
+    private:
+        struct PendingPost
+        {
+            SignedOrder order;
+            OrderType order_type;
+            std::string replaces; // Order id this one replaces, if any
+            std::promise<OrderResponse> promise;
+        };
+
+        struct Entry
+        {
+            TrackedOrder order;
+            bool known{true}; // False for a cancel of an id we never saw placed
+        };
+
+        ClobClient &client_;
+        OrderManagerConfig config_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;      // Work queued, flush requested or stopping
+        std::condition_variable idle_cv_; // A flush finished
+        std::unordered_map<std::string, Entry> orders_;
+        std::vector<std::string> cancel_queue_;
+        std::vector<PendingPost> post_queue_;
+        std::chrono::steady_clock::time_point first_queued_;
+        bool flush_now_{false};
+        bool in_flight_{false};
+        bool stopping_{false};
+        OrderManagerStats stats_;
+
+        std::thread flusher_;
+
+        // (first post, responses) per POST /orders request
+        using PostBatches = std::vector<std::pair<size_t, std::future<std::vector<OrderResponse>>>>;
+
+        void run();
+        void send(std::vector<std::string> cancels, std::vector<PendingPost> posts);
+        PostBatches send_posts(std::vector<PendingPost> &posts);
+        void finish_posts(std::vector<PendingPost> &posts, PostBatches batches);
+        void query_status(const std::vector<std::string> &order_ids);
+        bool queue_cancel(const std::string &order_id); // Caller holds mutex_
+        void mark_queued();                             // Caller holds mutex_
+        void prune();                                   // Caller holds mutex_
+        bool has_work() const { return !cancel_queue_.empty() || !post_queue_.empty(); }
+    };
+
+} // namespace polymarket
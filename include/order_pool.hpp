@@ -0,0 +1,138 @@
+#pragma once
+
+#include "types.hpp"
+#include "order_signer.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace polymarket
+{
+
+    // What the pool keeps signed for each leg
+    struct OrderPoolConfig
+    {
+        std::string exchange_address = NEG_RISK_EXCHANGE_ADDRESS;
+        std::string maker;                   // Funder address (defaults to the signer's address)
+        SignatureType signature_type = SignatureType::EOA;
+        OrderSide side = OrderSide::BUY;
+        std::string fee_rate_bps = "0";
+        std::string nonce = "0";
+
+        double tick_size = 0.01;
+        int levels = 4;                      // Prices kept per leg: best ask + 0 .. levels-1 ticks
+        std::vector<double> sizes_usdc;      // Notional per order; shares = floor(notional / price, 0.01)
+
+        uint64_t ttl_sec = 0;                // Order expiration (0: never expires)
+        uint64_t refresh_margin_sec = 90;    // Re-sign (and stop handing out) this long before expiry
+    };
+
+    struct OrderPoolStats
+    {
+        uint64_t hits{0};          // take() served a pre-signed order
+        uint64_t misses{0};        // take() found nothing usable
+        uint64_t signed_orders{0}; // Orders signed by the refill thread
+        uint64_t discarded{0};     // Dropped unused: repriced, expired or invalidated
+        size_t ready{0};           // Orders waiting to be taken
+    };
+
+    // Pre-signed orders for the legs of the active market, so a signal only has to pick one and post it.
+    //
+    // For every leg the pool keeps one order per (price, size) on a grid anchored at the leg's best ask, each with
+    // its own salt. update_price() moves the grid; a background thread signs what is missing (in one batch via
+    // OrderSigner::sign_orders) and drops orders that fell off the grid. take() is a short locked scan and hands
+    // each order out once. set_legs() drops the orders of legs it removes, set_nonce() and invalidate() drop
+    // everything; batches still being signed are thrown away too, so a rollover or a nonce bump can never serve a
+    // stale order.
+    class OrderPool
+    {
+    public:
+        OrderPool(OrderSigner &signer, OrderPoolConfig config);
+        ~OrderPool();
+
+        OrderPool(const OrderPool &) = delete;
+        OrderPool &operator=(const OrderPool &) = delete;
+
+        // Replace the legs (e.g. YES and NO of the new market on rollover). New legs start with an unknown price;
+        // legs already in the pool keep theirs and their signed orders, so adding the next market's legs ahead of
+        // a rollover and then dropping the old ones leaves the new legs hot.
+        void set_legs(const std::vector<std::string> &token_ids);
+
+        // Best ask of a leg changed; cheap when it stays on the same tick. Unknown tokens are ignored.
+        void update_price(const std::string &token_id, double best_ask);
+
+        void set_sizes(const std::vector<double> &sizes_usdc);
+        void set_nonce(const std::string &nonce);
+        void invalidate();
+
+        // Largest ready order for the token at exactly this limit price with at most max_shares shares (none for a
+        // price off the tick grid)
+        std::optional<SignedOrder> take(const std::string &token_id, double price, double max_shares);
+
+        // Block until every leg with a known price has its full grid signed (false on timeout)
+        bool wait_ready(std::chrono::milliseconds timeout);
+
+        OrderPoolStats stats() const;
+
+        // Shares a notional buys at a price, rounded down to 0.01 like the arb legs
+        static double shares_for(double size_usdc, double price);
+
+    private:
+        struct Entry
+        {
+            int64_t price_ticks;
+            double shares;
+            uint64_t expires_at; // Unix seconds, 0: never
+            SignedOrder order;
+        };
+
+        struct Leg
+        {
+            std::string token_id;
+            int64_t ask_ticks{0}; // 0 until the first update_price()
+            std::vector<Entry> entries;
+        };
+
+        // What one refill pass signs
+        struct Pending
+        {
+            size_t leg;
+            int64_t price_ticks;
+            double shares;
+            uint64_t expires_at;
+        };
+
+        OrderSigner &signer_;
+        OrderPoolConfig config_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable work_cv_;  // Refill thread: something changed
+        std::condition_variable ready_cv_; // wait_ready(): a refill pass finished
+        std::vector<Leg> legs_;
+        uint64_t generation_{0}; // Bumped by set_legs/set_nonce/invalidate; in-flight batches are thrown away
+        bool dirty_{false};
+        bool stopping_{false};
+        std::thread worker_;
+
+        std::atomic<uint64_t> hits_{0};
+        std::atomic<uint64_t> misses_{0};
+        std::atomic<uint64_t> signed_{0};
+        std::atomic<uint64_t> discarded_{0};
+
+        void run();
+        std::vector<Pending> plan(uint64_t now);
+        bool complete() const;
+        bool wanted(const Leg &leg, int64_t price_ticks, double shares) const;
+        bool usable(const Entry &entry, uint64_t now) const;
+        OrderData make_order(const Leg &leg, int64_t price_ticks, double shares, uint64_t expires_at) const;
+        double tick_price(int64_t ticks) const;
+        int64_t to_ticks(double price) const;
+        void clear_entries();
+    };
+
+} // namespace polymarket
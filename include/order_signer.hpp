@@ -4,12 +4,19 @@
 #include <vector>
 #include <cstdint>
 #include <array>
+#include <memory>
+#include <mutex>
+#include <span>
 
 namespace polymarket
 {
     // Forward declaration
     class HttpClient;
 
+    // Exchange contracts for Polygon mainnet (verifying contracts of the order EIP-712 domain)
+    inline const std::string EXCHANGE_ADDRESS = "0x4bFb41d5B3570DeFd03C39a9A4D8dE6Bd8B8982E";
+    inline const std::string NEG_RISK_EXCHANGE_ADDRESS = "0xC5d563A36AE78145C45a50134d48A1215220f80a";
+
     // Signature types supported by Polymarket
     enum class SignatureType
     {
@@ -73,6 +80,10 @@ namespace polymarket
         OrderSigner(const std::string &private_key, int chain_id = 137);
         ~OrderSigner();
 
+        // Owns the secp256k1 context, the HMAC context and the locked key buffer
+        OrderSigner(const OrderSigner &) = delete;
+        OrderSigner &operator=(const OrderSigner &) = delete;
+
         // Get the signer's address
         std::string address() const { return address_; }
 
@@ -80,6 +91,21 @@ namespace polymarket
         SignedOrder sign_order(const OrderData &order, const std::string &exchange_address);
         SignedOrder sign_order_with_salt(const OrderData &order, const std::string &exchange_address, const std::string &salt);
 
+        // EIP-712 digest that sign_order_with_salt signs: keccak256(0x1901 || domain separator || order struct hash)
+        std::array<uint8_t, 32> order_digest(const OrderData &order, const std::string &exchange_address,
+                                             const std::string &salt) const;
+
+        // Sign a batch, spreading it over the signing pool (one secp256k1 context per worker); results keep the
+        // input order. exchange_addresses holds one verifying contract per order.
+        std::vector<SignedOrder> sign_orders(std::span<const OrderData> orders, const std::string &exchange_address);
+        std::vector<SignedOrder> sign_orders(std::span<const OrderData> orders,
+                                             std::span<const std::string> exchange_addresses);
+
+        // Worker threads used by sign_orders (0: sign on the calling thread). Defaults to
+        // min(4, hardware_concurrency - 1); the calling thread always signs alongside the workers.
+        void set_signing_threads(size_t threads);
+        size_t signing_threads() const { return signing_threads_; }
+
         // Sign a message hash (returns 65-byte signature with v,r,s)
         std::string sign_hash(const std::array<uint8_t, 32> &hash);
 
@@ -115,26 +141,61 @@ namespace polymarket
         };
         L2Headers generate_l2_headers(const ApiCredentials &creds, const std::string &method,
                                       const std::string &path, const std::string &body = "");
+        // Same, signed at a given unix timestamp (seconds)
+        L2Headers generate_l2_headers(const ApiCredentials &creds, const std::string &method,
+                                      const std::string &path, const std::string &body, uint64_t timestamp);
 
     private:
-        std::string private_key_;
+        std::array<uint8_t, 32> secret_key_{}; // Parsed once; mlock'ed and wiped on destruction
+        bool key_locked_{false};
         std::string address_;
         int chain_id_;
-        void *secp256k1_ctx_; // secp256k1_context*
+        void *secp256k1_ctx_{nullptr}; // secp256k1_context*
+
+        // HMAC-SHA256 context preloaded with the decoded L2 secret (EVP_MAC_CTX* / HMAC_CTX*), reused per request
+        std::mutex hmac_mutex_;
+        void *hmac_ctx_{nullptr};
+        std::string hmac_secret_; // Secret the context was loaded from
+
+        // Batch signing workers, started on first use; batches are serialised by pool_mutex_
+        struct SigningPool;
+        std::mutex pool_mutex_;
+        std::unique_ptr<SigningPool> pool_;
+        size_t signing_threads_;
+
+        // Domain separators computed at construction (chain id + verifying contract are fixed per signer)
+        struct ExchangeDomain
+        {
+            std::array<uint8_t, 20> contract;
+            std::array<uint8_t, 32> separator;
+        };
+        std::array<ExchangeDomain, 2> exchange_domains_; // EXCHANGE_ADDRESS, NEG_RISK_EXCHANGE_ADDRESS
+        std::array<uint8_t, 32> clob_auth_domain_;
 
         // Derive address from private key
         std::string derive_address();
 
-        // EIP-712 encoding helpers
-        std::array<uint8_t, 32> hash_domain(const std::string &name, const std::string &version,
-                                            int chain_id, const std::string &verifying_contract);
-        std::array<uint8_t, 32> hash_order(const OrderData &order, const std::string &salt);
-        std::array<uint8_t, 32> encode_eip712(const std::array<uint8_t, 32> &domain_hash,
-                                              const std::array<uint8_t, 32> &struct_hash);
+        // Sign through a specific secp256k1 context (pool workers use their own)
+        std::string sign_hash_with(void *ctx, const std::array<uint8_t, 32> &hash) const;
+        SignedOrder sign_with(void *ctx, const OrderData &order, const std::string &exchange_address,
+                              std::string salt) const;
+
+        // EIP-712 encoding helpers (type hashes are compile-time constants; encodings are built on the stack)
+        std::array<uint8_t, 32> hash_domain(const std::array<uint8_t, 20> &verifying_contract) const;
+        std::array<uint8_t, 32> exchange_domain(const std::string &exchange_address) const;
+        std::array<uint8_t, 32> hash_order(const OrderData &order, const std::string &salt) const;
+        static std::array<uint8_t, 32> encode_eip712(const std::array<uint8_t, 32> &domain_hash,
+                                                     const std::array<uint8_t, 32> &struct_hash);
+
+        // L2 auth helpers (hmac_mutex_ held)
+        void load_hmac_key(const std::string &api_secret);
+        void hmac_sha256(const std::string &timestamp, const std::string &method, const std::string &path,
+                         const std::string &body, unsigned char out[32]);
+        void free_hmac();
 
         // L1 auth helpers
-        std::array<uint8_t, 32> hash_clob_auth_domain();
-        std::array<uint8_t, 32> hash_clob_auth(const std::string &timestamp, uint64_t nonce);
+        std::array<uint8_t, 32> hash_clob_auth_domain() const;
+        std::array<uint8_t, 32> hash_clob_auth(const std::string &timestamp, uint64_t nonce) const;
     };
 
     // Utility functions
@@ -143,6 +204,7 @@ namespace polymarket
     std::vector<uint8_t> from_hex(const std::string &hex);
     std::array<uint8_t, 32> keccak256(const std::vector<uint8_t> &data);
     std::array<uint8_t, 32> keccak256(const std::string &data);
+    std::array<uint8_t, 32> keccak256(const uint8_t *data, size_t size);
 
     // Convert USDC amount to wei (6 decimals)
     std::string to_wei(double amount, int decimals = 6, bool round_down = true);
@@ -2,10 +2,24 @@
 
 #include "types.hpp"
 #include "websocket_client.hpp"
-#include <unordered_map>
+#include "book_parser.hpp"
+#include "price_ladder.hpp"
+#include "book_snapshot.hpp"
+#include "token_registry.hpp"
+#include "event_arb.hpp"
+#include "depth_profile.hpp"
+#include "latency_histogram.hpp"
+#include "feed_log.hpp"
+#include "frame_queue.hpp"
+#include "update_dispatch.hpp"
+#include <memory>
 #include <shared_mutex>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <functional>
 #include <optional>
+#include <string_view>
 
 namespace polymarket
 {
@@ -13,76 +27,317 @@ namespace polymarket
     // Callback for orderbook updates
     using OrderbookUpdateCallback = std::function<void(const std::string &asset_id, const Orderbook &book)>;
     using ArbOpportunityCallback = std::function<void(const LiveMarketState &market, double combined)>;
+    using ArbSizingCallback = std::function<void(const LiveMarketState &market, const ArbSizing &sizing)>;
+    using ResyncNeededCallback = std::function<void(const std::string &asset_id)>;
+    using TickSizeChangeCallback = std::function<void(const std::string &asset_id, const std::string &old_tick_size,
+                                                      const std::string &new_tick_size)>;
 
-    // Orderbook manager - subscribes to WebSocket and maintains orderbook state
+    // Per-connection statistics
+    struct ShardStats
+    {
+        size_t index{0};
+        size_t tokens{0};           // Tokens subscribed on this connection
+        bool connected{false};
+        int cpu{-1};                // CPU the worker is pinned to (-1: unpinned or inline)
+        uint64_t messages{0};
+        uint64_t bytes{0};
+        uint64_t connects{0};       // Successful (re)connects; each one resubscribes
+        uint64_t parse_errors{0};
+        uint64_t events{0};         // Orderbook events applied
+        size_t queue_depth{0};      // Messages waiting for the worker
+    };
+
+    // Market data path latency per stage, one sample per book update (now_ns; server stages against wall_ns)
+    struct LatencyStats
+    {
+        LatencySummary network;    // Server timestamp -> socket receive (ms server resolution, includes clock skew)
+        LatencySummary queue;      // Socket receive -> parse start (ws_shard_workers only)
+        LatencySummary parse;      // Parse of the whole frame
+        LatencySummary apply;      // Applying the update to the book store, lock wait included
+        LatencySummary dispatch;   // Update callback, depth rebuild and arb checks
+        LatencySummary internal;   // Socket receive -> dispatched
+        LatencySummary end_to_end; // Server timestamp -> dispatched (exchange to strategy)
+    };
+
+    // Result of OrderbookManager::replay()
+    struct ReplayStats
+    {
+        uint64_t frames{0};
+        uint64_t bytes{0};
+        double seconds{0.0};
+        double frames_per_sec{0.0};
+    };
+
+    // Orderbook manager - subscribes to WebSocket and maintains orderbook state.
+    //
+    // Tokens are spread over Config::ws_shards connections (both tokens of a market on the same one). Each shard
+    // reconnects and resubscribes on its own and parses either on its socket thread or, with ws_shard_workers,
+    // on a dedicated (optionally CPU-pinned) worker; all shards apply into the same book store. Callbacks may
+    // therefore run concurrently from different shards, but updates for one token always come from one thread.
     class OrderbookManager
     {
     public:
         explicit OrderbookManager(const Config &config);
         ~OrderbookManager();
 
-        // Subscribe to markets
+        // Subscribe to markets (sent right away on connected shards, otherwise when the shard connects)
         void subscribe(const std::vector<MarketState> &markets);
         void subscribe(const MarketState &market);
+
+        // Subscribe to every outcome of a neg-risk event and scan it as one basket (see on_event_arb). Returns false
+        // if the basket was rejected (an outcome not subscribed or already in another event): its books still
+        // stream, but the event is not scanned.
+        bool subscribe_event(const NegRiskEvent &event);
         void unsubscribe(const std::string &token_id);
+        void unsubscribe_market(const std::string &condition_id); // Both tokens, one message
         void unsubscribe_all();
 
+        // Rollover without a data gap. stage_market() subscribes the next window's market on the live connection
+        // while the current one keeps streaming: its books, top of book and update callbacks are kept hot, but it
+        // raises no arb callbacks. promote_staged() then makes it live and drops the retiring market in one step,
+        // so arb callbacks never see both or neither. Staging another market replaces (and unsubscribes) the staged
+        // one; promote_staged() returns false if nothing is staged.
+        void stage_market(const MarketState &market);
+        bool promote_staged(const std::string &retire_condition_id = "");
+        std::string staged_condition_id() const; // Empty if nothing is staged
+
         // Get current orderbook
         std::optional<Orderbook> get_orderbook(const std::string &token_id) const;
 
+        // Current best bid/ask, O(1) from the token's price ladder
+        std::optional<TopOfBook> get_top_of_book(const std::string &token_id) const;
+        std::optional<TopOfBook> get_top_of_book(TokenHandle token) const;
+
+        // Dense handles for token ids, assigned at subscribe time (or when the feed first mentions a token).
+        // Resolve once and use the handle overloads to skip hashing the id string on every call.
+        TokenHandle token_handle(const std::string &token_id) const { return tokens_.find(token_id); }
+        const TokenRegistry &tokens() const { return tokens_; }
+        const TokenRegistry &conditions() const { return conditions_; } // Handles of UpdateEvent::condition
+
+        // Lock-free top-N reads for strategy threads. The slot for a token is created on first use and stays
+        // valid for the manager's lifetime (unsubscribed tokens read as empty books), so resolve it once and
+        // call read() on it from any thread without blocking the WebSocket thread.
+        const BookSnapshotSlot &snapshot_slot(const std::string &token_id);
+        const BookSnapshotSlot &snapshot_slot(TokenHandle token) const; // token must be a valid handle
+
+        // snapshot_slot(token_id).read(out); false if no book has been published for the token
+        bool read_snapshot(const std::string &token_id, BookSnapshot &out);
+        bool read_snapshot(TokenHandle token, BookSnapshot &out) const; // Also false for an unknown handle
+
+        // Seed or replace a book from a full snapshot, e.g. ClobClient::get_order_book() after a resync request.
+        // Deltas older than server_timestamp_ms (if given) are ignored afterwards.
+        void apply_snapshot(const Orderbook &book, const std::string &hash = "", uint64_t server_timestamp_ms = 0);
+
+        // True if price_change deltas for the token no longer match the server and the book should be re-fetched
+        bool needs_resync(const std::string &token_id) const;
+
+        // Last server book hash seen for the token (empty if the feed did not send one)
+        std::string get_book_hash(const std::string &token_id) const;
+
         // Get market state (returns empty MarketState if not found)
         MarketState get_market(const std::string &condition_id) const;
 
         // Callbacks
         void on_orderbook_update(OrderbookUpdateCallback callback);
         void on_arb_opportunity(ArbOpportunityCallback callback);
+        void on_arb_sizing(ArbSizingCallback callback); // Same trigger, with the size executable across ask depth and leg VWAPs
+        void on_resync_needed(ResyncNeededCallback callback); // Called once each time a book goes out of sync
+        void on_event_arb(EventArbCallback callback);          // Buy-all / sell-all baskets of subscribed events
+        void on_tick_size_change(TickSizeChangeCallback callback); // e.g. ClobClient::on_tick_size_change
+
+        // Decoupled dispatch: every consumer gets each routed book update (and arb trigger) as a fixed-size
+        // UpdateEvent in its own lock-free rings, one per shard, for a strategy thread on its own core to poll()
+        // instead of running user code on the WebSocket thread. Add consumers before connect() or replay(); they
+        // live as long as the manager. Callbacks that are set still run as well.
+        UpdateConsumer &add_consumer(UpdateConsumerConfig config = {});
 
         // Connection
         bool connect();
         void disconnect();
         bool is_connected() const;
 
+        // Block until every shard is connected / has sent its subscription since it last connected (false on
+        // timeout or stop). Both wake on the event itself, so a rollover can wait for its resubscribe.
+        bool wait_connected(std::chrono::milliseconds timeout);
+        bool wait_subscribed(std::chrono::milliseconds timeout);
+
         // Run event loop (blocking)
         void run();
 
         // Stop
         void stop();
 
+        // Capture every frame received on any shard, before parsing (null stops recording). The recorder must
+        // outlive the manager or be detached first.
+        void set_recorder(FeedRecorder *recorder) { recorder_.store(recorder, std::memory_order_release); }
+
+        // Feed a capture through the same parse/apply/dispatch path as the live feed, on the calling thread, with
+        // each frame handled by the shard it was recorded on (modulo the shard count). Subscribe the recorded
+        // markets first so routing and arb checks match; don't replay into a manager that is connected. With
+        // realtime the original inter-frame gaps are kept, otherwise frames go through as fast as possible.
+        ReplayStats replay(FeedReader &reader, bool realtime = false);
+
         // Statistics
         uint64_t total_updates() const { return total_updates_.load(); }
         uint64_t arb_opportunities() const { return arb_opportunities_.load(); }
+        uint64_t resyncs_requested() const { return resyncs_requested_.load(); }
+        uint64_t event_arb_opportunities() const { return event_arb_opportunities_.load(); }
+        std::vector<ShardStats> shard_stats() const;
+        LatencyStats get_latency_stats() const;
+        void reset_latency_stats();
 
     private:
         Config config_;
-        WebSocketClient ws_;
 
-        // Orderbooks by token_id
+        // One WebSocket connection and the state only its parsing thread touches
+        struct Shard
+        {
+            size_t index{0};
+            WebSocketClient ws;
+            BookFrameParser parser; // Reused across messages
+
+            // Per-token copies of delta-updated books handed to callbacks, by token handle. Only this shard's
+            // thread touches them: deltas are applied to the copy too, so it stays in step with the stored
+            // book without copying it, and it is re-copied only after a snapshot from elsewhere (epoch differs).
+            struct DeltaBook
+            {
+                Orderbook book;
+                uint64_t epoch{0};
+            };
+            std::vector<DeltaBook> delta_books;
+            std::vector<std::string> tokens; // Guarded by shards_mutex_
+            bool subscribed{false};          // Tokens sent since the last connect (guarded by shards_mutex_)
+
+            uint64_t receive_ns{0};  // Socket receive time of the frame being handled
+
+            // Worker hand-off (ws_shard_workers): the socket thread pushes, the worker drains
+            FrameQueue queue;
+            std::thread worker;
+            int cpu{-1};
+
+            std::atomic<uint64_t> parse_errors{0};
+            std::atomic<uint64_t> events{0};
+        };
+
+        // Shards are created in the constructor and never resized
+        std::vector<std::unique_ptr<Shard>> shards_;
+        mutable std::mutex shards_mutex_;
+        std::condition_variable subscribed_cv_;
+
+        // Per-token book maintained from snapshots and price_change deltas
+        struct BookState
+        {
+            Orderbook book;            // Levels sorted best-first
+            PriceLadder ladder;        // Same levels, tick-indexed (top of book and depth)
+            std::string hash;          // Last server hash seen
+            uint64_t server_ts_ms{0};  // Server timestamp of the last applied event
+            bool seeded{false};        // A snapshot has been applied
+            bool needs_resync{false};  // Deltas diverged from the server top of book
+            bool active{false};        // Book exists (cleared on unsubscribe)
+            uint64_t epoch{0};         // Set from book_epochs_ by every stored snapshot
+            BookSnapshotSlot *snapshot{nullptr}; // Reader-facing copy, owned by snapshot_slots_
+        };
+
+        // Market a token belongs to
+        struct TokenRoute
+        {
+            TokenHandle condition{kInvalidToken};
+            bool is_yes{false};
+        };
+
+        // Interned token and condition ids; everything below is indexed by their handles
+        TokenRegistry tokens_;
+        TokenRegistry conditions_;
+
+        // Orderbooks by token handle
         mutable std::shared_mutex orderbooks_mutex_;
-        std::unordered_map<std::string, Orderbook> orderbooks_;
+        std::vector<BookState> books_;
+        uint64_t book_epochs_{0}; // Snapshots stored so far (guarded by orderbooks_mutex_)
 
-        // Markets by condition_id (using unique_ptr for non-copyable LiveMarketState)
+        // Seqlock snapshots by token handle (written under orderbooks_mutex_, never freed so readers can keep references)
+        mutable std::shared_mutex snapshots_mutex_;
+        std::vector<std::unique_ptr<BookSnapshotSlot>> snapshot_slots_;
+
+        // Markets by condition handle (using unique_ptr for non-copyable LiveMarketState, null once unsubscribed)
+        // and token to market routing by token handle, both guarded by markets_mutex_
         mutable std::shared_mutex markets_mutex_;
-        std::unordered_map<std::string, std::unique_ptr<LiveMarketState>> markets_;
+        std::vector<std::unique_ptr<LiveMarketState>> markets_;
+        std::vector<TokenRoute> routes_;
+        TokenHandle staged_{kInvalidToken}; // stage_market() condition; skipped by arb checks
 
-        // Token to condition mapping
-        std::unordered_map<std::string, std::string> token_to_condition_;
+        // Ask depth of both legs of a market, for sizing binary arbs
+        struct MarketDepth
+        {
+            DepthProfile yes_asks;
+            DepthProfile no_asks;
+        };
 
-        // Subscribed tokens
-        std::vector<std::string> subscribed_tokens_;
+        // Arb evaluation state, guarded by arb_mutex_: market depth by condition handle and neg-risk event
+        // baskets (buy below trigger_combined, sell above 2 - trigger_combined)
+        std::mutex arb_mutex_;
+        std::vector<MarketDepth> market_depth_;
+        EventArbScanner event_scanner_;
+        std::atomic<bool> has_events_{false};
 
         // Callbacks
         OrderbookUpdateCallback on_update_cb_;
         ArbOpportunityCallback on_arb_cb_;
+        ArbSizingCallback on_arb_sizing_cb_;
+        ResyncNeededCallback on_resync_cb_;
+        EventArbCallback on_event_arb_cb_;
+        TickSizeChangeCallback on_tick_size_cb_;
+
+        // Ring consumers, lanes 0..shards-1 by shard index and the last for apply_snapshot() (fixed once connected)
+        std::vector<std::unique_ptr<UpdateConsumer>> consumers_;
+        bool arb_consumers_{false};
 
         // Statistics
         std::atomic<uint64_t> total_updates_{0};
         std::atomic<uint64_t> arb_opportunities_{0};
+        std::atomic<uint64_t> resyncs_requested_{0};
+        std::atomic<uint64_t> event_arb_opportunities_{0};
+
+        // Stage histograms (lock-free, shared by all shards)
+        struct LatencyHistograms
+        {
+            LatencyHistogram network;
+            LatencyHistogram queue;
+            LatencyHistogram parse;
+            LatencyHistogram apply;
+            LatencyHistogram dispatch;
+            LatencyHistogram internal;
+            LatencyHistogram end_to_end;
+        };
+        std::unique_ptr<LatencyHistograms> latency_;
+
+        std::atomic<FeedRecorder *> recorder_{nullptr};
 
         // Internal methods
-        void handle_message(const std::string &message);
-        void handle_orderbook_update(const std::string &asset_id, const Orderbook &book);
-        void send_subscribe_message();
-        void check_arb_opportunity(const std::string &condition_id);
+        void handle_message(Shard &shard, std::string_view message, uint64_t receive_ns);
+        void handle_price_change(Shard &shard, const BookEvent &event);
+        void apply_changes(Shard &shard, TokenHandle token, const LevelChange *changes, size_t count, uint64_t server_ts_ms);
+        TopOfBook store_snapshot(TokenHandle token, const Orderbook &book, std::string_view hash, uint64_t server_ts_ms);
+        TokenHandle intern_token(std::string_view token_id);
+        BookState &book_state(TokenHandle token);
+        const BookState *find_book(TokenHandle token) const;
+        void publish_snapshot(const BookState &state);
+        void load_ladder(BookState &state);
+        void request_resync(TokenHandle token);
+        void handle_orderbook_update(size_t lane, TokenHandle token, const Orderbook &book, const TopOfBook &top,
+                                     uint64_t server_ts_ms, uint64_t receive_ns);
+        void dispatch_update(Shard &shard, TokenHandle token, const Orderbook &book, const TopOfBook &top,
+                             uint64_t apply_start_ns, uint64_t server_ts_ms);
+        void send_subscribe_message(Shard &shard);
+        bool send_subscription(Shard &shard, const char *action, const std::vector<std::string> &tokens);
+        Shard &add_market(const MarketState &market);
+        std::vector<std::string> detach_market(TokenHandle condition); // Caller holds markets_mutex_ exclusively
+        void drop_tokens(const std::vector<std::string> &token_ids);
+        void start_workers();
+        void stop_workers();
+        void run_worker(Shard &shard);
+        Shard &least_loaded_shard();
+        void check_arb_opportunity(size_t lane, TokenHandle condition, UpdateEvent &event);
+        void publish_event(size_t lane, const UpdateEvent &event);
     };
 
 } // namespace polymarket
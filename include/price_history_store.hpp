@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace polymarket
+{
+
+    // Zero-copy view of a cached price series: parallel columns, ascending by timestamp
+    struct PriceHistoryView
+    {
+        std::span<const uint64_t> timestamps; // Unix seconds
+        std::span<const double> prices;
+
+        size_t size() const { return timestamps.size(); }
+        bool empty() const { return timestamps.empty(); }
+
+        // Points with from <= timestamp <= to (to 0: no upper bound), pointing into the same memory
+        PriceHistoryView slice(uint64_t from, uint64_t to = 0) const;
+    };
+
+    // Time range a series is known to be complete for (both 0 if it was never fetched)
+    struct PriceHistoryCoverage
+    {
+        uint64_t from{0};
+        uint64_t to{0};
+    };
+
+    // Persistent columnar cache of price histories, one series per name (e.g. token and fidelity).
+    //
+    // Each series is two memory-mapped files in the directory, <name>.ts with the timestamps and <name>.px with
+    // the prices, each a 64-byte header followed by one packed column. Appends write straight into the mapping,
+    // doubling the files when full. Views are spans over the mapping, so reading a warm series costs no copy
+    // and no parse.
+    //
+    // A view stays valid for the store's lifetime. Appends only write past the points it covers, and mappings
+    // that were grown away from or replaced are kept until the store is destroyed. replace() writes new files
+    // and renames them over the old ones. A series whose files don't agree (e.g. after a crash mid-append) is
+    // discarded and refetched. Thread-safe.
+    class PriceHistoryStore
+    {
+    public:
+        explicit PriceHistoryStore(std::string directory); // Creates the directory; throws on I/O errors
+        ~PriceHistoryStore();
+
+        PriceHistoryStore(const PriceHistoryStore &) = delete;
+        PriceHistoryStore &operator=(const PriceHistoryStore &) = delete;
+
+        PriceHistoryView view(const std::string &series);
+        PriceHistoryCoverage coverage(const std::string &series);
+
+        // Add points after the last cached one (earlier and duplicate timestamps are skipped) and extend the
+        // coverage to covered_to. Input in ascending timestamp order.
+        void append(const std::string &series, const uint64_t *timestamps, const double *prices, size_t count,
+                    uint64_t covered_to);
+
+        // Swap the whole series for these points, complete over [covered_from, covered_to]
+        void replace(const std::string &series, const uint64_t *timestamps, const double *prices, size_t count,
+                     uint64_t covered_from, uint64_t covered_to);
+
+        // Fetches the points in [from, to], appending them to the columns; false if the request failed
+        using Fetch = std::function<bool(uint64_t from, uint64_t to, std::vector<uint64_t> &timestamps,
+                                         std::vector<double> &prices)>;
+
+        // Points of a series in [start_ts, end_ts] (end_ts 0: up to now), first fetching what the cache lacks: the
+        // range before it for an earlier start_ts, and the range after it once a new point can exist (open-ended
+        // calls refresh at most every step seconds). The refresh starts at the last cached point, not where the
+        // previous fetch ended, so points the server publishes late are still picked up. If a fetch fails, the
+        // cached points are returned as they are.
+        PriceHistoryView refresh(const std::string &series, uint64_t start_ts, uint64_t end_ts, uint64_t now,
+                                 uint64_t step, const Fetch &fetch);
+
+        // Write mapped pages back to the files (the kernel does this on its own eventually)
+        void flush();
+
+        const std::string &directory() const { return directory_; }
+
+    private:
+        struct Column
+        {
+            int fd{-1};
+            char *base{nullptr};
+            size_t bytes{0};
+        };
+
+        struct Series
+        {
+            Column timestamps;
+            Column prices;
+            size_t capacity{0}; // Points both files have room for
+        };
+
+        std::string directory_;
+        std::mutex mutex_;
+        std::unordered_map<std::string, std::unique_ptr<Series>> series_;
+        std::vector<std::pair<void *, size_t>> retired_; // Mappings views may still point into
+
+        // Callers hold mutex_
+        Series &open_series(const std::string &name);
+        std::unique_ptr<Series> load(const std::string &path, const std::string &name, bool truncate);
+        void reserve(Series &series, size_t capacity);
+        void map_column(Column &column, size_t bytes, const std::string &path);
+        void release(Series &series); // Retire its mappings and close its files
+    };
+
+    // Parse a GET /prices-history response ({"history": [{"t": 1700000000, "p": 0.52}, ...]}, prices as numbers
+    // or strings) into columns, appending. False if the body is malformed.
+    bool parse_price_history(std::string_view body, std::vector<uint64_t> &timestamps, std::vector<double> &prices);
+
+} // namespace polymarket
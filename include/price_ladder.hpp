@@ -0,0 +1,96 @@
+#pragma once
+
+#include "types.hpp"
+#include <vector>
+#include <cstddef>
+
+namespace polymarket
+{
+
+    // Cumulative size and notional over a range of levels
+    struct DepthSum
+    {
+        double size{0.0};     // Shares
+        double notional{0.0}; // Sum of price * size (USDC)
+
+        double vwap() const { return size > 0.0 ? notional / size : 0.0; }
+    };
+
+    // Dense orderbook for one token, indexed by integer price tick.
+    //
+    // Prices on a Polymarket book are multiples of the market tick size between 0 and 1, so every possible
+    // level gets a slot: tick i has price i * tick_size. Bid sizes, ask sizes and tick prices are kept in
+    // three separate contiguous arrays (structure of arrays), which makes size_at() a single load and lets
+    // depth() run as a straight multiply-add loop the compiler can vectorise. The best bid and best ask
+    // ticks are maintained on every set(), so top of book is O(1); removing the best level walks to the
+    // next occupied tick, which is a short scan over a few cache lines.
+    //
+    // A ladder at 0.001 (the default) also holds 0.01 and 0.1 books. Prices that are not on the grid are
+    // rejected, so the owner can rebuild with a finer tick_size.
+    class PriceLadder
+    {
+    public:
+        PriceLadder() : PriceLadder(0.001) {}
+        explicit PriceLadder(double tick_size);
+
+        double tick_size() const { return tick_size_; }
+        int num_ticks() const { return static_cast<int>(prices_.size()); }
+
+        // Tick index of a price, or -1 if the price is outside [0, 1] or not on the grid
+        int to_tick(double price) const;
+        double to_price(int tick) const { return prices_[tick]; }
+
+        // Set the size at a price (size <= 0 removes the level). Returns false if the price is off the grid.
+        bool set(BookSide side, double price, double size);
+        void set_tick(BookSide side, int tick, double size);
+
+        // Replace the contents with a full book. Returns false if any price is off the grid (the ladder is left empty).
+        bool load(const Orderbook &book);
+        void clear();
+
+        // Top of book, O(1). Empty sides follow Orderbook: best bid 0.0, best ask 1.0, size 0.0.
+        bool has_bids() const { return best_bid_ >= 0; }
+        bool has_asks() const { return best_ask_ < num_ticks(); }
+        int best_bid_tick() const { return best_bid_; }
+        int best_ask_tick() const { return best_ask_; }
+        double best_bid() const { return has_bids() ? prices_[best_bid_] : 0.0; }
+        double best_ask() const { return has_asks() ? prices_[best_ask_] : 1.0; }
+        double best_bid_size() const { return has_bids() ? bid_sizes_[best_bid_] : 0.0; }
+        double best_ask_size() const { return has_asks() ? ask_sizes_[best_ask_] : 0.0; }
+        TopOfBook top() const { return {best_bid(), best_bid_size(), best_ask(), best_ask_size()}; }
+
+        // Size resting at a price, O(1) (0 if none or off the grid)
+        double size_at(BookSide side, double price) const;
+
+        // Number of occupied levels on a side
+        size_t level_count(BookSide side) const { return side == BookSide::BID ? bid_levels_ : ask_levels_; }
+
+        // Cumulative depth over ticks [from_tick, to_tick] (clamped to the ladder)
+        DepthSum depth(BookSide side, int from_tick, int to_tick) const;
+
+        // Everything a buyer can take at or below max_price / a seller can hit at or above min_price
+        DepthSum ask_depth_to(double max_price) const;
+        DepthSum bid_depth_to(double min_price) const;
+
+        // Raw per-tick arrays (num_ticks() entries each)
+        const double *prices() const { return prices_.data(); }
+        const double *sizes(BookSide side) const { return side == BookSide::BID ? bid_sizes_.data() : ask_sizes_.data(); }
+
+    private:
+        double tick_size_;
+        double ticks_per_unit_;
+        std::vector<double> prices_;
+        std::vector<double> bid_sizes_;
+        std::vector<double> ask_sizes_;
+
+        int best_bid_; // -1 when there are no bids
+        int best_ask_; // num_ticks() when there are no asks
+        size_t bid_levels_;
+        size_t ask_levels_;
+
+        // Range of ticks written since the last clear(), so clearing only touches what was used
+        int dirty_low_;
+        int dirty_high_;
+    };
+
+} // namespace polymarket
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "latency_histogram.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace polymarket
+{
+
+    // Priority lanes, highest first
+    enum class RequestLane
+    {
+        CANCEL,      // DELETE /order(s), cancel-all, cancel-market-orders
+        ORDER,       // POST /order(s)
+        ACCOUNT,     // Authenticated queries: open orders, trades, balances, notifications, API keys
+        MARKET_DATA  // Public queries: books, prices, markets, metadata
+    };
+    constexpr size_t kRequestLanes = 4;
+
+    struct RequestSchedulerConfig
+    {
+        bool enabled = true;
+
+        // Shared bucket every CLOB request also draws from (general limit: 9000 per 10s)
+        double global_burst = 9000;
+        double global_per_second = 900;
+
+        // Share of the shared bucket ACCOUNT and MARKET_DATA may not touch, kept for orders and cancels
+        double query_reserve = 0.2;
+
+        // How long a request may wait for a token. Queries are dropped after their wait; orders and cancels
+        // are sent anyway (and counted as overruns), since a late order beats a lost one.
+        std::chrono::milliseconds order_max_wait{2000};
+        std::chrono::milliseconds query_max_wait{250};
+    };
+
+    struct RequestLaneStats
+    {
+        uint64_t requests{0};  // Admitted (sent)
+        uint64_t throttled{0}; // Had to wait for a token
+        uint64_t dropped{0};   // Gave up waiting (queries only)
+        uint64_t overruns{0};  // Sent without a token after order_max_wait (orders and cancels only)
+        uint64_t rejected{0};  // 429 responses received
+        LatencySummary queued; // Time spent waiting for admission, one sample per admitted request
+    };
+
+    struct RequestSchedulerStats
+    {
+        std::array<RequestLaneStats, kRequestLanes> lanes; // Indexed by RequestLane
+        const RequestLaneStats &lane(RequestLane l) const { return lanes[static_cast<size_t>(l)]; }
+    };
+
+    // Client-side rate limiting in front of the CLOB REST API.
+    //
+    // Each endpoint ("POST /order", "GET /book", ...) has a token bucket preloaded with the limit Polymarket
+    // documents for it, and every request also draws from a shared bucket for the API-wide limit. acquire() admits
+    // a request when both have a token. Otherwise it waits on the calling thread until one refills, so the
+    // client slows down instead of learning about the limit from a 429.
+    //
+    // Lanes set the order of admission: while a request of a higher lane is waiting, lower lanes don't take
+    // tokens, and queries never dip into the reserved part of the shared bucket. So bulk market data backs off
+    // (and is dropped after query_max_wait) before it can delay an order or a cancel. A 429 empties the
+    // endpoint's bucket so the following requests wait for the server's window to pass. Thread-safe.
+    class RequestScheduler
+    {
+    public:
+        explicit RequestScheduler(RequestSchedulerConfig config = {});
+
+        RequestScheduler(const RequestScheduler &) = delete;
+        RequestScheduler &operator=(const RequestScheduler &) = delete;
+
+        // Replace one endpoint's limit: burst requests at once, refilling at per_second. path has no query string.
+        void set_limit(std::string_view method, std::string_view path, double burst, double per_second);
+        void set_enabled(bool enabled);
+
+        // Lane a CLOB request belongs to, from its method and path
+        static RequestLane lane_for(std::string_view method, std::string_view path);
+
+        // Block until the request may be sent. False if it was dropped (queries only: nothing to send).
+        bool acquire(RequestLane lane, std::string_view method, std::string_view path);
+        bool acquire(std::string_view method, std::string_view path) { return acquire(lane_for(method, path), method, path); }
+
+        // Never waits: admits the request only if a token is available now (for background work that must not block)
+        bool try_acquire(RequestLane lane, std::string_view method, std::string_view path);
+
+        // Report the response status; a 429 empties the endpoint's bucket
+        void on_response(RequestLane lane, std::string_view method, std::string_view path, long status_code);
+
+        RequestSchedulerStats stats() const;
+        void reset_stats();
+
+    private:
+        struct Bucket
+        {
+            double burst{0.0};
+            double per_second{0.0};
+            double tokens{0.0};
+            std::chrono::steady_clock::time_point updated;
+        };
+
+        struct LaneCounters
+        {
+            std::atomic<uint64_t> requests{0};
+            std::atomic<uint64_t> throttled{0};
+            std::atomic<uint64_t> dropped{0};
+            std::atomic<uint64_t> overruns{0};
+            std::atomic<uint64_t> rejected{0};
+            LatencyHistogram queued;
+        };
+
+        RequestSchedulerConfig config_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;                      // A waiter left or a limit changed
+        std::unordered_map<std::string, Bucket> buckets_; // "METHOD /path"
+        Bucket global_;
+        std::array<size_t, kRequestLanes> waiting_{};     // Requests currently waiting, per lane
+
+        std::array<LaneCounters, kRequestLanes> counters_;
+
+        bool admit(RequestLane lane, std::string_view method, std::string_view path,
+                   std::chrono::steady_clock::duration max_wait);
+        Bucket *find_bucket(std::string_view method, std::string_view path); // Caller holds mutex_
+    };
+
+} // namespace polymarket
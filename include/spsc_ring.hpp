@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace polymarket
+{
+
+    // Bounded single-producer, single-consumer queue of trivially copyable values.
+    //
+    // Capacity is rounded up to a power of two. Head and tail are monotonically increasing counters on their own
+    // cache lines; each side keeps a private copy of the other's counter and only reloads it when the ring looks
+    // full (producer) or empty (consumer), so in steady state a push or pop touches one shared line. Never blocks
+    // and never allocates after construction.
+    template <typename T>
+    class SpscRing
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "SpscRing holds trivially copyable values");
+
+    public:
+        explicit SpscRing(size_t capacity)
+        {
+            size_t size = 2;
+            while (size < capacity)
+            {
+                size <<= 1;
+            }
+            mask_ = size - 1;
+            slots_ = std::make_unique<T[]>(size);
+        }
+
+        SpscRing(const SpscRing &) = delete;
+        SpscRing &operator=(const SpscRing &) = delete;
+
+        // Producer side; false if the ring is full
+        bool try_push(const T &value)
+        {
+            uint64_t head = head_.load(std::memory_order_relaxed);
+            if (head - tail_cache_ > mask_)
+            {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                if (head - tail_cache_ > mask_)
+                {
+                    return false;
+                }
+            }
+            slots_[head & mask_] = value;
+            head_.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side; false if the ring is empty
+        bool try_pop(T &out)
+        {
+            uint64_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail == head_cache_)
+            {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (tail == head_cache_)
+                {
+                    return false;
+                }
+            }
+            out = slots_[tail & mask_];
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Approximate from any thread other than the two ends
+        size_t size() const
+        {
+            uint64_t tail = tail_.load(std::memory_order_acquire);
+            uint64_t head = head_.load(std::memory_order_acquire);
+            return head > tail ? static_cast<size_t>(head - tail) : 0;
+        }
+
+        size_t capacity() const { return mask_ + 1; }
+
+    private:
+        alignas(64) std::atomic<uint64_t> head_{0}; // Next slot to write
+        uint64_t tail_cache_{0};                     // Producer's last view of tail_
+        alignas(64) std::atomic<uint64_t> tail_{0}; // Next slot to read
+        uint64_t head_cache_{0};                     // Consumer's last view of head_
+        alignas(64) size_t mask_{0};
+        std::unique_ptr<T[]> slots_;
+    };
+
+} // namespace polymarket
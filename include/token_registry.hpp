@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace polymarket
+{
+
+    // Dense integer id for an interned token or condition id
+    using TokenHandle = uint32_t;
+    constexpr TokenHandle kInvalidToken = std::numeric_limits<TokenHandle>::max();
+
+    // Interns token / condition id strings (70+ decimal digits) once and hands out dense handles 0, 1, 2, ...
+    // that can index flat arrays. Handles are never reused, so they stay valid for the registry's lifetime.
+    // Thread-safe: find() and id() take a shared lock, intern() a unique lock only for new ids.
+    class TokenRegistry
+    {
+    public:
+        // Handle for id, assigning the next one if id is new
+        TokenHandle intern(std::string_view id);
+
+        // Handle for id, or kInvalidToken if it was never interned
+        TokenHandle find(std::string_view id) const;
+
+        // Id string of a handle (the reference stays valid for the registry's lifetime)
+        const std::string &id(TokenHandle handle) const;
+
+        size_t size() const;
+
+    private:
+        mutable std::shared_mutex mutex_;
+        std::deque<std::string> ids_;                               // By handle; deque keeps element addresses stable
+        std::unordered_map<std::string_view, TokenHandle> handles_; // Views into ids_
+    };
+
+} // namespace polymarket
@@ -16,6 +16,22 @@ namespace polymarket
         double size;
     };
 
+    // Side of an orderbook
+    enum class BookSide
+    {
+        BID,
+        ASK
+    };
+
+    // Best bid/ask of a book (empty sides: bid 0.0, ask 1.0, size 0.0)
+    struct TopOfBook
+    {
+        double best_bid{0.0};
+        double best_bid_size{0.0};
+        double best_ask{1.0};
+        double best_ask_size{0.0};
+    };
+
     // Orderbook for a single token
     struct Orderbook
     {
@@ -101,9 +117,11 @@ namespace polymarket
         std::string question;
         std::string market_slug;
         std::vector<Token> tokens;
-        bool neg_risk;
-        bool active;
-        bool closed;
+        std::vector<std::string> tags;
+        std::string neg_risk_market_id; // Shared by all outcomes of a neg-risk event
+        bool neg_risk{false};
+        bool active{false};
+        bool closed{false};
 
         std::string token_yes() const
         {
@@ -157,6 +175,13 @@ namespace polymarket
         }
     };
 
+    // Neg-risk event: mutually exclusive outcomes, each a binary market, exactly one of which resolves YES
+    struct NegRiskEvent
+    {
+        std::string id;                    // neg_risk_market_id
+        std::vector<MarketState> outcomes; // One market per outcome
+    };
+
     // Thread-safe market state for live orderbook tracking
     struct LiveMarketState
     {
@@ -206,6 +231,7 @@ namespace polymarket
     {
         ORDERBOOK_SNAPSHOT,
         ORDERBOOK_UPDATE,
+        TICK_SIZE_CHANGE,
         TRADE,
         UNKNOWN
     };
@@ -216,6 +242,7 @@ namespace polymarket
         // API endpoints
         std::string clob_rest_url = "https://clob.polymarket.com";
         std::string clob_ws_url = "wss://ws-subscriptions-clob.polymarket.com/ws/market";
+        std::string user_ws_url = "wss://ws-subscriptions-clob.polymarket.com/ws/user";
         std::string gamma_api_url = "https://gamma-api.polymarket.com";
         std::string rtds_ws_url = "wss://ws-live-data.polymarket.com";
 
@@ -229,6 +256,18 @@ namespace polymarket
         int http_timeout_ms = 5000;
         int max_markets = 50;
 
+        // Gamma discovery cache: found markets are kept gamma_cache_ttl_sec, slugs not listed yet gamma_miss_ttl_sec.
+        // Up to gamma_max_in_flight lookups run at once.
+        int gamma_cache_ttl_sec = 3600;
+        int gamma_miss_ttl_sec = 30;
+        int gamma_max_in_flight = 16;
+
+        // Market data sharding: tokens are spread over ws_shards connections. With ws_shard_workers, each shard
+        // parses and applies messages on its own worker thread, pinned to ws_shard_cpus[i % size] if given.
+        int ws_shards = 1;
+        bool ws_shard_workers = false;
+        std::vector<int> ws_shard_cpus;
+
         // Crypto tickers for 15m/4h/1h markets
         std::vector<std::string> crypto_tickers = {
             "btc", "eth", "xrp", "sol", "doge", "bnb",
@@ -243,6 +282,15 @@ namespace polymarket
             .count();
     }
 
+    // Utility: get current Unix time in nanoseconds. now_ns() may be a steady clock with its own epoch, so use
+    // this when comparing with server timestamps.
+    inline uint64_t wall_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    }
+
     // Utility: get current time in seconds (Unix timestamp)
     inline uint64_t now_sec()
     {
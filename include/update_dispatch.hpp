@@ -0,0 +1,127 @@
+#pragma once
+
+#include "types.hpp"
+#include "depth_profile.hpp"
+#include "spsc_ring.hpp"
+#include "token_registry.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace polymarket
+{
+
+    enum class UpdateKind : uint8_t
+    {
+        BOOK, // A routed token's book changed
+        ARB   // Its market's combined ask crossed trigger_combined
+    };
+
+    // Fixed-size copy of one market data update, handed to strategy threads instead of a callback on the WebSocket
+    // thread. Ids are handles: resolve them with OrderbookManager::tokens() / conditions().
+    struct UpdateEvent
+    {
+        UpdateKind kind{UpdateKind::BOOK};
+        bool is_yes{false};                   // token is the market's YES leg
+        TokenHandle token{kInvalidToken};     // Token whose book changed
+        TokenHandle condition{kInvalidToken}; // Its market
+        TopOfBook top;                        // Token's top of book after the update
+        double best_ask_yes{0.0};             // Both legs' best asks after the update
+        double best_ask_no{0.0};
+        ArbSizing sizing;                     // ARB only: size executable below the trigger and leg VWAPs
+        uint64_t server_ts_ms{0};             // 0 if the feed did not send one
+        uint64_t receive_ns{0};               // Socket receive time (0 for OrderbookManager::apply_snapshot)
+        uint64_t publish_ns{0};               // Pushed into the ring
+
+        double combined() const { return best_ask_yes + best_ask_no; }
+    };
+
+    enum class OverflowPolicy
+    {
+        DROP,  // A full ring drops the new event
+        BLOCK  // The producer waits up to block_timeout for room, then drops
+    };
+
+    struct UpdateConsumerConfig
+    {
+        size_t capacity = 4096; // Events per lane, rounded up to a power of two
+        bool books = true;      // Receive BOOK events
+        bool arbs = true;       // Receive ARB events
+        OverflowPolicy overflow = OverflowPolicy::DROP;
+        std::chrono::microseconds block_timeout{1000};
+    };
+
+    struct UpdateConsumerStats
+    {
+        uint64_t published{0}; // Events pushed
+        uint64_t dropped{0};   // Events lost to a full ring
+        uint64_t blocked{0};   // Pushes that had to wait for room (BLOCK)
+        uint64_t consumed{0};  // Events popped
+        size_t depth{0};       // Events waiting, all lanes
+    };
+
+    // One strategy thread's inbox of UpdateEvents, filled by OrderbookManager::add_consumer().
+    //
+    // Every producer thread gets its own lane, an SpscRing, so publishing is a plain ring push with no lock and
+    // no contention between shards: lane i is written only by shard i's parsing thread, and the last lane takes
+    // apply_snapshot() calls from any thread under a mutex. Exactly one thread may poll(); it round-robins the
+    // lanes, so events of one token stay in order but events of different shards may interleave.
+    class UpdateConsumer
+    {
+    public:
+        UpdateConsumer(UpdateConsumerConfig config, size_t producer_lanes);
+
+        UpdateConsumer(const UpdateConsumer &) = delete;
+        UpdateConsumer &operator=(const UpdateConsumer &) = delete;
+
+        // Next event, false if every lane is empty (consumer thread only)
+        bool poll(UpdateEvent &out);
+
+        // poll() until an event arrives or timeout passes, spinning briefly and then yielding
+        bool wait(UpdateEvent &out, std::chrono::microseconds timeout);
+
+        // Pop up to max events into fn(const UpdateEvent &); returns how many
+        template <typename Fn>
+        size_t drain(Fn &&fn, size_t max = std::numeric_limits<size_t>::max())
+        {
+            UpdateEvent event;
+            size_t count = 0;
+            while (count < max && poll(event))
+            {
+                fn(event);
+                count++;
+            }
+            return count;
+        }
+
+        // Producer side (OrderbookManager): lane < lanes() - 1 must only ever be written by one thread; the
+        // last lane may be written by any thread
+        void publish(size_t lane, const UpdateEvent &event);
+
+        const UpdateConsumerConfig &config() const { return config_; }
+        size_t lanes() const { return lanes_.size(); }
+        UpdateConsumerStats stats() const; // Any thread
+
+    private:
+        struct Lane
+        {
+            explicit Lane(size_t capacity) : ring(capacity) {}
+            SpscRing<UpdateEvent> ring;
+            alignas(64) std::atomic<uint64_t> published{0}; // Producer-owned counters
+            std::atomic<uint64_t> dropped{0};
+            std::atomic<uint64_t> blocked{0};
+        };
+
+        UpdateConsumerConfig config_;
+        std::vector<std::unique_ptr<Lane>> lanes_;
+        std::mutex shared_lane_mutex_; // Serialises writers of the last lane
+        size_t next_lane_{0};          // Consumer-owned
+        std::atomic<uint64_t> consumed_{0};
+    };
+
+} // namespace polymarket
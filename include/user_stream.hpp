@@ -0,0 +1,150 @@
+#pragma once
+
+#include "types.hpp"
+#include "order_signer.hpp"
+#include "websocket_client.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace polymarket
+{
+
+    // One of our orders on the maker side of a trade
+    struct MakerFill
+    {
+        std::string order_id;
+        std::string asset_id;
+        std::string outcome;
+        std::string matched_amount;
+        std::string price;
+        std::string owner; // API key of the order's owner
+    };
+
+    // User channel "trade" event. Sent when one of our orders matches, then again on each settlement step
+    // (status MATCHED -> MINED -> CONFIRMED, or RETRYING / FAILED) with the same id.
+    struct UserTrade
+    {
+        std::string id;
+        std::string taker_order_id;
+        std::string market;   // Condition id
+        std::string asset_id;
+        std::string side;     // Taker side
+        std::string outcome;
+        std::string size;
+        std::string price;
+        std::string fee_rate_bps;
+        std::string status;
+        std::string owner;    // API key of the taker order's owner
+        std::string match_time;
+        std::string transaction_hash;
+        std::vector<MakerFill> maker_orders;
+        uint64_t server_timestamp_ms{0};
+        uint64_t receive_ns{0};
+    };
+
+    // User channel "order" event: type is PLACEMENT, UPDATE (partial fill) or CANCELLATION
+    struct UserOrderEvent
+    {
+        std::string id;
+        std::string type;
+        std::string market;
+        std::string asset_id;
+        std::string side;
+        std::string outcome;
+        std::string price;
+        std::string original_size;
+        std::string size_matched;
+        std::string status;
+        std::string owner;
+        std::vector<std::string> associate_trades;
+        uint64_t server_timestamp_ms{0};
+        uint64_t receive_ns{0};
+    };
+
+    using UserTradeCallback = std::function<void(const UserTrade &trade)>;
+    using UserOrderCallback = std::function<void(const UserOrderEvent &order)>;
+
+    // Authenticated CLOB user channel: fills, placements, partial fills and cancels for our own orders, pushed as
+    // they happen instead of polling get_open_orders() / get_trades().
+    //
+    // The subscription (credentials plus condition id filter) is sent on every connect, so a reconnect resumes
+    // on its own. Events missed while disconnected are not replayed by the server; reconcile over REST after
+    // a reconnect if that matters. Callbacks run on the WebSocket thread.
+    class UserStreamManager
+    {
+    public:
+        UserStreamManager(const Config &config, const ApiCredentials &creds);
+        ~UserStreamManager();
+
+        UserStreamManager(const UserStreamManager &) = delete;
+        UserStreamManager &operator=(const UserStreamManager &) = delete;
+
+        // Condition ids to receive events for; none subscribes to every market. Changes on a live connection
+        // are sent right away.
+        void subscribe(const std::vector<std::string> &condition_ids);
+        void unsubscribe(const std::vector<std::string> &condition_ids);
+        std::vector<std::string> markets() const;
+
+        // Callbacks
+        void on_trade(UserTradeCallback callback);
+        void on_order(UserOrderCallback callback);
+
+        // Connection
+        bool connect();
+        void disconnect();
+        bool is_connected() const;
+
+        // Block until the subscription has been sent since the last connect (false on timeout or stop)
+        bool wait_subscribed(std::chrono::milliseconds timeout);
+
+        // Run event loop (blocking)
+        void run();
+        void stop();
+
+        // Statistics
+        uint64_t trades_received() const { return trades_received_.load(); }
+        uint64_t orders_received() const { return orders_received_.load(); }
+        uint64_t parse_errors() const { return parse_errors_.load(); }
+
+        // Decode one user channel frame (an event or an array of them) into trades and orders; false if it is
+        // not valid JSON. Keepalive replies and unknown event types are skipped.
+        static bool parse_message(std::string_view message, std::vector<UserTrade> &trades,
+                                  std::vector<UserOrderEvent> &orders);
+
+        // Initial subscription: {"auth": {...}, "markets": [...], "type": "user"}
+        static std::string subscription_message(const ApiCredentials &creds, const std::vector<std::string> &condition_ids);
+
+    private:
+        Config config_;
+        ApiCredentials creds_;
+        WebSocketClient ws_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable subscribed_cv_;
+        std::vector<std::string> markets_; // Guarded by mutex_
+        bool subscribed_{false};           // Guarded by mutex_
+        bool stopping_{false};             // Guarded by mutex_
+
+        // Reused by handle_message (WebSocket thread only)
+        std::vector<UserTrade> trades_;
+        std::vector<UserOrderEvent> orders_;
+
+        UserTradeCallback on_trade_cb_;
+        UserOrderCallback on_order_cb_;
+
+        std::atomic<uint64_t> trades_received_{0};
+        std::atomic<uint64_t> orders_received_{0};
+        std::atomic<uint64_t> parse_errors_{0};
+
+        void handle_message(const std::string &message);
+        void send_subscription();
+        bool send_update(const char *operation, const std::vector<std::string> &condition_ids);
+    };
+
+} // namespace polymarket
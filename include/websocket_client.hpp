@@ -5,6 +5,8 @@
 #include <atomic>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include <memory>
 #include <ixwebsocket/IXWebSocket.h>
 
@@ -56,19 +58,29 @@ namespace polymarket
         bool is_connected() const;
         WsState state() const;
 
+        // Block until the connection is open (true) or timeout / stop() (false); wakes on the state change itself
+        bool wait_connected(std::chrono::milliseconds timeout);
+
+        // Number of times the connection has opened; lets callers wait for a reconnect rather than the current one
+        uint64_t connect_count() const { return connect_count_.load(); }
+        bool wait_connect_count(uint64_t count, std::chrono::milliseconds timeout);
+
         // Send message
         bool send(const std::string &message);
 
-        // Run event loop (blocking) - IXWebSocket runs in its own thread
+        // Run event loop (blocking until stop()) - IXWebSocket runs in its own thread
         void run();
 
-        // Stop event loop
+        // Stop event loop; wakes run() and waiters immediately
         void stop();
 
         // Get statistics
         uint64_t messages_received() const { return messages_received_.load(); }
         uint64_t bytes_received() const { return bytes_received_.load(); }
 
+        // Local time (now_ns) the message being delivered was received; valid inside the on_message callback
+        uint64_t receive_ns() const { return receive_ns_; }
+
     private:
         ix::WebSocket ws_;
 
@@ -81,6 +93,11 @@ namespace polymarket
         std::atomic<WsState> state_;
         std::atomic<bool> running_;
         std::atomic<bool> should_stop_;
+        std::atomic<uint64_t> connect_count_{0};
+
+        // Signalled on every state change and on stop, so waiters never poll
+        mutable std::mutex state_mutex_;
+        std::condition_variable state_cv_;
 
         // Callbacks
         OnMessageCallback on_message_cb_;
@@ -91,6 +108,9 @@ namespace polymarket
         // Statistics
         std::atomic<uint64_t> messages_received_{0};
         std::atomic<uint64_t> bytes_received_{0};
+        uint64_t receive_ns_{0}; // Only touched on the IXWebSocket thread
+
+        void set_state(WsState state);
     };
 
 } // namespace polymarket
@@ -0,0 +1,487 @@
+#include "async_http_client.hpp"
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+namespace polymarket
+{
+
+    struct AsyncHttpClient::Transfer
+    {
+        std::string method;
+        std::string url;
+        std::string body; // Owned here: curl reads POSTFIELDS in place while the transfer runs
+        struct curl_slist *headers{nullptr};
+        HttpPriority priority{HttpPriority::NORMAL};
+        HttpCallback callback;
+        HttpResponse response{};
+        std::chrono::steady_clock::time_point start;
+
+        ~Transfer()
+        {
+            if (headers)
+            {
+                curl_slist_free_all(headers);
+            }
+        }
+    };
+
+    namespace
+    {
+        size_t write_callback(char *ptr, size_t size, size_t nmemb, void *userdata)
+        {
+            auto *body = static_cast<std::string *>(userdata);
+            body->append(ptr, size * nmemb);
+            return size * nmemb;
+        }
+    }
+
+    AsyncHttpClient::AsyncHttpClient()
+    {
+        CURLM *multi = curl_multi_init();
+        if (!multi)
+        {
+            throw std::runtime_error("Failed to initialize CURL multi handle");
+        }
+        // Multiplex requests to one host over a single HTTP/2 connection
+        curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        multi_ = multi;
+
+        loop_ = std::thread([this]()
+                            { run(); });
+    }
+
+    AsyncHttpClient::~AsyncHttpClient()
+    {
+        stop();
+        for (void *easy : idle_handles_)
+        {
+            curl_easy_cleanup(static_cast<CURL *>(easy));
+        }
+        curl_multi_cleanup(static_cast<CURLM *>(multi_));
+    }
+
+    void AsyncHttpClient::set_base_url(const std::string &base_url)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        base_url_ = base_url;
+        if (!base_url_.empty() && base_url_.back() == '/')
+        {
+            base_url_.pop_back();
+        }
+    }
+
+    void AsyncHttpClient::set_timeout_ms(long timeout_ms)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        timeout_ms_ = timeout_ms;
+    }
+
+    void AsyncHttpClient::set_proxy(const std::string &proxy_url)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        proxy_url_ = proxy_url;
+    }
+
+    void AsyncHttpClient::set_user_agent(const std::string &user_agent)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        user_agent_ = user_agent;
+    }
+
+    void AsyncHttpClient::add_header(const std::string &header)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        default_headers_.push_back(header);
+    }
+
+    void AsyncHttpClient::set_max_background(size_t count)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            max_background_ = count > 0 ? count : 1;
+        }
+        curl_multi_wakeup(static_cast<CURLM *>(multi_));
+    }
+
+    void AsyncHttpClient::set_http2(bool enabled)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        http2_ = enabled;
+    }
+
+    void AsyncHttpClient::set_share(CURLSH *share)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        share_ = share;
+    }
+
+    void AsyncHttpClient::submit(const std::string &method, const std::string &path, std::string body,
+                                 const std::map<std::string, std::string> &headers, HttpPriority priority,
+                                 HttpCallback callback)
+    {
+        auto transfer = std::make_unique<Transfer>();
+        transfer->method = method;
+        transfer->body = std::move(body);
+        transfer->priority = priority;
+        transfer->callback = std::move(callback);
+        for (const auto &[key, value] : headers)
+        {
+            std::string header = key + ": " + value;
+            transfer->headers = curl_slist_append(transfer->headers, header.c_str());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!stopping_)
+            {
+                transfer->url = base_url_.empty() ? path : base_url_ + path;
+                for (const auto &header : default_headers_)
+                {
+                    transfer->headers = curl_slist_append(transfer->headers, header.c_str());
+                }
+                transfer->start = std::chrono::steady_clock::now();
+                (priority == HttpPriority::HIGH ? high_queue_ : normal_queue_).push_back(std::move(transfer));
+                queued_++;
+                submitted_++;
+            }
+        }
+
+        if (transfer)
+        {
+            // Stopped: fail right away on the caller's thread
+            transfer->response.error = "Client stopped";
+            complete(*transfer);
+            return;
+        }
+        curl_multi_wakeup(static_cast<CURLM *>(multi_));
+    }
+
+    std::future<HttpResponse> AsyncHttpClient::submit(const std::string &method, const std::string &path, std::string body,
+                                                      const std::map<std::string, std::string> &headers,
+                                                      HttpPriority priority)
+    {
+        auto promise = std::make_shared<std::promise<HttpResponse>>();
+        auto future = promise->get_future();
+        submit(method, path, std::move(body), headers, priority, [promise](HttpResponse response)
+               { promise->set_value(std::move(response)); });
+        return future;
+    }
+
+    std::future<HttpResponse> AsyncHttpClient::get(const std::string &path, const std::map<std::string, std::string> &headers,
+                                                   HttpPriority priority)
+    {
+        return submit("GET", path, "", headers, priority);
+    }
+
+    std::future<HttpResponse> AsyncHttpClient::post(const std::string &path, std::string body,
+                                                    const std::map<std::string, std::string> &headers,
+                                                    HttpPriority priority)
+    {
+        return submit("POST", path, std::move(body), headers, priority);
+    }
+
+    std::future<HttpResponse> AsyncHttpClient::del(const std::string &path, std::string body,
+                                                   const std::map<std::string, std::string> &headers,
+                                                   HttpPriority priority)
+    {
+        return submit("DELETE", path, std::move(body), headers, priority);
+    }
+
+    bool AsyncHttpClient::warm_connection()
+    {
+        // Hit a cheap endpoint to establish TCP/TLS and settle the HTTP version
+        auto response = submit("GET", "/", "", {}, HttpPriority::HIGH).get();
+        return response.ok() || response.status_code == 404;
+    }
+
+    void AsyncHttpClient::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        curl_multi_wakeup(static_cast<CURLM *>(multi_));
+        if (loop_.joinable() && loop_.get_id() != std::this_thread::get_id())
+        {
+            loop_.join();
+        }
+    }
+
+    AsyncHttpStats AsyncHttpClient::get_stats() const
+    {
+        AsyncHttpStats stats;
+        stats.submitted = submitted_.load();
+        stats.completed = completed_.load();
+        stats.failed = failed_.load();
+        stats.http2 = http2_count_.load();
+        stats.connects = connects_.load();
+        stats.queued = queued_.load();
+        stats.in_flight = in_flight_.load();
+        return stats;
+    }
+
+    void AsyncHttpClient::run()
+    {
+        CURLM *multi = static_cast<CURLM *>(multi_);
+        while (true)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (stopping_)
+                {
+                    break;
+                }
+                start_queued();
+            }
+            for (auto &transfer : rejected_)
+            {
+                complete(*transfer);
+            }
+            rejected_.clear();
+
+            int running = 0;
+            curl_multi_perform(multi, &running);
+
+            bool finished = false;
+            int pending = 0;
+            while (CURLMsg *msg = curl_multi_info_read(multi, &pending))
+            {
+                if (msg->msg == CURLMSG_DONE)
+                {
+                    finish_transfer(msg->easy_handle, msg->data.result);
+                    finished = true;
+                }
+            }
+
+            // A finished background request frees a slot for the next queued one, so go round again right away.
+            // Otherwise sleep until socket activity, a timeout, or curl_multi_wakeup() from submit()/stop().
+            if (!finished)
+            {
+                curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+            }
+        }
+
+        fail_all("Client stopped");
+    }
+
+    void AsyncHttpClient::start_queued()
+    {
+        while (!high_queue_.empty())
+        {
+            auto transfer = std::move(high_queue_.front());
+            high_queue_.pop_front();
+            start_transfer(std::move(transfer));
+        }
+        while (!normal_queue_.empty() && active_normal_ < max_background_)
+        {
+            auto transfer = std::move(normal_queue_.front());
+            normal_queue_.pop_front();
+            start_transfer(std::move(transfer));
+        }
+    }
+
+    void AsyncHttpClient::start_transfer(std::unique_ptr<Transfer> transfer)
+    {
+        // Called with mutex_ held (reads the shared configuration)
+        CURL *easy;
+        if (!idle_handles_.empty())
+        {
+            easy = static_cast<CURL *>(idle_handles_.back());
+            idle_handles_.pop_back();
+            curl_easy_reset(easy);
+        }
+        else
+        {
+            easy = curl_easy_init();
+        }
+        queued_--;
+        if (!easy)
+        {
+            // Completed by run() once mutex_ is released, in case the callback submits again
+            transfer->response.error = "Failed to initialize CURL";
+            failed_++;
+            rejected_.push_back(std::move(transfer));
+            return;
+        }
+
+        curl_easy_setopt(easy, CURLOPT_URL, transfer->url.c_str());
+        curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->headers);
+        curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, timeout_ms_);
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, write_callback);
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer->response.body);
+        curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(easy, CURLOPT_TCP_NODELAY, 1L);
+        curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(easy, CURLOPT_TCP_KEEPIDLE, 20L);
+        curl_easy_setopt(easy, CURLOPT_TCP_KEEPINTVL, 20L);
+        curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(easy, CURLOPT_MAXREDIRS, 3L);
+        curl_easy_setopt(easy, CURLOPT_SSL_VERIFYPEER, 1L);
+        curl_easy_setopt(easy, CURLOPT_SSL_VERIFYHOST, 2L);
+        if (share_)
+        {
+            curl_easy_setopt(easy, CURLOPT_SHARE, share_);
+        }
+
+        // HTTP/2 over TLS (HTTP/1.1 for plain http). PIPEWAIT makes a request wait for the connection being set
+        // up to confirm multiplexing instead of opening a second one; on plain http it would only queue requests
+        // behind busy HTTP/1.1 connections.
+        bool multiplex = http2_ && transfer->url.compare(0, 8, "https://") == 0;
+        curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, http2_ ? CURL_HTTP_VERSION_2TLS : CURL_HTTP_VERSION_1_1);
+        curl_easy_setopt(easy, CURLOPT_PIPEWAIT, multiplex ? 1L : 0L);
+        curl_easy_setopt(easy, CURLOPT_STREAM_WEIGHT, transfer->priority == HttpPriority::HIGH ? 256L : 16L);
+
+        if (!user_agent_.empty())
+        {
+            curl_easy_setopt(easy, CURLOPT_USERAGENT, user_agent_.c_str());
+        }
+        if (!proxy_url_.empty())
+        {
+            // Same proxy handling as HttpClient::set_proxy
+            curl_easy_setopt(easy, CURLOPT_PROXY, proxy_url_.c_str());
+            if (proxy_url_.find("socks5://") == 0 || proxy_url_.find("socks5h://") == 0)
+            {
+                curl_easy_setopt(easy, CURLOPT_PROXYTYPE, CURLPROXY_SOCKS5_HOSTNAME);
+            }
+            else if (proxy_url_.find("socks4://") == 0)
+            {
+                curl_easy_setopt(easy, CURLOPT_PROXYTYPE, CURLPROXY_SOCKS4);
+            }
+            else
+            {
+                curl_easy_setopt(easy, CURLOPT_HTTPPROXYTUNNEL, 1L);
+                curl_easy_setopt(easy, CURLOPT_PROXYTYPE, CURLPROXY_HTTP);
+            }
+            curl_easy_setopt(easy, CURLOPT_SSL_VERIFYPEER, 0L);
+            curl_easy_setopt(easy, CURLOPT_SSL_VERIFYHOST, 0L);
+            curl_easy_setopt(easy, CURLOPT_PROXY_SSL_VERIFYPEER, 0L);
+            curl_easy_setopt(easy, CURLOPT_PROXY_SSL_VERIFYHOST, 0L);
+        }
+
+        if (transfer->method == "GET")
+        {
+            curl_easy_setopt(easy, CURLOPT_HTTPGET, 1L);
+        }
+        else
+        {
+            if (transfer->method == "POST")
+            {
+                curl_easy_setopt(easy, CURLOPT_POST, 1L);
+            }
+            else
+            {
+                curl_easy_setopt(easy, CURLOPT_CUSTOMREQUEST, transfer->method.c_str());
+            }
+            if (transfer->method == "POST" || !transfer->body.empty())
+            {
+                curl_easy_setopt(easy, CURLOPT_POSTFIELDS, transfer->body.c_str());
+                curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, static_cast<long>(transfer->body.size()));
+            }
+        }
+
+        if (transfer->priority == HttpPriority::NORMAL)
+        {
+            active_normal_++;
+        }
+        in_flight_++;
+        curl_multi_add_handle(static_cast<CURLM *>(multi_), easy);
+        active_[easy] = std::move(transfer);
+    }
+
+    void AsyncHttpClient::finish_transfer(void *handle, int result)
+    {
+        CURL *easy = static_cast<CURL *>(handle);
+        auto it = active_.find(easy);
+        if (it == active_.end())
+        {
+            return;
+        }
+        auto transfer = std::move(it->second);
+        active_.erase(it);
+        curl_multi_remove_handle(static_cast<CURLM *>(multi_), easy);
+
+        auto code = static_cast<CURLcode>(result);
+        HttpResponse &response = transfer->response;
+        response.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - transfer->start).count();
+        if (code != CURLE_OK)
+        {
+            response.error = curl_easy_strerror(code);
+            failed_++;
+        }
+        else
+        {
+            curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &response.status_code);
+            long version = 0;
+            curl_easy_getinfo(easy, CURLINFO_HTTP_VERSION, &version);
+            if (version == CURL_HTTP_VERSION_2_0)
+            {
+                http2_count_++;
+            }
+        }
+        long connects = 0;
+        curl_easy_getinfo(easy, CURLINFO_NUM_CONNECTS, &connects);
+        connects_ += static_cast<uint64_t>(connects);
+
+        if (transfer->priority == HttpPriority::NORMAL)
+        {
+            active_normal_--;
+        }
+        in_flight_--;
+        completed_++;
+        idle_handles_.push_back(easy);
+
+        complete(*transfer);
+    }
+
+    void AsyncHttpClient::fail_all(const std::string &error)
+    {
+        CURLM *multi = static_cast<CURLM *>(multi_);
+        for (auto &[easy, transfer] : active_)
+        {
+            curl_multi_remove_handle(multi, static_cast<CURL *>(easy));
+            idle_handles_.push_back(easy);
+            transfer->response.error = error;
+            complete(*transfer);
+        }
+        active_.clear();
+        active_normal_ = 0;
+        in_flight_ = 0;
+
+        std::deque<std::unique_ptr<Transfer>> queued;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto *queue : {&high_queue_, &normal_queue_})
+            {
+                for (auto &transfer : *queue)
+                {
+                    queued.push_back(std::move(transfer));
+                }
+                queue->clear();
+            }
+            queued_ = 0;
+        }
+        for (auto &transfer : queued)
+        {
+            transfer->response.error = error;
+            complete(*transfer);
+        }
+    }
+
+    void AsyncHttpClient::complete(Transfer &transfer)
+    {
+        if (!transfer.callback)
+        {
+            return;
+        }
+        try
+        {
+            transfer.callback(std::move(transfer.response));
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "[AsyncHttp] Callback threw: " << e.what() << std::endl;
+        }
+    }
+
+} // namespace polymarket
@@ -0,0 +1,569 @@
+#include "book_parser.hpp"
+#include <algorithm>
+#include <charconv>
+
+namespace polymarket
+{
+
+    namespace
+    {
+        // Minimal forward-only JSON tokenizer over a frame buffer
+        class Scanner
+        {
+        public:
+            explicit Scanner(std::string_view text)
+                : p_(text.data()), end_(text.data() + text.size())
+            {
+            }
+
+            char peek()
+            {
+                skip_ws();
+                return p_ < end_ ? *p_ : '\0';
+            }
+
+            bool consume(char c)
+            {
+                if (peek() == c)
+                {
+                    ++p_;
+                    return true;
+                }
+                return false;
+            }
+
+            bool at_end()
+            {
+                skip_ws();
+                return p_ >= end_;
+            }
+
+            // String token without the quotes (escape sequences are left as-is)
+            bool read_string(std::string_view &out)
+            {
+                if (!consume('"'))
+                {
+                    return false;
+                }
+                const char *start = p_;
+                while (p_ < end_ && *p_ != '"')
+                {
+                    if (*p_ == '\\' && p_ + 1 < end_)
+                    {
+                        ++p_;
+                    }
+                    ++p_;
+                }
+                if (p_ >= end_)
+                {
+                    return false;
+                }
+                out = std::string_view(start, static_cast<size_t>(p_ - start));
+                ++p_;
+                return true;
+            }
+
+            // String or bare number/literal token
+            bool read_scalar(std::string_view &out)
+            {
+                char c = peek();
+                if (c == '"')
+                {
+                    return read_string(out);
+                }
+                if (c == '{' || c == '[' || c == '\0')
+                {
+                    return false;
+                }
+                const char *start = p_;
+                while (p_ < end_ && !is_delimiter(*p_))
+                {
+                    ++p_;
+                }
+                out = std::string_view(start, static_cast<size_t>(p_ - start));
+                return !out.empty();
+            }
+
+            bool skip_value()
+            {
+                char c = peek();
+                if (c == '{' || c == '[')
+                {
+                    return skip_container();
+                }
+                std::string_view ignored;
+                return read_scalar(ignored);
+            }
+
+        private:
+            const char *p_;
+            const char *end_;
+
+            static bool is_space(char c)
+            {
+                return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+            }
+
+            static bool is_delimiter(char c)
+            {
+                return c == ',' || c == '}' || c == ']' || c == ':' || is_space(c);
+            }
+
+            void skip_ws()
+            {
+                while (p_ < end_ && is_space(*p_))
+                {
+                    ++p_;
+                }
+            }
+
+            // Skip a nested object/array without decoding it
+            bool skip_container()
+            {
+                int depth = 0;
+                while (p_ < end_)
+                {
+                    char c = *p_;
+                    if (c == '"')
+                    {
+                        std::string_view ignored;
+                        if (!read_string(ignored))
+                        {
+                            return false;
+                        }
+                        continue;
+                    }
+                    ++p_;
+                    if (c == '{' || c == '[')
+                    {
+                        depth++;
+                    }
+                    else if (c == '}' || c == ']')
+                    {
+                        if (--depth == 0)
+                        {
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+        };
+
+        bool to_double(std::string_view text, double &out)
+        {
+            auto result = std::from_chars(text.data(), text.data() + text.size(), out);
+            return result.ec == std::errc() && result.ptr == text.data() + text.size();
+        }
+
+        bool to_uint64(std::string_view text, uint64_t &out)
+        {
+            auto result = std::from_chars(text.data(), text.data() + text.size(), out);
+            return result.ec == std::errc() && result.ptr == text.data() + text.size();
+        }
+
+        bool read_decimal(Scanner &s, double &out)
+        {
+            std::string_view text;
+            return s.read_scalar(text) && to_double(text, out);
+        }
+
+        // [{"price": "0.52", "size": "100"}, ...] - values may be strings or numbers
+        bool parse_levels(Scanner &s, std::vector<PriceLevel> &out)
+        {
+            if (!s.consume('['))
+            {
+                return false;
+            }
+            if (s.consume(']'))
+            {
+                return true;
+            }
+            do
+            {
+                if (!s.consume('{'))
+                {
+                    return false;
+                }
+                PriceLevel level{0.0, 0.0};
+                if (!s.consume('}'))
+                {
+                    do
+                    {
+                        std::string_view key;
+                        if (!s.read_string(key) || !s.consume(':'))
+                        {
+                            return false;
+                        }
+                        if (key == "price")
+                        {
+                            if (!read_decimal(s, level.price))
+                                return false;
+                        }
+                        else if (key == "size")
+                        {
+                            if (!read_decimal(s, level.size))
+                                return false;
+                        }
+                        else if (!s.skip_value())
+                        {
+                            return false;
+                        }
+                    } while (s.consume(','));
+                    if (!s.consume('}'))
+                    {
+                        return false;
+                    }
+                }
+                out.push_back(level);
+            } while (s.consume(','));
+            return s.consume(']');
+        }
+
+        // [{"asset_id": "...", "price": "0.5", "size": "200", "side": "BUY", "hash": "...", "best_bid": "0.5", "best_ask": "0.51"}, ...]
+        // asset_id is optional (older events carry it on the event itself)
+        bool parse_changes(Scanner &s, std::vector<LevelChange> &out)
+        {
+            if (!s.consume('['))
+            {
+                return false;
+            }
+            if (s.consume(']'))
+            {
+                return true;
+            }
+            do
+            {
+                if (!s.consume('{'))
+                {
+                    return false;
+                }
+                LevelChange change{};
+                change.side = BookSide::BID;
+                bool has_bid = false;
+                bool has_ask = false;
+                if (!s.consume('}'))
+                {
+                    do
+                    {
+                        std::string_view key;
+                        if (!s.read_string(key) || !s.consume(':'))
+                        {
+                            return false;
+                        }
+                        bool ok = true;
+                        if (key == "price")
+                        {
+                            ok = read_decimal(s, change.price);
+                        }
+                        else if (key == "size")
+                        {
+                            ok = read_decimal(s, change.size);
+                        }
+                        else if (key == "side")
+                        {
+                            std::string_view side;
+                            ok = s.read_string(side);
+                            change.side = (side == "SELL" || side == "sell") ? BookSide::ASK : BookSide::BID;
+                        }
+                        else if (key == "asset_id")
+                        {
+                            ok = s.read_string(change.asset_id);
+                        }
+                        else if (key == "hash")
+                        {
+                            ok = s.read_string(change.hash);
+                        }
+                        else if (key == "best_bid")
+                        {
+                            ok = read_decimal(s, change.best_bid);
+                            has_bid = ok;
+                        }
+                        else if (key == "best_ask")
+                        {
+                            ok = read_decimal(s, change.best_ask);
+                            has_ask = ok;
+                        }
+                        else
+                        {
+                            ok = s.skip_value();
+                        }
+                        if (!ok)
+                        {
+                            return false;
+                        }
+                    } while (s.consume(','));
+                    if (!s.consume('}'))
+                    {
+                        return false;
+                    }
+                }
+                change.has_top_of_book = has_bid && has_ask;
+                out.push_back(change);
+            } while (s.consume(','));
+            return s.consume(']');
+        }
+
+        // Sort levels best-first; feeds usually send them in one order or the other, so avoid a full sort
+        template <typename Better>
+        void sort_best_first(std::vector<PriceLevel> &levels, Better better)
+        {
+            if (std::is_sorted(levels.begin(), levels.end(), better))
+            {
+                return;
+            }
+            if (std::is_sorted(levels.rbegin(), levels.rend(), better))
+            {
+                std::reverse(levels.begin(), levels.end());
+                return;
+            }
+            std::sort(levels.begin(), levels.end(), better);
+        }
+
+        void append_changes(const std::vector<PriceLevel> &levels, BookSide side, std::vector<LevelChange> &out)
+        {
+            for (const auto &level : levels)
+            {
+                LevelChange change{};
+                change.side = side;
+                change.price = level.price;
+                change.size = level.size;
+                out.push_back(change);
+            }
+        }
+
+        // Envelope fields that decide what kind of event an object is
+        struct EventHeader
+        {
+            std::string_view topic;
+            std::string_view type;
+            std::string_view event_type;
+            std::string_view asset_id;
+        };
+
+        // Parse an event object (and its "payload" object, if any) into ev
+        bool parse_object(Scanner &s, BookEvent &ev, EventHeader &header, bool allow_payload)
+        {
+            if (!s.consume('{'))
+            {
+                return false;
+            }
+            if (s.consume('}'))
+            {
+                return true;
+            }
+            do
+            {
+                std::string_view key;
+                if (!s.read_string(key) || !s.consume(':'))
+                {
+                    return false;
+                }
+
+                bool ok = true;
+                if (key == "asset_id")
+                {
+                    ok = s.read_string(header.asset_id);
+                }
+                else if (key == "bids" || key == "buys")
+                {
+                    ok = parse_levels(s, ev.book.bids);
+                }
+                else if (key == "asks" || key == "sells")
+                {
+                    ok = parse_levels(s, ev.book.asks);
+                }
+                else if (key == "price_changes" || key == "changes")
+                {
+                    ok = parse_changes(s, ev.changes);
+                }
+                else if (key == "hash")
+                {
+                    ok = s.read_string(ev.hash);
+                }
+                else if (key == "event_type")
+                {
+                    ok = s.read_string(header.event_type);
+                }
+                else if (key == "old_tick_size")
+                {
+                    ok = s.read_scalar(ev.old_tick_size);
+                }
+                else if (key == "new_tick_size")
+                {
+                    ok = s.read_scalar(ev.new_tick_size);
+                }
+                else if (key == "topic")
+                {
+                    ok = s.read_string(header.topic);
+                }
+                else if (key == "type")
+                {
+                    ok = s.read_scalar(header.type);
+                }
+                else if (key == "timestamp")
+                {
+                    std::string_view ts;
+                    ok = s.read_scalar(ts);
+                    uint64_t value = 0;
+                    if (ok && to_uint64(ts, value))
+                    {
+                        ev.server_timestamp_ms = value;
+                    }
+                }
+                else if (key == "payload" && allow_payload && s.peek() == '{')
+                {
+                    EventHeader payload_header;
+                    ok = parse_object(s, ev, payload_header, false);
+                    if (!payload_header.asset_id.empty())
+                    {
+                        header.asset_id = payload_header.asset_id;
+                    }
+                }
+                else
+                {
+                    ok = s.skip_value();
+                }
+
+                if (!ok)
+                {
+                    return false;
+                }
+            } while (s.consume(','));
+
+            return s.consume('}');
+        }
+
+        WsMessageType classify(const EventHeader &header, const BookEvent &ev)
+        {
+            // price_change events may carry the asset per change instead of on the event
+            if (header.event_type == "price_change")
+            {
+                bool has_levels = !ev.changes.empty() || !ev.book.bids.empty() || !ev.book.asks.empty();
+                return has_levels ? WsMessageType::ORDERBOOK_UPDATE : WsMessageType::UNKNOWN;
+            }
+
+            if (header.asset_id.empty())
+            {
+                return WsMessageType::UNKNOWN;
+            }
+
+            // Real-time data format
+            if (!header.topic.empty())
+            {
+                if (header.topic == "clob_market" && header.type == "agg_orderbook")
+                {
+                    return WsMessageType::ORDERBOOK_SNAPSHOT;
+                }
+                return WsMessageType::UNKNOWN;
+            }
+
+            // Market channel format
+            if (header.event_type == "book")
+            {
+                return WsMessageType::ORDERBOOK_SNAPSHOT;
+            }
+            if (header.event_type == "tick_size_change")
+            {
+                return WsMessageType::TICK_SIZE_CHANGE;
+            }
+            return WsMessageType::UNKNOWN;
+        }
+    } // namespace
+
+    BookFrameParser::BookFrameParser()
+        : count_(0), error_(nullptr)
+    {
+    }
+
+    BookEvent &BookFrameParser::next_event()
+    {
+        if (count_ == events_.size())
+        {
+            events_.emplace_back();
+        }
+        BookEvent &ev = events_[count_];
+        ev.type = WsMessageType::UNKNOWN;
+        ev.server_timestamp_ms = 0;
+        ev.hash = std::string_view();
+        ev.old_tick_size = std::string_view();
+        ev.new_tick_size = std::string_view();
+        ev.book.bids.clear();
+        ev.book.asks.clear();
+        ev.changes.clear();
+        return ev;
+    }
+
+    bool BookFrameParser::parse(std::string_view frame)
+    {
+        count_ = 0;
+        error_ = nullptr;
+
+        Scanner s(frame);
+        bool is_array = s.consume('[');
+        if (is_array && s.consume(']'))
+        {
+            return true;
+        }
+
+        do
+        {
+            BookEvent &ev = next_event();
+            EventHeader header;
+            if (!parse_object(s, ev, header, true))
+            {
+                count_ = 0;
+                error_ = "malformed orderbook frame";
+                return false;
+            }
+
+            ev.type = classify(header, ev);
+            if (ev.type == WsMessageType::UNKNOWN)
+            {
+                continue;
+            }
+
+            ev.book.asset_id.assign(header.asset_id.data(), header.asset_id.size());
+            ev.book.timestamp_ns = now_ns();
+
+            if (ev.type == WsMessageType::ORDERBOOK_UPDATE)
+            {
+                // Levels listed as bids/asks on a price_change are deltas too
+                append_changes(ev.book.bids, BookSide::BID, ev.changes);
+                append_changes(ev.book.asks, BookSide::ASK, ev.changes);
+                ev.book.bids.clear();
+                ev.book.asks.clear();
+                for (auto &change : ev.changes)
+                {
+                    if (change.asset_id.empty())
+                    {
+                        change.asset_id = header.asset_id;
+                    }
+                    if (change.hash.empty())
+                    {
+                        change.hash = ev.hash;
+                    }
+                }
+            }
+            else
+            {
+                sort_best_first(ev.book.bids, [](const PriceLevel &a, const PriceLevel &b)
+                                { return a.price > b.price; });
+                sort_best_first(ev.book.asks, [](const PriceLevel &a, const PriceLevel &b)
+                                { return a.price < b.price; });
+            }
+
+            count_++;
+        } while (is_array && s.consume(','));
+
+        if ((is_array && !s.consume(']')) || !s.at_end())
+        {
+            count_ = 0;
+            error_ = "malformed orderbook frame";
+            return false;
+        }
+
+        return true;
+    }
+
+} // namespace polymarket
@@ -1,13 +1,14 @@
 #include "clob_client.hpp"
+#include "fixed_point.hpp"
+#include "http_pool.hpp"
 #include "order_signer.hpp"
+#include "order_json.hpp"
+#include "orderbook.hpp"
 #include <nlohmann/json.hpp>
-#include <cmath>
-#include <iomanip>
-#include <limits>
+#include <algorithm>
 #include <map>
 #include <optional>
 #include <memory>
-#include <sstream>
 #include <stdexcept>
 
 using json = nlohmann::json;
@@ -15,15 +16,24 @@ using json = nlohmann::json;
 namespace polymarket
 {
 
-    // Exchange addresses for Polygon mainnet
-    static const std::string EXCHANGE_ADDRESS = "0x4bFb41d5B3570DeFd03C39a9A4D8dE6Bd8B8982E";
-    static const std::string NEG_RISK_EXCHANGE_ADDRESS = "0xC5d563A36AE78145C45a50134d48A1215220f80a";
-
     // Data API URL for positions
     static const std::string DATA_API_URL = "https://data-api.polymarket.com";
 
     namespace
     {
+        // Request body buffer for order posts, reused so serialization never reallocates once warm
+        std::string &order_body_buffer()
+        {
+            thread_local std::string buffer = []()
+            {
+                std::string b;
+                b.reserve(16 * 1024);
+                return b;
+            }();
+            buffer.clear();
+            return buffer;
+        }
+
         struct RoundConfig
         {
             int price;
@@ -40,28 +50,9 @@ namespace polymarket
 
         std::string normalize_tick_size(const std::string &tick_size)
         {
-            std::ostringstream oss;
-            oss.setf(std::ios::fixed);
-            oss << std::setprecision(6) << std::stod(tick_size);
-            std::string normalized = oss.str();
-
-            auto dot = normalized.find('.');
-            if (dot == std::string::npos)
-            {
-                return normalized;
-            }
-
-            size_t end = normalized.size();
-            while (end > dot + 1 && normalized[end - 1] == '0')
-            {
-                --end;
-            }
-            if (end == dot + 1)
-            {
-                end = dot;
-            }
-            normalized.resize(end);
-            return normalized;
+            // "0.010" and "0.01" are the same tick; anything parse() rejects ("1e-2") goes through stod
+            auto tick = Fixed6::parse(tick_size);
+            return (tick ? *tick : Fixed6::from_double(std::stod(tick_size))).to_string();
         }
 
         bool is_tick_size_smaller(const std::string &a, const std::string &b)
@@ -75,64 +66,27 @@ namespace polymarket
             return price >= tick && price <= 1.0 - tick;
         }
 
-        int decimal_places(double value)
-        {
-            if (std::floor(value) == value)
-            {
-                return 0;
-            }
-
-            std::ostringstream oss;
-            oss.setf(std::ios::fixed);
-            oss << std::setprecision(12) << value;
-            std::string str = oss.str();
-
-            auto dot = str.find('.');
-            if (dot == std::string::npos)
-            {
-                return 0;
-            }
-
-            size_t end = str.size();
-            while (end > dot + 1 && str[end - 1] == '0')
-            {
-                --end;
-            }
-            if (end == dot + 1)
-            {
-                return 0;
-            }
-            return static_cast<int>(end - dot - 1);
-        }
-
-        double round_normal(double value, int decimals)
+        // Taker side of a market order, in micros: the exact maker / price (BUY) or maker * price (SELL), rounded
+        // up at amount + 4 decimals and then down at amount, so a quotient a hair under a round number lands on
+        // it and anything else is truncated
+        Fixed6 market_taker_amount(OrderSide side, Fixed6 maker, Fixed6 price, int amount_decimals)
         {
-            if (decimal_places(value) <= decimals)
+            __int128 fine = 1;
+            for (int i = 0; i < amount_decimals + 4; i++)
             {
-                return value;
+                fine *= 10;
             }
-            double scale = std::pow(10.0, decimals);
-            return std::round((value + std::numeric_limits<double>::epsilon()) * scale) / scale;
-        }
-
-        double round_down(double value, int decimals)
-        {
-            if (decimal_places(value) <= decimals)
+            __int128 numerator = side == OrderSide::BUY ? static_cast<__int128>(maker.raw()) * fine
+                                                        : static_cast<__int128>(maker.raw()) * price.raw() * fine;
+            __int128 denominator = side == OrderSide::BUY ? static_cast<__int128>(price.raw())
+                                                          : static_cast<__int128>(Fixed6::kScale) * Fixed6::kScale;
+            __int128 units = (numerator + denominator - 1) / denominator / 10000; // Both non-negative
+            int64_t step = 1;
+            for (int i = amount_decimals; i < Fixed6::kDecimals; i++)
             {
-                return value;
+                step *= 10;
             }
-            double scale = std::pow(10.0, decimals);
-            return std::floor(value * scale) / scale;
-        }
-
-        double round_up(double value, int decimals)
-        {
-            if (decimal_places(value) <= decimals)
-            {
-                return value;
-            }
-            double scale = std::pow(10.0, decimals);
-            return std::ceil(value * scale) / scale;
+            return Fixed6::from_raw(static_cast<int64_t>(units) * step);
         }
 
         RoundConfig get_round_config(const std::string &tick_size)
@@ -199,13 +153,57 @@ namespace polymarket
 
             return positions.front().price;
         }
+
+        std::optional<std::string> parse_tick_size(const std::string &body)
+        {
+            try
+            {
+                auto j = json::parse(body);
+                return j.value("minimum_tick_size", "0.01");
+            }
+            catch (...)
+            {
+                return std::nullopt;
+            }
+        }
+
+        std::optional<bool> parse_neg_risk(const std::string &body)
+        {
+            try
+            {
+                auto j = json::parse(body);
+                return j.value("neg_risk", false);
+            }
+            catch (...)
+            {
+                return std::nullopt;
+            }
+        }
+
+        std::optional<int> parse_fee_rate(const std::string &body)
+        {
+            try
+            {
+                auto j = json::parse(body);
+                if (j.contains("base_fee"))
+                {
+                    return j.value("base_fee", 0);
+                }
+                return 0;
+            }
+            catch (...)
+            {
+                return std::nullopt;
+            }
+        }
     } // namespace
 
     ClobClient::ClobClient(const std::string &base_url, int chain_id)
         : chain_id_(chain_id), base_url_(base_url), sig_type_(SignatureType::EOA)
     {
         http_.set_base_url(base_url);
-        http_.set_timeout_ms(10000);
+        http_.set_timeout_ms(timeout_ms_);
+        HttpPool::global().attach(http_, base_url);
     }
 
     ClobClient::ClobClient(const std::string &base_url, int chain_id,
@@ -216,13 +214,23 @@ namespace polymarket
         : chain_id_(chain_id), base_url_(base_url), funder_address_(funder_address), sig_type_(sig_type)
     {
         http_.set_base_url(base_url);
-        http_.set_timeout_ms(10000);
+        http_.set_timeout_ms(timeout_ms_);
+        HttpPool::global().attach(http_, base_url);
 
         order_signer_ = std::make_unique<OrderSigner>(private_key, chain_id);
         api_creds_ = std::make_unique<ApiCredentials>(creds);
     }
 
-    ClobClient::~ClobClient() = default;
+    ClobClient::~ClobClient()
+    {
+        // The pool warms and heartbeats attached clients, so take ours off before they go
+        HttpPool::global().detach(http_);
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        if (async_http_)
+        {
+            HttpPool::global().detach(*async_http_);
+        }
+    }
 
     std::string ClobClient::get_exchange_address() const
     {
@@ -234,6 +242,124 @@ namespace polymarket
         return NEG_RISK_EXCHANGE_ADDRESS;
     }
 
+    void ClobClient::set_timeout_ms(long timeout_ms)
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        timeout_ms_ = timeout_ms;
+        http_.set_timeout_ms(timeout_ms);
+        if (async_http_)
+        {
+            async_http_->set_timeout_ms(timeout_ms);
+        }
+    }
+
+    void ClobClient::set_proxy(const std::string &proxy_url)
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        proxy_url_ = proxy_url;
+        http_.set_proxy(proxy_url);
+        if (async_http_)
+        {
+            async_http_->set_proxy(proxy_url);
+        }
+    }
+
+    void ClobClient::set_user_agent(const std::string &user_agent)
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        user_agent_ = user_agent;
+        http_.set_user_agent(user_agent);
+        if (async_http_)
+        {
+            async_http_->set_user_agent(user_agent);
+        }
+    }
+
+    AsyncHttpClient &ClobClient::async_http()
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        if (!async_http_)
+        {
+            async_http_ = std::make_unique<AsyncHttpClient>();
+            async_http_->set_base_url(base_url_);
+            async_http_->set_timeout_ms(timeout_ms_);
+            async_http_->add_header("Accept: application/json");
+            async_http_->add_header("Content-Type: application/json");
+            if (!proxy_url_.empty())
+            {
+                async_http_->set_proxy(proxy_url_);
+            }
+            if (!user_agent_.empty())
+            {
+                async_http_->set_user_agent(user_agent_);
+            }
+            HttpPool::global().attach(*async_http_, base_url_);
+        }
+        return *async_http_;
+    }
+
+    namespace
+    {
+        HttpResponse dropped_response()
+        {
+            return HttpResponse{0, "", "rate limited: dropped by the request scheduler", 0.0};
+        }
+    } // namespace
+
+    HttpResponse ClobClient::send(const std::string &method, const std::string &path, const std::string &body,
+                                  const std::map<std::string, std::string> &headers)
+    {
+        return send(RequestScheduler::lane_for(method, path), method, method, path, body, headers);
+    }
+
+    HttpResponse ClobClient::send(RequestLane lane, const std::string &limit_method, const std::string &method,
+                                  const std::string &path, const std::string &body,
+                                  const std::map<std::string, std::string> &headers)
+    {
+        if (!scheduler_.acquire(lane, limit_method, path))
+        {
+            return dropped_response();
+        }
+
+        HttpResponse response;
+        if (method == "GET")
+        {
+            response = headers.empty() ? http_.get(path) : http_.get(path, headers);
+        }
+        else if (method == "DELETE")
+        {
+            response = headers.empty() ? http_.del(path, body) : http_.del(path, body, headers);
+        }
+        else
+        {
+            response = headers.empty() ? http_.post(path, body) : http_.post(path, body, headers);
+        }
+        scheduler_.on_response(lane, limit_method, path, response.status_code);
+        return response;
+    }
+
+    void ClobClient::submit(const std::string &method, const std::string &path, std::string body,
+                            const std::map<std::string, std::string> &headers, HttpCallback callback, bool background)
+    {
+        RequestLane lane = RequestScheduler::lane_for(method, path);
+        bool admitted = background ? scheduler_.try_acquire(lane, method, path) : scheduler_.acquire(lane, method, path);
+        if (!admitted)
+        {
+            callback(dropped_response());
+            return;
+        }
+
+        // Orders and cancels go first on the connection; queries fill what is left
+        HttpPriority priority = lane == RequestLane::CANCEL || lane == RequestLane::ORDER ? HttpPriority::HIGH
+                                                                                           : HttpPriority::NORMAL;
+        async_http().submit(method, path, std::move(body), headers, priority,
+                            [this, lane, method, path, callback = std::move(callback)](HttpResponse response)
+                            {
+                                scheduler_.on_response(lane, method, path, response.status_code);
+                                callback(std::move(response));
+                            });
+    }
+
     bool ClobClient::warm_connection()
     {
         // Step 1: Hit a cheap GET endpoint to establish TCP/TLS
@@ -250,6 +376,15 @@ namespace polymarket
         return true;
     }
 
+    size_t ClobClient::warm_all_connections()
+    {
+        // The async client (order posts) and the Data API client (positions) are created on first use; create
+        // them now so the pool warms the connections those requests will go out on
+        async_http();
+        HttpPool::global().client(DATA_API_URL);
+        return HttpPool::global().warm_all();
+    }
+
     std::string ClobClient::get_address() const
     {
         if (!order_signer_)
@@ -305,7 +440,7 @@ namespace polymarket
 
     std::optional<uint64_t> ClobClient::get_server_time()
     {
-        auto response = http_.get("/time");
+        auto response = send("GET", "/time");
         if (!response.ok())
             return std::nullopt;
 
@@ -328,16 +463,29 @@ namespace polymarket
             path += "?next_cursor=" + next_cursor;
         }
 
-        auto response = http_.get(path);
+        auto response = send("GET", path);
         if (!response.ok())
             return {};
 
         return parse_markets(response.body);
     }
 
+    MarketPager ClobClient::market_pager(const std::string &endpoint, MarketFilter filter, size_t limit)
+    {
+        auto fetch = [this](const std::string &path)
+        {
+            auto promise = std::make_shared<std::promise<HttpResponse>>();
+            auto future = promise->get_future();
+            submit("GET", path, "", {}, [promise](HttpResponse response)
+                   { promise->set_value(std::move(response)); });
+            return future;
+        };
+        return MarketPager(fetch, endpoint, std::move(filter), limit);
+    }
+
     std::optional<ClobMarket> ClobClient::get_market(const std::string &condition_id)
     {
-        auto response = http_.get("/markets/" + condition_id);
+        auto response = send("GET", "/markets/" + condition_id);
         if (!response.ok())
             return std::nullopt;
 
@@ -356,7 +504,7 @@ namespace polymarket
             path += "?next_cursor=" + next_cursor;
         }
 
-        auto response = http_.get(path);
+        auto response = send("GET", path);
         if (!response.ok())
             return {};
 
@@ -371,7 +519,7 @@ namespace polymarket
             path += "?next_cursor=" + next_cursor;
         }
 
-        auto response = http_.get(path);
+        auto response = send("GET", path);
         if (!response.ok())
             return {};
 
@@ -386,7 +534,7 @@ namespace polymarket
             path += "?next_cursor=" + next_cursor;
         }
 
-        auto response = http_.get(path);
+        auto response = send("GET", path);
         if (!response.ok())
             return {};
 
@@ -395,7 +543,7 @@ namespace polymarket
 
     std::optional<Orderbook> ClobClient::get_order_book(const std::string &token_id)
     {
-        auto response = http_.get("/book?token_id=" + token_id);
+        auto response = send("GET", "/book?token_id=" + token_id);
         if (!response.ok())
             return std::nullopt;
 
@@ -415,7 +563,7 @@ namespace polymarket
             ids += token_ids[i];
         }
 
-        auto response = http_.get("/books?token_ids=" + ids);
+        auto response = send("GET", "/books?token_ids=" + ids);
         if (!response.ok())
             return result;
 
@@ -469,19 +617,87 @@ namespace polymarket
         return calculate_sell_market_price(book->bids, amount, order_type);
     }
 
+    namespace
+    {
+        // Comma-separated ids of the tokens at the given indexes
+        std::string join_ids(const std::vector<std::string> &token_ids, const std::vector<size_t> &indexes)
+        {
+            std::string ids;
+            for (size_t i : indexes)
+            {
+                if (!ids.empty())
+                    ids += ",";
+                ids += token_ids[i];
+            }
+            return ids;
+        }
+
+        // Answers in request order, skipping tokens that got none
+        template <typename Info>
+        std::vector<Info> compact(std::vector<std::optional<Info>> &slots)
+        {
+            std::vector<Info> result;
+            result.reserve(slots.size());
+            for (auto &slot : slots)
+            {
+                if (slot)
+                    result.push_back(std::move(*slot));
+            }
+            return result;
+        }
+
+        // The buy side of the book is its bids, as on GET /price
+        double side_price(const TopOfBook &top, const std::string &side)
+        {
+            return !side.empty() && (side[0] == 'b' || side[0] == 'B') ? top.best_bid : top.best_ask;
+        }
+    } // namespace
+
+    void ClobClient::attach_orderbook(const OrderbookManager *books, std::chrono::milliseconds max_age)
+    {
+        local_max_age_ns_.store(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(max_age).count()),
+                                std::memory_order_relaxed);
+        local_books_.store(books, std::memory_order_release);
+    }
+
+    bool ClobClient::local_quote(const std::string &token_id, TopOfBook &top, uint64_t &age_ns) const
+    {
+        const OrderbookManager *books = local_books_.load(std::memory_order_acquire);
+        if (!books)
+            return false;
+
+        BookSnapshot snapshot;
+        TokenHandle token = books->token_handle(token_id);
+        if (token == kInvalidToken || !books->read_snapshot(token, snapshot) || snapshot.needs_resync ||
+            snapshot.bid_count == 0 || snapshot.ask_count == 0)
+            return false;
+
+        uint64_t now = now_ns();
+        age_ns = now > snapshot.timestamp_ns ? now - snapshot.timestamp_ns : 0;
+        if (age_ns > local_max_age_ns_.load(std::memory_order_relaxed))
+            return false;
+
+        top = snapshot.top;
+        return true;
+    }
+
     std::optional<PriceInfo> ClobClient::get_price(const std::string &token_id, const std::string &side)
     {
-        auto response = http_.get("/price?token_id=" + token_id + "&side=" + side);
+        TopOfBook top;
+        uint64_t age_ns = 0;
+        if (local_quote(token_id, top, age_ns))
+        {
+            return PriceInfo{token_id, side_price(top, side), QuoteSource::LOCAL_BOOK, age_ns};
+        }
+
+        auto response = send("GET", "/price?token_id=" + token_id + "&side=" + side);
         if (!response.ok())
             return std::nullopt;
 
         try
         {
             auto j = json::parse(response.body);
-            PriceInfo info;
-            info.token_id = token_id;
-            info.price = std::stod(j.value("price", "0"));
-            return info;
+            return PriceInfo{token_id, std::stod(j.value("price", "0")), QuoteSource::REST, 0};
         }
         catch (...)
         {
@@ -491,31 +707,33 @@ namespace polymarket
 
     std::vector<PriceInfo> ClobClient::get_prices(const std::vector<std::string> &token_ids, const std::string &side)
     {
-        std::vector<PriceInfo> result;
-
-        std::string ids;
+        std::vector<std::optional<PriceInfo>> slots(token_ids.size());
+        std::vector<size_t> remote;
         for (size_t i = 0; i < token_ids.size(); i++)
         {
-            if (i > 0)
-                ids += ",";
-            ids += token_ids[i];
+            TopOfBook top;
+            uint64_t age_ns = 0;
+            if (local_quote(token_ids[i], top, age_ns))
+                slots[i] = PriceInfo{token_ids[i], side_price(top, side), QuoteSource::LOCAL_BOOK, age_ns};
+            else
+                remote.push_back(i);
         }
+        if (remote.empty())
+            return compact(slots);
 
-        auto response = http_.get("/prices?token_ids=" + ids + "&side=" + side);
+        auto response = send("GET", "/prices?token_ids=" + join_ids(token_ids, remote) + "&side=" + side);
         if (!response.ok())
-            return result;
+            return compact(slots);
 
         try
         {
             auto j = json::parse(response.body);
             if (j.is_array())
             {
-                for (size_t i = 0; i < j.size() && i < token_ids.size(); i++)
+                for (size_t k = 0; k < j.size() && k < remote.size(); k++)
                 {
-                    PriceInfo info;
-                    info.token_id = token_ids[i];
-                    info.price = std::stod(j[i].value("price", "0"));
-                    result.push_back(info);
+                    const std::string &token_id = token_ids[remote[k]];
+                    slots[remote[k]] = PriceInfo{token_id, std::stod(j[k].value("price", "0")), QuoteSource::REST, 0};
                 }
             }
         }
@@ -523,12 +741,12 @@ namespace polymarket
         {
         }
 
-        return result;
+        return compact(slots);
     }
 
     std::optional<PriceInfo> ClobClient::get_last_trade_price(const std::string &token_id)
     {
-        auto response = http_.get("/last-trade-price?token_id=" + token_id);
+        auto response = send("GET", "/last-trade-price?token_id=" + token_id);
         if (!response.ok())
             return std::nullopt;
 
@@ -558,7 +776,7 @@ namespace polymarket
             ids += token_ids[i];
         }
 
-        auto response = http_.get("/last-trades-prices?token_ids=" + ids);
+        auto response = send("GET", "/last-trades-prices?token_ids=" + ids);
         if (!response.ok())
             return result;
 
@@ -585,17 +803,21 @@ namespace polymarket
 
     std::optional<MidpointInfo> ClobClient::get_midpoint(const std::string &token_id)
     {
-        auto response = http_.get("/midpoint?token_id=" + token_id);
+        TopOfBook top;
+        uint64_t age_ns = 0;
+        if (local_quote(token_id, top, age_ns))
+        {
+            return MidpointInfo{token_id, (top.best_bid + top.best_ask) / 2.0, QuoteSource::LOCAL_BOOK, age_ns};
+        }
+
+        auto response = send("GET", "/midpoint?token_id=" + token_id);
         if (!response.ok())
             return std::nullopt;
 
         try
         {
             auto j = json::parse(response.body);
-            MidpointInfo info;
-            info.token_id = token_id;
-            info.mid = std::stod(j.value("mid", "0"));
-            return info;
+            return MidpointInfo{token_id, std::stod(j.value("mid", "0")), QuoteSource::REST, 0};
         }
         catch (...)
         {
@@ -605,31 +827,33 @@ namespace polymarket
 
     std::vector<MidpointInfo> ClobClient::get_midpoints(const std::vector<std::string> &token_ids)
     {
-        std::vector<MidpointInfo> result;
-
-        std::string ids;
+        std::vector<std::optional<MidpointInfo>> slots(token_ids.size());
+        std::vector<size_t> remote;
         for (size_t i = 0; i < token_ids.size(); i++)
         {
-            if (i > 0)
-                ids += ",";
-            ids += token_ids[i];
+            TopOfBook top;
+            uint64_t age_ns = 0;
+            if (local_quote(token_ids[i], top, age_ns))
+                slots[i] = MidpointInfo{token_ids[i], (top.best_bid + top.best_ask) / 2.0, QuoteSource::LOCAL_BOOK, age_ns};
+            else
+                remote.push_back(i);
         }
+        if (remote.empty())
+            return compact(slots);
 
-        auto response = http_.get("/midpoints?token_ids=" + ids);
+        auto response = send("GET", "/midpoints?token_ids=" + join_ids(token_ids, remote));
         if (!response.ok())
-            return result;
+            return compact(slots);
 
         try
         {
             auto j = json::parse(response.body);
             if (j.is_array())
             {
-                for (size_t i = 0; i < j.size() && i < token_ids.size(); i++)
+                for (size_t k = 0; k < j.size() && k < remote.size(); k++)
                 {
-                    MidpointInfo info;
-                    info.token_id = token_ids[i];
-                    info.mid = std::stod(j[i].value("mid", "0"));
-                    result.push_back(info);
+                    const std::string &token_id = token_ids[remote[k]];
+                    slots[remote[k]] = MidpointInfo{token_id, std::stod(j[k].value("mid", "0")), QuoteSource::REST, 0};
                 }
             }
         }
@@ -637,22 +861,26 @@ namespace polymarket
         {
         }
 
-        return result;
+        return compact(slots);
     }
 
     std::optional<SpreadInfo> ClobClient::get_spread(const std::string &token_id)
     {
-        auto response = http_.get("/spread?token_id=" + token_id);
+        TopOfBook top;
+        uint64_t age_ns = 0;
+        if (local_quote(token_id, top, age_ns))
+        {
+            return SpreadInfo{token_id, top.best_ask - top.best_bid, QuoteSource::LOCAL_BOOK, age_ns};
+        }
+
+        auto response = send("GET", "/spread?token_id=" + token_id);
         if (!response.ok())
             return std::nullopt;
 
         try
         {
             auto j = json::parse(response.body);
-            SpreadInfo info;
-            info.token_id = token_id;
-            info.spread = std::stod(j.value("spread", "0"));
-            return info;
+            return SpreadInfo{token_id, std::stod(j.value("spread", "0")), QuoteSource::REST, 0};
         }
         catch (...)
         {
@@ -662,31 +890,33 @@ namespace polymarket
 
     std::vector<SpreadInfo> ClobClient::get_spreads(const std::vector<std::string> &token_ids)
     {
-        std::vector<SpreadInfo> result;
-
-        std::string ids;
+        std::vector<std::optional<SpreadInfo>> slots(token_ids.size());
+        std::vector<size_t> remote;
         for (size_t i = 0; i < token_ids.size(); i++)
         {
-            if (i > 0)
-                ids += ",";
-            ids += token_ids[i];
+            TopOfBook top;
+            uint64_t age_ns = 0;
+            if (local_quote(token_ids[i], top, age_ns))
+                slots[i] = SpreadInfo{token_ids[i], top.best_ask - top.best_bid, QuoteSource::LOCAL_BOOK, age_ns};
+            else
+                remote.push_back(i);
         }
+        if (remote.empty())
+            return compact(slots);
 
-        auto response = http_.get("/spreads?token_ids=" + ids);
+        auto response = send("GET", "/spreads?token_ids=" + join_ids(token_ids, remote));
         if (!response.ok())
-            return result;
+            return compact(slots);
 
         try
         {
             auto j = json::parse(response.body);
             if (j.is_array())
             {
-                for (size_t i = 0; i < j.size() && i < token_ids.size(); i++)
+                for (size_t k = 0; k < j.size() && k < remote.size(); k++)
                 {
-                    SpreadInfo info;
-                    info.token_id = token_ids[i];
-                    info.spread = std::stod(j[i].value("spread", "0"));
-                    result.push_back(info);
+                    const std::string &token_id = token_ids[remote[k]];
+                    slots[remote[k]] = SpreadInfo{token_id, std::stod(j[k].value("spread", "0")), QuoteSource::REST, 0};
                 }
             }
         }
@@ -694,66 +924,205 @@ namespace polymarket
         {
         }
 
-        return result;
+        return compact(slots);
     }
 
     std::optional<TickSizeInfo> ClobClient::get_tick_size(const std::string &token_id)
     {
-        auto response = http_.get("/tick-size?token_id=" + token_id);
+        auto response = send("GET", "/tick-size?token_id=" + token_id);
         if (!response.ok())
             return std::nullopt;
 
-        try
-        {
-            auto j = json::parse(response.body);
-            TickSizeInfo info;
-            info.minimum_tick_size = j.value("minimum_tick_size", "0.01");
-            return info;
-        }
-        catch (...)
-        {
+        auto tick_size = parse_tick_size(response.body);
+        if (!tick_size)
             return std::nullopt;
+
+        {
+            std::unique_lock<std::shared_mutex> lock(metadata_mutex_);
+            metadata_[token_id].tick_size = *tick_size;
         }
+        TickSizeInfo info;
+        info.minimum_tick_size = *tick_size;
+        return info;
     }
 
     std::optional<NegRiskInfo> ClobClient::get_neg_risk(const std::string &token_id)
     {
-        auto response = http_.get("/neg-risk?token_id=" + token_id);
+        auto response = send("GET", "/neg-risk?token_id=" + token_id);
         if (!response.ok())
             return std::nullopt;
 
-        try
-        {
-            auto j = json::parse(response.body);
-            NegRiskInfo info;
-            info.neg_risk = j.value("neg_risk", false);
-            return info;
-        }
-        catch (...)
-        {
+        auto neg_risk = parse_neg_risk(response.body);
+        if (!neg_risk)
             return std::nullopt;
+
+        {
+            std::unique_lock<std::shared_mutex> lock(metadata_mutex_);
+            metadata_[token_id].neg_risk = *neg_risk;
         }
+        NegRiskInfo info;
+        info.neg_risk = *neg_risk;
+        return info;
     }
 
     std::optional<int> ClobClient::get_fee_rate_bps(const std::string &token_id)
     {
-        auto response = http_.get("/fee-rate?token_id=" + token_id);
+        auto response = send("GET", "/fee-rate?token_id=" + token_id);
         if (!response.ok())
             return std::nullopt;
 
-        try
+        auto fee_rate = parse_fee_rate(response.body);
+        if (fee_rate)
         {
-            auto j = json::parse(response.body);
-            if (j.contains("base_fee"))
+            std::unique_lock<std::shared_mutex> lock(metadata_mutex_);
+            metadata_[token_id].fee_rate_bps = *fee_rate;
+        }
+        return fee_rate;
+    }
+
+    void ClobClient::fetch_metadata_async(const std::string &token_id, std::function<void()> done)
+    {
+        TokenMetadata known;
+        {
+            std::shared_lock<std::shared_mutex> lock(metadata_mutex_);
+            auto it = metadata_.find(token_id);
+            if (it != metadata_.end())
+            {
+                known = it->second;
+            }
+        }
+
+        std::vector<std::pair<std::string, std::function<void(const std::string &)>>> requests;
+        if (!known.tick_size)
+        {
+            requests.emplace_back("/tick-size?token_id=" + token_id, [this, token_id](const std::string &body)
+                                  {
+                if (auto tick_size = parse_tick_size(body))
+                {
+                    std::unique_lock<std::shared_mutex> lock(metadata_mutex_);
+                    metadata_[token_id].tick_size = *tick_size;
+                } });
+        }
+        if (!known.neg_risk)
+        {
+            requests.emplace_back("/neg-risk?token_id=" + token_id, [this, token_id](const std::string &body)
+                                  {
+                if (auto neg_risk = parse_neg_risk(body))
+                {
+                    std::unique_lock<std::shared_mutex> lock(metadata_mutex_);
+                    metadata_[token_id].neg_risk = *neg_risk;
+                } });
+        }
+        if (!known.fee_rate_bps)
+        {
+            requests.emplace_back("/fee-rate?token_id=" + token_id, [this, token_id](const std::string &body)
+                                  {
+                if (auto fee_rate = parse_fee_rate(body))
+                {
+                    std::unique_lock<std::shared_mutex> lock(metadata_mutex_);
+                    metadata_[token_id].fee_rate_bps = *fee_rate;
+                } });
+        }
+
+        if (requests.empty())
+        {
+            if (done)
             {
-                return j.value("base_fee", 0);
+                done();
             }
+            return;
+        }
+
+        // Background priority: this must never hold up order traffic on the same connection
+        auto remaining = std::make_shared<std::atomic<size_t>>(requests.size());
+        for (auto &[path, store] : requests)
+        {
+            submit("GET", path, "", {},
+                   [remaining, store = std::move(store), done](HttpResponse response)
+                   {
+                       if (response.ok())
+                       {
+                           store(response.body);
+                       }
+                       if (remaining->fetch_sub(1) == 1 && done)
+                       {
+                           done();
+                       }
+                   },
+                   true);
+        }
+    }
+
+    size_t ClobClient::warm_metadata(const std::vector<std::string> &token_ids)
+    {
+        if (token_ids.empty())
+        {
             return 0;
         }
-        catch (...)
+
+        auto remaining = std::make_shared<std::atomic<size_t>>(token_ids.size());
+        auto finished = std::make_shared<std::promise<void>>();
+        auto all_done = finished->get_future();
+        for (const auto &token_id : token_ids)
+        {
+            fetch_metadata_async(token_id, [remaining, finished]()
+                                 {
+                if (remaining->fetch_sub(1) == 1)
+                {
+                    finished->set_value();
+                } });
+        }
+        all_done.wait();
+
+        size_t complete = 0;
+        std::shared_lock<std::shared_mutex> lock(metadata_mutex_);
+        for (const auto &token_id : token_ids)
+        {
+            auto it = metadata_.find(token_id);
+            if (it != metadata_.end() && it->second.complete())
+            {
+                complete++;
+            }
+        }
+        return complete;
+    }
+
+    std::optional<TokenMetadata> ClobClient::cached_metadata(const std::string &token_id) const
+    {
+        std::shared_lock<std::shared_mutex> lock(metadata_mutex_);
+        auto it = metadata_.find(token_id);
+        if (it == metadata_.end())
         {
             return std::nullopt;
         }
+        return it->second;
+    }
+
+    void ClobClient::on_tick_size_change(const std::string &token_id, const std::string &new_tick_size)
+    {
+        std::unique_lock<std::shared_mutex> lock(metadata_mutex_);
+        if (new_tick_size.empty())
+        {
+            auto it = metadata_.find(token_id);
+            if (it != metadata_.end())
+            {
+                it->second.tick_size.reset();
+            }
+            return;
+        }
+        metadata_[token_id].tick_size = new_tick_size;
+    }
+
+    void ClobClient::invalidate_metadata(const std::string &token_id)
+    {
+        std::unique_lock<std::shared_mutex> lock(metadata_mutex_);
+        metadata_.erase(token_id);
+    }
+
+    void ClobClient::clear_metadata()
+    {
+        std::unique_lock<std::shared_mutex> lock(metadata_mutex_);
+        metadata_.clear();
     }
 
     std::vector<ClobClient::PriceHistoryPoint> ClobClient::get_prices_history(
@@ -773,29 +1142,48 @@ namespace polymarket
         path += "&interval=" + interval;
         path += "&fidelity=" + fidelity;
 
-        auto response = http_.get(path);
-        if (!response.ok())
+        std::vector<uint64_t> timestamps;
+        std::vector<double> prices;
+        if (!fetch_prices_history(path, timestamps, prices))
             return result;
 
-        try
+        result.reserve(timestamps.size());
+        for (size_t i = 0; i < timestamps.size(); i++)
         {
-            auto j = json::parse(response.body);
-            if (j.contains("history") && j["history"].is_array())
-            {
-                for (const auto &item : j["history"])
-                {
-                    PriceHistoryPoint point;
-                    point.timestamp = item.value("t", 0ULL);
-                    point.price = std::stod(item.value("p", "0"));
-                    result.push_back(point);
-                }
-            }
+            result.push_back(PriceHistoryPoint{timestamps[i], prices[i]});
         }
-        catch (...)
+        return result;
+    }
+
+    bool ClobClient::fetch_prices_history(const std::string &path, std::vector<uint64_t> &timestamps,
+                                          std::vector<double> &prices)
+    {
+        auto response = send("GET", path);
+        return response.ok() && parse_price_history(response.body, timestamps, prices);
+    }
+
+    void ClobClient::set_prices_history_cache(const std::string &directory)
+    {
+        history_store_ = directory.empty() ? nullptr : std::make_unique<PriceHistoryStore>(directory);
+    }
+
+    PriceHistoryView ClobClient::get_prices_history_cached(const std::string &token_id, uint64_t start_ts,
+                                                           uint64_t end_ts, int fidelity)
+    {
+        if (!history_store_)
         {
+            throw std::runtime_error("No prices history cache set (see set_prices_history_cache)");
         }
-
-        return result;
+        fidelity = std::max(fidelity, 1);
+        std::string series = token_id + "-" + std::to_string(fidelity) + "m";
+        return history_store_->refresh(
+            series, start_ts, end_ts, now_sec(), static_cast<uint64_t>(fidelity) * 60,
+            [&](uint64_t from, uint64_t to, std::vector<uint64_t> &timestamps, std::vector<double> &prices)
+            {
+                return fetch_prices_history("/prices-history?token_id=" + token_id + "&startTs=" + std::to_string(from) +
+                                                "&endTs=" + std::to_string(to) + "&fidelity=" + std::to_string(fidelity),
+                                            timestamps, prices);
+            });
     }
 
     std::vector<Trade> ClobClient::get_market_trades_events(const std::string &condition_id,
@@ -807,7 +1195,7 @@ namespace polymarket
             path += "&next_cursor=" + next_cursor;
         }
 
-        auto response = http_.get(path);
+        auto response = send("GET", path);
         if (!response.ok())
             return {};
 
@@ -850,7 +1238,7 @@ namespace polymarket
         std::vector<std::string> result;
 
         auto headers = get_l2_headers("GET", "/auth/api-keys", "");
-        auto response = http_.get("/auth/api-keys", headers);
+        auto response = send("GET", "/auth/api-keys", "", headers);
 
         if (!response.ok())
             return result;
@@ -885,56 +1273,147 @@ namespace polymarket
     // AUTHENTICATED ENDPOINTS (L2 - Trading)
     // ============================================================
 
-    SignedOrder ClobClient::create_order(const CreateOrderParams &params)
+    bool ClobClient::is_neg_risk(const std::string &token_id, const std::optional<bool> &cached)
     {
-        if (!order_signer_)
+        // Caller's value first, then the metadata cache, then (if allowed) the API
+        if (cached.has_value())
         {
-            throw std::runtime_error("Client not authenticated");
+            return cached.value();
         }
-
-        // Use cached neg_risk if provided, otherwise fetch from API
-        bool is_neg_risk = false;
-        if (params.neg_risk.has_value())
         {
-            is_neg_risk = params.neg_risk.value();
+            std::shared_lock<std::shared_mutex> lock(metadata_mutex_);
+            auto it = metadata_.find(token_id);
+            if (it != metadata_.end() && it->second.neg_risk)
+            {
+                return *it->second.neg_risk;
+            }
         }
-        else
+        if (!metadata_fallback_.load())
         {
-            auto neg_risk_info = get_neg_risk(params.token_id);
-            is_neg_risk = neg_risk_info && neg_risk_info->neg_risk;
+            fetch_metadata_async(token_id, nullptr);
+            throw std::runtime_error("neg_risk for token " + token_id + " is not cached (warm_metadata first)");
         }
+        auto neg_risk_info = get_neg_risk(token_id);
+        return neg_risk_info && neg_risk_info->neg_risk;
+    }
 
-        std::string exchange_addr = is_neg_risk ? NEG_RISK_EXCHANGE_ADDRESS : EXCHANGE_ADDRESS;
+    std::string ClobClient::order_tick_size(const std::string &token_id)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(metadata_mutex_);
+            auto it = metadata_.find(token_id);
+            if (it != metadata_.end() && it->second.tick_size)
+            {
+                return *it->second.tick_size;
+            }
+        }
+        if (!metadata_fallback_.load())
+        {
+            fetch_metadata_async(token_id, nullptr);
+            throw std::runtime_error("tick size for token " + token_id + " is not cached (warm_metadata first)");
+        }
+        auto tick_size = get_tick_size(token_id);
+        if (!tick_size)
+        {
+            throw std::runtime_error("failed to fetch tick size for token " + token_id);
+        }
+        return tick_size->minimum_tick_size;
+    }
 
-        // Calculate amounts
-        double maker_amount, taker_amount;
-        if (params.side == OrderSide::BUY)
+    int ClobClient::order_fee_rate_bps(const std::string &token_id)
+    {
         {
-            // BUY: maker pays USDC, receives shares
-            maker_amount = params.size * params.price;
-            taker_amount = params.size;
+            std::shared_lock<std::shared_mutex> lock(metadata_mutex_);
+            auto it = metadata_.find(token_id);
+            if (it != metadata_.end() && it->second.fee_rate_bps)
+            {
+                return *it->second.fee_rate_bps;
+            }
         }
-        else
+        if (!metadata_fallback_.load())
         {
-            // SELL: maker pays shares, receives USDC
-            maker_amount = params.size;
-            taker_amount = params.size * params.price;
+            fetch_metadata_async(token_id, nullptr);
+            throw std::runtime_error("fee rate for token " + token_id + " is not cached (warm_metadata first)");
         }
+        auto fee_rate = get_fee_rate_bps(token_id);
+        if (!fee_rate)
+        {
+            throw std::runtime_error("failed to fetch fee rate for token " + token_id);
+        }
+        return *fee_rate;
+    }
+
+    OrderData ClobClient::build_order_data(const CreateOrderParams &params) const
+    {
+        // Notional truncated to a micro, like the order amounts on chain
+        Fixed6 size = Fixed6::from_double(params.size, Rounding::DOWN);
+        Fixed6 notional = Fixed6::mul(size, Fixed6::from_double(params.price), Rounding::DOWN);
+
+        // BUY: maker pays USDC, receives shares. SELL: maker pays shares, receives USDC
+        bool buy = params.side == OrderSide::BUY;
+        Fixed6 maker_amount = buy ? notional : size;
+        Fixed6 taker_amount = buy ? size : notional;
 
         OrderData order_data;
         order_data.maker = funder_address_.empty() ? order_signer_->address() : funder_address_;
         order_data.taker = "0x0000000000000000000000000000000000000000";
         order_data.token_id = params.token_id;
-        order_data.maker_amount = to_wei(maker_amount, 6);
-        order_data.taker_amount = to_wei(taker_amount, 6);
+        order_data.maker_amount = maker_amount.to_wei();
+        order_data.taker_amount = taker_amount.to_wei();
         order_data.side = params.side;
         order_data.fee_rate_bps = params.fee_rate_bps;
         order_data.nonce = params.nonce;
         order_data.signer = order_signer_->address();
         order_data.expiration = params.expiration;
         order_data.signature_type = sig_type_;
+        return order_data;
+    }
 
-        return order_signer_->sign_order(order_data, exchange_addr);
+    SignedOrder ClobClient::create_order(const CreateOrderParams &params)
+    {
+        if (!order_signer_)
+        {
+            throw std::runtime_error("Client not authenticated");
+        }
+
+        const std::string &exchange_addr = is_neg_risk(params.token_id, params.neg_risk) ? NEG_RISK_EXCHANGE_ADDRESS : EXCHANGE_ADDRESS;
+        return order_signer_->sign_order(build_order_data(params), exchange_addr);
+    }
+
+    std::vector<SignedOrder> ClobClient::create_orders(const std::vector<CreateOrderParams> &params)
+    {
+        if (!order_signer_)
+        {
+            throw std::runtime_error("Client not authenticated");
+        }
+
+        // Resolve neg_risk up front (one lookup per distinct token), then sign the whole batch in parallel
+        std::map<std::string, bool> neg_risk_by_token;
+        std::vector<OrderData> orders;
+        std::vector<std::string> exchanges;
+        orders.reserve(params.size());
+        exchanges.reserve(params.size());
+        for (const auto &p : params)
+        {
+            bool neg_risk;
+            if (p.neg_risk.has_value())
+            {
+                neg_risk = *p.neg_risk;
+            }
+            else
+            {
+                auto it = neg_risk_by_token.find(p.token_id);
+                if (it == neg_risk_by_token.end())
+                {
+                    it = neg_risk_by_token.emplace(p.token_id, is_neg_risk(p.token_id, std::nullopt)).first;
+                }
+                neg_risk = it->second;
+            }
+            exchanges.push_back(neg_risk ? NEG_RISK_EXCHANGE_ADDRESS : EXCHANGE_ADDRESS);
+            orders.push_back(build_order_data(p));
+        }
+
+        return order_signer_->sign_orders(orders, exchanges);
     }
 
     SignedOrder ClobClient::create_market_order(const CreateMarketOrderParams &params)
@@ -986,11 +1465,9 @@ namespace polymarket
             throw std::runtime_error("Client not authenticated");
         }
 
-        std::string min_tick_size = "0.01";
-        // if (auto tick_info = get_tick_size(params.token_id))
-        // {
-        //     min_tick_size = tick_info->minimum_tick_size;
-        // }
+        // Signed over the market's own tick size and fee rate, never over guessed defaults
+        std::string min_tick_size = order_tick_size(params.token_id);
+        int market_fee_rate_bps = order_fee_rate_bps(params.token_id);
 
         std::string tick_size = min_tick_size;
         if (params.tick_size.has_value() && !params.tick_size->empty())
@@ -1019,64 +1496,25 @@ namespace polymarket
                                      " - max: " + std::to_string(1.0 - std::stod(tick_size)));
         }
 
-        bool is_neg_risk = false;
-        if (params.neg_risk.has_value())
-        {
-            is_neg_risk = params.neg_risk.value();
-        }
-        else
-        {
-            auto neg_risk_info = get_neg_risk(params.token_id);
-            is_neg_risk = neg_risk_info && neg_risk_info->neg_risk;
-        }
-
-        constexpr int market_fee_rate_bps = 1000; // TODO
-        // if (auto fee_rate = get_fee_rate_bps(params.token_id))
-        // {
-        //     market_fee_rate_bps = *fee_rate;
-        // }
+        bool neg_risk = is_neg_risk(params.token_id, params.neg_risk);
 
-        std::string exchange_addr = is_neg_risk ? NEG_RISK_EXCHANGE_ADDRESS : EXCHANGE_ADDRESS;
+        std::string exchange_addr = neg_risk ? NEG_RISK_EXCHANGE_ADDRESS : EXCHANGE_ADDRESS;
         RoundConfig round_config = get_round_config(tick_size);
-        double raw_price = round_normal(price, round_config.price);
-
-        double raw_maker_amt = round_down(params.amount, round_config.size);
-        double raw_taker_amt = 0.0;
-        if (params.side == OrderSide::BUY)
-        {
-            raw_taker_amt = raw_maker_amt / raw_price;
-            if (decimal_places(raw_taker_amt) > round_config.amount)
-            {
-                raw_taker_amt = round_up(raw_taker_amt, round_config.amount + 4);
-                if (decimal_places(raw_taker_amt) > round_config.amount)
-                {
-                    raw_taker_amt = round_down(raw_taker_amt, round_config.amount);
-                }
-            }
-        }
-        else if (params.side == OrderSide::SELL)
-        {
-            raw_taker_amt = raw_maker_amt * raw_price;
-            if (decimal_places(raw_taker_amt) > round_config.amount)
-            {
-                raw_taker_amt = round_up(raw_taker_amt, round_config.amount + 4);
-                if (decimal_places(raw_taker_amt) > round_config.amount)
-                {
-                    raw_taker_amt = round_down(raw_taker_amt, round_config.amount);
-                }
-            }
-        }
-        else
+        Fixed6 raw_price = Fixed6::from_double(price).round(round_config.price, Rounding::NEAREST);
+        if (params.side != OrderSide::BUY && params.side != OrderSide::SELL)
         {
             throw std::runtime_error("invalid order side");
         }
 
+        Fixed6 raw_maker_amt = Fixed6::from_double(params.amount, Rounding::DOWN).round(round_config.size, Rounding::DOWN);
+        Fixed6 raw_taker_amt = market_taker_amount(params.side, raw_maker_amt, raw_price, round_config.amount);
+
         OrderData order_data;
         order_data.maker = funder_address_.empty() ? order_signer_->address() : funder_address_;
         order_data.taker = params.taker.empty() ? "0x0000000000000000000000000000000000000000" : params.taker;
         order_data.token_id = params.token_id;
-        order_data.maker_amount = to_wei(raw_maker_amt, 6);
-        order_data.taker_amount = to_wei(raw_taker_amt, 6);
+        order_data.maker_amount = raw_maker_amt.to_wei();
+        order_data.taker_amount = raw_taker_amt.to_wei();
         order_data.side = params.side;
         std::string fee_rate_bps = params.fee_rate_bps.empty() ? "0" : params.fee_rate_bps;
         if (market_fee_rate_bps > 0)
@@ -1110,7 +1548,7 @@ namespace polymarket
         return order_signer_->sign_order(order_data, exchange_addr);
     }
 
-    OrderResponse ClobClient::post_order(const SignedOrder &order, OrderType order_type, bool post_only)
+    const std::string &ClobClient::order_body(const SignedOrder &order, OrderType order_type, bool post_only) const
     {
         if (post_only && order_type != OrderType::GTC && order_type != OrderType::GTD)
         {
@@ -1121,45 +1559,13 @@ namespace polymarket
             throw std::runtime_error("Client not authenticated");
         }
 
-        nlohmann::ordered_json body;
-        nlohmann::ordered_json order_json;
-        order_json["salt"] = std::stoll(order.salt);
-        order_json["maker"] = order.maker;
-        order_json["signer"] = order.signer;
-        order_json["taker"] = order.taker;
-        order_json["tokenId"] = order.token_id;
-        order_json["makerAmount"] = order.maker_amount;
-        order_json["takerAmount"] = order.taker_amount;
-        order_json["side"] = order.side == 0 ? "BUY" : "SELL";
-        order_json["expiration"] = order.expiration;
-        order_json["nonce"] = order.nonce;
-        order_json["feeRateBps"] = order.fee_rate_bps;
-        order_json["signatureType"] = order.signature_type;
-        order_json["signature"] = order.signature;
-
-        body["order"] = order_json;
-        body["owner"] = api_creds_->api_key;
-        body["orderType"] = order_type_to_string(order_type);
-        body["deferExec"] = false;
-        if (post_only)
-        {
-            body["postOnly"] = true;
-        }
-
-        std::string body_str = body.dump();
-        auto headers = get_l2_headers("POST", "/order", body_str);
-        auto response = http_.post("/order", body_str, headers);
-
-        return parse_order_response(response.body);
+        std::string &body = order_body_buffer();
+        append_order_payload(body, order, api_creds_->api_key, order_type_to_string(order_type), post_only);
+        return body;
     }
 
-    std::vector<OrderResponse> ClobClient::post_orders(const std::vector<BatchOrderEntry> &orders, bool post_only)
+    const std::string &ClobClient::orders_body(const std::vector<BatchOrderEntry> &orders, bool post_only) const
     {
-        std::vector<OrderResponse> results;
-
-        if (orders.empty())
-            return results;
-
         if (post_only)
         {
             for (const auto &entry : orders)
@@ -1175,57 +1581,123 @@ namespace polymarket
             throw std::runtime_error("Client not authenticated");
         }
 
-        nlohmann::ordered_json body = nlohmann::ordered_json::array();
+        std::string &body = order_body_buffer();
+        body += '[';
         for (const auto &entry : orders)
         {
-            nlohmann::ordered_json order_json;
-            nlohmann::ordered_json signed_json;
-            signed_json["salt"] = std::stoll(entry.order.salt);
-            signed_json["maker"] = entry.order.maker;
-            signed_json["signer"] = entry.order.signer;
-            signed_json["taker"] = entry.order.taker;
-            signed_json["tokenId"] = entry.order.token_id;
-            signed_json["makerAmount"] = entry.order.maker_amount;
-            signed_json["takerAmount"] = entry.order.taker_amount;
-            signed_json["side"] = entry.order.side == 0 ? "BUY" : "SELL";
-            signed_json["expiration"] = entry.order.expiration;
-            signed_json["nonce"] = entry.order.nonce;
-            signed_json["feeRateBps"] = entry.order.fee_rate_bps;
-            signed_json["signatureType"] = entry.order.signature_type;
-            signed_json["signature"] = entry.order.signature;
-            order_json["order"] = signed_json;
-            order_json["owner"] = api_creds_->api_key;
-            order_json["orderType"] = order_type_to_string(entry.order_type);
-            order_json["deferExec"] = false;
-            if (post_only)
-            {
-                order_json["postOnly"] = true;
-            }
-            body.push_back(order_json);
+            if (body.size() > 1)
+            {
+                body += ',';
+            }
+            append_order_payload(body, entry.order, api_creds_->api_key, order_type_to_string(entry.order_type), post_only);
         }
+        body += ']';
+        return body;
+    }
 
-        std::string body_str = body.dump();
+    OrderResponse ClobClient::post_order(const SignedOrder &order, OrderType order_type, bool post_only)
+    {
+        const std::string &body_str = order_body(order, order_type, post_only);
+        auto headers = get_l2_headers("POST", "/order", body_str);
+        auto response = send("POST", "/order", body_str, headers);
+
+        return parse_order_response(response.body);
+    }
+
+    std::vector<OrderResponse> ClobClient::post_orders(const std::vector<BatchOrderEntry> &orders, bool post_only)
+    {
+        if (orders.empty())
+            return {};
+
+        const std::string &body_str = orders_body(orders, post_only);
         auto headers = get_l2_headers("POST", "/orders", body_str);
-        auto response = http_.post("/orders", body_str, headers);
+        auto response = send("POST", "/orders", body_str, headers);
 
-        try
+        return parse_order_responses(response.body);
+    }
+
+    std::future<OrderResponse> ClobClient::post_order_async(const SignedOrder &order, OrderType order_type, bool post_only)
+    {
+        std::string body = order_body(order, order_type, post_only);
+        auto headers = get_l2_headers("POST", "/order", body);
+
+        auto promise = std::make_shared<std::promise<OrderResponse>>();
+        auto future = promise->get_future();
+        submit("POST", "/order", std::move(body), headers, [promise](HttpResponse response)
+                            {
+            OrderResponse result = parse_order_response(response.body);
+            if (!response.error.empty() && result.error_msg.empty())
+            {
+                result.error_msg = response.error;
+            }
+            promise->set_value(std::move(result)); });
+        return future;
+    }
+
+    std::future<std::vector<OrderResponse>> ClobClient::post_orders_async(const std::vector<BatchOrderEntry> &orders, bool post_only)
+    {
+        auto promise = std::make_shared<std::promise<std::vector<OrderResponse>>>();
+        auto future = promise->get_future();
+        if (orders.empty())
         {
-            auto j = json::parse(response.body);
-            if (j.is_array())
+            promise->set_value({});
+            return future;
+        }
+
+        std::string body = orders_body(orders, post_only);
+        auto headers = get_l2_headers("POST", "/orders", body);
+        submit("POST", "/orders", std::move(body), headers, [promise, count = orders.size()](HttpResponse response)
+                            {
+            if (!response.error.empty() && response.body.empty())
             {
-                for (const auto &item : j)
+                // Transport error: nothing came back, so every order in the batch failed with it
+                OrderResponse failed{};
+                failed.success = false;
+                failed.error_msg = response.error;
+                promise->set_value(std::vector<OrderResponse>(count, failed));
+                return;
+            }
+            std::vector<OrderResponse> results = parse_order_responses(response.body);
+            for (auto &result : results)
+            {
+                if (!response.error.empty() && result.error_msg.empty())
                 {
-                    results.push_back(parse_order_response(item.dump()));
+                    result.error_msg = response.error;
                 }
             }
-        }
-        catch (...)
+            promise->set_value(std::move(results)); });
+        return future;
+    }
+
+    std::future<bool> ClobClient::cancel_order_async(const std::string &order_id)
+    {
+        json body;
+        body["orderID"] = order_id;
+        std::string body_str = body.dump();
+        auto headers = get_l2_headers("DELETE", "/order", body_str);
+
+        auto promise = std::make_shared<std::promise<bool>>();
+        auto future = promise->get_future();
+        submit("DELETE", "/order", std::move(body_str), headers, [promise](HttpResponse response)
+                            { promise->set_value(response.ok()); });
+        return future;
+    }
+
+    std::future<CancelResponse> ClobClient::cancel_orders_async(const std::vector<std::string> &order_ids)
+    {
+        auto promise = std::make_shared<std::promise<CancelResponse>>();
+        auto future = promise->get_future();
+        if (order_ids.empty())
         {
-            // Single error response
-            results.push_back(parse_order_response(response.body));
+            promise->set_value(CancelResponse{true, {}, {}});
+            return future;
         }
 
-        return results;
+        std::string body = json(order_ids).dump();
+        auto headers = get_l2_headers("DELETE", "/orders", body);
+        submit("DELETE", "/orders", std::move(body), headers, [promise](HttpResponse response)
+                            { promise->set_value(response.ok() ? parse_cancel_response(response.body) : CancelResponse{}); });
+        return future;
     }
 
     OrderResponse ClobClient::create_and_post_order(const CreateOrderParams &params, OrderType order_type)
@@ -1234,6 +1706,19 @@ namespace polymarket
         return post_order(signed_order, order_type);
     }
 
+    std::vector<OrderResponse> ClobClient::create_and_post_orders(const std::vector<CreateOrderParams> &params,
+                                                                  OrderType order_type, bool post_only)
+    {
+        auto signed_orders = create_orders(params);
+        std::vector<BatchOrderEntry> entries;
+        entries.reserve(signed_orders.size());
+        for (auto &order : signed_orders)
+        {
+            entries.push_back(BatchOrderEntry{std::move(order), order_type});
+        }
+        return post_orders(entries, post_only);
+    }
+
     OrderResponse ClobClient::create_and_post_market_order(const CreateMarketOrderParams &params, OrderType order_type)
     {
         auto signed_order = create_market_order(params);
@@ -1254,8 +1739,8 @@ namespace polymarket
         std::string body_str = body.dump();
         auto headers = get_l2_headers("DELETE", "/order", body_str);
 
-        // Use POST with body for cancel (API accepts this)
-        auto response = http_.post("/order", body_str, headers);
+        // Use POST with body for cancel (API accepts this); still a cancel for rate limiting
+        auto response = send(RequestLane::CANCEL, "DELETE", "POST", "/order", body_str, headers);
         return response.ok();
     }
 
@@ -1266,14 +1751,14 @@ namespace polymarket
         std::string body_str = body.dump();
         auto headers = get_l2_headers("DELETE", "/orders", body_str);
 
-        auto response = http_.post("/orders", body_str, headers);
+        auto response = send(RequestLane::CANCEL, "DELETE", "POST", "/orders", body_str, headers);
         return response.ok();
     }
 
     bool ClobClient::cancel_all()
     {
         auto headers = get_l2_headers("DELETE", "/cancel-all", "");
-        auto response = http_.post("/cancel-all", "{}", headers);
+        auto response = send("POST", "/cancel-all", "{}", headers);
         return response.ok();
     }
 
@@ -1285,14 +1770,14 @@ namespace polymarket
         std::string body_str = body.dump();
         auto headers = get_l2_headers("DELETE", "/cancel-market-orders", body_str);
 
-        auto response = http_.post("/cancel-market-orders", body_str, headers);
+        auto response = send("POST", "/cancel-market-orders", body_str, headers);
         return response.ok();
     }
 
     std::optional<OpenOrder> ClobClient::get_order(const std::string &order_id)
     {
         auto headers = get_l2_headers("GET", "/order/" + order_id, "");
-        auto response = http_.get("/order/" + order_id, headers);
+        auto response = send("GET", "/order/" + order_id, "", headers);
 
         if (!response.ok())
             return std::nullopt;
@@ -1313,7 +1798,7 @@ namespace polymarket
         }
 
         auto headers = get_l2_headers("GET", path, "");
-        auto response = http_.get(path, headers);
+        auto response = send("GET", path, "", headers);
 
         if (!response.ok())
             return {};
@@ -1330,7 +1815,7 @@ namespace polymarket
         }
 
         auto headers = get_l2_headers("GET", path, "");
-        auto response = http_.get(path, headers);
+        auto response = send("GET", path, "", headers);
 
         if (!response.ok())
             return {};
@@ -1344,7 +1829,7 @@ namespace polymarket
         std::string sig_type = std::to_string(static_cast<int>(sig_type_));
         std::string path_with_params = base_path + "?asset_type=COLLATERAL&signature_type=" + sig_type;
         auto headers = get_l2_headers("GET", base_path, "");
-        auto response = http_.get(path_with_params, headers);
+        auto response = send("GET", path_with_params, "", headers);
 
         if (!response.ok())
             return std::nullopt;
@@ -1371,7 +1856,7 @@ namespace polymarket
         std::string body_str = body.dump();
         auto headers = get_l2_headers("POST", "/balance-allowance", body_str);
 
-        auto response = http_.post("/balance-allowance", body_str, headers);
+        auto response = send("POST", "/balance-allowance", body_str, headers);
         return response.ok();
     }
 
@@ -1381,7 +1866,7 @@ namespace polymarket
         body["orderId"] = order.salt; // Use salt as order identifier for scoring check
 
         std::string body_str = body.dump();
-        auto response = http_.post("/order-scoring", body_str);
+        auto response = send("POST", "/order-scoring", body_str);
 
         if (!response.ok())
             return std::nullopt;
@@ -1410,7 +1895,7 @@ namespace polymarket
         }
 
         std::string body_str = body.dump();
-        auto response = http_.post("/orders-scoring", body_str);
+        auto response = send("POST", "/orders-scoring", body_str);
 
         if (!response.ok())
             return results;
@@ -1440,7 +1925,7 @@ namespace polymarket
         std::vector<Notification> result;
 
         auto headers = get_l2_headers("GET", "/notifications", "");
-        auto response = http_.get("/notifications", headers);
+        auto response = send("GET", "/notifications", "", headers);
 
         if (!response.ok())
             return result;
@@ -1475,7 +1960,7 @@ namespace polymarket
         std::string body_str = body.dump();
         auto headers = get_l2_headers("DELETE", "/notifications", body_str);
 
-        auto response = http_.post("/notifications", body_str, headers);
+        auto response = send("POST", "/notifications", body_str, headers);
         return response.ok();
     }
 
@@ -1483,7 +1968,7 @@ namespace polymarket
     {
         std::vector<RewardsInfo> result;
 
-        auto response = http_.get("/rewards/markets/current");
+        auto response = send("GET", "/rewards/markets/current");
         if (!response.ok())
             return result;
 
@@ -1520,7 +2005,7 @@ namespace polymarket
             path += "?epoch=" + epoch;
         }
 
-        auto response = http_.get(path);
+        auto response = send("GET", path);
         if (!response.ok())
             return result;
 
@@ -1556,7 +2041,7 @@ namespace polymarket
         }
 
         auto headers = get_l2_headers("GET", path, "");
-        auto response = http_.get(path, headers);
+        auto response = send("GET", path, "", headers);
 
         if (!response.ok())
             return std::nullopt;
@@ -1585,7 +2070,7 @@ namespace polymarket
         }
 
         auto headers = get_l2_headers("GET", path, "");
-        auto response = http_.get(path, headers);
+        auto response = send("GET", path, "", headers);
 
         if (!response.ok())
             return std::nullopt;
@@ -1607,7 +2092,7 @@ namespace polymarket
     std::optional<ClobClient::FeeRateInfo> ClobClient::get_fee_rate()
     {
         auto headers = get_l2_headers("GET", "/fee-rate", "");
-        auto response = http_.get("/fee-rate", headers);
+        auto response = send("GET", "/fee-rate", "", headers);
 
         if (!response.ok())
             return std::nullopt;
@@ -1643,12 +2128,8 @@ namespace polymarket
             return result;
         }
 
-        // Use a separate HTTP client for Data API
-        HttpClient data_http;
-        data_http.set_base_url(DATA_API_URL);
-        data_http.set_timeout_ms(10000);
-
-        auto response = data_http.get("/positions?user=" + address);
+        // Persistent Data API client from the shared pool, so repeat calls skip DNS and the TLS handshake
+        auto response = HttpPool::global().client(DATA_API_URL).get("/positions?user=" + address);
         if (!response.ok())
         {
             return result;
@@ -1733,78 +2214,8 @@ namespace polymarket
     std::vector<ClobMarket> ClobClient::parse_markets(const std::string &json_str)
     {
         std::vector<ClobMarket> markets;
-
-        try
-        {
-            auto j = json::parse(json_str);
-
-            json market_array;
-            if (j.is_array())
-            {
-                market_array = j;
-            }
-            else if (j.contains("data") && j["data"].is_array())
-            {
-                market_array = j["data"];
-            }
-            else
-            {
-                return markets;
-            }
-
-            for (const auto &item : market_array)
-            {
-                ClobMarket market;
-
-                if (item.contains("condition_id"))
-                {
-                    market.condition_id = item["condition_id"].get<std::string>();
-                }
-                if (item.contains("question") && !item["question"].is_null())
-                {
-                    market.question = item["question"].get<std::string>();
-                }
-                if (item.contains("market_slug") && !item["market_slug"].is_null())
-                {
-                    market.market_slug = item["market_slug"].get<std::string>();
-                }
-                if (item.contains("neg_risk"))
-                {
-                    market.neg_risk = item["neg_risk"].get<bool>();
-                }
-                if (item.contains("active"))
-                {
-                    market.active = item["active"].get<bool>();
-                }
-                if (item.contains("closed"))
-                {
-                    market.closed = item["closed"].get<bool>();
-                }
-
-                if (item.contains("tokens") && item["tokens"].is_array())
-                {
-                    for (const auto &t : item["tokens"])
-                    {
-                        Token token;
-                        if (t.contains("token_id"))
-                        {
-                            token.token_id = t["token_id"].get<std::string>();
-                        }
-                        if (t.contains("outcome"))
-                        {
-                            token.outcome = t["outcome"].get<std::string>();
-                        }
-                        market.tokens.push_back(token);
-                    }
-                }
-
-                markets.push_back(std::move(market));
-            }
-        }
-        catch (...)
-        {
-        }
-
+        std::string next_cursor;
+        MarketPager::parse_page(json_str, MarketFilter{}, markets, next_cursor);
         return markets;
     }
 
@@ -1852,6 +2263,28 @@ namespace polymarket
         }
     }
 
+    std::vector<OrderResponse> ClobClient::parse_order_responses(const std::string &json_str)
+    {
+        std::vector<OrderResponse> results;
+        try
+        {
+            auto j = json::parse(json_str);
+            if (j.is_array())
+            {
+                for (const auto &item : j)
+                {
+                    results.push_back(parse_order_response(item.dump()));
+                }
+            }
+        }
+        catch (...)
+        {
+            // Single error response
+            results.push_back(parse_order_response(json_str));
+        }
+        return results;
+    }
+
     OrderResponse ClobClient::parse_order_response(const std::string &json_str)
     {
         OrderResponse result;
@@ -1975,4 +2408,34 @@ namespace polymarket
         return trades;
     }
 
+    CancelResponse ClobClient::parse_cancel_response(const std::string &json_str)
+    {
+        CancelResponse result;
+
+        try
+        {
+            auto j = json::parse(json_str);
+            if (j.contains("canceled") && j["canceled"].is_array())
+            {
+                for (const auto &id : j["canceled"])
+                {
+                    result.canceled.push_back(id.get<std::string>());
+                }
+            }
+            if (j.contains("not_canceled") && j["not_canceled"].is_object())
+            {
+                for (const auto &[id, reason] : j["not_canceled"].items())
+                {
+                    result.not_canceled[id] = reason.is_string() ? reason.get<std::string>() : reason.dump();
+                }
+            }
+            result.success = true;
+        }
+        catch (...)
+        {
+        }
+
+        return result;
+    }
+
 } // namespace polymarket
@@ -0,0 +1,92 @@
+#include "depth_profile.hpp"
+#include <algorithm>
+
+namespace polymarket
+{
+
+    void DepthProfile::build(const std::vector<PriceLevel> &levels)
+    {
+        count = static_cast<uint32_t>(std::min(levels.size(), kDepthLevels));
+        double size = 0.0;
+        double notional = 0.0;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            size += levels[i].size;
+            notional += levels[i].price * levels[i].size;
+            price[i] = levels[i].price;
+            cum_size[i] = size;
+            cum_notional[i] = notional;
+        }
+    }
+
+    uint32_t DepthProfile::level_for(double size) const
+    {
+        return static_cast<uint32_t>(std::lower_bound(cum_size, cum_size + count, size) - cum_size);
+    }
+
+    double DepthProfile::cost(double size) const
+    {
+        uint32_t level = level_for(size);
+        if (level >= count)
+        {
+            return count ? cum_notional[count - 1] : 0.0;
+        }
+        double before_size = level ? cum_size[level - 1] : 0.0;
+        double before_notional = level ? cum_notional[level - 1] : 0.0;
+        return before_notional + (size - before_size) * price[level];
+    }
+
+    double DepthProfile::vwap(double size) const
+    {
+        double filled = std::min(size, total_size());
+        return filled > 0.0 ? cost(filled) / filled : 0.0;
+    }
+
+    double DepthProfile::limit_price(double size) const
+    {
+        if (count == 0)
+        {
+            return 0.0;
+        }
+        return price[std::min(level_for(size), count - 1)];
+    }
+
+    ArbSizing size_pair_arb(const DepthProfile &yes_asks, const DepthProfile &no_asks, double threshold)
+    {
+        ArbSizing sizing;
+
+        // Each step extends the fill to the next level boundary on either side
+        uint32_t i = 0;
+        uint32_t j = 0;
+        double size = 0.0;
+        while (i < yes_asks.count && j < no_asks.count && yes_asks.price[i] + no_asks.price[j] < threshold)
+        {
+            size = std::min(yes_asks.cum_size[i], no_asks.cum_size[j]);
+            if (yes_asks.cum_size[i] <= size)
+            {
+                i++;
+            }
+            if (no_asks.cum_size[j] <= size)
+            {
+                j++;
+            }
+        }
+
+        if (size <= 0.0)
+        {
+            return sizing;
+        }
+
+        double cost_yes = yes_asks.cost(size);
+        double cost_no = no_asks.cost(size);
+        sizing.size = size;
+        sizing.vwap_yes = cost_yes / size;
+        sizing.vwap_no = cost_no / size;
+        sizing.limit_yes = yes_asks.limit_price(size);
+        sizing.limit_no = no_asks.limit_price(size);
+        sizing.cost = cost_yes + cost_no;
+        sizing.edge = size - sizing.cost;
+        return sizing;
+    }
+
+} // namespace polymarket
@@ -0,0 +1,216 @@
+#include "event_arb.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace polymarket
+{
+
+    namespace
+    {
+        constexpr double kMicrosPerUnit = 1e6;
+
+        int64_t to_micros(double price)
+        {
+            return std::llround(price * kMicrosPerUnit);
+        }
+
+        // Copy up to kSnapshotDepth best-first levels
+        uint32_t copy_levels(const std::vector<PriceLevel> &from, PriceLevel *to)
+        {
+            uint32_t count = static_cast<uint32_t>(std::min(from.size(), kSnapshotDepth));
+            std::copy_n(from.begin(), count, to);
+            return count;
+        }
+
+        // Keep an event sum in step with one leg's best price (0 = side empty)
+        void update_sum(int64_t &best, int64_t next, int64_t &sum, uint32_t &legs_without)
+        {
+            if (best == 0 && next != 0)
+            {
+                legs_without--;
+            }
+            else if (best != 0 && next == 0)
+            {
+                legs_without++;
+            }
+            sum += next - best;
+            best = next;
+        }
+    } // namespace
+
+    EventArbScanner::EventArbScanner(double buy_trigger, double sell_trigger)
+    {
+        set_triggers(buy_trigger, sell_trigger);
+    }
+
+    void EventArbScanner::set_triggers(double buy_trigger, double sell_trigger)
+    {
+        buy_trigger_micros_ = to_micros(buy_trigger);
+        sell_trigger_micros_ = to_micros(sell_trigger);
+    }
+
+    size_t EventArbScanner::add_event(const std::string &event_id, const std::vector<TokenHandle> &yes_tokens)
+    {
+        if (yes_tokens.empty())
+        {
+            return kRejectedEvent;
+        }
+        for (size_t i = 0; i < yes_tokens.size(); i++)
+        {
+            TokenHandle token = yes_tokens[i];
+            if (token == kInvalidToken || (token < leg_by_token_.size() && leg_by_token_[token] != kNoLeg) ||
+                std::find(yes_tokens.begin(), yes_tokens.begin() + i, token) != yes_tokens.begin() + i)
+            {
+                return kRejectedEvent;
+            }
+        }
+
+        uint32_t event_index = static_cast<uint32_t>(events_.size());
+        Event &event = events_.emplace_back();
+        event.id = event_id;
+
+        for (TokenHandle token : yes_tokens)
+        {
+            if (leg_by_token_.size() <= token)
+            {
+                leg_by_token_.resize(token + 1, kNoLeg);
+            }
+
+            leg_by_token_[token] = static_cast<uint32_t>(legs_.size());
+            event.legs.push_back(static_cast<uint32_t>(legs_.size()));
+            Leg &leg = legs_.emplace_back();
+            leg.token = token;
+            leg.event = event_index;
+        }
+
+        event.legs_without_ask = static_cast<uint32_t>(event.legs.size());
+        event.legs_without_bid = static_cast<uint32_t>(event.legs.size());
+        if (event.legs.size() > fills_.capacity())
+        {
+            fills_.reserve(event.legs.size());
+            walk_level_.reserve(event.legs.size());
+            walk_left_.reserve(event.legs.size());
+        }
+        return event_index;
+    }
+
+    void EventArbScanner::clear()
+    {
+        legs_.clear();
+        events_.clear();
+        leg_by_token_.clear();
+    }
+
+    double EventArbScanner::sum_asks(size_t event) const
+    {
+        const Event &e = events_[event];
+        return e.legs_without_ask == 0 ? e.sum_ask_micros / kMicrosPerUnit : 0.0;
+    }
+
+    double EventArbScanner::sum_bids(size_t event) const
+    {
+        const Event &e = events_[event];
+        return e.legs_without_bid == 0 ? e.sum_bid_micros / kMicrosPerUnit : 0.0;
+    }
+
+    void EventArbScanner::update(TokenHandle token, const Orderbook &book)
+    {
+        if (token >= leg_by_token_.size() || leg_by_token_[token] == kNoLeg)
+        {
+            return;
+        }
+
+        Leg &leg = legs_[leg_by_token_[token]];
+        leg.ask_count = copy_levels(book.asks, leg.asks);
+        leg.bid_count = copy_levels(book.bids, leg.bids);
+
+        Event &event = events_[leg.event];
+        update_sum(leg.best_ask_micros, leg.ask_count ? to_micros(leg.asks[0].price) : 0, event.sum_ask_micros,
+                   event.legs_without_ask);
+        update_sum(leg.best_bid_micros, leg.bid_count ? to_micros(leg.bids[0].price) : 0, event.sum_bid_micros,
+                   event.legs_without_bid);
+
+        if (event.legs.size() < 2)
+        {
+            return;
+        }
+        if (event.legs_without_ask == 0 && event.sum_ask_micros < buy_trigger_micros_)
+        {
+            check(leg.event, true);
+        }
+        if (event.legs_without_bid == 0 && event.sum_bid_micros > sell_trigger_micros_)
+        {
+            check(leg.event, false);
+        }
+    }
+
+    void EventArbScanner::check(uint32_t event_index, bool buy)
+    {
+        const Event &event = events_[event_index];
+        size_t n = event.legs.size();
+        double trigger = (buy ? buy_trigger_micros_ : sell_trigger_micros_) / kMicrosPerUnit;
+
+        fills_.clear();
+        walk_level_.assign(n, 0);
+        walk_left_.clear();
+
+        // Marginal basket price: sum over legs of the price at the level currently being filled
+        double marginal = 0.0;
+        for (uint32_t leg_index : event.legs)
+        {
+            const Leg &leg = legs_[leg_index];
+            const PriceLevel &best = buy ? leg.asks[0] : leg.bids[0];
+            marginal += best.price;
+            walk_left_.push_back(best.size);
+            fills_.push_back({leg.token, best.price, best.price});
+        }
+        double sum_best = marginal;
+
+        // Take baskets while the marginal price stays past the trigger, one level boundary at a time,
+        // until some leg runs out of known depth
+        double size = 0.0;
+        double notional = 0.0;
+        bool exhausted = false;
+        while (!exhausted && (buy ? marginal < trigger : marginal > trigger))
+        {
+            double step = *std::min_element(walk_left_.begin(), walk_left_.end());
+            size += step;
+            notional += step * marginal;
+
+            for (size_t i = 0; i < n; i++)
+            {
+                const Leg &leg = legs_[event.legs[i]];
+                const PriceLevel *levels = buy ? leg.asks : leg.bids;
+                uint32_t count = buy ? leg.ask_count : leg.bid_count;
+
+                fills_[i].limit_price = levels[walk_level_[i]].price;
+                walk_left_[i] -= step;
+                if (walk_left_[i] > 0.0)
+                {
+                    continue;
+                }
+                if (++walk_level_[i] >= count)
+                {
+                    exhausted = true;
+                    continue;
+                }
+                marginal += levels[walk_level_[i]].price - levels[walk_level_[i] - 1].price;
+                walk_left_[i] = levels[walk_level_[i]].size;
+            }
+        }
+
+        if (size <= 0.0)
+        {
+            return;
+        }
+
+        opportunities_++;
+        if (on_opportunity_cb_)
+        {
+            EventArbOpportunity opportunity{event.id, event_index, buy, sum_best, size, notional,
+                                            buy ? size - notional : notional - size, fills_};
+            on_opportunity_cb_(opportunity);
+        }
+    }
+
+} // namespace polymarket
@@ -0,0 +1,233 @@
+#include "feed_log.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace polymarket
+{
+
+    namespace
+    {
+        constexpr char kMagic[8] = {'P', 'M', 'F', 'E', 'E', 'D', '0', '1'};
+        constexpr size_t kFileHeaderSize = 16;
+
+        struct RecordHeader
+        {
+            uint32_t length; // Frame bytes; 0 marks the end of a file that was not closed cleanly
+            uint32_t shard;
+            uint64_t receive_ns;
+        };
+        static_assert(sizeof(RecordHeader) == 16, "record header layout is part of the file format");
+
+        size_t padded(size_t length)
+        {
+            return (length + 7) & ~size_t(7);
+        }
+
+        std::runtime_error io_error(const std::string &what, const std::string &path)
+        {
+            return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+        }
+    } // namespace
+
+    FeedRecorder::FeedRecorder(const std::string &path, size_t chunk_bytes)
+        : chunk_bytes_(std::max<size_t>(padded(chunk_bytes), 4096))
+    {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0)
+        {
+            throw io_error("Failed to create feed log", path);
+        }
+        try
+        {
+            grow(kFileHeaderSize);
+        }
+        catch (...)
+        {
+            ::close(fd_);
+            throw;
+        }
+        std::memcpy(base_, kMagic, sizeof(kMagic));
+        size_ = kFileHeaderSize;
+    }
+
+    FeedRecorder::~FeedRecorder()
+    {
+        if (base_)
+        {
+            ::munmap(base_, capacity_);
+        }
+        if (fd_ >= 0)
+        {
+            // Drop the unused tail of the last chunk
+            if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0)
+            {
+                // Nothing to do from a destructor; readers stop at the zeroed tail anyway
+            }
+            ::close(fd_);
+        }
+    }
+
+    void FeedRecorder::grow(size_t needed)
+    {
+        size_t capacity = capacity_;
+        while (capacity < needed)
+        {
+            capacity += chunk_bytes_;
+        }
+        // Allocate the blocks up front: a sparse extension would turn a full disk into SIGBUS on the next write
+        // through the mapping instead of an error here
+        int err = ::posix_fallocate(fd_, static_cast<off_t>(capacity_), static_cast<off_t>(capacity - capacity_));
+        if (err != 0)
+        {
+            errno = err;
+            throw io_error("Failed to extend feed log", "fd " + std::to_string(fd_));
+        }
+        void *base = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (base == MAP_FAILED)
+        {
+            throw io_error("Failed to map feed log", "fd " + std::to_string(fd_));
+        }
+        if (base_)
+        {
+            ::munmap(base_, capacity_);
+        }
+        base_ = static_cast<char *>(base);
+        capacity_ = capacity;
+    }
+
+    void FeedRecorder::append(size_t shard, uint64_t receive_ns, std::string_view frame)
+    {
+        if (frame.empty())
+        {
+            return; // Length 0 is the end marker
+        }
+        size_t record = sizeof(RecordHeader) + padded(frame.size());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (failed_)
+        {
+            dropped_++;
+            return;
+        }
+        if (size_ + record > capacity_)
+        {
+            try
+            {
+                grow(size_ + record);
+            }
+            catch (const std::exception &e)
+            {
+                // Keep the feed running; the file stays readable up to the last whole frame
+                std::cerr << "[FeedRecorder] Recording stopped: " << e.what() << std::endl;
+                failed_ = true;
+                dropped_++;
+                return;
+            }
+        }
+        RecordHeader header{static_cast<uint32_t>(frame.size()), static_cast<uint32_t>(shard), receive_ns};
+        std::memcpy(base_ + size_, &header, sizeof(header));
+        std::memcpy(base_ + size_ + sizeof(header), frame.data(), frame.size());
+        size_ += record;
+        frames_++;
+    }
+
+    void FeedRecorder::flush()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ::msync(base_, size_, MS_SYNC);
+    }
+
+    uint64_t FeedRecorder::frames() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frames_;
+    }
+
+    bool FeedRecorder::failed() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return failed_;
+    }
+
+    uint64_t FeedRecorder::dropped() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dropped_;
+    }
+
+    size_t FeedRecorder::bytes() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_;
+    }
+
+    FeedReader::FeedReader(const std::string &path)
+    {
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0)
+        {
+            throw io_error("Failed to open feed log", path);
+        }
+        struct stat st;
+        if (::fstat(fd_, &st) != 0 || static_cast<size_t>(st.st_size) < kFileHeaderSize)
+        {
+            ::close(fd_);
+            throw std::runtime_error("Not a feed log: " + path);
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        void *base = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (base == MAP_FAILED)
+        {
+            ::close(fd_);
+            throw io_error("Failed to map feed log", path);
+        }
+        base_ = static_cast<const char *>(base);
+        if (std::memcmp(base_, kMagic, sizeof(kMagic)) != 0)
+        {
+            ::munmap(const_cast<char *>(base_), size_);
+            ::close(fd_);
+            throw std::runtime_error("Not a feed log: " + path);
+        }
+        ::madvise(const_cast<char *>(base_), size_, MADV_SEQUENTIAL);
+        offset_ = kFileHeaderSize;
+    }
+
+    FeedReader::~FeedReader()
+    {
+        ::munmap(const_cast<char *>(base_), size_);
+        ::close(fd_);
+    }
+
+    bool FeedReader::next(FeedFrame &out)
+    {
+        if (offset_ + sizeof(RecordHeader) > size_)
+        {
+            return false;
+        }
+        RecordHeader header;
+        std::memcpy(&header, base_ + offset_, sizeof(header));
+        size_t record = sizeof(RecordHeader) + padded(header.length);
+        if (header.length == 0 || offset_ + record > size_)
+        {
+            return false; // End marker or a record cut short
+        }
+        out.shard = header.shard;
+        out.receive_ns = header.receive_ns;
+        out.data = std::string_view(base_ + offset_ + sizeof(header), header.length);
+        offset_ += record;
+        return true;
+    }
+
+    void FeedReader::rewind()
+    {
+        offset_ = kFileHeaderSize;
+    }
+
+} // namespace polymarket
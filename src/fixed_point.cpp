@@ -0,0 +1,217 @@
+#include "fixed_point.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+
+namespace polymarket
+{
+
+    namespace
+    {
+        constexpr int64_t kPow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+        // Micros per unit of the last kept decimal
+        int64_t step_for(int decimals)
+        {
+            return kPow10[Fixed6::kDecimals - std::clamp(decimals, 0, Fixed6::kDecimals)];
+        }
+
+        // floor / ceil / half-away-from-zero of n / d for d > 0
+        __int128 divide(__int128 n, __int128 d, Rounding rounding)
+        {
+            __int128 q = n / d;
+            __int128 r = n % d;
+            if (r == 0)
+            {
+                return q;
+            }
+            switch (rounding)
+            {
+            case Rounding::DOWN:
+                return n < 0 ? q - 1 : q;
+            case Rounding::UP:
+                return n < 0 ? q : q + 1;
+            case Rounding::NEAREST:
+            default:
+            {
+                __int128 twice = (r < 0 ? -r : r) * 2;
+                if (twice >= d)
+                {
+                    return n < 0 ? q - 1 : q + 1;
+                }
+                return q;
+            }
+            }
+        }
+    } // namespace
+
+    Fixed6 Fixed6::from_double(double value, Rounding rounding)
+    {
+        double scaled = value * kScale;
+        double nearest = std::round(scaled);
+        // Within a few ulps of a whole micro: take it as exact, whatever the rounding mode
+        if (std::fabs(scaled - nearest) <= 1e-9 + 4 * DBL_EPSILON * std::fabs(scaled))
+        {
+            return Fixed6(static_cast<int64_t>(nearest));
+        }
+        switch (rounding)
+        {
+        case Rounding::DOWN:
+            return Fixed6(static_cast<int64_t>(std::floor(scaled)));
+        case Rounding::UP:
+            return Fixed6(static_cast<int64_t>(std::ceil(scaled)));
+        case Rounding::NEAREST:
+        default:
+            return Fixed6(static_cast<int64_t>(nearest));
+        }
+    }
+
+    std::optional<Fixed6> Fixed6::parse(std::string_view text, Rounding rounding)
+    {
+        size_t i = 0;
+        bool negative = false;
+        if (i < text.size() && (text[i] == '-' || text[i] == '+'))
+        {
+            negative = text[i] == '-';
+            i++;
+        }
+
+        // Digits as an integer scaled by 10^digits_after_dot, capped where int64 micros would overflow
+        __int128 value = 0;
+        int frac_digits = 0;
+        bool digits = false;
+        bool dot = false;
+        for (; i < text.size(); i++)
+        {
+            char c = text[i];
+            if (c == '.' && !dot)
+            {
+                dot = true;
+                continue;
+            }
+            if (c < '0' || c > '9')
+            {
+                return std::nullopt;
+            }
+            digits = true;
+            if (dot)
+            {
+                if (frac_digits >= 18)
+                {
+                    continue; // Far below a micro; only matters for rounding, which the first 18 decide
+                }
+                frac_digits++;
+            }
+            value = value * 10 + (c - '0');
+            if (value > (static_cast<__int128>(1) << 100))
+            {
+                return std::nullopt;
+            }
+        }
+        if (!digits)
+        {
+            return std::nullopt;
+        }
+
+        if (negative)
+        {
+            value = -value;
+        }
+        __int128 micros;
+        if (frac_digits <= kDecimals)
+        {
+            micros = value * kPow10[kDecimals - frac_digits];
+        }
+        else
+        {
+            __int128 divisor = 1;
+            for (int k = kDecimals; k < frac_digits; k++)
+            {
+                divisor *= 10;
+            }
+            micros = divide(value, divisor, rounding);
+        }
+        if (micros > std::numeric_limits<int64_t>::max() || micros < std::numeric_limits<int64_t>::min())
+        {
+            return std::nullopt;
+        }
+        return Fixed6(static_cast<int64_t>(micros));
+    }
+
+    std::string Fixed6::to_string() const
+    {
+        uint64_t magnitude = micros_ < 0 ? 0 - static_cast<uint64_t>(micros_) : static_cast<uint64_t>(micros_);
+        std::string out = micros_ < 0 ? "-" : "";
+        out += std::to_string(magnitude / kScale);
+        uint64_t frac = magnitude % kScale;
+        if (frac != 0)
+        {
+            char buf[kDecimals];
+            for (int k = kDecimals - 1; k >= 0; k--)
+            {
+                buf[k] = static_cast<char>('0' + frac % 10);
+                frac /= 10;
+            }
+            int len = kDecimals;
+            while (buf[len - 1] == '0')
+            {
+                len--;
+            }
+            out += '.';
+            out.append(buf, len);
+        }
+        return out;
+    }
+
+    int Fixed6::decimals() const
+    {
+        int64_t frac = micros_ % kScale;
+        if (frac == 0)
+        {
+            return 0;
+        }
+        int places = kDecimals;
+        while (frac % 10 == 0)
+        {
+            frac /= 10;
+            places--;
+        }
+        return places;
+    }
+
+    Fixed6 Fixed6::round(int decimals, Rounding rounding) const
+    {
+        if (decimals >= kDecimals)
+        {
+            return *this;
+        }
+        int64_t step = step_for(decimals);
+        return Fixed6(static_cast<int64_t>(divide(micros_, step, rounding) * step));
+    }
+
+    Fixed6 Fixed6::ratio(__int128 numerator, __int128 denominator, Rounding rounding)
+    {
+        if (denominator < 0)
+        {
+            numerator = -numerator;
+            denominator = -denominator;
+        }
+        return Fixed6(static_cast<int64_t>(divide(numerator, denominator, rounding)));
+    }
+
+    Fixed6 Fixed6::mul(Fixed6 a, Fixed6 b, Rounding rounding, int decimals)
+    {
+        int64_t step = step_for(decimals);
+        return Fixed6(ratio(static_cast<__int128>(a.micros_) * b.micros_, static_cast<__int128>(kScale) * step,
+                            rounding).micros_ * step);
+    }
+
+    Fixed6 Fixed6::div(Fixed6 a, Fixed6 b, Rounding rounding, int decimals)
+    {
+        int64_t step = step_for(decimals);
+        return Fixed6(ratio(static_cast<__int128>(a.micros_) * kScale, static_cast<__int128>(b.micros_) * step,
+                            rounding).micros_ * step);
+    }
+
+} // namespace polymarket
@@ -0,0 +1,124 @@
+#include "gamma_cache.hpp"
+#include <iterator>
+#include <memory>
+
+namespace polymarket
+{
+
+    GammaCache::GammaCache(Submit submit, Parse parse, int hit_ttl_sec, int miss_ttl_sec)
+        : submit_(std::move(submit)), parse_(std::move(parse)), hit_ttl_sec_(hit_ttl_sec), miss_ttl_sec_(miss_ttl_sec)
+    {
+    }
+
+    std::vector<MarketState> GammaCache::lookup(const Query &query, bool wait, uint64_t now)
+    {
+        struct Request
+        {
+            std::string slug;
+            std::string ticker;
+            std::shared_ptr<std::promise<std::optional<MarketState>>> promise;
+        };
+        std::vector<Request> requests;
+        std::vector<std::shared_future<std::optional<MarketState>>> results;
+        results.reserve(query.size());
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            // Drop expired entries (mostly past windows, which are never asked for again)
+            for (auto it = entries_.begin(); it != entries_.end();)
+            {
+                bool expired = !it->second.pending.valid() && it->second.expires_sec <= now;
+                it = expired ? entries_.erase(it) : std::next(it);
+            }
+
+            for (const auto &[slug, ticker] : query)
+            {
+                auto it = entries_.find(slug);
+                if (it != entries_.end())
+                {
+                    if (it->second.pending.valid())
+                    {
+                        results.push_back(it->second.pending);
+                    }
+                    else
+                    {
+                        std::promise<std::optional<MarketState>> ready;
+                        ready.set_value(it->second.market);
+                        results.push_back(ready.get_future().share());
+                    }
+                    continue;
+                }
+
+                auto promise = std::make_shared<std::promise<std::optional<MarketState>>>();
+                auto &entry = entries_[slug];
+                entry.pending = promise->get_future().share();
+                results.push_back(entry.pending);
+                requests.push_back({slug, ticker, std::move(promise)});
+            }
+        }
+
+        // Submitted outside mutex_: a stopped client completes the callback right away
+        for (auto &request : requests)
+        {
+            submit_("/events?slug=" + request.slug,
+                    [this, request, now](HttpResponse response)
+                    {
+                        std::optional<MarketState> market;
+                        if (response.ok())
+                        {
+                            market = parse_(response.body, request.ticker);
+                        }
+
+                        {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            auto it = entries_.find(request.slug);
+                            if (it != entries_.end())
+                            {
+                                if (response.ok())
+                                {
+                                    it->second.market = market;
+                                    it->second.expires_sec = now + static_cast<uint64_t>(market ? hit_ttl_sec_ : miss_ttl_sec_);
+                                    it->second.pending = {};
+                                }
+                                else
+                                {
+                                    entries_.erase(it); // Transport or HTTP error: retry next time
+                                }
+                            }
+                        }
+                        request.promise->set_value(std::move(market));
+                    });
+        }
+
+        std::vector<MarketState> markets;
+        if (!wait)
+        {
+            return markets;
+        }
+        for (auto &result : results)
+        {
+            if (const auto &market = result.get())
+            {
+                markets.push_back(*market);
+            }
+        }
+        return markets;
+    }
+
+    void GammaCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = entries_.begin(); it != entries_.end();)
+        {
+            it = it->second.pending.valid() ? std::next(it) : entries_.erase(it);
+        }
+    }
+
+    size_t GammaCache::size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+} // namespace polymarket
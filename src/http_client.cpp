@@ -1,4 +1,5 @@
 #include "http_client.hpp"
+#include "http_pool.hpp"
 #include <chrono>
 #include <stdexcept>
 #include <thread>
@@ -20,6 +21,7 @@ namespace polymarket
 
     void http_global_cleanup()
     {
+        HttpPool::shutdown_global();
         if (g_curl_initialized)
         {
             curl_global_cleanup();
@@ -210,6 +212,15 @@ namespace polymarket
         }
     }
 
+    void HttpClient::set_share(CURLSH *share)
+    {
+        std::lock_guard<std::recursive_mutex> lock(curl_mutex_);
+        if (curl_)
+        {
+            curl_easy_setopt(curl_, CURLOPT_SHARE, share);
+        }
+    }
+
     size_t HttpClient::write_callback(char *ptr, size_t size, size_t nmemb, void *userdata)
     {
         auto *response = static_cast<std::string *>(userdata);
@@ -264,6 +275,7 @@ namespace polymarket
 
     HttpResponse HttpClient::get(const std::string &path)
     {
+        std::lock_guard<std::recursive_mutex> lock(curl_mutex_);
         std::string url = base_url_.empty() ? path : base_url_ + path;
 
         curl_easy_setopt(curl_, CURLOPT_HTTPGET, 1L);
@@ -274,6 +286,7 @@ namespace polymarket
 
     HttpResponse HttpClient::get(const std::string &path, const std::map<std::string, std::string> &custom_headers)
     {
+        std::lock_guard<std::recursive_mutex> lock(curl_mutex_);
         // Save original headers
         struct curl_slist *original_headers = headers_;
 
@@ -301,6 +314,7 @@ namespace polymarket
 
     HttpResponse HttpClient::post(const std::string &path, const std::string &body)
     {
+        std::lock_guard<std::recursive_mutex> lock(curl_mutex_);
         std::string url = base_url_.empty() ? path : base_url_ + path;
 
         curl_easy_setopt(curl_, CURLOPT_POST, 1L);
@@ -312,6 +326,7 @@ namespace polymarket
 
     HttpResponse HttpClient::post(const std::string &path, const std::string &body, const std::map<std::string, std::string> &custom_headers)
     {
+        std::lock_guard<std::recursive_mutex> lock(curl_mutex_);
         // Save original headers
         struct curl_slist *original_headers = headers_;
 
@@ -339,6 +354,7 @@ namespace polymarket
 
     HttpResponse HttpClient::del(const std::string &path, const std::string &body)
     {
+        std::lock_guard<std::recursive_mutex> lock(curl_mutex_);
         std::string url = base_url_.empty() ? path : base_url_ + path;
 
         curl_easy_setopt(curl_, CURLOPT_CUSTOMREQUEST, "DELETE");
@@ -358,6 +374,7 @@ namespace polymarket
 
     HttpResponse HttpClient::del(const std::string &path, const std::string &body, const std::map<std::string, std::string> &custom_headers)
     {
+        std::lock_guard<std::recursive_mutex> lock(curl_mutex_);
         // Save original headers
         struct curl_slist *original_headers = headers_;
 
@@ -429,7 +446,7 @@ namespace polymarket
                 }
 
                 // Send a lightweight GET to keep connection alive
-                std::lock_guard<std::mutex> lock(curl_mutex_);
+                std::lock_guard<std::recursive_mutex> lock(curl_mutex_);
                 if (curl_ && !base_url_.empty())
                 {
                     get("/");
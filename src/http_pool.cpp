@@ -0,0 +1,256 @@
+#include "http_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace polymarket
+{
+
+    HttpPool::HttpPool()
+    {
+        CURLSH *share = curl_share_init();
+        if (!share)
+        {
+            throw std::runtime_error("Failed to initialize CURL share handle");
+        }
+        curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lock_share);
+        curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlock_share);
+        curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        share_ = share;
+    }
+
+    HttpPool::~HttpPool()
+    {
+        shutdown();
+        curl_share_cleanup(static_cast<CURLSH *>(share_));
+    }
+
+    namespace
+    {
+        std::atomic<HttpPool *> g_global_pool{nullptr};
+    }
+
+    HttpPool &HttpPool::global()
+    {
+        // Leaked on purpose: the share handle must outlive every attached client, including static ones
+        static HttpPool *pool = []()
+        {
+            auto *created = new HttpPool();
+            g_global_pool.store(created);
+            return created;
+        }();
+        return *pool;
+    }
+
+    void HttpPool::shutdown_global()
+    {
+        if (auto *pool = g_global_pool.load())
+        {
+            pool->shutdown();
+        }
+    }
+
+    void HttpPool::lock_share(CURL *, curl_lock_data data, curl_lock_access, void *userptr)
+    {
+        static_cast<HttpPool *>(userptr)->share_locks_[data].lock();
+    }
+
+    void HttpPool::unlock_share(CURL *, curl_lock_data data, void *userptr)
+    {
+        static_cast<HttpPool *>(userptr)->share_locks_[data].unlock();
+    }
+
+    void HttpPool::attach(HttpClient &client, const std::string &base_url)
+    {
+        client.set_share(static_cast<CURLSH *>(share_));
+        add_host(base_url);
+        std::lock_guard<std::mutex> lock(attached_mutex_);
+        attached_.push_back({base_url, &client, nullptr});
+    }
+
+    void HttpPool::attach(AsyncHttpClient &client, const std::string &base_url)
+    {
+        client.set_share(static_cast<CURLSH *>(share_));
+        add_host(base_url);
+        std::lock_guard<std::mutex> lock(attached_mutex_);
+        attached_.push_back({base_url, nullptr, &client});
+    }
+
+    void HttpPool::detach(HttpClient &client)
+    {
+        remove_attached(&client);
+    }
+
+    void HttpPool::detach(AsyncHttpClient &client)
+    {
+        remove_attached(&client);
+    }
+
+    void HttpPool::remove_attached(const void *client)
+    {
+        std::lock_guard<std::mutex> lock(attached_mutex_);
+        std::vector<std::string> removed;
+        for (auto it = attached_.begin(); it != attached_.end();)
+        {
+            if (it->http == client || it->async == client)
+            {
+                removed.push_back(it->base_url);
+                it = attached_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // A host stays known while another client of it is attached
+        std::lock_guard<std::mutex> hosts_lock(mutex_);
+        for (const auto &base_url : removed)
+        {
+            bool still_attached = std::any_of(attached_.begin(), attached_.end(), [&base_url](const Attached &a)
+                                              { return a.base_url == base_url; });
+            if (!still_attached)
+            {
+                attached_hosts_.erase(std::remove(attached_hosts_.begin(), attached_hosts_.end(), base_url),
+                                      attached_hosts_.end());
+            }
+        }
+    }
+
+    void HttpPool::add_host(const std::string &base_url)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!base_url.empty() && std::find(attached_hosts_.begin(), attached_hosts_.end(), base_url) == attached_hosts_.end())
+        {
+            attached_hosts_.push_back(base_url);
+        }
+    }
+
+    HttpClient &HttpPool::client(const std::string &base_url, long timeout_ms)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto &client = clients_[base_url];
+        if (!client)
+        {
+            client = std::make_unique<HttpClient>();
+            client->set_base_url(base_url);
+            client->set_timeout_ms(timeout_ms);
+            client->set_share(static_cast<CURLSH *>(share_));
+        }
+        return *client;
+    }
+
+    bool HttpPool::warm(const std::string &base_url)
+    {
+        // Every client opens its own connection; only the DNS entry and the TLS session carry over between them
+        bool attached = false;
+        bool warmed = false;
+        {
+            std::lock_guard<std::mutex> lock(attached_mutex_);
+            for (const auto &a : attached_)
+            {
+                if (a.base_url != base_url)
+                {
+                    continue;
+                }
+                attached = true;
+                bool ok = a.http ? a.http->warm_connection() : a.async->warm_connection();
+                warmed = warmed || ok;
+            }
+        }
+
+        bool owned;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            owned = clients_.count(base_url) > 0;
+        }
+        if (owned || !attached)
+        {
+            bool ok = client(base_url).warm_connection();
+            warmed = warmed || ok;
+        }
+        return warmed;
+    }
+
+    size_t HttpPool::warm_all()
+    {
+        size_t warmed = 0;
+        for (const auto &host : hosts())
+        {
+            if (warm(host))
+            {
+                warmed++;
+            }
+        }
+        return warmed;
+    }
+
+    std::vector<std::string> HttpPool::hosts() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::string> result = attached_hosts_;
+        for (const auto &[base_url, client] : clients_)
+        {
+            if (std::find(result.begin(), result.end(), base_url) == result.end())
+            {
+                result.push_back(base_url);
+            }
+        }
+        return result;
+    }
+
+    void HttpPool::start_heartbeat(long interval_seconds)
+    {
+        if (heartbeat_running_.exchange(true))
+        {
+            return; // Already running
+        }
+
+        heartbeat_thread_ = std::thread([this, interval_seconds]()
+                                        {
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(heartbeat_mutex_);
+                    heartbeat_cv_.wait_for(lock, std::chrono::seconds(interval_seconds), [this]()
+                                           { return !heartbeat_running_.load(); });
+                }
+                if (!heartbeat_running_.load())
+                {
+                    break;
+                }
+
+                for (const auto &host : hosts())
+                {
+                    if (!heartbeat_running_.load())
+                    {
+                        break;
+                    }
+                    warm(host);
+                }
+            } });
+    }
+
+    void HttpPool::stop_heartbeat()
+    {
+        {
+            std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+            heartbeat_running_.store(false);
+        }
+        heartbeat_cv_.notify_all();
+        if (heartbeat_thread_.joinable())
+        {
+            heartbeat_thread_.join();
+        }
+    }
+
+    void HttpPool::shutdown()
+    {
+        stop_heartbeat();
+        std::lock_guard<std::mutex> lock(mutex_);
+        clients_.clear();
+    }
+
+} // namespace polymarket
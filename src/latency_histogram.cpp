@@ -0,0 +1,102 @@
+#include "latency_histogram.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace polymarket
+{
+
+    size_t LatencyHistogram::bucket_for(uint64_t value)
+    {
+        if (value < 2 * kSubBuckets)
+        {
+            return static_cast<size_t>(value);
+        }
+        uint32_t shift = static_cast<uint32_t>(std::bit_width(value)) - 1 - kSubBucketBits;
+        return static_cast<size_t>(shift + 1) * kSubBuckets + static_cast<size_t>((value >> shift) - kSubBuckets);
+    }
+
+    uint64_t LatencyHistogram::bucket_upper(size_t bucket)
+    {
+        if (bucket < 2 * kSubBuckets)
+        {
+            return bucket;
+        }
+        uint32_t shift = static_cast<uint32_t>(bucket / kSubBuckets) - 1;
+        uint64_t top = bucket % kSubBuckets + kSubBuckets;
+        return (top << shift) + ((uint64_t{1} << shift) - 1);
+    }
+
+    void LatencyHistogram::record(uint64_t value_ns)
+    {
+        buckets_[bucket_for(value_ns)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value_ns, std::memory_order_relaxed);
+
+        uint64_t seen = min_.load(std::memory_order_relaxed);
+        while (value_ns < seen && !min_.compare_exchange_weak(seen, value_ns, std::memory_order_relaxed))
+        {
+        }
+        seen = max_.load(std::memory_order_relaxed);
+        while (value_ns > seen && !max_.compare_exchange_weak(seen, value_ns, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void LatencyHistogram::reset()
+    {
+        for (auto &bucket : buckets_)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        min_.store(UINT64_MAX, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    uint64_t LatencyHistogram::percentile(double q) const
+    {
+        // Count from the buckets themselves, so a concurrent record() cannot push the rank past the total
+        uint64_t total = 0;
+        for (const auto &bucket : buckets_)
+        {
+            total += bucket.load(std::memory_order_relaxed);
+        }
+        if (total == 0)
+        {
+            return 0;
+        }
+
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * total)));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; i++)
+        {
+            seen += buckets_[i].load(std::memory_order_relaxed);
+            if (seen >= rank)
+            {
+                // Never report past the largest recorded value
+                return std::min(bucket_upper(i), max_.load(std::memory_order_relaxed));
+            }
+        }
+        return max_.load(std::memory_order_relaxed);
+    }
+
+    LatencySummary LatencyHistogram::summary() const
+    {
+        LatencySummary s;
+        s.count = count();
+        if (s.count == 0)
+        {
+            return s;
+        }
+        s.min_ns = min_.load(std::memory_order_relaxed);
+        s.max_ns = max_.load(std::memory_order_relaxed);
+        s.mean_ns = static_cast<double>(sum_.load(std::memory_order_relaxed)) / s.count;
+        s.p50_ns = percentile(0.50);
+        s.p99_ns = percentile(0.99);
+        s.p999_ns = percentile(0.999);
+        return s;
+    }
+
+} // namespace polymarket
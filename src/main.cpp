@@ -1,8 +1,13 @@
 #include "types.hpp"
 #include "http_client.hpp"
 #include "market_fetcher.hpp"
+#include "clob_client.hpp"
 #include "orderbook.hpp"
 #include "order_signer.hpp"
+#include "order_pool.hpp"
+#include "fixed_point.hpp"
+#include "feed_log.hpp"
+#include "user_stream.hpp"
 #include <iostream>
 #include <csignal>
 #include <thread>
@@ -46,6 +51,25 @@ struct MarketConfig
 std::atomic<bool> g_config_ready{false};
 MarketConfig g_market_config;
 
+// Take the market's tick size and neg_risk from the metadata cache (filled by ClobClient::warm_metadata). Orders
+// stay blocked until both are known, so a market is never traded with the previous window's values.
+bool load_market_config(const ClobClient &client, const MarketState &market)
+{
+    auto metadata = client.cached_metadata(market.token_yes);
+    if (!metadata || !metadata->tick_size || !metadata->neg_risk)
+    {
+        g_config_ready.store(false);
+        std::cerr << "[Warn] No tick size/neg_risk cached for " << market.slug << ", orders disabled" << std::endl;
+        return false;
+    }
+    g_market_config.tick_size = *metadata->tick_size;
+    g_market_config.neg_risk = *metadata->neg_risk;
+    g_config_ready.store(true);
+    std::cout << "[Prefetch] tickSize=" << g_market_config.tick_size
+              << ", negRisk=" << (g_market_config.neg_risk ? "true" : "false") << std::endl;
+    return true;
+}
+
 void signal_handler(int signal)
 {
     std::cout << "\n[Main] Received signal " << signal << ", shutting down..." << std::endl;
@@ -66,6 +90,10 @@ void print_usage()
               << "  --neg-risk      Fetch neg_risk binary markets (default)\n"
               << "  --max N         Maximum number of markets to fetch (default: 50)\n"
               << "  --trigger N     Trigger threshold for arb (default: 0.98)\n"
+              << "  --shards N      Spread tokens over N WebSocket connections (default: 1)\n"
+              << "  --shard-workers Parse each connection on its own worker thread\n"
+              << "  --record PATH   Capture raw orderbook frames to PATH (replay with feed_replay_bench)\n"
+              << "  --strategy-thread Handle arb triggers on a separate thread fed by a lock-free ring\n"
               << "  --dry-run       Don't place actual orders (default)\n"
               << "  --live          Place actual orders (requires PRIVATE_KEY, API_KEY, etc)\n"
               << "\nEnvironment variables for live trading:\n"
@@ -88,6 +116,10 @@ int main(int argc, char *argv[])
     bool fetch_neg_risk = false;
     int max_markets = 50;
     double trigger = 0.98;
+    int ws_shards = 1;
+    bool ws_shard_workers = false;
+    std::string record_path;
+    bool strategy_thread = false;
     bool dry_run = true;
     double size_usdc = 5.0;
 
@@ -127,6 +159,22 @@ int main(int argc, char *argv[])
         {
             trigger = std::stod(argv[++i]);
         }
+        else if (arg == "--shards" && i + 1 < argc)
+        {
+            ws_shards = std::stoi(argv[++i]);
+        }
+        else if (arg == "--shard-workers")
+        {
+            ws_shard_workers = true;
+        }
+        else if (arg == "--record" && i + 1 < argc)
+        {
+            record_path = argv[++i];
+        }
+        else if (arg == "--strategy-thread")
+        {
+            strategy_thread = true;
+        }
         else if (arg == "--dry-run")
         {
             dry_run = true;
@@ -168,10 +216,13 @@ int main(int argc, char *argv[])
     Config config;
     config.max_markets = max_markets;
     config.trigger_combined = trigger;
+    config.ws_shards = ws_shards;
+    config.ws_shard_workers = ws_shard_workers;
 
     std::cout << "[Config] Trigger threshold: " << std::fixed << std::setprecision(2)
               << config.trigger_combined << std::endl;
     std::cout << "[Config] Max markets: " << config.max_markets << std::endl;
+    std::cout << "[Config] WS shards: " << config.ws_shards << (config.ws_shard_workers ? " (workers)" : "") << std::endl;
     std::cout << "[Config] Size per leg: $" << size_usdc << std::endl;
     std::cout << "[Config] Mode: " << (dry_run ? "DRY RUN" : "LIVE TRADING") << std::endl;
     std::cout << std::endl;
@@ -306,11 +357,13 @@ int main(int argc, char *argv[])
         return 0;
     }
 
-    // Filter to get the best market (soonest expiring with enough time left)
-    auto get_best_market = [](const std::vector<MarketState> &all_markets, const std::string &symbol) -> MarketState *
+    // Filter to get the best market (soonest expiring with enough time left, and after after_ms if given)
+    auto get_best_market = [](const std::vector<MarketState> &all_markets, const std::string &symbol,
+                              uint64_t after_ms = 0) -> MarketState *
     {
         uint64_t now_ms = now_sec() * 1000;
         uint64_t min_time_left = 2 * 60 * 1000; // At least 2 min left
+        uint64_t min_expiry = std::max(now_ms + min_time_left, after_ms);
 
         MarketState *best = nullptr;
         uint64_t best_expiry = UINT64_MAX;
@@ -320,7 +373,7 @@ int main(int argc, char *argv[])
             if (m.symbol != symbol)
                 continue;
             uint64_t expiry = get_market_expiry(m.slug);
-            if (expiry > now_ms + min_time_left && expiry < best_expiry)
+            if (expiry > min_expiry && expiry < best_expiry)
             {
                 best_expiry = expiry;
                 best = &m;
@@ -346,32 +399,56 @@ int main(int argc, char *argv[])
               << " (expires in " << time_left_sec << "s)" << std::endl;
 
     // Prefetch tick size and neg_risk for fast order placement
+    std::unique_ptr<ClobClient> metadata_client;
     if (!dry_run)
     {
         std::cout << "[Prefetch] Fetching tick size and neg_risk..." << std::endl;
-        auto book = fetcher.fetch_orderbook(current_market->token_yes);
-        if (book)
-        {
-            g_market_config.tick_size = "0.01"; // Default for crypto markets
-            g_market_config.neg_risk = true;    // Crypto markets are neg_risk
-            g_config_ready.store(true);
-            std::cout << "[Prefetch] tickSize=" << g_market_config.tick_size
-                      << ", negRisk=" << (g_market_config.neg_risk ? "true" : "false") << std::endl;
-        }
+        metadata_client = std::make_unique<ClobClient>(config.clob_rest_url);
+        metadata_client->warm_metadata({current_market->token_yes, current_market->token_no});
+        load_market_config(*metadata_client, *current_market);
+    }
+
+    // Keep both legs pre-signed around the current asks so an opportunity only has to pick orders and post them
+    std::unique_ptr<OrderPool> order_pool;
+    if (!dry_run && order_signer && g_config_ready.load())
+    {
+        OrderPoolConfig pool_config;
+        pool_config.exchange_address = g_market_config.neg_risk ? NEG_RISK_EXCHANGE_ADDRESS : EXCHANGE_ADDRESS;
+        pool_config.tick_size = std::stod(g_market_config.tick_size);
+        pool_config.sizes_usdc = {size_usdc};
+        order_pool = std::make_unique<OrderPool>(*order_signer, pool_config);
+        order_pool->set_legs({current_market->token_yes, current_market->token_no});
+    }
+
+    // Feed capture (declared first so it outlives the orderbook manager)
+    std::unique_ptr<FeedRecorder> recorder;
+    if (!record_path.empty())
+    {
+        recorder = std::make_unique<FeedRecorder>(record_path);
+        std::cout << "[Main] Recording orderbook frames to " << record_path << std::endl;
     }
 
     // Create orderbook manager
     OrderbookManager orderbook_mgr(config);
+    orderbook_mgr.set_recorder(recorder.get());
+
+    if (order_pool)
+    {
+        orderbook_mgr.on_orderbook_update([&order_pool](const std::string &asset_id, const Orderbook &book)
+                                          { order_pool->update_price(asset_id, book.best_ask()); });
+    }
 
-    // Set up arb opportunity callback
-    orderbook_mgr.on_arb_opportunity([&config, &dry_run, &size_usdc, &order_signer, &api_creds, &fetcher, &current_market](const LiveMarketState &market, double combined)
-                                     {
+    // Arb handler: signs (or takes pre-signed) orders for both legs
+    auto handle_arb = [&config, &dry_run, &size_usdc, &order_signer, &order_pool](const MarketState &market, const ArbSizing &sizing)
+    {
+        double combined = market.best_ask_yes + market.best_ask_no;
         double edge = 1.0 - combined;
         double edge_pct = edge * 100.0;
         double slippage_buffer = 0.005; // 0.5% slippage per side
         
-        double yes_price = std::min(market.best_ask_yes.load() + slippage_buffer, 0.99);
-        double no_price = std::min(market.best_ask_no.load() + slippage_buffer, 0.99);
+        // Limit at the worst level the executable size reaches on each leg
+        double yes_price = std::min(std::max(sizing.limit_yes, market.best_ask_yes) + slippage_buffer, 0.99);
+        double no_price = std::min(std::max(sizing.limit_no, market.best_ask_no) + slippage_buffer, 0.99);
         
         // Round to 2 decimals for API compliance
         yes_price = std::round(yes_price * 100) / 100;
@@ -380,9 +457,11 @@ int main(int argc, char *argv[])
         std::cout << "\n\n🎯 OPPORTUNITY FOUND! Combined=" << std::fixed << std::setprecision(4) 
                   << combined << " < " << config.trigger_combined << std::endl;
         std::cout << "  Market: " << market.slug << std::endl;
-        std::cout << "  YES Ask: " << market.best_ask_yes.load() << " -> order @ " << yes_price << std::endl;
-        std::cout << "  NO Ask:  " << market.best_ask_no.load() << " -> order @ " << no_price << std::endl;
+        std::cout << "  YES Ask: " << market.best_ask_yes << " -> order @ " << yes_price << std::endl;
+        std::cout << "  NO Ask:  " << market.best_ask_no << " -> order @ " << no_price << std::endl;
         std::cout << "  Edge: " << std::setprecision(2) << edge_pct << "%" << std::endl;
+        std::cout << "  Depth: " << sizing.size << " shares executable (VWAP YES " << std::setprecision(4) << sizing.vwap_yes
+                  << ", NO " << sizing.vwap_no << ", edge $" << std::setprecision(2) << sizing.edge << ")" << std::endl;
         std::cout << "  Size: $" << size_usdc << " per leg" << std::endl;
         
         if (dry_run) {
@@ -395,34 +474,52 @@ int main(int argc, char *argv[])
             return;
         }
         
-        // Calculate shares
-        double yes_shares = std::floor((size_usdc / yes_price) * 100) / 100;
-        double no_shares = std::floor((size_usdc / no_price) * 100) / 100;
+        // Calculate shares (budget per leg, capped by what the books can fill below the trigger)
+        double yes_shares = std::floor(std::min(size_usdc / yes_price, sizing.size) * 100) / 100;
+        double no_shares = std::floor(std::min(size_usdc / no_price, sizing.size) * 100) / 100;
         
         std::cout << "  [EXECUTING] Creating orders..." << std::endl;
         std::cout << "    YES: " << yes_shares << " shares @ " << yes_price << std::endl;
         std::cout << "    NO:  " << no_shares << " shares @ " << no_price << std::endl;
         
-        // Create and sign orders
+        // Take pre-signed orders from the pool, signing on the spot only when the grid has no match
         // Note: Full order placement would require posting to API with L2 headers
-        // This is a placeholder showing the signing works
         try {
-            OrderData yes_order;
-            yes_order.maker = order_signer->address();
-            yes_order.taker = "0x0000000000000000000000000000000000000000";
-            yes_order.token_id = market.token_yes;
-            yes_order.maker_amount = to_wei(size_usdc, 6);
-            yes_order.taker_amount = to_wei(yes_shares, 6);
-            yes_order.side = OrderSide::BUY;
-            yes_order.fee_rate_bps = "0";
-            yes_order.nonce = "0";
-            yes_order.signer = order_signer->address();
-            yes_order.expiration = "0";
-            yes_order.signature_type = SignatureType::EOA;
-            
-            auto signed_yes = order_signer->sign_order(yes_order, "0xC5d563A36AE78145C45a50134d48A1215220f80a");
-            std::cout << "    YES order signed: " << signed_yes.signature.substr(0, 20) << "..." << std::endl;
-            
+            auto leg_order = [&](const std::string &token_id, double price, double shares, bool &presigned) {
+                if (order_pool) {
+                    if (auto order = order_pool->take(token_id, price, shares)) {
+                        presigned = true;
+                        return *order;
+                    }
+                }
+                presigned = false;
+
+                OrderData order;
+                order.maker = order_signer->address();
+                order.taker = "0x0000000000000000000000000000000000000000";
+                order.token_id = token_id;
+                Fixed6 size = Fixed6::from_double(shares, Rounding::DOWN);
+                order.maker_amount = Fixed6::mul(size, Fixed6::from_double(price), Rounding::NEAREST, 2).to_wei();
+                order.taker_amount = size.to_wei();
+                order.side = OrderSide::BUY;
+                order.fee_rate_bps = "0";
+                order.nonce = "0";
+                order.signer = order_signer->address();
+                order.expiration = "0";
+                order.signature_type = SignatureType::EOA;
+                return order_signer->sign_order(order, g_market_config.neg_risk ? NEG_RISK_EXCHANGE_ADDRESS : EXCHANGE_ADDRESS);
+            };
+
+            auto start = std::chrono::steady_clock::now();
+            bool yes_presigned, no_presigned;
+            auto signed_yes = leg_order(market.token_yes, yes_price, yes_shares, yes_presigned);
+            auto signed_no = leg_order(market.token_no, no_price, no_shares, no_presigned);
+            auto ready_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+            std::cout << "    YES order " << (yes_presigned ? "pre-signed" : "signed") << ": " << signed_yes.signature.substr(0, 20) << "..." << std::endl;
+            std::cout << "    NO order " << (no_presigned ? "pre-signed" : "signed") << ": " << signed_no.signature.substr(0, 20) << "..." << std::endl;
+            std::cout << "    Orders ready in " << ready_us << "us" << std::endl;
+
             // TODO: Post orders to API with L2 headers
             // HttpClient http;
             // http.set_base_url("https://clob.polymarket.com");
@@ -432,7 +529,30 @@ int main(int argc, char *argv[])
             std::cout << "  [TODO] Order posting not yet implemented\n" << std::endl;
         } catch (const std::exception& e) {
             std::cout << "  [ERROR] Order signing failed: " << e.what() << "\n" << std::endl;
-        } });
+        }
+    };
+
+    // Either inline on the WebSocket thread, or from a ring on a strategy thread so signing never holds up the feed
+    UpdateConsumer *arb_events = nullptr;
+    if (strategy_thread)
+    {
+        UpdateConsumerConfig consumer_config;
+        consumer_config.books = false;
+        arb_events = &orderbook_mgr.add_consumer(consumer_config);
+    }
+    else
+    {
+        orderbook_mgr.on_arb_sizing([&handle_arb](const LiveMarketState &live, const ArbSizing &sizing)
+                                    {
+            MarketState market;
+            market.slug = live.slug;
+            market.condition_id = live.condition_id;
+            market.token_yes = live.token_yes;
+            market.token_no = live.token_no;
+            market.best_ask_yes = live.best_ask_yes.load();
+            market.best_ask_no = live.best_ask_no.load();
+            handle_arb(market, sizing); });
+    }
 
     // Subscribe to current market only
     std::vector<MarketState> current_markets = {*current_market};
@@ -452,7 +572,58 @@ int main(int argc, char *argv[])
     std::thread ws_thread([&orderbook_mgr]()
                           { orderbook_mgr.run(); });
 
+    std::thread arb_thread;
+    if (arb_events)
+    {
+        arb_thread = std::thread([&orderbook_mgr, &handle_arb, arb_events]()
+                                 {
+            UpdateEvent event;
+            while (g_running.load())
+            {
+                if (!arb_events->wait(event, std::chrono::milliseconds(100)) || event.kind != UpdateKind::ARB)
+                {
+                    continue;
+                }
+                // Prices as of the trigger; the strings come from the manager, off the feed thread
+                MarketState market = orderbook_mgr.get_market(orderbook_mgr.conditions().id(event.condition));
+                market.best_ask_yes = event.best_ask_yes;
+                market.best_ask_no = event.best_ask_no;
+                handle_arb(market, event.sizing);
+            } });
+    }
+
+    if (!orderbook_mgr.wait_subscribed(std::chrono::seconds(10)))
+    {
+        std::cerr << "[Warn] Orderbook stream not subscribed yet, continuing (auto-reconnect is on)" << std::endl;
+    }
+
+    // Live: fills and order state for every market come over the user channel instead of REST polling
+    std::unique_ptr<UserStreamManager> user_stream;
+    std::thread user_thread;
+    if (!dry_run)
+    {
+        user_stream = std::make_unique<UserStreamManager>(config, api_creds);
+        user_stream->on_trade([](const UserTrade &trade)
+                              { std::cout << "[Fill] " << trade.side << " " << trade.size << " @ " << trade.price
+                                          << " (" << trade.status << ", trade " << trade.id << ")" << std::endl; });
+        user_stream->on_order([](const UserOrderEvent &order)
+                              { std::cout << "[Order] " << order.type << " " << order.id << " matched "
+                                          << order.size_matched << "/" << order.original_size << std::endl; });
+        if (user_stream->connect())
+        {
+            user_thread = std::thread([&user_stream]()
+                                      { user_stream->run(); });
+        }
+        else
+        {
+            std::cerr << "[Warn] Failed to connect to user channel, fills won't be reported" << std::endl;
+        }
+    }
+
     // Main loop - monitor prices and check for market expiry
+    std::vector<MarketState> upcoming_markets;
+    MarketState *staged_market = nullptr; // Next window, pre-subscribed; points into upcoming_markets
+    bool staging_attempted = false;
     while (g_running.load())
     {
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -475,13 +646,71 @@ int main(int argc, char *argv[])
                       << " TTL=" << time_left << "s   " << std::flush;
         }
 
+        // Three minutes out, stage the next window on the live connection so its books, tick size and pre-signed
+        // orders are hot at the switch (the discovery cache already has it, the prefetch covers the window after)
+        if (time_left < 180 && !staging_attempted)
+        {
+            staging_attempted = true;
+            fetcher.prefetch_crypto_15m_markets();
+            upcoming_markets = fetcher.fetch_crypto_15m_markets();
+            staged_market = get_best_market(upcoming_markets, target_symbol, market_expiry);
+            if (staged_market)
+            {
+                orderbook_mgr.stage_market(*staged_market);
+                if (metadata_client)
+                {
+                    // Cached only; the current window keeps trading on its own config until the switch
+                    metadata_client->warm_metadata({staged_market->token_yes, staged_market->token_no});
+                }
+                if (order_pool)
+                {
+                    order_pool->set_legs({current_market->token_yes, current_market->token_no,
+                                          staged_market->token_yes, staged_market->token_no});
+                }
+                std::cout << "[Market] Staged next window: " << staged_market->slug << std::endl;
+            }
+        }
+
         // Check for market expiry - switch 60s before
         if (time_left < 60)
         {
+            staging_attempted = false;
             std::cout << "\n\n⏰ Market expiring soon, switching..." << std::endl;
 
+            // Hot swap: the staged market has been streaming for two minutes, nothing to fetch or wait for
+            if (staged_market)
+            {
+                auto swap_start = std::chrono::steady_clock::now();
+                orderbook_mgr.promote_staged(current_market->condition_id);
+                if (metadata_client)
+                {
+                    load_market_config(*metadata_client, *staged_market);
+                }
+                if (order_pool)
+                {
+                    order_pool->set_legs({staged_market->token_yes, staged_market->token_no});
+                }
+                markets.swap(upcoming_markets); // Element addresses survive the swap
+                current_market = staged_market;
+                staged_market = nullptr;
+                auto swap_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::steady_clock::now() - swap_start)
+                                   .count();
+
+                market_expiry = get_market_expiry(current_market->slug);
+                time_left_sec = (market_expiry - now_sec() * 1000) / 1000;
+                std::cout << "[Market] Switched to: " << current_market->slug << " in " << swap_us
+                          << "us (pre-subscribed, expires in " << time_left_sec << "s)" << std::endl;
+                continue;
+            }
+
+            // Nothing staged: cold switch
             // Stop current subscription
             orderbook_mgr.unsubscribe_all();
+            if (order_pool)
+            {
+                order_pool->invalidate();
+            }
 
             // Re-fetch markets to get fresh data
             auto fresh_markets = fetcher.fetch_crypto_15m_markets();
@@ -518,21 +747,28 @@ int main(int argc, char *argv[])
                       << " (expires in " << time_left_sec << "s)" << std::endl;
 
             // Prefetch tick size for new market
-            if (!dry_run)
+            if (metadata_client)
             {
-                auto book = fetcher.fetch_orderbook(current_market->token_yes);
-                if (book)
-                {
-                    g_market_config.tick_size = "0.01";
-                    g_market_config.neg_risk = true;
-                    g_config_ready.store(true);
-                    std::cout << "[Prefetch] tickSize=" << g_market_config.tick_size << std::endl;
-                }
+                metadata_client->warm_metadata({current_market->token_yes, current_market->token_no});
+                load_market_config(*metadata_client, *current_market);
+            }
+
+            if (order_pool)
+            {
+                order_pool->set_legs({current_market->token_yes, current_market->token_no});
             }
 
-            // Subscribe to new market
+            // Subscribe to new market (sent on the live connection right away)
+            auto resubscribe_start = std::chrono::steady_clock::now();
             current_markets = {*current_market};
             orderbook_mgr.subscribe(current_markets);
+            if (orderbook_mgr.wait_subscribed(std::chrono::seconds(5)))
+            {
+                auto resubscribe_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                                          std::chrono::steady_clock::now() - resubscribe_start)
+                                          .count();
+                std::cout << "[Market] Resubscribed in " << resubscribe_us << "us" << std::endl;
+            }
         }
     }
 
@@ -544,9 +780,56 @@ int main(int argc, char *argv[])
     {
         ws_thread.join();
     }
+    if (arb_thread.joinable())
+    {
+        g_running.store(false); // Also set when the main loop gave up on finding markets
+        arb_thread.join();
+    }
+    if (user_stream)
+    {
+        user_stream->stop();
+        if (user_thread.joinable())
+        {
+            user_thread.join();
+        }
+    }
 
     std::cout << "[Main] Final stats - Updates: " << orderbook_mgr.total_updates()
               << " | Arb opportunities: " << orderbook_mgr.arb_opportunities() << std::endl;
+    if (arb_events)
+    {
+        auto ring_stats = arb_events->stats();
+        std::cout << "[Main] Strategy ring - Published: " << ring_stats.published << " | Dropped: " << ring_stats.dropped
+                  << " | Consumed: " << ring_stats.consumed << std::endl;
+    }
+    if (recorder)
+    {
+        std::cout << "[Main] Recorded " << recorder->frames() << " frames (" << recorder->bytes() << " bytes) to "
+                  << record_path << std::endl;
+    }
+    if (order_pool)
+    {
+        auto pool_stats = order_pool->stats();
+        std::cout << "[Main] Order pool - Pre-signed hits: " << pool_stats.hits << " | Misses: " << pool_stats.misses
+                  << " | Signed: " << pool_stats.signed_orders << " | Discarded: " << pool_stats.discarded << std::endl;
+    }
+
+    auto latency = orderbook_mgr.get_latency_stats();
+    auto print_stage = [](const char *name, const LatencySummary &s)
+    {
+        if (s.count == 0)
+        {
+            return;
+        }
+        std::cout << "[Main] Latency " << name << " (us) - p50: " << s.p50_ns / 1000.0 << " | p99: " << s.p99_ns / 1000.0
+                  << " | p999: " << s.p999_ns / 1000.0 << " | n=" << s.count << std::endl;
+    };
+    print_stage("network", latency.network);
+    print_stage("parse", latency.parse);
+    print_stage("apply", latency.apply);
+    print_stage("dispatch", latency.dispatch);
+    print_stage("internal", latency.internal);
+    print_stage("end-to-end", latency.end_to_end);
 
     http_global_cleanup();
 
@@ -1,9 +1,13 @@
 #include "market_fetcher.hpp"
+#include "http_pool.hpp"
 #include <nlohmann/json.hpp>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <ctime>
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
 
 using json = nlohmann::json;
 
@@ -11,88 +15,58 @@ namespace polymarket
 {
 
     MarketFetcher::MarketFetcher(const Config &config)
-        : config_(config)
+        : config_(config),
+          gamma_([this](const std::string &path, HttpCallback callback)
+                 { gamma_http().submit("GET", path, "", {}, HttpPriority::NORMAL, std::move(callback)); },
+                 [this](const std::string &body, const std::string &ticker)
+                 { return parse_gamma_event(body, ticker); },
+                 config.gamma_cache_ttl_sec, config.gamma_miss_ttl_sec)
     {
         http_.set_base_url(config_.clob_rest_url);
         http_.set_timeout_ms(config_.http_timeout_ms);
+        HttpPool::global().attach(http_, config_.clob_rest_url);
     }
 
-    std::vector<ClobMarket> MarketFetcher::fetch_all_markets(int max_markets)
+    MarketFetcher::~MarketFetcher()
     {
-        std::vector<ClobMarket> markets;
-        std::string next_cursor;
-
-        while (markets.size() < static_cast<size_t>(max_markets))
+        // The Gamma callbacks touch gamma_, so finish them first
+        if (gamma_async_)
         {
-            std::string path = "/markets";
-            if (!next_cursor.empty())
-            {
-                path += "?next_cursor=" + next_cursor;
-            }
-
-            auto response = http_.get(path);
-            if (!response.ok())
-            {
-                std::cerr << "Failed to fetch markets: " << response.status_code
-                          << " - " << response.error << std::endl;
-                break;
-            }
-
-            try
-            {
-                auto parsed = parse_markets_response(response.body);
-                if (parsed.empty())
-                    break;
+            gamma_async_->stop();
+            HttpPool::global().detach(*gamma_async_);
+        }
+        if (clob_async_)
+        {
+            HttpPool::global().detach(*clob_async_);
+        }
+        HttpPool::global().detach(http_);
+    }
 
-                for (auto &m : parsed)
-                {
-                    if (markets.size() >= static_cast<size_t>(max_markets))
-                        break;
-                    markets.push_back(std::move(m));
-                }
+    std::vector<ClobMarket> MarketFetcher::fetch_all_markets(int max_markets)
+    {
+        return fetch_markets(MarketFilter{}, max_markets);
+    }
 
-                // Get next cursor from response
-                auto j = json::parse(response.body);
-                if (j.contains("next_cursor") && !j["next_cursor"].is_null())
-                {
-                    next_cursor = j["next_cursor"].get<std::string>();
-                }
-                else
-                {
-                    break;
-                }
-            }
-            catch (const std::exception &e)
-            {
-                std::cerr << "JSON parse error: " << e.what() << std::endl;
-                break;
-            }
+    std::vector<ClobMarket> MarketFetcher::fetch_markets(const MarketFilter &filter, int max_markets)
+    {
+        AsyncHttpClient &http = clob_http();
+        MarketPager pager([&http](const std::string &path)
+                          { return http.get(path); },
+                          "/markets", filter, static_cast<size_t>(std::max(0, max_markets)));
+        auto markets = pager.collect();
+        if (!pager.error().empty())
+        {
+            std::cerr << "Failed to fetch markets: " << pager.error() << std::endl;
         }
-
         return markets;
     }
 
     std::vector<ClobMarket> MarketFetcher::fetch_neg_risk_markets(int max_markets)
     {
-        auto all_markets = fetch_all_markets(max_markets * 5); // Fetch more to filter
-
-        std::vector<ClobMarket> valid_markets;
-        for (auto &m : all_markets)
-        {
-            // Filter for markets with valid tokens (Yes/No outcomes with token IDs)
-            bool has_valid_tokens = m.tokens.size() == 2 &&
-                                    !m.token_yes().empty() &&
-                                    !m.token_no().empty();
-
-            if (has_valid_tokens && !m.condition_id.empty())
-            {
-                valid_markets.push_back(std::move(m));
-                if (valid_markets.size() >= static_cast<size_t>(max_markets))
-                {
-                    break;
-                }
-            }
-        }
+        // Markets with valid tokens (Yes/No outcomes with token IDs); the rest are dropped while parsing
+        MarketFilter filter;
+        filter.tradable_only = true;
+        auto valid_markets = fetch_markets(filter, max_markets);
 
         std::cout << "[MarketFetcher] Found " << valid_markets.size()
                   << " markets with valid tokens" << std::endl;
@@ -130,80 +104,8 @@ namespace polymarket
     std::vector<ClobMarket> MarketFetcher::parse_markets_response(const std::string &json_str)
     {
         std::vector<ClobMarket> markets;
-
-        try
-        {
-            auto j = json::parse(json_str);
-
-            // Handle both array and object with "data" field
-            json market_array;
-            if (j.is_array())
-            {
-                market_array = j;
-            }
-            else if (j.contains("data") && j["data"].is_array())
-            {
-                market_array = j["data"];
-            }
-            else
-            {
-                return markets;
-            }
-
-            for (const auto &item : market_array)
-            {
-                ClobMarket market;
-
-                if (item.contains("condition_id"))
-                {
-                    market.condition_id = item["condition_id"].get<std::string>();
-                }
-                if (item.contains("question") && !item["question"].is_null())
-                {
-                    market.question = item["question"].get<std::string>();
-                }
-                if (item.contains("market_slug") && !item["market_slug"].is_null())
-                {
-                    market.market_slug = item["market_slug"].get<std::string>();
-                }
-                if (item.contains("neg_risk"))
-                {
-                    market.neg_risk = item["neg_risk"].get<bool>();
-                }
-                if (item.contains("active"))
-                {
-                    market.active = item["active"].get<bool>();
-                }
-                if (item.contains("closed"))
-                {
-                    market.closed = item["closed"].get<bool>();
-                }
-
-                if (item.contains("tokens") && item["tokens"].is_array())
-                {
-                    for (const auto &t : item["tokens"])
-                    {
-                        Token token;
-                        if (t.contains("token_id"))
-                        {
-                            token.token_id = t["token_id"].get<std::string>();
-                        }
-                        if (t.contains("outcome"))
-                        {
-                            token.outcome = t["outcome"].get<std::string>();
-                        }
-                        market.tokens.push_back(token);
-                    }
-                }
-
-                markets.push_back(std::move(market));
-            }
-        }
-        catch (const std::exception &e)
-        {
-            std::cerr << "Parse error: " << e.what() << std::endl;
-        }
-
+        std::string next_cursor;
+        MarketPager::parse_page(json_str, MarketFilter{}, markets, next_cursor);
         return markets;
     }
 
@@ -252,10 +154,9 @@ namespace polymarket
         }
     }
 
-    std::vector<uint64_t> MarketFetcher::get_15m_timestamps(int count)
+    std::vector<uint64_t> MarketFetcher::get_15m_timestamps(int count, uint64_t now)
     {
         std::vector<uint64_t> timestamps;
-        uint64_t now = now_sec();
         uint64_t interval = 15 * 60;
         uint64_t current_window = (now / interval) * interval;
 
@@ -267,10 +168,9 @@ namespace polymarket
         return timestamps;
     }
 
-    std::vector<uint64_t> MarketFetcher::get_4h_timestamps(int count)
+    std::vector<uint64_t> MarketFetcher::get_4h_timestamps(int count, uint64_t now)
     {
         std::vector<uint64_t> timestamps;
-        uint64_t now = now_sec();
         uint64_t interval = 4 * 60 * 60;
         uint64_t offset = 1 * 60 * 60; // 4h markets offset by 1h
         uint64_t adjusted = now - offset;
@@ -284,7 +184,7 @@ namespace polymarket
         return timestamps;
     }
 
-    std::vector<std::string> MarketFetcher::generate_1h_slugs(int count)
+    std::vector<std::string> MarketFetcher::generate_1h_slugs(int count, time_t now)
     {
         std::vector<std::string> slugs;
 
@@ -298,11 +198,8 @@ namespace polymarket
             {"xrp", "xrp"},
             {"sol", "solana"}};
 
-        // Get current time in ET (UTC-5)
-        time_t now = time(nullptr);
-        struct tm *utc = gmtime(&now);
+        // Time in ET (UTC-5)
         time_t et_time = now - 5 * 3600; // UTC-5
-        struct tm *et = gmtime(&et_time);
 
         for (const auto &[ticker, name] : crypto_names)
         {
@@ -333,36 +230,87 @@ namespace polymarket
         return slugs;
     }
 
-    std::vector<MarketState> MarketFetcher::fetch_crypto_15m_markets()
+    GammaCache::Query MarketFetcher::crypto_15m_query(uint64_t now)
     {
-        std::vector<MarketState> markets;
-        auto timestamps = get_15m_timestamps(3);
-
-        HttpClient gamma_http;
-        gamma_http.set_base_url(config_.gamma_api_url);
-        gamma_http.set_timeout_ms(config_.http_timeout_ms);
-
-        std::cout << "Fetching crypto up/down 15m markets from Gamma API...\n"
-                  << std::endl;
+        GammaCache::Query query;
+        auto timestamps = get_15m_timestamps(3, now);
+        for (const auto &ticker : config_.crypto_tickers)
+        {
+            for (const auto &ts : timestamps)
+            {
+                query.emplace_back(ticker + "-updown-15m-" + std::to_string(ts), ticker);
+            }
+        }
+        return query;
+    }
 
+    GammaCache::Query MarketFetcher::crypto_4h_query(uint64_t now)
+    {
+        GammaCache::Query query;
+        auto timestamps = get_4h_timestamps(3, now);
         for (const auto &ticker : config_.crypto_tickers)
         {
             for (const auto &ts : timestamps)
             {
-                std::string slug = ticker + "-updown-15m-" + std::to_string(ts);
-                std::string path = "/events?slug=" + slug;
+                query.emplace_back(ticker + "-updown-4h-" + std::to_string(ts), ticker);
+            }
+        }
+        return query;
+    }
 
-                auto response = gamma_http.get(path);
-                if (!response.ok())
-                    continue;
+    GammaCache::Query MarketFetcher::crypto_1h_query(uint64_t now)
+    {
+        GammaCache::Query query;
+        for (const auto &slug : generate_1h_slugs(3, static_cast<time_t>(now)))
+        {
+            // Extract ticker from slug
+            query.emplace_back(slug, slug.substr(0, slug.find('-')));
+        }
+        return query;
+    }
 
-                auto market = parse_gamma_event(response.body, ticker);
-                if (market)
-                {
-                    std::cout << "  Found: " << ticker << " - " << market->slug << std::endl;
-                    markets.push_back(std::move(*market));
-                }
-            }
+    AsyncHttpClient &MarketFetcher::gamma_http()
+    {
+        std::lock_guard<std::mutex> lock(gamma_mutex_);
+        if (!gamma_async_)
+        {
+            gamma_async_ = std::make_unique<AsyncHttpClient>();
+            gamma_async_->set_base_url(config_.gamma_api_url);
+            gamma_async_->set_timeout_ms(config_.http_timeout_ms);
+            gamma_async_->set_max_background(static_cast<size_t>(std::max(1, config_.gamma_max_in_flight)));
+            HttpPool::global().attach(*gamma_async_, config_.gamma_api_url);
+        }
+        return *gamma_async_;
+    }
+
+    AsyncHttpClient &MarketFetcher::clob_http()
+    {
+        std::lock_guard<std::mutex> lock(clob_async_mutex_);
+        if (!clob_async_)
+        {
+            clob_async_ = std::make_unique<AsyncHttpClient>();
+            clob_async_->set_base_url(config_.clob_rest_url);
+            clob_async_->set_timeout_ms(config_.http_timeout_ms);
+            HttpPool::global().attach(*clob_async_, config_.clob_rest_url);
+        }
+        return *clob_async_;
+    }
+
+    void MarketFetcher::clear_gamma_cache()
+    {
+        gamma_.clear();
+    }
+
+    std::vector<MarketState> MarketFetcher::fetch_crypto_15m_markets()
+    {
+        std::cout << "Fetching crypto up/down 15m markets from Gamma API...\n"
+                  << std::endl;
+
+        uint64_t now = now_sec();
+        auto markets = gamma_.lookup(crypto_15m_query(now), true, now);
+        for (const auto &market : markets)
+        {
+            std::cout << "  Found: " << market.symbol << " - " << market.slug << std::endl;
         }
 
         std::cout << "\nFound " << markets.size() << " crypto 15m markets\n"
@@ -372,34 +320,14 @@ namespace polymarket
 
     std::vector<MarketState> MarketFetcher::fetch_crypto_4h_markets()
     {
-        std::vector<MarketState> markets;
-        auto timestamps = get_4h_timestamps(3);
-
-        HttpClient gamma_http;
-        gamma_http.set_base_url(config_.gamma_api_url);
-        gamma_http.set_timeout_ms(config_.http_timeout_ms);
-
         std::cout << "Fetching crypto up/down 4h markets from Gamma API...\n"
                   << std::endl;
 
-        for (const auto &ticker : config_.crypto_tickers)
+        uint64_t now = now_sec();
+        auto markets = gamma_.lookup(crypto_4h_query(now), true, now);
+        for (const auto &market : markets)
         {
-            for (const auto &ts : timestamps)
-            {
-                std::string slug = ticker + "-updown-4h-" + std::to_string(ts);
-                std::string path = "/events?slug=" + slug;
-
-                auto response = gamma_http.get(path);
-                if (!response.ok())
-                    continue;
-
-                auto market = parse_gamma_event(response.body, ticker);
-                if (market)
-                {
-                    std::cout << "  Found: " << ticker << " - " << market->slug << std::endl;
-                    markets.push_back(std::move(*market));
-                }
-            }
+            std::cout << "  Found: " << market.symbol << " - " << market.slug << std::endl;
         }
 
         std::cout << "\nFound " << markets.size() << " crypto 4h markets\n"
@@ -409,33 +337,14 @@ namespace polymarket
 
     std::vector<MarketState> MarketFetcher::fetch_crypto_1h_markets()
     {
-        std::vector<MarketState> markets;
-        auto slugs = generate_1h_slugs(3);
-
-        HttpClient gamma_http;
-        gamma_http.set_base_url(config_.gamma_api_url);
-        gamma_http.set_timeout_ms(config_.http_timeout_ms);
-
         std::cout << "Fetching crypto up/down 1h markets from Gamma API...\n"
                   << std::endl;
 
-        for (const auto &slug : slugs)
+        uint64_t now = now_sec();
+        auto markets = gamma_.lookup(crypto_1h_query(now), true, now);
+        for (const auto &market : markets)
         {
-            std::string path = "/events?slug=" + slug;
-
-            auto response = gamma_http.get(path);
-            if (!response.ok())
-                continue;
-
-            // Extract ticker from slug
-            std::string ticker = slug.substr(0, slug.find('-'));
-
-            auto market = parse_gamma_event(response.body, ticker);
-            if (market)
-            {
-                markets.push_back(std::move(*market));
-                std::cout << "  Found: " << slug << std::endl;
-            }
+            std::cout << "  Found: " << market.slug << std::endl;
         }
 
         std::cout << "\nFound " << markets.size() << " crypto 1h markets\n"
@@ -443,6 +352,24 @@ namespace polymarket
         return markets;
     }
 
+    void MarketFetcher::prefetch_crypto_15m_markets()
+    {
+        uint64_t now = now_sec();
+        gamma_.lookup(crypto_15m_query(now + 15 * 60), false, now);
+    }
+
+    void MarketFetcher::prefetch_crypto_4h_markets()
+    {
+        uint64_t now = now_sec();
+        gamma_.lookup(crypto_4h_query(now + 4 * 60 * 60), false, now);
+    }
+
+    void MarketFetcher::prefetch_crypto_1h_markets()
+    {
+        uint64_t now = now_sec();
+        gamma_.lookup(crypto_1h_query(now + 60 * 60), false, now);
+    }
+
     std::optional<MarketState> MarketFetcher::parse_gamma_event(const std::string &json_str, const std::string &ticker)
     {
         try
@@ -505,4 +432,33 @@ namespace polymarket
         return state;
     }
 
+    std::vector<NegRiskEvent> MarketFetcher::group_neg_risk_events(const std::vector<ClobMarket> &markets)
+    {
+        std::vector<NegRiskEvent> events;
+        std::unordered_map<std::string, size_t> index_by_id;
+
+        for (const auto &market : markets)
+        {
+            if (!market.neg_risk || market.neg_risk_market_id.empty() || market.closed ||
+                market.token_yes().empty() || market.token_no().empty())
+            {
+                continue;
+            }
+
+            auto it = index_by_id.find(market.neg_risk_market_id);
+            if (it == index_by_id.end())
+            {
+                it = index_by_id.emplace(market.neg_risk_market_id, events.size()).first;
+                events.push_back(NegRiskEvent{market.neg_risk_market_id, {}});
+            }
+            events[it->second].outcomes.push_back(to_market_state(market));
+        }
+
+        events.erase(std::remove_if(events.begin(), events.end(),
+                                    [](const NegRiskEvent &event)
+                                    { return event.outcomes.size() < 2; }),
+                     events.end());
+        return events;
+    }
+
 } // namespace polymarket
@@ -0,0 +1,451 @@
+#include "market_pager.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+
+using json = nlohmann::json;
+
+namespace polymarket
+{
+
+    namespace
+    {
+        enum class Field
+        {
+            OTHER,
+            CONDITION_ID,
+            QUESTION,
+            MARKET_SLUG,
+            NEG_RISK_MARKET_ID,
+            NEG_RISK,
+            ACTIVE,
+            CLOSED,
+            TOKENS,
+            TAGS,
+            TOKEN_ID,
+            OUTCOME
+        };
+
+        Field market_field(const std::string &key)
+        {
+            static const std::pair<const char *, Field> kFields[] = {
+                {"condition_id", Field::CONDITION_ID},
+                {"question", Field::QUESTION},
+                {"market_slug", Field::MARKET_SLUG},
+                {"neg_risk_market_id", Field::NEG_RISK_MARKET_ID},
+                {"neg_risk", Field::NEG_RISK},
+                {"active", Field::ACTIVE},
+                {"closed", Field::CLOSED},
+                {"tokens", Field::TOKENS},
+                {"tags", Field::TAGS},
+            };
+            for (const auto &[name, field] : kFields)
+            {
+                if (key == name)
+                {
+                    return field;
+                }
+            }
+            return Field::OTHER;
+        }
+
+        Field token_field(const std::string &key)
+        {
+            if (key == "token_id")
+                return Field::TOKEN_ID;
+            if (key == "outcome")
+                return Field::OUTCOME;
+            return Field::OTHER;
+        }
+
+        // Builds markets straight from the token stream. Depth counts open objects and arrays; markets are the
+        // objects directly inside the top-level array or the top-level "data" array.
+        class PageHandler : public nlohmann::json_sax<json>
+        {
+        public:
+            PageHandler(const MarketFilter &filter, std::vector<ClobMarket> &out, std::string &next_cursor)
+                : filter_(filter), out_(out), next_cursor_(next_cursor)
+            {
+            }
+
+            size_t skipped{0};
+
+            bool null() override
+            {
+                if (depth_ == 1 && top_key_ == TopKey::CURSOR)
+                {
+                    next_cursor_.clear();
+                }
+                return true;
+            }
+
+            bool boolean(bool value) override
+            {
+                if (!in_market_ || depth_ != market_depth_)
+                {
+                    return true;
+                }
+                switch (field_)
+                {
+                case Field::NEG_RISK:
+                    market_.neg_risk = value;
+                    rejected_ = rejected_ || (filter_.neg_risk && *filter_.neg_risk != value);
+                    break;
+                case Field::ACTIVE:
+                    market_.active = value;
+                    rejected_ = rejected_ || (filter_.active_only && !value);
+                    break;
+                case Field::CLOSED:
+                    market_.closed = value;
+                    rejected_ = rejected_ || (filter_.active_only && value);
+                    break;
+                default:
+                    break;
+                }
+                return true;
+            }
+
+            bool number_integer(number_integer_t) override { return true; }
+            bool number_unsigned(number_unsigned_t) override { return true; }
+            bool number_float(number_float_t, const string_t &) override { return true; }
+            bool binary(binary_t &) override { return true; }
+
+            bool string(string_t &value) override
+            {
+                if (depth_ == 1 && top_key_ == TopKey::CURSOR)
+                {
+                    next_cursor_ = std::move(value);
+                    return true;
+                }
+                if (!in_market_ || rejected_)
+                {
+                    return true;
+                }
+                if (depth_ == market_depth_)
+                {
+                    switch (field_)
+                    {
+                    case Field::CONDITION_ID:
+                        market_.condition_id = std::move(value);
+                        break;
+                    case Field::QUESTION:
+                        market_.question = std::move(value);
+                        break;
+                    case Field::MARKET_SLUG:
+                        market_.market_slug = std::move(value);
+                        break;
+                    case Field::NEG_RISK_MARKET_ID:
+                        market_.neg_risk_market_id = std::move(value);
+                        break;
+                    default:
+                        break;
+                    }
+                }
+                else if (in_tags_ && depth_ == market_depth_ + 1)
+                {
+                    market_.tags.push_back(std::move(value));
+                }
+                else if (in_tokens_ && depth_ == market_depth_ + 2 && !market_.tokens.empty())
+                {
+                    if (token_field_ == Field::TOKEN_ID)
+                        market_.tokens.back().token_id = std::move(value);
+                    else if (token_field_ == Field::OUTCOME)
+                        market_.tokens.back().outcome = std::move(value);
+                }
+                return true;
+            }
+
+            bool start_object(std::size_t) override
+            {
+                depth_++;
+                if (market_depth_ != 0 && depth_ == market_depth_)
+                {
+                    begin_market();
+                }
+                else if (in_tokens_ && depth_ == market_depth_ + 2 && !rejected_)
+                {
+                    market_.tokens.emplace_back();
+                    token_field_ = Field::OTHER;
+                }
+                return true;
+            }
+
+            bool end_object() override
+            {
+                if (in_market_ && depth_ == market_depth_)
+                {
+                    finish_market();
+                }
+                depth_--;
+                return true;
+            }
+
+            bool start_array(std::size_t) override
+            {
+                if (market_depth_ == 0 && (depth_ == 0 || (depth_ == 1 && top_key_ == TopKey::DATA)))
+                {
+                    market_depth_ = depth_ + 2;
+                }
+                else if (in_market_ && depth_ == market_depth_)
+                {
+                    in_tokens_ = field_ == Field::TOKENS;
+                    in_tags_ = field_ == Field::TAGS;
+                }
+                depth_++;
+                return true;
+            }
+
+            bool end_array() override
+            {
+                depth_--;
+                if (in_market_ && depth_ == market_depth_)
+                {
+                    in_tokens_ = in_tags_ = false;
+                }
+                return true;
+            }
+
+            bool key(string_t &key) override
+            {
+                if (depth_ == 1)
+                {
+                    top_key_ = key == "next_cursor" ? TopKey::CURSOR : key == "data" ? TopKey::DATA
+                                                                                     : TopKey::OTHER;
+                }
+                else if (in_market_ && depth_ == market_depth_)
+                {
+                    field_ = market_field(key);
+                }
+                else if (in_tokens_ && depth_ == market_depth_ + 2)
+                {
+                    token_field_ = token_field(key);
+                }
+                return true;
+            }
+
+            bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) override
+            {
+                return false;
+            }
+
+        private:
+            enum class TopKey
+            {
+                OTHER,
+                DATA,
+                CURSOR
+            };
+
+            const MarketFilter &filter_;
+            std::vector<ClobMarket> &out_;
+            std::string &next_cursor_;
+
+            size_t depth_{0};
+            size_t market_depth_{0}; // 0 until the market array is found
+            TopKey top_key_{TopKey::OTHER};
+
+            ClobMarket market_; // Market being parsed; keeps its buffers across rejected markets
+            bool in_market_{false};
+            bool rejected_{false};
+            bool in_tokens_{false};
+            bool in_tags_{false};
+            Field field_{Field::OTHER};
+            Field token_field_{Field::OTHER};
+
+            void begin_market()
+            {
+                market_.condition_id.clear();
+                market_.question.clear();
+                market_.market_slug.clear();
+                market_.neg_risk_market_id.clear();
+                market_.tokens.clear();
+                market_.tags.clear();
+                market_.neg_risk = market_.active = market_.closed = false;
+                in_market_ = true;
+                rejected_ = false;
+                in_tokens_ = in_tags_ = false;
+                field_ = Field::OTHER;
+            }
+
+            void finish_market()
+            {
+                in_market_ = false;
+                if (!rejected_ && filter_.matches(market_))
+                {
+                    out_.push_back(std::move(market_));
+                }
+                else
+                {
+                    skipped++;
+                }
+            }
+        };
+    } // namespace
+
+    bool MarketFilter::matches(const ClobMarket &market) const
+    {
+        if (active_only && (!market.active || market.closed))
+            return false;
+        if (neg_risk && market.neg_risk != *neg_risk)
+            return false;
+        if (!tag.empty() && std::find(market.tags.begin(), market.tags.end(), tag) == market.tags.end())
+            return false;
+        if (tradable_only && (market.condition_id.empty() || market.tokens.size() != 2 ||
+                              market.token_yes().empty() || market.token_no().empty()))
+            return false;
+        return !predicate || predicate(market);
+    }
+
+    bool MarketPager::parse_page(std::string_view body, const MarketFilter &filter, std::vector<ClobMarket> &out,
+                                 std::string &next_cursor, size_t *skipped)
+    {
+        out.clear();
+        next_cursor.clear();
+        PageHandler handler(filter, out, next_cursor);
+        bool ok = json::sax_parse(body.begin(), body.end(), &handler);
+        if (!ok)
+        {
+            out.clear();
+            next_cursor.clear();
+        }
+        if (skipped)
+        {
+            *skipped = handler.skipped;
+        }
+        return ok;
+    }
+
+    std::optional<std::string> MarketPager::scan_cursor(std::string_view body)
+    {
+        // The key is usually at the end of the page; an escaped quote in front means it is inside a string
+        constexpr std::string_view kKey = "\"next_cursor\"";
+        size_t pos = body.rfind(kKey);
+        while (pos != std::string_view::npos && pos > 0 && body[pos - 1] == '\\')
+        {
+            pos = body.rfind(kKey, pos - 1);
+        }
+        if (pos == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+
+        size_t i = pos + kKey.size();
+        auto skip_space = [&]()
+        {
+            while (i < body.size() && (body[i] == ' ' || body[i] == '\t' || body[i] == '\n' || body[i] == '\r'))
+                i++;
+        };
+        skip_space();
+        if (i >= body.size() || body[i] != ':')
+        {
+            return std::nullopt;
+        }
+        i++;
+        skip_space();
+        if (i >= body.size() || body[i] != '"')
+        {
+            return std::nullopt;
+        }
+        size_t end = body.find('"', i + 1);
+        if (end == std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        return std::string(body.substr(i + 1, end - i - 1));
+    }
+
+    MarketPager::MarketPager(Fetch fetch, std::string endpoint, MarketFilter filter, size_t limit, std::string cursor)
+        : fetch_(std::move(fetch)), endpoint_(std::move(endpoint)), filter_(std::move(filter)), limit_(limit),
+          cursor_(std::move(cursor))
+    {
+        done_ = limit_ == 0 || cursor_ == "LTE=";
+    }
+
+    void MarketPager::request(const std::string &cursor)
+    {
+        std::string path = endpoint_;
+        if (!cursor.empty())
+        {
+            path += "?next_cursor=" + cursor;
+        }
+        pending_ = fetch_(path);
+    }
+
+    bool MarketPager::next(std::vector<ClobMarket> &out)
+    {
+        out.clear();
+        if (done_)
+        {
+            return false;
+        }
+        if (!pending_.valid())
+        {
+            request(cursor_);
+        }
+
+        HttpResponse response;
+        try
+        {
+            response = pending_.get();
+        }
+        catch (const std::future_error &e)
+        {
+            response = HttpResponse{0, "", e.what(), 0.0};
+        }
+        if (!response.ok())
+        {
+            done_ = true;
+            error_ = "HTTP " + std::to_string(response.status_code) + ": " + response.error;
+            return false;
+        }
+
+        // Ask for the next page before parsing this one, unless the last page alone already covered what is left
+        size_t remaining = limit_ - matched_;
+        auto scanned = scan_cursor(response.body);
+        bool prefetch = scanned && !is_end_cursor(*scanned) && *scanned != cursor_ &&
+                        (stats_.pages == 0 || last_page_matched_ < remaining);
+        if (prefetch)
+        {
+            request(*scanned);
+            stats_.prefetched++;
+        }
+
+        std::string next_cursor;
+        size_t skipped = 0;
+        if (!parse_page(response.body, filter_, out, next_cursor, &skipped))
+        {
+            done_ = true;
+            error_ = "malformed page at cursor '" + cursor_ + "'";
+            pending_ = {};
+            return false;
+        }
+        stats_.pages++;
+        stats_.markets += out.size() + skipped;
+        stats_.skipped += skipped;
+
+        last_page_matched_ = out.size();
+        if (out.size() > remaining)
+        {
+            out.resize(remaining);
+        }
+        matched_ += out.size();
+
+        if (prefetch && *scanned != next_cursor)
+        {
+            stats_.refetched++;
+            pending_ = {};
+        }
+        // A cursor that doesn't move would repeat the same page forever
+        done_ = matched_ >= limit_ || is_end_cursor(next_cursor) || next_cursor == cursor_;
+        cursor_ = std::move(next_cursor);
+        return true;
+    }
+
+    std::vector<ClobMarket> MarketPager::collect()
+    {
+        std::vector<ClobMarket> markets;
+        for_each([&markets](ClobMarket &&market)
+                 { markets.push_back(std::move(market)); });
+        return markets;
+    }
+
+} // namespace polymarket
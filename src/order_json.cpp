@@ -0,0 +1,135 @@
+#include "order_json.hpp"
+#include <charconv>
+#include <stdexcept>
+
+namespace polymarket
+{
+
+    namespace
+    {
+        void append_int(std::string &out, long long value)
+        {
+            char buf[24];
+            auto result = std::to_chars(buf, buf + sizeof(buf), value);
+            out.append(buf, result.ptr);
+        }
+
+        // The API takes the salt as a JSON number; parse it like std::stoll did so malformed salts still throw
+        long long parse_salt(const std::string &salt)
+        {
+            long long value = 0;
+            const char *begin = salt.data();
+            const char *end = begin + salt.size();
+            while (begin != end && (*begin == ' ' || *begin == '\t' || *begin == '\n'))
+            {
+                begin++;
+            }
+            if (begin != end && *begin == '+')
+            {
+                begin++;
+            }
+            auto result = std::from_chars(begin, end, value);
+            if (result.ec == std::errc::invalid_argument)
+            {
+                throw std::invalid_argument("invalid order salt: " + salt);
+            }
+            if (result.ec == std::errc::result_out_of_range)
+            {
+                throw std::out_of_range("order salt out of range: " + salt);
+            }
+            return value;
+        }
+
+        void append_field(std::string &out, std::string_view key, std::string_view value)
+        {
+            out += '"';
+            out += key;
+            out += "\":";
+            append_json_string(out, value);
+        }
+    }
+
+    void append_json_string(std::string &out, std::string_view value)
+    {
+        static const char kHex[] = "0123456789abcdef";
+
+        out += '"';
+        size_t run = 0; // Start of the pending run of bytes that need no escaping
+        for (size_t i = 0; i < value.size(); i++)
+        {
+            unsigned char c = static_cast<unsigned char>(value[i]);
+            if (c >= 0x20 && c != '"' && c != '\\')
+            {
+                continue;
+            }
+            out.append(value.data() + run, i - run);
+            run = i + 1;
+            switch (c)
+            {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\b':
+                out += "\\b";
+                break;
+            case '\f':
+                out += "\\f";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                out += "\\u00";
+                out += kHex[c >> 4];
+                out += kHex[c & 0xf];
+                break;
+            }
+        }
+        out.append(value.data() + run, value.size() - run);
+        out += '"';
+    }
+
+    void append_order_payload(std::string &out, const SignedOrder &order, std::string_view owner,
+                              std::string_view order_type, bool post_only)
+    {
+        out += "{\"order\":{\"salt\":";
+        append_int(out, parse_salt(order.salt));
+        out += ',';
+        append_field(out, "maker", order.maker);
+        out += ',';
+        append_field(out, "signer", order.signer);
+        out += ',';
+        append_field(out, "taker", order.taker);
+        out += ',';
+        append_field(out, "tokenId", order.token_id);
+        out += ',';
+        append_field(out, "makerAmount", order.maker_amount);
+        out += ',';
+        append_field(out, "takerAmount", order.taker_amount);
+        out += order.side == 0 ? ",\"side\":\"BUY\"," : ",\"side\":\"SELL\",";
+        append_field(out, "expiration", order.expiration);
+        out += ',';
+        append_field(out, "nonce", order.nonce);
+        out += ',';
+        append_field(out, "feeRateBps", order.fee_rate_bps);
+        out += ",\"signatureType\":";
+        append_int(out, order.signature_type);
+        out += ',';
+        append_field(out, "signature", order.signature);
+        out += "},";
+        append_field(out, "owner", owner);
+        out += ',';
+        append_field(out, "orderType", order_type);
+        out += post_only ? ",\"deferExec\":false,\"postOnly\":true}" : ",\"deferExec\":false}";
+    }
+
+} // namespace polymarket
@@ -0,0 +1,609 @@
+#include "order_manager.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace polymarket
+{
+
+    namespace
+    {
+        double amount(const std::string &wei)
+        {
+            try
+            {
+                return wei.empty() ? 0.0 : std::stod(wei) / 1e6;
+            }
+            catch (...)
+            {
+                return 0.0;
+            }
+        }
+
+        double number(const std::string &value)
+        {
+            try
+            {
+                return value.empty() ? 0.0 : std::stod(value);
+            }
+            catch (...)
+            {
+                return 0.0;
+            }
+        }
+
+        bool is_dead(OrderState state)
+        {
+            return state == OrderState::FILLED || state == OrderState::CANCELED;
+        }
+
+        // State of an order the CLOB refused to cancel, from the not_canceled reason (the API's exact texts). Any
+        // other reason, including ones that don't say whether it matched, needs a status query.
+        std::optional<OrderState> refused_cancel_state(const std::string &reason)
+        {
+            if (reason == "order already canceled")
+            {
+                return OrderState::CANCELED;
+            }
+            if (reason == "order already matched")
+            {
+                return OrderState::FILLED;
+            }
+            return std::nullopt;
+        }
+
+        // State from the status field of GET /order
+        OrderState order_status_state(const std::string &status)
+        {
+            if (status == "LIVE")
+            {
+                return OrderState::LIVE;
+            }
+            if (status == "MATCHED")
+            {
+                return OrderState::FILLED;
+            }
+            if (status == "CANCELED")
+            {
+                return OrderState::CANCELED;
+            }
+            return OrderState::UNKNOWN;
+        }
+
+        OrderResponse failure(const std::string &error)
+        {
+            OrderResponse response{};
+            response.success = false;
+            response.error_msg = error;
+            return response;
+        }
+
+        // Price and size of a signed order from its amounts (BUY: maker pays USDC for taker shares)
+        TrackedOrder from_signed(const std::string &id, const SignedOrder &order)
+        {
+            TrackedOrder tracked;
+            tracked.id = id;
+            tracked.token_id = order.token_id;
+            tracked.side = order.side == 0 ? OrderSide::BUY : OrderSide::SELL;
+            double maker = amount(order.maker_amount);
+            double taker = amount(order.taker_amount);
+            double shares = tracked.side == OrderSide::BUY ? taker : maker;
+            double usdc = tracked.side == OrderSide::BUY ? maker : taker;
+            tracked.original_size = shares;
+            tracked.price = shares > 0 ? usdc / shares : 0.0;
+            return tracked;
+        }
+    } // namespace
+
+    OrderManager::OrderManager(ClobClient &client, OrderManagerConfig config)
+        : client_(client), config_(config)
+    {
+        config_.max_post_batch = std::max<size_t>(config_.max_post_batch, 1);
+        config_.max_cancel_batch = std::max<size_t>(config_.max_cancel_batch, 1);
+        flusher_ = std::thread([this]()
+                               { run(); });
+    }
+
+    OrderManager::~OrderManager()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        flusher_.join();
+    }
+
+    void OrderManager::mark_queued()
+    {
+        if (!has_work())
+        {
+            first_queued_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    bool OrderManager::queue_cancel(const std::string &order_id)
+    {
+        stats_.cancels++;
+        auto it = orders_.find(order_id);
+        if (it != orders_.end() && (is_dead(it->second.order.state) || it->second.order.state == OrderState::CANCEL_PENDING))
+        {
+            stats_.cancels_suppressed++;
+            return false;
+        }
+        if (it == orders_.end())
+        {
+            Entry entry;
+            entry.order.id = order_id;
+            entry.known = false;
+            it = orders_.emplace(order_id, std::move(entry)).first;
+        }
+        it->second.order.state = OrderState::CANCEL_PENDING;
+        it->second.order.updated_ns = now_ns();
+        mark_queued();
+        cancel_queue_.push_back(order_id);
+        return true;
+    }
+
+    bool OrderManager::cancel(const std::string &order_id)
+    {
+        bool queued;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queued = queue_cancel(order_id);
+        }
+        if (queued)
+        {
+            cv_.notify_all();
+        }
+        return queued;
+    }
+
+    std::future<OrderResponse> OrderManager::post(const SignedOrder &order, OrderType order_type)
+    {
+        PendingPost pending{order, order_type, "", {}};
+        auto future = pending.promise.get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.posts++;
+            mark_queued();
+            post_queue_.push_back(std::move(pending));
+        }
+        cv_.notify_all();
+        return future;
+    }
+
+    std::future<OrderResponse> OrderManager::replace(const std::string &order_id, const SignedOrder &order,
+                                                     OrderType order_type)
+    {
+        PendingPost pending{order, order_type, order_id, {}};
+        auto future = pending.promise.get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.posts++;
+            auto it = orders_.find(order_id);
+            if (it != orders_.end() && is_dead(it->second.order.state))
+            {
+                stats_.posts_rejected++;
+                pending.promise.set_value(failure("order " + order_id + " is no longer live"));
+                return future;
+            }
+
+            // A replacement of the same order still waiting to go out is overtaken by this one
+            auto queued = std::find_if(post_queue_.begin(), post_queue_.end(), [&order_id](const PendingPost &p)
+                                       { return p.replaces == order_id; });
+            if (queued != post_queue_.end())
+            {
+                stats_.posts_superseded++;
+                queued->promise.set_value(failure("superseded by a newer replace of " + order_id));
+                queued->order = order;
+                queued->order_type = order_type;
+                queued->promise = std::move(pending.promise);
+                return future;
+            }
+
+            queue_cancel(order_id);
+            mark_queued();
+            post_queue_.push_back(std::move(pending));
+        }
+        cv_.notify_all();
+        return future;
+    }
+
+    void OrderManager::flush()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            flush_now_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    bool OrderManager::wait_idle(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return idle_cv_.wait_for(lock, timeout, [this]()
+                                 { return !has_work() && !in_flight_; });
+    }
+
+    void OrderManager::run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            cv_.wait(lock, [this]()
+                     { return stopping_ || has_work(); });
+            if (!has_work())
+            {
+                return; // Stopping with nothing left to send
+            }
+
+            // Let the window fill up unless asked to go now
+            cv_.wait_until(lock, first_queued_ + config_.coalesce_window, [this]()
+                           { return stopping_ || flush_now_ || post_queue_.size() >= config_.max_post_batch; });
+            flush_now_ = false;
+
+            // Orders that died while their cancel was queued (user channel) need no request
+            std::vector<std::string> cancels;
+            cancels.reserve(cancel_queue_.size());
+            for (auto &id : cancel_queue_)
+            {
+                auto it = orders_.find(id);
+                if (it != orders_.end() && it->second.order.state != OrderState::CANCEL_PENDING)
+                {
+                    stats_.cancels_suppressed++;
+                    continue;
+                }
+                cancels.push_back(std::move(id));
+            }
+            cancel_queue_.clear();
+            std::vector<PendingPost> posts;
+            posts.swap(post_queue_);
+            in_flight_ = true;
+
+            lock.unlock();
+            send(std::move(cancels), std::move(posts));
+            lock.lock();
+
+            in_flight_ = false;
+            prune();
+            idle_cv_.notify_all();
+        }
+    }
+
+    void OrderManager::send(std::vector<std::string> cancels, std::vector<PendingPost> posts)
+    {
+        // Replacements wait for their cancel; plain posts go out alongside the cancels
+        std::vector<PendingPost> replacements;
+        for (auto it = posts.begin(); it != posts.end();)
+        {
+            if (it->replaces.empty())
+            {
+                ++it;
+                continue;
+            }
+            replacements.push_back(std::move(*it));
+            it = posts.erase(it);
+        }
+
+        std::vector<std::pair<std::vector<std::string>, std::future<CancelResponse>>> cancel_batches;
+        for (size_t i = 0; i < cancels.size(); i += config_.max_cancel_batch)
+        {
+            std::vector<std::string> batch(cancels.begin() + i, cancels.begin() + std::min(cancels.size(), i + config_.max_cancel_batch));
+            std::future<CancelResponse> future;
+            try
+            {
+                future = client_.cancel_orders_async(batch);
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "[OrderManager] Cancel batch failed: " << e.what() << std::endl;
+                std::promise<CancelResponse> failed;
+                failed.set_value(CancelResponse{});
+                future = failed.get_future();
+            }
+            cancel_batches.emplace_back(std::move(batch), std::move(future));
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.cancel_requests += cancel_batches.size();
+        }
+
+        PostBatches post_batches = send_posts(posts);
+
+        std::vector<std::string> unsettled; // Refused for a reason we can't read: ask the server
+        for (auto &[ids, future] : cancel_batches)
+        {
+            CancelResponse response = future.get();
+            std::lock_guard<std::mutex> lock(mutex_);
+            uint64_t now = now_ns();
+            if (!response.success)
+            {
+                stats_.cancel_errors++;
+            }
+            for (const auto &id : ids)
+            {
+                auto it = orders_.find(id);
+                if (it == orders_.end() || it->second.order.state != OrderState::CANCEL_PENDING)
+                {
+                    continue; // Settled by the user channel meanwhile
+                }
+                OrderState state = OrderState::LIVE; // Failed: let a later cancel try again
+                if (std::find(response.canceled.begin(), response.canceled.end(), id) != response.canceled.end())
+                {
+                    state = OrderState::CANCELED;
+                }
+                else if (auto reason = response.not_canceled.find(id); reason != response.not_canceled.end())
+                {
+                    std::optional<OrderState> refused = refused_cancel_state(reason->second);
+                    state = refused.value_or(OrderState::UNKNOWN);
+                    if (!refused)
+                    {
+                        unsettled.push_back(id);
+                    }
+                }
+                if (state == OrderState::LIVE && !it->second.known)
+                {
+                    orders_.erase(it);
+                    continue;
+                }
+                it->second.order.state = state;
+                it->second.order.updated_ns = now;
+            }
+        }
+        query_status(unsettled);
+
+        // Only a confirmed cancel lets its replacement out; a fill or a failed cancel keeps the old order's exposure
+        std::vector<PendingPost> confirmed;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto &pending : replacements)
+            {
+                auto it = orders_.find(pending.replaces);
+                OrderState state = it != orders_.end() ? it->second.order.state : OrderState::LIVE;
+                if (state == OrderState::CANCELED)
+                {
+                    confirmed.push_back(std::move(pending));
+                    continue;
+                }
+                stats_.replaces_aborted++;
+                pending.promise.set_value(failure(state == OrderState::FILLED
+                                                      ? "order " + pending.replaces + " filled before it was canceled, replacement not sent"
+                                                      : "cancel of " + pending.replaces + " not confirmed, replacement not sent"));
+            }
+        }
+
+        PostBatches replacement_batches = send_posts(confirmed);
+        finish_posts(posts, std::move(post_batches));
+        finish_posts(confirmed, std::move(replacement_batches));
+    }
+
+    OrderManager::PostBatches OrderManager::send_posts(std::vector<PendingPost> &posts)
+    {
+        PostBatches batches;
+        for (size_t i = 0; i < posts.size(); i += config_.max_post_batch)
+        {
+            std::vector<BatchOrderEntry> batch;
+            for (size_t k = i; k < std::min(posts.size(), i + config_.max_post_batch); k++)
+            {
+                batch.push_back(BatchOrderEntry{posts[k].order, posts[k].order_type});
+            }
+            std::future<std::vector<OrderResponse>> future;
+            try
+            {
+                future = client_.post_orders_async(batch, config_.post_only);
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "[OrderManager] Post batch failed: " << e.what() << std::endl;
+                std::promise<std::vector<OrderResponse>> failed;
+                failed.set_value({});
+                future = failed.get_future();
+            }
+            batches.emplace_back(i, std::move(future));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.post_requests += batches.size();
+        return batches;
+    }
+
+    void OrderManager::finish_posts(std::vector<PendingPost> &posts, PostBatches batches)
+    {
+        for (auto &[first, future] : batches)
+        {
+            std::vector<OrderResponse> responses = future.get();
+            size_t count = std::min(posts.size() - first, config_.max_post_batch);
+            for (size_t k = 0; k < count; k++)
+            {
+                PendingPost &pending = posts[first + k];
+                if (k >= responses.size())
+                {
+                    pending.promise.set_value(failure("no response for order in batch"));
+                    continue;
+                }
+                const OrderResponse &response = responses[k];
+                if (response.success && !response.order_id.empty())
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    auto [it, inserted] = orders_.try_emplace(response.order_id);
+                    if (inserted || !it->second.known)
+                    {
+                        // The user channel may have seen it first; don't undo a cancel or fill it reported
+                        OrderState state = it->second.order.state;
+                        it->second.order = from_signed(response.order_id, pending.order);
+                        it->second.known = true;
+                        if (!inserted)
+                        {
+                            it->second.order.state = state;
+                        }
+                        else if (response.status == "matched")
+                        {
+                            it->second.order.state = OrderState::FILLED;
+                        }
+                        else if (response.status == "unmatched")
+                        {
+                            it->second.order.state = OrderState::CANCELED; // FAK/FOK remainder killed
+                        }
+                    }
+                    it->second.order.updated_ns = now_ns();
+                }
+                pending.promise.set_value(response);
+            }
+        }
+    }
+
+    void OrderManager::query_status(const std::vector<std::string> &order_ids)
+    {
+        for (const auto &id : order_ids)
+        {
+            std::optional<OpenOrder> open;
+            try
+            {
+                open = client_.get_order(id);
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "[OrderManager] Status query failed: " << e.what() << std::endl;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = orders_.find(id);
+            if (!open || it == orders_.end() || it->second.order.state != OrderState::UNKNOWN)
+            {
+                continue; // Stays UNKNOWN, or the user channel settled it meanwhile
+            }
+            it->second.order.state = order_status_state(open->status);
+            if (!open->size_matched.empty())
+            {
+                it->second.order.size_matched = number(open->size_matched);
+            }
+            it->second.order.updated_ns = now_ns();
+        }
+    }
+
+    void OrderManager::on_user_order(const UserOrderEvent &event)
+    {
+        if (event.id.empty())
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry &entry = orders_[event.id];
+        TrackedOrder &order = entry.order;
+        if (order.id.empty() || !entry.known)
+        {
+            order.id = event.id;
+            order.token_id = event.asset_id;
+            order.side = event.side == "SELL" ? OrderSide::SELL : OrderSide::BUY;
+            order.price = number(event.price);
+            order.original_size = number(event.original_size);
+            if (!entry.known && order.state != OrderState::CANCEL_PENDING)
+            {
+                order.state = OrderState::LIVE;
+            }
+            entry.known = true;
+        }
+        if (!event.market.empty())
+        {
+            order.market = event.market;
+        }
+        if (!event.original_size.empty())
+        {
+            order.original_size = number(event.original_size);
+        }
+        if (!event.size_matched.empty())
+        {
+            order.size_matched = number(event.size_matched);
+        }
+
+        if (event.type == "CANCELLATION")
+        {
+            order.state = OrderState::CANCELED;
+        }
+        else if (order.original_size > 0 && order.size_matched >= order.original_size - 1e-9)
+        {
+            order.state = OrderState::FILLED;
+        }
+        order.updated_ns = now_ns();
+    }
+
+    void OrderManager::track(const OpenOrder &open)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry &entry = orders_[open.id];
+        if (entry.known && !entry.order.id.empty() && entry.order.state != OrderState::UNKNOWN)
+        {
+            return;
+        }
+        TrackedOrder &order = entry.order;
+        order.id = open.id;
+        order.market = open.market;
+        order.token_id = open.asset_id;
+        order.side = open.side == "SELL" ? OrderSide::SELL : OrderSide::BUY;
+        order.price = number(open.price);
+        order.original_size = number(open.original_size);
+        order.size_matched = number(open.size_matched);
+        if (order.state != OrderState::CANCEL_PENDING)
+        {
+            order.state = OrderState::LIVE;
+        }
+        order.updated_ns = now_ns();
+        entry.known = true;
+    }
+
+    std::optional<TrackedOrder> OrderManager::order(const std::string &order_id) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = orders_.find(order_id);
+        if (it == orders_.end() || !it->second.known)
+        {
+            return std::nullopt;
+        }
+        return it->second.order;
+    }
+
+    std::vector<TrackedOrder> OrderManager::live_orders() const
+    {
+        std::vector<TrackedOrder> live;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &[id, entry] : orders_)
+        {
+            if (entry.known && !is_dead(entry.order.state))
+            {
+                live.push_back(entry.order);
+            }
+        }
+        return live;
+    }
+
+    OrderManagerStats OrderManager::stats() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        OrderManagerStats stats = stats_;
+        for (const auto &[id, entry] : orders_)
+        {
+            if (entry.known && !is_dead(entry.order.state))
+            {
+                stats.live_orders++;
+            }
+        }
+        return stats;
+    }
+
+    void OrderManager::prune()
+    {
+        uint64_t cutoff = now_ns() - static_cast<uint64_t>(std::chrono::nanoseconds(config_.retain_dead).count());
+        for (auto it = orders_.begin(); it != orders_.end();)
+        {
+            if (is_dead(it->second.order.state) && it->second.order.updated_ns < cutoff)
+            {
+                it = orders_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+} // namespace polymarket
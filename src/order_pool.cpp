@@ -0,0 +1,405 @@
+#include "order_pool.hpp"
+#include "fixed_point.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace polymarket
+{
+
+    OrderPool::OrderPool(OrderSigner &signer, OrderPoolConfig config)
+        : signer_(signer), config_(std::move(config))
+    {
+        if (config_.maker.empty())
+        {
+            config_.maker = signer_.address();
+        }
+        worker_ = std::thread([this]()
+                              { run(); });
+    }
+
+    OrderPool::~OrderPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        work_cv_.notify_all();
+        ready_cv_.notify_all();
+        if (worker_.joinable())
+        {
+            worker_.join();
+        }
+    }
+
+    double OrderPool::shares_for(double size_usdc, double price)
+    {
+        if (price <= 0)
+        {
+            return 0;
+        }
+        return std::floor(size_usdc / price * 100) / 100;
+    }
+
+    double OrderPool::tick_price(int64_t ticks) const
+    {
+        // Round to the tick's decimals so the signed amounts match what the arb path computes
+        return std::round(ticks * config_.tick_size * 1e6) / 1e6;
+    }
+
+    int64_t OrderPool::to_ticks(double price) const
+    {
+        return std::llround(price / config_.tick_size);
+    }
+
+    void OrderPool::clear_entries()
+    {
+        for (auto &leg : legs_)
+        {
+            discarded_ += leg.entries.size();
+            leg.entries.clear();
+        }
+    }
+
+    void OrderPool::set_legs(const std::vector<std::string> &token_ids)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            generation_++;
+
+            // Legs that stay keep their price and orders (a staged market becoming the active one)
+            std::vector<Leg> legs;
+            for (const auto &token_id : token_ids)
+            {
+                auto it = std::find_if(legs_.begin(), legs_.end(), [&](const Leg &leg)
+                                       { return leg.token_id == token_id; });
+                if (it != legs_.end())
+                {
+                    legs.push_back(std::move(*it));
+                    legs_.erase(it);
+                }
+                else
+                {
+                    legs.push_back(Leg{token_id, 0, {}});
+                }
+            }
+            clear_entries();
+            legs_ = std::move(legs);
+            dirty_ = true;
+        }
+        work_cv_.notify_one();
+    }
+
+    void OrderPool::update_price(const std::string &token_id, double best_ask)
+    {
+        int64_t ticks = best_ask > 0 && best_ask < 1 ? to_ticks(best_ask) : 0;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &leg : legs_)
+        {
+            if (leg.token_id == token_id)
+            {
+                if (leg.ask_ticks != ticks)
+                {
+                    leg.ask_ticks = ticks;
+                    dirty_ = true;
+                    work_cv_.notify_one();
+                }
+                return;
+            }
+        }
+    }
+
+    void OrderPool::set_sizes(const std::vector<double> &sizes_usdc)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_.sizes_usdc = sizes_usdc;
+            dirty_ = true;
+        }
+        work_cv_.notify_one();
+    }
+
+    void OrderPool::set_nonce(const std::string &nonce)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_.nonce = nonce;
+            generation_++;
+            clear_entries();
+            dirty_ = true;
+        }
+        work_cv_.notify_one();
+    }
+
+    void OrderPool::invalidate()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            generation_++;
+            clear_entries();
+            dirty_ = true;
+        }
+        work_cv_.notify_one();
+    }
+
+    bool OrderPool::usable(const Entry &entry, uint64_t now) const
+    {
+        return entry.expires_at == 0 || entry.expires_at > now + config_.refresh_margin_sec;
+    }
+
+    bool OrderPool::wanted(const Leg &leg, int64_t price_ticks, double shares) const
+    {
+        int64_t max_ticks = to_ticks(1.0) - 1;
+        if (leg.ask_ticks <= 0 || price_ticks < leg.ask_ticks || price_ticks >= leg.ask_ticks + config_.levels ||
+            price_ticks > max_ticks)
+        {
+            return false;
+        }
+        double price = tick_price(price_ticks);
+        for (double size : config_.sizes_usdc)
+        {
+            if (shares_for(size, price) == shares)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<OrderPool::Pending> OrderPool::plan(uint64_t now)
+    {
+        std::vector<Pending> pending;
+        int64_t max_ticks = to_ticks(1.0) - 1;
+        uint64_t expires_at = config_.ttl_sec ? now + config_.ttl_sec : 0;
+
+        for (size_t i = 0; i < legs_.size(); i++)
+        {
+            Leg &leg = legs_[i];
+
+            // Drop what fell off the grid or is about to expire
+            auto stale = std::remove_if(leg.entries.begin(), leg.entries.end(), [&](const Entry &entry)
+                                        { return !usable(entry, now) || !wanted(leg, entry.price_ticks, entry.shares); });
+            discarded_ += static_cast<uint64_t>(leg.entries.end() - stale);
+            leg.entries.erase(stale, leg.entries.end());
+
+            if (leg.ask_ticks <= 0)
+            {
+                continue;
+            }
+            for (int64_t ticks = leg.ask_ticks; ticks < leg.ask_ticks + config_.levels && ticks <= max_ticks; ticks++)
+            {
+                double price = tick_price(ticks);
+                for (double size : config_.sizes_usdc)
+                {
+                    double shares = shares_for(size, price);
+                    if (shares <= 0)
+                    {
+                        continue;
+                    }
+                    bool have = std::any_of(leg.entries.begin(), leg.entries.end(), [&](const Entry &entry)
+                                            { return entry.price_ticks == ticks && entry.shares == shares; }) ||
+                                std::any_of(pending.begin(), pending.end(), [&](const Pending &p)
+                                            { return p.leg == i && p.price_ticks == ticks && p.shares == shares; });
+                    if (!have)
+                    {
+                        pending.push_back(Pending{i, ticks, shares, expires_at});
+                    }
+                }
+            }
+        }
+        return pending;
+    }
+
+    bool OrderPool::complete() const
+    {
+        if (dirty_)
+        {
+            return false;
+        }
+        int64_t max_ticks = to_ticks(1.0) - 1;
+        for (const auto &leg : legs_)
+        {
+            if (leg.ask_ticks <= 0)
+            {
+                continue;
+            }
+            for (int64_t ticks = leg.ask_ticks; ticks < leg.ask_ticks + config_.levels && ticks <= max_ticks; ticks++)
+            {
+                double price = tick_price(ticks);
+                for (double size : config_.sizes_usdc)
+                {
+                    double shares = shares_for(size, price);
+                    if (shares > 0 && std::none_of(leg.entries.begin(), leg.entries.end(), [&](const Entry &entry)
+                                                   { return entry.price_ticks == ticks && entry.shares == shares; }))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    OrderData OrderPool::make_order(const Leg &leg, int64_t price_ticks, double shares, uint64_t expires_at) const
+    {
+        // Same amounts as the arb path: USDC rounded to cents, shares as given
+        Fixed6 size = Fixed6::from_double(shares, Rounding::DOWN);
+        Fixed6 usdc = Fixed6::mul(size, Fixed6::from_double(tick_price(price_ticks)), Rounding::NEAREST, 2);
+        bool buy = config_.side == OrderSide::BUY;
+
+        OrderData order;
+        order.maker = config_.maker;
+        order.taker = "0x0000000000000000000000000000000000000000";
+        order.token_id = leg.token_id;
+        order.maker_amount = (buy ? usdc : size).to_wei();
+        order.taker_amount = (buy ? size : usdc).to_wei();
+        order.side = config_.side;
+        order.fee_rate_bps = config_.fee_rate_bps;
+        order.nonce = config_.nonce;
+        order.signer = signer_.address();
+        order.expiration = std::to_string(expires_at);
+        order.signature_type = config_.signature_type;
+        return order;
+    }
+
+    void OrderPool::run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            // Wake on changes, and once a second to re-sign orders that are nearing expiry
+            work_cv_.wait_for(lock, std::chrono::seconds(1), [this]()
+                              { return stopping_ || dirty_; });
+            if (stopping_)
+            {
+                return;
+            }
+            dirty_ = false;
+
+            auto pending = plan(now_sec());
+            if (pending.empty())
+            {
+                ready_cv_.notify_all();
+                continue;
+            }
+
+            uint64_t generation = generation_;
+            std::vector<OrderData> orders;
+            orders.reserve(pending.size());
+            for (const auto &p : pending)
+            {
+                orders.push_back(make_order(legs_[p.leg], p.price_ticks, p.shares, p.expires_at));
+            }
+            std::string exchange_address = config_.exchange_address;
+
+            // Sign without the lock so take() and update_price() never wait on ECDSA
+            lock.unlock();
+            std::vector<SignedOrder> signed_orders;
+            try
+            {
+                signed_orders = signer_.sign_orders(orders, exchange_address);
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "[OrderPool] Signing failed: " << e.what() << std::endl;
+            }
+            lock.lock();
+
+            signed_ += signed_orders.size();
+            if (generation != generation_)
+            {
+                discarded_ += signed_orders.size();
+                continue;
+            }
+            for (size_t i = 0; i < signed_orders.size(); i++)
+            {
+                const Pending &p = pending[i];
+                Leg &leg = legs_[p.leg];
+                if (!wanted(leg, p.price_ticks, p.shares))
+                {
+                    discarded_++;
+                    continue;
+                }
+                leg.entries.push_back(Entry{p.price_ticks, p.shares, p.expires_at, std::move(signed_orders[i])});
+            }
+            ready_cv_.notify_all();
+        }
+    }
+
+    std::optional<SignedOrder> OrderPool::take(const std::string &token_id, double price, double max_shares)
+    {
+        // A price off the grid has no pre-signed order; snapping it would sign a different limit than asked for
+        int64_t ticks = to_ticks(price);
+        if (std::fabs(tick_price(ticks) - price) > 1e-9)
+        {
+            misses_++;
+            return std::nullopt;
+        }
+        uint64_t now = now_sec();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &leg : legs_)
+        {
+            if (leg.token_id != token_id)
+            {
+                continue;
+            }
+
+            size_t best = leg.entries.size();
+            for (size_t i = 0; i < leg.entries.size(); i++)
+            {
+                const Entry &entry = leg.entries[i];
+                if (entry.price_ticks == ticks && entry.shares <= max_shares + 1e-9 && usable(entry, now) &&
+                    (best == leg.entries.size() || entry.shares > leg.entries[best].shares))
+                {
+                    best = i;
+                }
+            }
+            if (best == leg.entries.size())
+            {
+                break;
+            }
+
+            SignedOrder order = std::move(leg.entries[best].order);
+            if (best + 1 != leg.entries.size())
+            {
+                leg.entries[best] = std::move(leg.entries.back());
+            }
+            leg.entries.pop_back();
+            hits_++;
+
+            // Sign a replacement with a fresh salt
+            dirty_ = true;
+            work_cv_.notify_one();
+            return order;
+        }
+        misses_++;
+        return std::nullopt;
+    }
+
+    bool OrderPool::wait_ready(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return ready_cv_.wait_for(lock, timeout, [this]()
+                                  { return stopping_ || complete(); }) &&
+               !stopping_;
+    }
+
+    OrderPoolStats OrderPool::stats() const
+    {
+        OrderPoolStats s;
+        s.hits = hits_.load();
+        s.misses = misses_.load();
+        s.signed_orders = signed_.load();
+        s.discarded = discarded_.load();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &leg : legs_)
+        {
+            s.ready += leg.entries.size();
+        }
+        return s;
+    }
+
+} // namespace polymarket
@@ -1,10 +1,16 @@
 #include "order_signer.hpp"
+#include "fixed_point.hpp"
 #include "http_client.hpp"
 #include <secp256k1.h>
 #include <secp256k1_recovery.h>
 #include <ethash/keccak.hpp>
 #include <openssl/hmac.h>
 #include <openssl/evp.h>
+#include <openssl/crypto.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#endif
 #include <nlohmann/json.hpp>
 #include <random>
 #include <sstream>
@@ -12,67 +18,386 @@
 #include <cstring>
 #include <stdexcept>
 #include <chrono>
+#include <algorithm>
+#include <string_view>
+#include <thread>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
 
 using json = nlohmann::json;
 
 namespace polymarket
 {
 
-    std::string to_hex(const std::vector<uint8_t> &data)
+    namespace
     {
-        std::stringstream ss;
-        ss << "0x";
-        for (auto b : data)
+        // Compile-time Keccak-256 for the fixed EIP-712 type strings and constant fields
+        constexpr uint64_t kKeccakRoundConstants[24] = {
+            0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+            0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+            0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+            0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+            0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+            0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL};
+        constexpr int kKeccakRotations[24] = {1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14,
+                                              27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44};
+        constexpr int kKeccakLanes[24] = {10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4,
+                                          15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1};
+
+        constexpr uint64_t rotl64(uint64_t x, int n)
+        {
+            return (x << n) | (x >> (64 - n));
+        }
+
+        constexpr void keccak_f1600(uint64_t (&state)[25])
+        {
+            for (int round = 0; round < 24; round++)
+            {
+                uint64_t columns[5]{};
+                for (int i = 0; i < 5; i++)
+                {
+                    columns[i] = state[i] ^ state[i + 5] ^ state[i + 10] ^ state[i + 15] ^ state[i + 20];
+                }
+                for (int i = 0; i < 5; i++)
+                {
+                    uint64_t t = columns[(i + 4) % 5] ^ rotl64(columns[(i + 1) % 5], 1);
+                    for (int j = 0; j < 25; j += 5)
+                    {
+                        state[j + i] ^= t;
+                    }
+                }
+
+                uint64_t carry = state[1];
+                for (int i = 0; i < 24; i++)
+                {
+                    int lane = kKeccakLanes[i];
+                    uint64_t next = state[lane];
+                    state[lane] = rotl64(carry, kKeccakRotations[i]);
+                    carry = next;
+                }
+
+                for (int j = 0; j < 25; j += 5)
+                {
+                    uint64_t row[5]{};
+                    for (int i = 0; i < 5; i++)
+                    {
+                        row[i] = state[j + i];
+                    }
+                    for (int i = 0; i < 5; i++)
+                    {
+                        state[j + i] ^= ~row[(i + 1) % 5] & row[(i + 2) % 5];
+                    }
+                }
+                state[0] ^= kKeccakRoundConstants[round];
+            }
+        }
+
+        constexpr std::array<uint8_t, 32> keccak256_constexpr(std::string_view data)
+        {
+            constexpr size_t kRate = 136;
+            uint64_t state[25]{};
+            size_t offset = 0;
+            while (true)
+            {
+                size_t take = std::min(kRate, data.size() - offset);
+                for (size_t i = 0; i < take; i++)
+                {
+                    state[i / 8] ^= static_cast<uint64_t>(static_cast<uint8_t>(data[offset + i])) << (8 * (i % 8));
+                }
+                offset += take;
+                if (take < kRate)
+                {
+                    // Keccak (not SHA-3) padding
+                    state[take / 8] ^= uint64_t{0x01} << (8 * (take % 8));
+                    state[(kRate - 1) / 8] ^= uint64_t{0x80} << (8 * ((kRate - 1) % 8));
+                    keccak_f1600(state);
+                    break;
+                }
+                keccak_f1600(state);
+            }
+
+            std::array<uint8_t, 32> hash{};
+            for (size_t i = 0; i < 32; i++)
+            {
+                hash[i] = static_cast<uint8_t>(state[i / 8] >> (8 * (i % 8)));
+            }
+            return hash;
+        }
+
+        static_assert(keccak256_constexpr("")[0] == 0xc5 && keccak256_constexpr("")[31] == 0x70,
+                      "constexpr keccak256 mismatch");
+
+        constexpr auto kExchangeDomainTypeHash =
+            keccak256_constexpr("EIP712Domain(string name,string version,uint256 chainId,address verifyingContract)");
+        constexpr auto kExchangeNameHash = keccak256_constexpr("Polymarket CTF Exchange");
+        constexpr auto kExchangeVersionHash = keccak256_constexpr("1");
+        constexpr auto kOrderTypeHash = keccak256_constexpr(
+            "Order(uint256 salt,address maker,address signer,address taker,uint256 tokenId,"
+            "uint256 makerAmount,uint256 takerAmount,uint256 expiration,uint256 nonce,"
+            "uint256 feeRateBps,uint8 side,uint8 signatureType)");
+
+        constexpr auto kClobAuthDomainTypeHash = keccak256_constexpr("EIP712Domain(string name,string version,uint256 chainId)");
+        constexpr auto kClobAuthNameHash = keccak256_constexpr("ClobAuthDomain");
+        constexpr auto kClobAuthVersionHash = keccak256_constexpr("1");
+        constexpr auto kClobAuthTypeHash = keccak256_constexpr("ClobAuth(address address,string timestamp,uint256 nonce,string message)");
+        constexpr auto kClobAuthMessageHash = keccak256_constexpr("This message attests that I control the given wallet");
+
+        bool has_hex_prefix(const std::string &value)
         {
-            ss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(b);
+            return value.size() >= 2 && value[0] == '0' && (value[1] == 'x' || value[1] == 'X');
         }
-        return ss.str();
+
+        constexpr char kHexDigits[] = "0123456789abcdef";
+
+        // 256-entry lookup tables, built at compile time
+        constexpr std::array<int8_t, 256> make_hex_values()
+        {
+            std::array<int8_t, 256> values{};
+            for (auto &v : values)
+                v = -1;
+            for (int i = 0; i < 10; i++)
+                values['0' + i] = static_cast<int8_t>(i);
+            for (int i = 0; i < 6; i++)
+            {
+                values['a' + i] = static_cast<int8_t>(10 + i);
+                values['A' + i] = static_cast<int8_t>(10 + i);
+            }
+            return values;
+        }
+        constexpr auto kHexValues = make_hex_values();
+
+        constexpr std::array<std::array<char, 2>, 256> make_hex_pairs()
+        {
+            std::array<std::array<char, 2>, 256> pairs{};
+            for (int i = 0; i < 256; i++)
+            {
+                pairs[i] = {kHexDigits[i >> 4], kHexDigits[i & 0x0F]};
+            }
+            return pairs;
+        }
+        constexpr auto kHexPairs = make_hex_pairs();
+
+        // "0x" + lowercase hex of data into out[0 .. 2 + 2 * size)
+        void hex_encode(const uint8_t *data, size_t size, char *out)
+        {
+            out[0] = '0';
+            out[1] = 'x';
+            for (size_t i = 0; i < size; i++)
+            {
+                std::memcpy(out + 2 + 2 * i, kHexPairs[data[i]].data(), 2);
+            }
+        }
+
+        // Optionally 0x-prefixed hex of exactly size bytes into out
+        bool parse_hex(const std::string &hex, uint8_t *out, size_t size)
+        {
+            size_t begin = has_hex_prefix(hex) ? 2 : 0;
+            if (hex.size() - begin != size * 2)
+            {
+                return false;
+            }
+            for (size_t i = 0; i < size; i++)
+            {
+                int hi = kHexValues[static_cast<uint8_t>(hex[begin + 2 * i])];
+                int lo = kHexValues[static_cast<uint8_t>(hex[begin + 2 * i + 1])];
+                if (hi < 0 || lo < 0)
+                {
+                    return false;
+                }
+                out[i] = static_cast<uint8_t>(hi << 4 | lo);
+            }
+            return true;
+        }
+
+        constexpr char kBase64Std[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        constexpr char kBase64Url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+        // Both standard (+/) and URL-safe (-_) alphabets decode
+        constexpr std::array<int8_t, 256> make_base64_values()
+        {
+            std::array<int8_t, 256> values{};
+            for (auto &v : values)
+                v = -1;
+            for (int i = 0; i < 64; i++)
+            {
+                values[static_cast<uint8_t>(kBase64Std[i])] = static_cast<int8_t>(i);
+                values[static_cast<uint8_t>(kBase64Url[i])] = static_cast<int8_t>(i);
+            }
+            return values;
+        }
+        constexpr auto kBase64Values = make_base64_values();
+
+        std::vector<uint8_t> base64_decode(const std::string &encoded)
+        {
+            std::vector<uint8_t> result;
+            result.reserve(encoded.size() * 3 / 4);
+            uint32_t val = 0;
+            int bits = 0;
+            for (unsigned char c : encoded)
+            {
+                if (c == '=')
+                    break;
+                int v = kBase64Values[c];
+                if (v < 0)
+                    continue;
+                val = (val << 6) | static_cast<uint32_t>(v);
+                bits += 6;
+                if (bits >= 8)
+                {
+                    bits -= 8;
+                    result.push_back(static_cast<uint8_t>(val >> bits));
+                }
+            }
+            return result;
+        }
+
+        // Padded base64 of data into out[0 .. 4 * ceil(size / 3)); returns the length written
+        size_t base64_encode(const uint8_t *data, size_t size, char *out, bool url_safe)
+        {
+            const char *alphabet = url_safe ? kBase64Url : kBase64Std;
+            size_t n = 0;
+            size_t i = 0;
+            for (; i + 3 <= size; i += 3)
+            {
+                uint32_t v = static_cast<uint32_t>(data[i]) << 16 | static_cast<uint32_t>(data[i + 1]) << 8 | data[i + 2];
+                out[n++] = alphabet[v >> 18];
+                out[n++] = alphabet[(v >> 12) & 0x3F];
+                out[n++] = alphabet[(v >> 6) & 0x3F];
+                out[n++] = alphabet[v & 0x3F];
+            }
+            if (i < size)
+            {
+                uint32_t v = static_cast<uint32_t>(data[i]) << 16;
+                if (i + 1 < size)
+                    v |= static_cast<uint32_t>(data[i + 1]) << 8;
+                out[n++] = alphabet[v >> 18];
+                out[n++] = alphabet[(v >> 12) & 0x3F];
+                out[n++] = i + 1 < size ? alphabet[(v >> 6) & 0x3F] : '=';
+                out[n++] = '=';
+            }
+            return n;
+        }
+
+        // Big-endian uint64 into the low 8 bytes of a zeroed 32-byte word
+        void encode_uint64(uint64_t value, uint8_t *word)
+        {
+            for (int i = 0; i < 8; i++)
+            {
+                word[31 - i] = static_cast<uint8_t>(value >> (i * 8));
+            }
+        }
+
+        // Decimal or 0x-hex string into a zeroed 32-byte big-endian word (mod 2^256), without allocating
+        void encode_uint256(const std::string &value, uint8_t *word)
+        {
+            if (has_hex_prefix(value))
+            {
+                // Right-aligned nibbles, least significant first
+                size_t nibble = 0;
+                for (size_t i = value.size(); i > 2 && nibble < 64; i--, nibble++)
+                {
+                    int v = kHexValues[static_cast<uint8_t>(value[i - 1])];
+                    if (v < 0)
+                    {
+                        throw std::runtime_error("Invalid hex uint256: " + value);
+                    }
+                    word[31 - nibble / 2] |= static_cast<uint8_t>(nibble % 2 ? v << 4 : v);
+                }
+                return;
+            }
+
+            // value = value * 10 + digit over eight 32-bit limbs (least significant first)
+            uint32_t limbs[8]{};
+            for (char c : value)
+            {
+                if (c < '0' || c > '9')
+                {
+                    throw std::runtime_error("Invalid decimal uint256: " + value);
+                }
+                uint64_t carry = static_cast<uint64_t>(c - '0');
+                for (uint32_t &limb : limbs)
+                {
+                    uint64_t v = static_cast<uint64_t>(limb) * 10 + carry;
+                    limb = static_cast<uint32_t>(v);
+                    carry = v >> 32;
+                }
+            }
+            for (int i = 0; i < 8; i++)
+            {
+                for (int b = 0; b < 4; b++)
+                {
+                    word[31 - (i * 4 + b)] = static_cast<uint8_t>(limbs[i] >> (b * 8));
+                }
+            }
+        }
+
+        // 0x-prefixed 20-byte address into out[0..20) (left untouched, i.e. zero, for an empty address)
+        void parse_address(const std::string &address, uint8_t *out)
+        {
+            if (!address.empty() && !parse_hex(address, out, 20))
+            {
+                throw std::runtime_error("Invalid address: " + address);
+            }
+        }
+    } // namespace
+
+    std::string to_hex(const std::vector<uint8_t> &data)
+    {
+        std::string out(2 + data.size() * 2, '\0');
+        hex_encode(data.data(), data.size(), out.data());
+        return out;
     }
 
     std::string to_hex(const std::array<uint8_t, 32> &data)
     {
-        std::stringstream ss;
-        ss << "0x";
-        for (auto b : data)
-        {
-            ss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(b);
-        }
-        return ss.str();
+        char out[2 + 64];
+        hex_encode(data.data(), data.size(), out);
+        return std::string(out, sizeof(out));
     }
 
     std::vector<uint8_t> from_hex(const std::string &hex)
     {
-        std::string h = hex;
-        if (h.substr(0, 2) == "0x" || h.substr(0, 2) == "0X")
-        {
-            h = h.substr(2);
-        }
-        std::vector<uint8_t> result;
-        result.reserve(h.size() / 2);
-        for (size_t i = 0; i < h.size(); i += 2)
+        size_t begin = has_hex_prefix(hex) ? 2 : 0;
+        std::vector<uint8_t> result((hex.size() - begin) / 2);
+        if (!parse_hex(hex, result.data(), result.size()))
         {
-            uint8_t byte = static_cast<uint8_t>(std::stoi(h.substr(i, 2), nullptr, 16));
-            result.push_back(byte);
+            throw std::runtime_error("Invalid hex string");
         }
         return result;
     }
 
     std::array<uint8_t, 32> keccak256(const std::vector<uint8_t> &data)
     {
-        auto hash = ethash::keccak256(data.data(), data.size());
-        std::array<uint8_t, 32> result;
-        std::memcpy(result.data(), hash.bytes, 32);
-        return result;
+        return keccak256(data.data(), data.size());
     }
 
     std::array<uint8_t, 32> keccak256(const std::string &data)
     {
-        std::vector<uint8_t> bytes(data.begin(), data.end());
-        return keccak256(bytes);
+        return keccak256(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+    }
+
+    std::array<uint8_t, 32> keccak256(const uint8_t *data, size_t size)
+    {
+        auto hash = ethash::keccak256(data, size);
+        std::array<uint8_t, 32> result;
+        std::memcpy(result.data(), hash.bytes, 32);
+        return result;
     }
 
     std::string to_wei(double amount, int decimals, bool round_down)
     {
+        if (decimals == Fixed6::kDecimals)
+        {
+            // USDC and outcome shares: straight to integer micros
+            return Fixed6::from_double(amount, round_down ? Rounding::DOWN : Rounding::NEAREST).to_wei();
+        }
+
         // Use string-based conversion to avoid floating point precision issues
         // This ensures exact decimal representation for API requirements
 
@@ -124,305 +449,172 @@ namespace polymarket
     std::string generate_salt()
     {
         // Generate a random decimal number (like TS client does)
-        std::random_device rd;
-        std::mt19937_64 gen(rd());
+        // Seeded once per thread: a random_device read and engine seeding per salt cost more than the signature hash
+        thread_local std::mt19937_64 gen(std::random_device{}());
         std::uniform_int_distribution<uint64_t> dis(0, 999999999999ULL);
         return std::to_string(dis(gen));
     }
 
-    static std::vector<uint8_t> base64_decode(const std::string &encoded)
-    {
-        // Support both standard (+/) and URL-safe (-_) base64
-        static const std::string base64_chars =
-            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-        std::vector<uint8_t> result;
-        std::vector<int> T(256, -1);
-        for (int i = 0; i < 64; i++)
-            T[base64_chars[i]] = i;
-        // Also map URL-safe variants
-        T['-'] = 62;
-        T['_'] = 63;
-        int val = 0, valb = -8;
-        for (unsigned char c : encoded)
-        {
-            if (c == '=')
-                break;
-            if (T[c] == -1)
-                continue;
-            val = (val << 6) + T[c];
-            valb += 6;
-            if (valb >= 0)
-            {
-                result.push_back((val >> valb) & 0xFF);
-                valb -= 8;
-            }
-        }
-        return result;
-    }
-
-    static std::string base64_encode(const std::vector<uint8_t> &data, bool url_safe = false)
+    OrderSigner::OrderSigner(const std::string &private_key, int chain_id)
+        : chain_id_(chain_id)
     {
-        // Standard base64 or URL-safe base64
-        static const char *base64_chars_std =
-            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-        static const char *base64_chars_url =
-            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
-        const char *base64_chars = url_safe ? base64_chars_url : base64_chars_std;
+        unsigned int cores = std::thread::hardware_concurrency();
+        signing_threads_ = cores > 1 ? std::min<size_t>(4, cores - 1) : 0;
 
-        std::string result;
-        int val = 0, valb = -6;
-        for (uint8_t c : data)
+        // Parse the key once into a fixed buffer kept out of swap (best effort: mlock may hit RLIMIT_MEMLOCK)
+        if (!parse_hex(private_key, secret_key_.data(), secret_key_.size()))
         {
-            val = (val << 8) + c;
-            valb += 8;
-            while (valb >= 0)
-            {
-                result.push_back(base64_chars[(val >> valb) & 0x3F]);
-                valb -= 6;
-            }
+            throw std::runtime_error("Invalid private key length");
         }
-        if (valb > -6)
-            result.push_back(base64_chars[((val << 8) >> (valb + 8)) & 0x3F]);
-
-        // Add padding
-        while (result.size() % 4 != 0)
-            result.push_back('=');
+#if defined(__unix__) || defined(__APPLE__)
+        key_locked_ = mlock(secret_key_.data(), secret_key_.size()) == 0;
+#endif
 
-        return result;
-    }
-
-    OrderSigner::OrderSigner(const std::string &private_key, int chain_id)
-        : private_key_(private_key), chain_id_(chain_id)
-    {
         secp256k1_ctx_ = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
         if (!secp256k1_ctx_)
         {
             throw std::runtime_error("Failed to create secp256k1 context");
         }
         address_ = derive_address();
+
+        // Domain separators depend only on the chain and the verifying contract
+        for (size_t i = 0; i < exchange_domains_.size(); i++)
+        {
+            const std::string &address = i == 0 ? EXCHANGE_ADDRESS : NEG_RISK_EXCHANGE_ADDRESS;
+            parse_address(address, exchange_domains_[i].contract.data());
+            exchange_domains_[i].separator = hash_domain(exchange_domains_[i].contract);
+        }
+        clob_auth_domain_ = hash_clob_auth_domain();
     }
 
     OrderSigner::~OrderSigner()
     {
+        pool_.reset();
         if (secp256k1_ctx_)
         {
             secp256k1_context_destroy(static_cast<secp256k1_context *>(secp256k1_ctx_));
         }
+        free_hmac();
+
+        OPENSSL_cleanse(secret_key_.data(), secret_key_.size());
+#if defined(__unix__) || defined(__APPLE__)
+        if (key_locked_)
+        {
+            munlock(secret_key_.data(), secret_key_.size());
+        }
+#endif
     }
 
     std::string OrderSigner::derive_address()
     {
         auto ctx = static_cast<secp256k1_context *>(secp256k1_ctx_);
-        auto pk_bytes = from_hex(private_key_);
-        if (pk_bytes.size() != 32)
-        {
-            throw std::runtime_error("Invalid private key length");
-        }
         secp256k1_pubkey pubkey;
-        if (!secp256k1_ec_pubkey_create(ctx, &pubkey, pk_bytes.data()))
+        if (!secp256k1_ec_pubkey_create(ctx, &pubkey, secret_key_.data()))
         {
             throw std::runtime_error("Failed to create public key");
         }
         uint8_t pubkey_serialized[65];
         size_t pubkey_len = 65;
         secp256k1_ec_pubkey_serialize(ctx, pubkey_serialized, &pubkey_len, &pubkey, SECP256K1_EC_UNCOMPRESSED);
-        std::vector<uint8_t> pubkey_data(pubkey_serialized + 1, pubkey_serialized + 65);
-        auto hash = keccak256(pubkey_data);
+        auto hash = keccak256(pubkey_serialized + 1, 64);
 
-        // Build lowercase address first
-        std::stringstream ss_lower;
-        for (int i = 12; i < 32; i++)
-        {
-            ss_lower << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(hash[i]);
-        }
-        std::string addr_lower = ss_lower.str();
+        // Lowercase address first ("0x" + 40 hex chars)
+        char addr[2 + 40];
+        hex_encode(hash.data() + 12, 20, addr);
 
         // EIP-55 checksum: hash the lowercase address and use it to determine case
-        auto addr_hash = keccak256(addr_lower);
-
-        std::stringstream ss;
-        ss << "0x";
+        auto addr_hash = keccak256(reinterpret_cast<const uint8_t *>(addr + 2), 40);
         for (size_t i = 0; i < 40; i++)
         {
-            char c = addr_lower[i];
-            if (c >= 'a' && c <= 'f')
+            char &c = addr[2 + i];
+            int hash_nibble = (addr_hash[i / 2] >> (i % 2 == 0 ? 4 : 0)) & 0x0F;
+            if (c >= 'a' && c <= 'f' && hash_nibble >= 8)
             {
-                // Get the corresponding nibble from the hash
-                int hash_nibble = (addr_hash[i / 2] >> (i % 2 == 0 ? 4 : 0)) & 0x0F;
-                if (hash_nibble >= 8)
-                {
-                    c = std::toupper(c);
-                }
+                c = static_cast<char>(c - 'a' + 'A');
             }
-            ss << c;
         }
-        return ss.str();
+        return std::string(addr, sizeof(addr));
     }
 
     std::string OrderSigner::sign_hash(const std::array<uint8_t, 32> &hash)
     {
-        auto ctx = static_cast<secp256k1_context *>(secp256k1_ctx_);
-        auto pk_bytes = from_hex(private_key_);
+        return sign_hash_with(secp256k1_ctx_, hash);
+    }
+
+    std::string OrderSigner::sign_hash_with(void *context, const std::array<uint8_t, 32> &hash) const
+    {
+        auto ctx = static_cast<secp256k1_context *>(context);
         secp256k1_ecdsa_recoverable_signature sig;
-        if (!secp256k1_ecdsa_sign_recoverable(ctx, &sig, hash.data(), pk_bytes.data(), nullptr, nullptr))
+        if (!secp256k1_ecdsa_sign_recoverable(ctx, &sig, hash.data(), secret_key_.data(), nullptr, nullptr))
         {
             throw std::runtime_error("Failed to sign");
         }
-        uint8_t sig_serialized[64];
+        uint8_t signature[65];
         int recid;
-        secp256k1_ecdsa_recoverable_signature_serialize_compact(ctx, sig_serialized, &recid, &sig);
-        std::vector<uint8_t> signature(65);
-        std::memcpy(signature.data(), sig_serialized, 64);
+        secp256k1_ecdsa_recoverable_signature_serialize_compact(ctx, signature, &recid, &sig);
         signature[64] = static_cast<uint8_t>(recid + 27);
-        return to_hex(signature);
+
+        std::string out(2 + 2 * sizeof(signature), '\0');
+        hex_encode(signature, sizeof(signature), out.data());
+        return out;
     }
 
-    std::array<uint8_t, 32> OrderSigner::hash_domain(const std::string &name, const std::string &version,
-                                                     int chain_id, const std::string &verifying_contract)
+    std::array<uint8_t, 32> OrderSigner::hash_domain(const std::array<uint8_t, 20> &verifying_contract) const
     {
-        auto type_hash = keccak256(std::string("EIP712Domain(string name,string version,uint256 chainId,address verifyingContract)"));
-        auto name_hash = keccak256(name);
-        auto version_hash = keccak256(version);
-        std::vector<uint8_t> chain_id_bytes(32, 0);
-        for (int i = 0; i < 4; i++)
-        {
-            chain_id_bytes[31 - i] = (chain_id >> (i * 8)) & 0xFF;
-        }
-        auto contract_bytes = from_hex(verifying_contract);
-        std::vector<uint8_t> contract_padded(32, 0);
-        std::memcpy(contract_padded.data() + 12, contract_bytes.data(), 20);
-        std::vector<uint8_t> encoded;
-        encoded.insert(encoded.end(), type_hash.begin(), type_hash.end());
-        encoded.insert(encoded.end(), name_hash.begin(), name_hash.end());
-        encoded.insert(encoded.end(), version_hash.begin(), version_hash.end());
-        encoded.insert(encoded.end(), chain_id_bytes.begin(), chain_id_bytes.end());
-        encoded.insert(encoded.end(), contract_padded.begin(), contract_padded.end());
-        return keccak256(encoded);
+        // EIP712Domain(name, version, chainId, verifyingContract): 5 words
+        std::array<uint8_t, 5 * 32> encoded{};
+        std::memcpy(encoded.data(), kExchangeDomainTypeHash.data(), 32);
+        std::memcpy(encoded.data() + 32, kExchangeNameHash.data(), 32);
+        std::memcpy(encoded.data() + 64, kExchangeVersionHash.data(), 32);
+        encode_uint64(static_cast<uint64_t>(chain_id_), encoded.data() + 96);
+        std::memcpy(encoded.data() + 128 + 12, verifying_contract.data(), 20);
+        return keccak256(encoded.data(), encoded.size());
     }
 
-    std::array<uint8_t, 32> OrderSigner::hash_order(const OrderData &order, const std::string &salt)
+    std::array<uint8_t, 32> OrderSigner::exchange_domain(const std::string &exchange_address) const
     {
-        auto type_hash = keccak256(std::string(
-            "Order(uint256 salt,address maker,address signer,address taker,uint256 tokenId,"
-            "uint256 makerAmount,uint256 takerAmount,uint256 expiration,uint256 nonce,"
-            "uint256 feeRateBps,uint8 side,uint8 signatureType)"));
-
-        auto encode_uint256 = [](const std::string &value) -> std::vector<uint8_t>
+        std::array<uint8_t, 20> contract{};
+        parse_address(exchange_address, contract.data());
+        for (const auto &domain : exchange_domains_)
         {
-            std::vector<uint8_t> result(32, 0);
-            if (value.empty())
-            {
-                return result;
-            }
-            if (value.size() >= 2 && value.substr(0, 2) == "0x")
-            {
-                // Hex string
-                auto bytes = from_hex(value);
-                size_t offset = 32 - std::min(bytes.size(), size_t(32));
-                std::memcpy(result.data() + offset, bytes.data(), std::min(bytes.size(), size_t(32)));
-            }
-            else if (value.size() <= 18)
-            {
-                // Small enough for uint64_t
-                uint64_t val = std::stoull(value);
-                for (int i = 0; i < 8; i++)
-                {
-                    result[31 - i] = (val >> (i * 8)) & 0xFF;
-                }
-            }
-            else
+            if (domain.contract == contract)
             {
-                // Large decimal - convert to bytes manually using repeated division
-                std::string num = value;
-                std::vector<uint8_t> bytes;
-                while (!num.empty() && num != "0")
-                {
-                    // Divide by 256 and get remainder
-                    int remainder = 0;
-                    std::string quotient;
-                    for (char c : num)
-                    {
-                        int digit = remainder * 10 + (c - '0');
-                        if (!quotient.empty() || digit / 256 > 0)
-                        {
-                            quotient += ('0' + digit / 256);
-                        }
-                        remainder = digit % 256;
-                    }
-                    bytes.push_back(static_cast<uint8_t>(remainder));
-                    num = quotient.empty() ? "0" : quotient;
-                }
-                // Copy bytes in reverse (big-endian)
-                size_t offset = 32 - std::min(bytes.size(), size_t(32));
-                for (size_t i = 0; i < std::min(bytes.size(), size_t(32)); i++)
-                {
-                    result[31 - i] = bytes[i];
-                }
+                return domain.separator;
             }
-            return result;
-        };
-
-        auto encode_address = [](const std::string &addr) -> std::vector<uint8_t>
-        {
-            auto bytes = from_hex(addr);
-            std::vector<uint8_t> result(32, 0);
-            std::memcpy(result.data() + 12, bytes.data(), std::min(bytes.size(), size_t(20)));
-            return result;
-        };
-
-        std::vector<uint8_t> encoded;
-        encoded.insert(encoded.end(), type_hash.begin(), type_hash.end());
-
-        auto salt_enc = encode_uint256(salt);
-        encoded.insert(encoded.end(), salt_enc.begin(), salt_enc.end());
-
-        auto maker_enc = encode_address(order.maker);
-        encoded.insert(encoded.end(), maker_enc.begin(), maker_enc.end());
-
-        auto signer_enc = encode_address(order.signer);
-        encoded.insert(encoded.end(), signer_enc.begin(), signer_enc.end());
-
-        auto taker_enc = encode_address(order.taker);
-        encoded.insert(encoded.end(), taker_enc.begin(), taker_enc.end());
-
-        auto token_enc = encode_uint256(order.token_id);
-        encoded.insert(encoded.end(), token_enc.begin(), token_enc.end());
-
-        auto maker_amt_enc = encode_uint256(order.maker_amount);
-        encoded.insert(encoded.end(), maker_amt_enc.begin(), maker_amt_enc.end());
-
-        auto taker_amt_enc = encode_uint256(order.taker_amount);
-        encoded.insert(encoded.end(), taker_amt_enc.begin(), taker_amt_enc.end());
-
-        auto exp_enc = encode_uint256(order.expiration);
-        encoded.insert(encoded.end(), exp_enc.begin(), exp_enc.end());
-
-        auto nonce_enc = encode_uint256(order.nonce);
-        encoded.insert(encoded.end(), nonce_enc.begin(), nonce_enc.end());
-
-        auto fee_enc = encode_uint256(order.fee_rate_bps);
-        encoded.insert(encoded.end(), fee_enc.begin(), fee_enc.end());
-
-        std::vector<uint8_t> side_enc(32, 0);
-        side_enc[31] = static_cast<uint8_t>(order.side);
-        encoded.insert(encoded.end(), side_enc.begin(), side_enc.end());
-
-        std::vector<uint8_t> sig_type_enc(32, 0);
-        sig_type_enc[31] = static_cast<uint8_t>(order.signature_type);
-        encoded.insert(encoded.end(), sig_type_enc.begin(), sig_type_enc.end());
+        }
+        return hash_domain(contract);
+    }
 
-        return keccak256(encoded);
+    std::array<uint8_t, 32> OrderSigner::hash_order(const OrderData &order, const std::string &salt) const
+    {
+        // Type hash followed by the 12 Order fields, one 32-byte word each
+        std::array<uint8_t, 13 * 32> encoded{};
+        uint8_t *word = encoded.data();
+        std::memcpy(word, kOrderTypeHash.data(), 32);
+        encode_uint256(salt, word + 1 * 32);
+        parse_address(order.maker, word + 2 * 32 + 12);
+        parse_address(order.signer, word + 3 * 32 + 12);
+        parse_address(order.taker, word + 4 * 32 + 12);
+        encode_uint256(order.token_id, word + 5 * 32);
+        encode_uint256(order.maker_amount, word + 6 * 32);
+        encode_uint256(order.taker_amount, word + 7 * 32);
+        encode_uint256(order.expiration, word + 8 * 32);
+        encode_uint256(order.nonce, word + 9 * 32);
+        encode_uint256(order.fee_rate_bps, word + 10 * 32);
+        word[11 * 32 + 31] = static_cast<uint8_t>(order.side);
+        word[12 * 32 + 31] = static_cast<uint8_t>(order.signature_type);
+        return keccak256(encoded.data(), encoded.size());
     }
 
     std::array<uint8_t, 32> OrderSigner::encode_eip712(const std::array<uint8_t, 32> &domain_hash,
                                                        const std::array<uint8_t, 32> &struct_hash)
     {
-        std::vector<uint8_t> encoded;
-        encoded.push_back(0x19);
-        encoded.push_back(0x01);
-        encoded.insert(encoded.end(), domain_hash.begin(), domain_hash.end());
-        encoded.insert(encoded.end(), struct_hash.begin(), struct_hash.end());
-        return keccak256(encoded);
+        std::array<uint8_t, 2 + 32 + 32> encoded;
+        encoded[0] = 0x19;
+        encoded[1] = 0x01;
+        std::memcpy(encoded.data() + 2, domain_hash.data(), 32);
+        std::memcpy(encoded.data() + 34, struct_hash.data(), 32);
+        return keccak256(encoded.data(), encoded.size());
     }
 
     SignedOrder OrderSigner::sign_order(const OrderData &order, const std::string &exchange_address)
@@ -433,14 +625,21 @@ namespace polymarket
 
     SignedOrder OrderSigner::sign_order_with_salt(const OrderData &order, const std::string &exchange_address, const std::string &salt)
     {
-        auto domain_hash = hash_domain("Polymarket CTF Exchange", "1", chain_id_, exchange_address);
-        auto order_hash = hash_order(order, salt);
-        auto message_hash = encode_eip712(domain_hash, order_hash);
+        return sign_with(secp256k1_ctx_, order, exchange_address, salt);
+    }
 
-        std::string signature = sign_hash(message_hash);
+    std::array<uint8_t, 32> OrderSigner::order_digest(const OrderData &order, const std::string &exchange_address,
+                                                      const std::string &salt) const
+    {
+        return encode_eip712(exchange_domain(exchange_address), hash_order(order, salt));
+    }
 
+    SignedOrder OrderSigner::sign_with(void *ctx, const OrderData &order, const std::string &exchange_address,
+                                       std::string salt) const
+    {
         SignedOrder signed_order;
-        signed_order.salt = salt;
+        signed_order.signature = sign_hash_with(ctx, order_digest(order, exchange_address, salt));
+        signed_order.salt = std::move(salt);
         signed_order.maker = order.maker;
         signed_order.signer = order.signer;
         signed_order.taker = order.taker;
@@ -452,63 +651,235 @@ namespace polymarket
         signed_order.fee_rate_bps = order.fee_rate_bps;
         signed_order.side = static_cast<int>(order.side);
         signed_order.signature_type = static_cast<int>(order.signature_type);
-        signed_order.signature = signature;
 
         return signed_order;
     }
 
-    std::array<uint8_t, 32> OrderSigner::hash_clob_auth_domain()
+    // Persistent workers, each with its own secp256k1 context. One batch runs at a time: every worker (and the
+    // calling thread) claims order indices from an atomic counter until the batch is exhausted.
+    struct OrderSigner::SigningPool
     {
-        auto type_hash = keccak256(std::string("EIP712Domain(string name,string version,uint256 chainId)"));
-        auto name_hash = keccak256(std::string("ClobAuthDomain"));
-        auto version_hash = keccak256(std::string("1"));
+        struct ContextDeleter
+        {
+            void operator()(secp256k1_context *ctx) const { secp256k1_context_destroy(ctx); }
+        };
+
+        struct Worker
+        {
+            std::thread thread;
+            std::unique_ptr<secp256k1_context, ContextDeleter> ctx;
+        };
+
+        std::vector<Worker> workers;
+        std::mutex mutex;
+        std::condition_variable work_cv;
+        std::condition_variable done_cv;
+        uint64_t generation{0}; // Bumped per batch
+        size_t busy{0};         // Workers not yet done with the current batch
+        bool stopping{false};
+
+        std::function<void(void *ctx, size_t index)> task;
+        size_t count{0};
+        std::atomic<size_t> next{0};
+        std::exception_ptr error;
+
+        // The contexts are owned by their workers, so a failed clone or thread start releases everything made so far
+        SigningPool(size_t threads, const secp256k1_context *source)
+        {
+            workers.resize(threads);
+            for (auto &worker : workers)
+            {
+                worker.ctx.reset(secp256k1_context_clone(source));
+                if (!worker.ctx)
+                {
+                    throw std::runtime_error("Failed to clone secp256k1 context");
+                }
+            }
+            try
+            {
+                for (auto &worker : workers)
+                {
+                    worker.thread = std::thread([this, ctx = worker.ctx.get()]()
+                                                { run(ctx); });
+                }
+            }
+            catch (...)
+            {
+                stop();
+                throw;
+            }
+        }
+
+        ~SigningPool()
+        {
+            stop();
+        }
+
+        // Stop and join the started workers; their contexts go with the Worker entries
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            work_cv.notify_all();
+            for (auto &worker : workers)
+            {
+                if (worker.thread.joinable())
+                {
+                    worker.thread.join();
+                }
+            }
+        }
+
+        void run(secp256k1_context *ctx)
+        {
+            uint64_t seen = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    work_cv.wait(lock, [&]()
+                                 { return stopping || generation != seen; });
+                    if (stopping)
+                    {
+                        return;
+                    }
+                    seen = generation;
+                }
 
-        std::vector<uint8_t> chain_id_bytes(32, 0);
-        for (int i = 0; i < 4; i++)
+                drain(ctx);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--busy == 0)
+                {
+                    done_cv.notify_all();
+                }
+            }
+        }
+
+        void drain(void *ctx)
         {
-            chain_id_bytes[31 - i] = (chain_id_ >> (i * 8)) & 0xFF;
+            size_t index;
+            while ((index = next.fetch_add(1, std::memory_order_relaxed)) < count)
+            {
+                try
+                {
+                    task(ctx, index);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    next.store(count, std::memory_order_relaxed); // Abandon the rest of the batch
+                }
+            }
         }
 
-        std::vector<uint8_t> encoded;
-        encoded.insert(encoded.end(), type_hash.begin(), type_hash.end());
-        encoded.insert(encoded.end(), name_hash.begin(), name_hash.end());
-        encoded.insert(encoded.end(), version_hash.begin(), version_hash.end());
-        encoded.insert(encoded.end(), chain_id_bytes.begin(), chain_id_bytes.end());
+        // Run task(ctx, i) for i in [0, n) across the workers and the calling thread (using caller_ctx)
+        void run_batch(size_t n, void *caller_ctx, std::function<void(void *, size_t)> fn)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                task = std::move(fn);
+                count = n;
+                next.store(0, std::memory_order_relaxed);
+                error = nullptr;
+                busy = workers.size();
+                generation++;
+            }
+            work_cv.notify_all();
+
+            drain(caller_ctx);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            done_cv.wait(lock, [this]()
+                         { return busy == 0; });
+            task = nullptr;
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+    };
 
-        return keccak256(encoded);
+    void OrderSigner::set_signing_threads(size_t threads)
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        pool_.reset();
+        signing_threads_ = threads;
     }
 
-    std::array<uint8_t, 32> OrderSigner::hash_clob_auth(const std::string &timestamp, uint64_t nonce)
+    std::vector<SignedOrder> OrderSigner::sign_orders(std::span<const OrderData> orders, const std::string &exchange_address)
     {
-        auto type_hash = keccak256(std::string(
-            "ClobAuth(address address,string timestamp,uint256 nonce,string message)"));
+        return sign_orders(orders, std::span<const std::string>(&exchange_address, 1));
+    }
 
-        // Encode address (padded to 32 bytes)
-        auto addr_bytes = from_hex(address_);
-        std::vector<uint8_t> addr_padded(32, 0);
-        std::memcpy(addr_padded.data() + 12, addr_bytes.data(), std::min(addr_bytes.size(), size_t(20)));
+    std::vector<SignedOrder> OrderSigner::sign_orders(std::span<const OrderData> orders,
+                                                      std::span<const std::string> exchange_addresses)
+    {
+        if (exchange_addresses.size() != 1 && exchange_addresses.size() != orders.size())
+        {
+            throw std::invalid_argument("sign_orders: need one exchange address, or one per order");
+        }
 
-        // Hash the timestamp string
-        auto timestamp_hash = keccak256(timestamp);
+        std::vector<SignedOrder> signed_orders(orders.size());
+        std::vector<std::string> salts(orders.size());
+        for (auto &salt : salts)
+        {
+            salt = generate_salt();
+        }
+
+        auto sign_one = [&](void *ctx, size_t i)
+        {
+            const std::string &exchange = exchange_addresses[exchange_addresses.size() == 1 ? 0 : i];
+            signed_orders[i] = sign_with(ctx, orders[i], exchange, std::move(salts[i]));
+        };
 
-        // Encode nonce as uint256
-        std::vector<uint8_t> nonce_bytes(32, 0);
-        for (int i = 0; i < 8; i++)
+        // Not worth waking the pool for a single order
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        if (signing_threads_ == 0 || orders.size() < 2)
         {
-            nonce_bytes[31 - i] = (nonce >> (i * 8)) & 0xFF;
+            for (size_t i = 0; i < orders.size(); i++)
+            {
+                sign_one(secp256k1_ctx_, i);
+            }
+            return signed_orders;
         }
 
-        // Hash the message string
-        auto message_hash = keccak256(std::string("This message attests that I control the given wallet"));
+        if (!pool_)
+        {
+            pool_ = std::make_unique<SigningPool>(signing_threads_, static_cast<const secp256k1_context *>(secp256k1_ctx_));
+        }
+        pool_->run_batch(orders.size(), secp256k1_ctx_, sign_one);
+        return signed_orders;
+    }
 
-        std::vector<uint8_t> encoded;
-        encoded.insert(encoded.end(), type_hash.begin(), type_hash.end());
-        encoded.insert(encoded.end(), addr_padded.begin(), addr_padded.end());
-        encoded.insert(encoded.end(), timestamp_hash.begin(), timestamp_hash.end());
-        encoded.insert(encoded.end(), nonce_bytes.begin(), nonce_bytes.end());
-        encoded.insert(encoded.end(), message_hash.begin(), message_hash.end());
+    std::array<uint8_t, 32> OrderSigner::hash_clob_auth_domain() const
+    {
+        // EIP712Domain(name, version, chainId): 4 words
+        std::array<uint8_t, 4 * 32> encoded{};
+        std::memcpy(encoded.data(), kClobAuthDomainTypeHash.data(), 32);
+        std::memcpy(encoded.data() + 32, kClobAuthNameHash.data(), 32);
+        std::memcpy(encoded.data() + 64, kClobAuthVersionHash.data(), 32);
+        encode_uint64(static_cast<uint64_t>(chain_id_), encoded.data() + 96);
+        return keccak256(encoded.data(), encoded.size());
+    }
 
-        return keccak256(encoded);
+    std::array<uint8_t, 32> OrderSigner::hash_clob_auth(const std::string &timestamp, uint64_t nonce) const
+    {
+        // ClobAuth(address, timestamp, nonce, message): type hash + 4 words
+        std::array<uint8_t, 5 * 32> encoded{};
+        std::memcpy(encoded.data(), kClobAuthTypeHash.data(), 32);
+        parse_address(address_, encoded.data() + 32 + 12);
+        auto timestamp_hash = keccak256(timestamp);
+        std::memcpy(encoded.data() + 64, timestamp_hash.data(), 32);
+        encode_uint64(nonce, encoded.data() + 96);
+        std::memcpy(encoded.data() + 128, kClobAuthMessageHash.data(), 32);
+        return keccak256(encoded.data(), encoded.size());
     }
 
     OrderSigner::L1Headers OrderSigner::generate_l1_headers(uint64_t nonce, const std::string &override_address)
@@ -517,9 +888,8 @@ namespace polymarket
         auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
         std::string ts_str = std::to_string(timestamp);
 
-        auto domain_hash = hash_clob_auth_domain();
         auto struct_hash = hash_clob_auth(ts_str, nonce);
-        auto message_hash = encode_eip712(domain_hash, struct_hash);
+        auto message_hash = encode_eip712(clob_auth_domain_, struct_hash);
 
         std::string signature = sign_hash(message_hash);
 
@@ -617,37 +987,131 @@ namespace polymarket
     {
         auto now = std::chrono::system_clock::now();
         auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+        return generate_l2_headers(creds, method, path, body, static_cast<uint64_t>(timestamp));
+    }
 
-        std::string message = std::to_string(timestamp) + method + path;
-        if (!body.empty())
-        {
-            message += body;
-        }
-
-        auto secret_bytes = base64_decode(creds.api_secret);
+    OrderSigner::L2Headers OrderSigner::generate_l2_headers(const ApiCredentials &creds,
+                                                            const std::string &method,
+                                                            const std::string &path,
+                                                            const std::string &body,
+                                                            uint64_t timestamp)
+    {
+        std::string timestamp_str = std::to_string(timestamp);
 
         unsigned char hmac_result[32];
-        unsigned int hmac_len = 32;
-
-        HMAC(EVP_sha256(),
-             secret_bytes.data(), secret_bytes.size(),
-             reinterpret_cast<const unsigned char *>(message.c_str()), message.size(),
-             hmac_result, &hmac_len);
+        {
+            // The MAC context keeps the decoded secret; each request only re-initialises it and streams the message
+            std::lock_guard<std::mutex> lock(hmac_mutex_);
+            if (!hmac_ctx_ || hmac_secret_ != creds.api_secret)
+            {
+                load_hmac_key(creds.api_secret);
+            }
+            hmac_sha256(timestamp_str, method, path, body, hmac_result);
+        }
 
-        std::vector<uint8_t> hmac_vec(hmac_result, hmac_result + 32);
         // L2 HMAC signature must be URL-safe base64 (- and _ instead of + and /)
-        std::string signature = base64_encode(hmac_vec, true);
+        char signature[44];
+        size_t signature_len = base64_encode(hmac_result, sizeof(hmac_result), signature, true);
 
         L2Headers headers;
         // Always use signer address for L2 auth - the API key is associated with the signer
         headers.poly_address = address_;
-        headers.poly_timestamp = std::to_string(timestamp);
+        headers.poly_timestamp = std::move(timestamp_str);
         headers.poly_api_key = creds.api_key;
         headers.poly_passphrase = creds.api_passphrase;
         headers.poly_secret = creds.api_secret;
-        headers.poly_signature = signature;
+        headers.poly_signature.assign(signature, signature_len);
 
         return headers;
     }
 
+    void OrderSigner::load_hmac_key(const std::string &api_secret)
+    {
+        free_hmac();
+        auto key = base64_decode(api_secret);
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        EVP_MAC *mac = EVP_MAC_fetch(nullptr, "HMAC", nullptr);
+        EVP_MAC_CTX *ctx = mac ? EVP_MAC_CTX_new(mac) : nullptr;
+        EVP_MAC_free(mac); // The context holds its own reference
+        char digest[] = "SHA256";
+        OSSL_PARAM params[] = {OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0), OSSL_PARAM_construct_end()};
+        if (!ctx || !EVP_MAC_init(ctx, key.data(), key.size(), params))
+        {
+            EVP_MAC_CTX_free(ctx);
+            OPENSSL_cleanse(key.data(), key.size());
+            throw std::runtime_error("Failed to initialise HMAC context");
+        }
+#else
+        HMAC_CTX *ctx = HMAC_CTX_new();
+        if (!ctx || !HMAC_Init_ex(ctx, key.data(), static_cast<int>(key.size()), EVP_sha256(), nullptr))
+        {
+            HMAC_CTX_free(ctx);
+            OPENSSL_cleanse(key.data(), key.size());
+            throw std::runtime_error("Failed to initialise HMAC context");
+        }
+#endif
+        OPENSSL_cleanse(key.data(), key.size());
+        hmac_ctx_ = ctx;
+        hmac_secret_ = api_secret;
+    }
+
+    void OrderSigner::hmac_sha256(const std::string &timestamp, const std::string &method, const std::string &path,
+                                  const std::string &body, unsigned char out[32])
+    {
+        auto update_all = [&](auto update)
+        {
+            for (const std::string *part : {&timestamp, &method, &path, &body})
+            {
+                if (!part->empty() && !update(reinterpret_cast<const unsigned char *>(part->data()), part->size()))
+                {
+                    throw std::runtime_error("HMAC update failed");
+                }
+            }
+        };
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        auto ctx = static_cast<EVP_MAC_CTX *>(hmac_ctx_);
+        size_t out_len = 0;
+        // A null key re-initialises with the key already loaded
+        if (!EVP_MAC_init(ctx, nullptr, 0, nullptr))
+        {
+            throw std::runtime_error("HMAC init failed");
+        }
+        update_all([ctx](const unsigned char *data, size_t size)
+                   { return EVP_MAC_update(ctx, data, size) == 1; });
+        if (!EVP_MAC_final(ctx, out, &out_len, 32))
+        {
+            throw std::runtime_error("HMAC final failed");
+        }
+#else
+        auto ctx = static_cast<HMAC_CTX *>(hmac_ctx_);
+        unsigned int out_len = 0;
+        if (!HMAC_Init_ex(ctx, nullptr, 0, nullptr, nullptr))
+        {
+            throw std::runtime_error("HMAC init failed");
+        }
+        update_all([ctx](const unsigned char *data, size_t size)
+                   { return HMAC_Update(ctx, data, size) == 1; });
+        if (!HMAC_Final(ctx, out, &out_len))
+        {
+            throw std::runtime_error("HMAC final failed");
+        }
+#endif
+    }
+
+    void OrderSigner::free_hmac()
+    {
+        if (!hmac_ctx_)
+        {
+            return;
+        }
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+        EVP_MAC_CTX_free(static_cast<EVP_MAC_CTX *>(hmac_ctx_));
+#else
+        HMAC_CTX_free(static_cast<HMAC_CTX *>(hmac_ctx_));
+#endif
+        hmac_ctx_ = nullptr;
+        hmac_secret_.clear();
+    }
+
 } // namespace polymarket
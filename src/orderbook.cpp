@@ -2,34 +2,136 @@
 #include <nlohmann/json.hpp>
 #include <iostream>
 #include <algorithm>
+#include <cmath>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 using json = nlohmann::json;
 
 namespace polymarket
 {
 
+    namespace
+    {
+        constexpr double kPriceEpsilon = 1e-9;
+
+        // Finest Polymarket tick size; ladders fall back to it when a price is off the default grid
+        constexpr double kFinestTickSize = 0.0001;
+
+        bool same_price(double a, double b)
+        {
+            return std::fabs(a - b) < kPriceEpsilon;
+        }
+
+        // Insert, resize or remove (size 0) one level of a best-first sorted side
+        void apply_level(std::vector<PriceLevel> &levels, double price, double size, bool descending)
+        {
+            auto it = std::lower_bound(levels.begin(), levels.end(), price,
+                                       [descending](const PriceLevel &level, double p)
+                                       { return descending ? level.price > p + kPriceEpsilon : level.price < p - kPriceEpsilon; });
+            bool found = it != levels.end() && same_price(it->price, price);
+
+            if (size <= 0.0)
+            {
+                if (found)
+                {
+                    levels.erase(it);
+                }
+            }
+            else if (found)
+            {
+                it->size = size;
+            }
+            else
+            {
+                levels.insert(it, PriceLevel{price, size});
+            }
+        }
+
+        // Sort a side best-first if it is not already (REST books list levels worst-first)
+        void sort_best_first(std::vector<PriceLevel> &levels, bool descending)
+        {
+            auto better = [descending](const PriceLevel &a, const PriceLevel &b)
+            { return descending ? a.price > b.price : a.price < b.price; };
+            if (!std::is_sorted(levels.begin(), levels.end(), better))
+            {
+                std::sort(levels.begin(), levels.end(), better);
+            }
+        }
+
+        // Compare against the best_bid/best_ask the server reports after a change ("1" / "0" mean no asks)
+        bool top_of_book_matches(const PriceLadder &ladder, double best_bid, double best_ask)
+        {
+            double local_bid = ladder.best_bid();
+            double local_ask = ladder.has_asks() ? ladder.best_ask() : 0.0;
+            double server_ask = best_ask >= 1.0 ? 0.0 : best_ask;
+            return same_price(local_bid, best_bid) && same_price(local_ask, server_ask);
+        }
+    } // namespace
+
     OrderbookManager::OrderbookManager(const Config &config)
-        : config_(config)
+        : config_(config), event_scanner_(config.trigger_combined, 2.0 - config.trigger_combined),
+          latency_(std::make_unique<LatencyHistograms>())
     {
-        // Use real-time data WebSocket endpoint (same as @polymarket/real-time-data-client)
-        ws_.set_url(config_.rtds_ws_url);
-        ws_.set_ping_interval_ms(config_.ws_ping_interval_ms);
-        ws_.set_auto_reconnect(true);
+        event_scanner_.on_opportunity([this](const EventArbOpportunity &opportunity)
+                                      {
+            event_arb_opportunities_++;
+            if (on_event_arb_cb_)
+            {
+                on_event_arb_cb_(opportunity);
+            } });
+
+        size_t shard_count = static_cast<size_t>(std::max(config_.ws_shards, 1));
+        for (size_t i = 0; i < shard_count; i++)
+        {
+            auto shard = std::make_unique<Shard>();
+            Shard *s = shard.get();
+            s->index = i;
+            if (config_.ws_shard_workers && !config_.ws_shard_cpus.empty())
+            {
+                s->cpu = config_.ws_shard_cpus[i % config_.ws_shard_cpus.size()];
+            }
+
+            // Use real-time data WebSocket endpoint (same as @polymarket/real-time-data-client)
+            s->ws.set_url(config_.rtds_ws_url);
+            s->ws.set_ping_interval_ms(config_.ws_ping_interval_ms);
+            s->ws.set_auto_reconnect(true);
+
+            // Set up WebSocket callbacks (each shard reconnects and resubscribes on its own)
+            s->ws.on_message([this, s](const std::string &msg)
+                             {
+            if (FeedRecorder *recorder = recorder_.load(std::memory_order_acquire))
+            {
+                recorder->append(s->index, s->ws.receive_ns(), msg);
+            }
+            if (!config_.ws_shard_workers)
+            {
+                handle_message(*s, msg, s->ws.receive_ns());
+                return;
+            }
+            s->queue.push(msg, s->ws.receive_ns()); });
 
-        // Set up WebSocket callbacks
-        ws_.on_message([this](const std::string &msg)
-                       { handle_message(msg); });
+            s->ws.on_connect([this, s]()
+                             {
+            std::cout << "[WS] Connected to orderbook stream (shard " << s->index << ")" << std::endl;
+            send_subscribe_message(*s); });
 
-        ws_.on_connect([this]()
-                       {
-        std::cout << "[WS] Connected to orderbook stream" << std::endl;
-        send_subscribe_message(); });
+            s->ws.on_disconnect([this, s]()
+                                {
+            {
+                std::lock_guard<std::mutex> lock(shards_mutex_);
+                s->subscribed = false;
+            }
+            std::cout << "[WS] Disconnected from orderbook stream (shard " << s->index << ")" << std::endl; });
 
-        ws_.on_disconnect([this]()
-                          { std::cout << "[WS] Disconnected from orderbook stream" << std::endl; });
+            s->ws.on_error([s](const std::string &error)
+                           { std::cerr << "[WS] Error (shard " << s->index << "): " << error << std::endl; });
 
-        ws_.on_error([](const std::string &error)
-                     { std::cerr << "[WS] Error: " << error << std::endl; });
+            shards_.push_back(std::move(shard));
+        }
     }
 
     OrderbookManager::~OrderbookManager()
@@ -39,78 +141,372 @@ namespace polymarket
 
     void OrderbookManager::subscribe(const std::vector<MarketState> &markets)
     {
+        // One subscription message per shard for the whole batch
+        std::vector<std::vector<std::string>> added(shards_.size());
         for (const auto &market : markets)
         {
-            subscribe(market);
+            Shard &shard = add_market(market);
+            added[shard.index].push_back(market.token_yes);
+            added[shard.index].push_back(market.token_no);
+        }
+
+        for (size_t i = 0; i < shards_.size(); i++)
+        {
+            Shard &shard = *shards_[i];
+            if (added[i].empty() || !shard.ws.is_connected())
+            {
+                continue; // Not connected yet: on_connect sends the full list
+            }
+            {
+                std::lock_guard<std::mutex> lock(shards_mutex_);
+                shard.subscribed = false;
+            }
+            if (send_subscription(shard, "subscribe", added[i]))
+            {
+                {
+                    std::lock_guard<std::mutex> lock(shards_mutex_);
+                    shard.subscribed = true;
+                }
+                subscribed_cv_.notify_all();
+            }
         }
     }
 
     void OrderbookManager::subscribe(const MarketState &market)
     {
+        subscribe(std::vector<MarketState>{market});
+    }
+
+    OrderbookManager::Shard &OrderbookManager::add_market(const MarketState &market)
+    {
+        TokenHandle condition = conditions_.intern(market.condition_id);
+        TokenHandle yes = intern_token(market.token_yes);
+        TokenHandle no = intern_token(market.token_no);
+
         {
             std::unique_lock<std::shared_mutex> lock(markets_mutex_);
-            markets_[market.condition_id] = std::make_unique<LiveMarketState>(market);
+            if (markets_.size() <= condition)
+            {
+                markets_.resize(condition + 1);
+            }
+            markets_[condition] = std::make_unique<LiveMarketState>(market);
+
+            // Map tokens to condition
+            if (routes_.size() <= std::max(yes, no))
+            {
+                routes_.resize(std::max(yes, no) + 1);
+            }
+            routes_[yes] = TokenRoute{condition, true};
+            routes_[no] = TokenRoute{condition, false};
         }
 
-        // Map tokens to condition
-        token_to_condition_[market.token_yes] = market.condition_id;
-        token_to_condition_[market.token_no] = market.condition_id;
+        {
+            std::lock_guard<std::mutex> lock(arb_mutex_);
+            if (market_depth_.size() <= condition)
+            {
+                market_depth_.resize(condition + 1);
+            }
+            market_depth_[condition] = MarketDepth{};
+        }
 
-        // Add to subscribed tokens
-        subscribed_tokens_.push_back(market.token_yes);
-        subscribed_tokens_.push_back(market.token_no);
+        // Both tokens on one connection, so a market's legs are never further apart than one socket's ordering
+        Shard *shard = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(shards_mutex_);
+            shard = &least_loaded_shard();
+            shard->tokens.push_back(market.token_yes);
+            shard->tokens.push_back(market.token_no);
+        }
 
         std::cout << "[OrderbookManager] Subscribed to market: " << market.slug
                   << " (YES: " << market.token_yes.substr(0, 16) << "...)" << std::endl;
+        return *shard;
+    }
+
+    bool OrderbookManager::subscribe_event(const NegRiskEvent &event)
+    {
+        subscribe(event.outcomes);
+
+        std::vector<TokenHandle> yes_tokens;
+        for (const auto &outcome : event.outcomes)
+        {
+            yes_tokens.push_back(tokens_.find(outcome.token_yes));
+        }
+
+        size_t index;
+        {
+            std::lock_guard<std::mutex> lock(arb_mutex_);
+            index = event_scanner_.add_event(event.id, yes_tokens);
+        }
+        if (index == EventArbScanner::kRejectedEvent)
+        {
+            std::cerr << "[OrderbookManager] Event not scanned, an outcome is missing or already in another event: "
+                      << event.id.substr(0, 16) << "..." << std::endl;
+            return false;
+        }
+        has_events_.store(true);
+
+        std::cout << "[OrderbookManager] Subscribed to event: " << event.id.substr(0, 16) << "... ("
+                  << event.outcomes.size() << " outcomes)" << std::endl;
+        return true;
     }
 
     void OrderbookManager::unsubscribe(const std::string &token_id)
     {
-        auto it = std::find(subscribed_tokens_.begin(), subscribed_tokens_.end(), token_id);
-        if (it != subscribed_tokens_.end())
+        drop_tokens({token_id});
+    }
+
+    void OrderbookManager::drop_tokens(const std::vector<std::string> &token_ids)
+    {
+        // Both tokens of a market live on one shard, so a market's unsubscribe is a single message
+        std::vector<std::vector<std::string>> removed(shards_.size());
+        {
+            std::lock_guard<std::mutex> lock(shards_mutex_);
+            for (const auto &token_id : token_ids)
+            {
+                for (auto &shard : shards_)
+                {
+                    auto it = std::find(shard->tokens.begin(), shard->tokens.end(), token_id);
+                    if (it != shard->tokens.end())
+                    {
+                        shard->tokens.erase(it);
+                        removed[shard->index].push_back(token_id);
+                        break;
+                    }
+                }
+            }
+        }
+        for (size_t i = 0; i < shards_.size(); i++)
         {
-            subscribed_tokens_.erase(it);
+            if (!removed[i].empty() && shards_[i]->ws.is_connected())
+            {
+                send_subscription(*shards_[i], "unsubscribe", removed[i]);
+            }
         }
 
         std::unique_lock<std::shared_mutex> lock(orderbooks_mutex_);
-        orderbooks_.erase(token_id);
+        for (const auto &token_id : token_ids)
+        {
+            TokenHandle token = tokens_.find(token_id);
+            if (token < books_.size() && books_[token].active)
+            {
+                books_[token].snapshot->write(BookSnapshot{});
+                books_[token] = BookState{};
+            }
+        }
+    }
+
+    std::vector<std::string> OrderbookManager::detach_market(TokenHandle condition)
+    {
+        if (condition >= markets_.size() || !markets_[condition])
+        {
+            return {};
+        }
+        std::vector<std::string> token_ids = {markets_[condition]->token_yes, markets_[condition]->token_no};
+        markets_[condition].reset();
+        if (staged_ == condition)
+        {
+            staged_ = kInvalidToken;
+        }
+        return token_ids;
+    }
+
+    void OrderbookManager::unsubscribe_market(const std::string &condition_id)
+    {
+        TokenHandle condition = conditions_.find(condition_id);
+        std::vector<std::string> token_ids;
+        {
+            std::unique_lock<std::shared_mutex> lock(markets_mutex_);
+            token_ids = detach_market(condition);
+        }
+        drop_tokens(token_ids);
+    }
+
+    void OrderbookManager::stage_market(const MarketState &market)
+    {
+        TokenHandle condition = conditions_.intern(market.condition_id);
+        std::vector<std::string> replaced;
+        {
+            // Marked before the subscription goes out, so its first books never trigger an arb callback
+            std::unique_lock<std::shared_mutex> lock(markets_mutex_);
+            if (staged_ != kInvalidToken && staged_ != condition)
+            {
+                replaced = detach_market(staged_);
+            }
+            staged_ = condition;
+        }
+        drop_tokens(replaced);
+        subscribe(market);
+    }
+
+    bool OrderbookManager::promote_staged(const std::string &retire_condition_id)
+    {
+        TokenHandle retire = retire_condition_id.empty() ? kInvalidToken : conditions_.find(retire_condition_id);
+        std::vector<std::string> retired;
+        {
+            std::unique_lock<std::shared_mutex> lock(markets_mutex_);
+            if (staged_ == kInvalidToken)
+            {
+                return false;
+            }
+            TokenHandle promoted = staged_;
+            staged_ = kInvalidToken;
+            if (retire != promoted)
+            {
+                retired = detach_market(retire);
+            }
+        }
+        drop_tokens(retired);
+        return true;
+    }
+
+    std::string OrderbookManager::staged_condition_id() const
+    {
+        std::shared_lock<std::shared_mutex> lock(markets_mutex_);
+        if (staged_ < markets_.size() && markets_[staged_])
+        {
+            return markets_[staged_]->condition_id;
+        }
+        return "";
     }
 
     void OrderbookManager::unsubscribe_all()
     {
-        subscribed_tokens_.clear();
+        for (auto &shard : shards_)
+        {
+            std::vector<std::string> tokens;
+            {
+                std::lock_guard<std::mutex> lock(shards_mutex_);
+                tokens.swap(shard->tokens);
+            }
+            if (!tokens.empty() && shard->ws.is_connected())
+            {
+                send_subscription(*shard, "unsubscribe", tokens);
+            }
+        }
 
         {
             std::unique_lock<std::shared_mutex> lock(orderbooks_mutex_);
-            orderbooks_.clear();
+            for (auto &state : books_)
+            {
+                if (state.active)
+                {
+                    state.snapshot->write(BookSnapshot{});
+                }
+            }
+            books_.clear();
         }
 
         {
             std::unique_lock<std::shared_mutex> lock(markets_mutex_);
             markets_.clear();
+            routes_.clear();
+            staged_ = kInvalidToken;
         }
 
-        token_to_condition_.clear();
+        {
+            std::lock_guard<std::mutex> lock(arb_mutex_);
+            market_depth_.clear();
+            event_scanner_.clear();
+        }
+        has_events_.store(false);
     }
 
     std::optional<Orderbook> OrderbookManager::get_orderbook(const std::string &token_id) const
     {
+        TokenHandle token = tokens_.find(token_id);
         std::shared_lock<std::shared_mutex> lock(orderbooks_mutex_);
-        auto it = orderbooks_.find(token_id);
-        if (it != orderbooks_.end())
+        if (const BookState *state = find_book(token))
         {
-            return it->second;
+            return state->book;
         }
         return std::nullopt;
     }
 
+    std::optional<TopOfBook> OrderbookManager::get_top_of_book(const std::string &token_id) const
+    {
+        return get_top_of_book(tokens_.find(token_id));
+    }
+
+    std::optional<TopOfBook> OrderbookManager::get_top_of_book(TokenHandle token) const
+    {
+        std::shared_lock<std::shared_mutex> lock(orderbooks_mutex_);
+        if (const BookState *state = find_book(token))
+        {
+            return state->ladder.top();
+        }
+        return std::nullopt;
+    }
+
+    const BookSnapshotSlot &OrderbookManager::snapshot_slot(const std::string &token_id)
+    {
+        return snapshot_slot(intern_token(token_id));
+    }
+
+    const BookSnapshotSlot &OrderbookManager::snapshot_slot(TokenHandle token) const
+    {
+        std::shared_lock<std::shared_mutex> lock(snapshots_mutex_);
+        return *snapshot_slots_.at(token);
+    }
+
+    bool OrderbookManager::read_snapshot(const std::string &token_id, BookSnapshot &out)
+    {
+        return snapshot_slot(token_id).read(out);
+    }
+
+    bool OrderbookManager::read_snapshot(TokenHandle token, BookSnapshot &out) const
+    {
+        const BookSnapshotSlot *slot = nullptr;
+        {
+            // A handle from tokens() can be seen just before intern_token() has created its slot
+            std::shared_lock<std::shared_mutex> lock(snapshots_mutex_);
+            if (token >= snapshot_slots_.size())
+            {
+                return false;
+            }
+            slot = snapshot_slots_[token].get();
+        }
+        return slot->read(out);
+    }
+
+    void OrderbookManager::apply_snapshot(const Orderbook &book, const std::string &hash, uint64_t server_timestamp_ms)
+    {
+        // Deltas are applied by binary search, so the stored book must be best-first
+        Orderbook sorted = book;
+        sort_best_first(sorted.bids, true);
+        sort_best_first(sorted.asks, false);
+
+        TokenHandle token = intern_token(sorted.asset_id);
+        TopOfBook top = store_snapshot(token, sorted, hash, server_timestamp_ms);
+        handle_orderbook_update(shards_.size(), token, sorted, top, server_timestamp_ms, 0);
+    }
+
+    bool OrderbookManager::needs_resync(const std::string &token_id) const
+    {
+        TokenHandle token = tokens_.find(token_id);
+        std::shared_lock<std::shared_mutex> lock(orderbooks_mutex_);
+        const BookState *state = find_book(token);
+        return state && state->needs_resync;
+    }
+
+    std::string OrderbookManager::get_book_hash(const std::string &token_id) const
+    {
+        TokenHandle token = tokens_.find(token_id);
+        std::shared_lock<std::shared_mutex> lock(orderbooks_mutex_);
+        if (const BookState *state = find_book(token))
+        {
+            return state->hash;
+        }
+        return "";
+    }
+
     MarketState OrderbookManager::get_market(const std::string &condition_id) const
     {
+        TokenHandle condition = conditions_.find(condition_id);
         std::shared_lock<std::shared_mutex> lock(markets_mutex_);
-        auto it = markets_.find(condition_id);
-        if (it != markets_.end())
+        if (condition < markets_.size() && markets_[condition])
         {
-            const auto &live = it->second;
+            const auto &live = markets_[condition];
             MarketState state;
             state.slug = live->slug;
             state.title = live->title;
@@ -135,58 +531,301 @@ namespace polymarket
         on_arb_cb_ = std::move(callback);
     }
 
+    void OrderbookManager::on_arb_sizing(ArbSizingCallback callback)
+    {
+        on_arb_sizing_cb_ = std::move(callback);
+    }
+
+    void OrderbookManager::on_resync_needed(ResyncNeededCallback callback)
+    {
+        on_resync_cb_ = std::move(callback);
+    }
+
+    void OrderbookManager::on_event_arb(EventArbCallback callback)
+    {
+        on_event_arb_cb_ = std::move(callback);
+    }
+
+    UpdateConsumer &OrderbookManager::add_consumer(UpdateConsumerConfig config)
+    {
+        consumers_.push_back(std::make_unique<UpdateConsumer>(config, shards_.size() + 1));
+        arb_consumers_ = arb_consumers_ || config.arbs;
+        return *consumers_.back();
+    }
+
+    void OrderbookManager::publish_event(size_t lane, const UpdateEvent &event)
+    {
+        for (auto &consumer : consumers_)
+        {
+            const UpdateConsumerConfig &wants = consumer->config();
+            if (event.kind == UpdateKind::BOOK ? wants.books : wants.arbs)
+            {
+                consumer->publish(lane, event);
+            }
+        }
+    }
+
+    void OrderbookManager::on_tick_size_change(TickSizeChangeCallback callback)
+    {
+        on_tick_size_cb_ = std::move(callback);
+    }
+
+    std::vector<ShardStats> OrderbookManager::shard_stats() const
+    {
+        std::vector<ShardStats> stats;
+        stats.reserve(shards_.size());
+        for (const auto &shard : shards_)
+        {
+            ShardStats s;
+            s.index = shard->index;
+            s.connected = shard->ws.is_connected();
+            s.cpu = shard->cpu;
+            s.messages = shard->ws.messages_received();
+            s.bytes = shard->ws.bytes_received();
+            s.connects = shard->ws.connect_count();
+            s.parse_errors = shard->parse_errors.load();
+            s.events = shard->events.load();
+            {
+                std::lock_guard<std::mutex> lock(shards_mutex_);
+                s.tokens = shard->tokens.size();
+            }
+            s.queue_depth = shard->queue.size();
+            stats.push_back(s);
+        }
+        return stats;
+    }
+
+    LatencyStats OrderbookManager::get_latency_stats() const
+    {
+        LatencyStats stats;
+        stats.network = latency_->network.summary();
+        stats.queue = latency_->queue.summary();
+        stats.parse = latency_->parse.summary();
+        stats.apply = latency_->apply.summary();
+        stats.dispatch = latency_->dispatch.summary();
+        stats.internal = latency_->internal.summary();
+        stats.end_to_end = latency_->end_to_end.summary();
+        return stats;
+    }
+
+    void OrderbookManager::reset_latency_stats()
+    {
+        latency_->network.reset();
+        latency_->queue.reset();
+        latency_->parse.reset();
+        latency_->apply.reset();
+        latency_->dispatch.reset();
+        latency_->internal.reset();
+        latency_->end_to_end.reset();
+    }
+
     bool OrderbookManager::connect()
     {
-        return ws_.connect();
+        start_workers();
+
+        bool connected = true;
+        for (auto &shard : shards_)
+        {
+            connected &= shard->ws.connect();
+        }
+        return connected;
     }
 
     void OrderbookManager::disconnect()
     {
-        ws_.disconnect();
+        for (auto &shard : shards_)
+        {
+            shard->ws.disconnect();
+        }
     }
 
     bool OrderbookManager::is_connected() const
     {
-        return ws_.is_connected();
+        for (const auto &shard : shards_)
+        {
+            if (!shard->ws.is_connected())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool OrderbookManager::wait_connected(std::chrono::milliseconds timeout)
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (auto &shard : shards_)
+        {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (!shard->ws.wait_connected(std::max(left, std::chrono::milliseconds(0))))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool OrderbookManager::wait_subscribed(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(shards_mutex_);
+        return subscribed_cv_.wait_for(lock, timeout, [this]()
+                                       { return std::all_of(shards_.begin(), shards_.end(), [](const auto &shard)
+                                                            { return shard->subscribed; }); });
     }
 
     void OrderbookManager::run()
     {
-        ws_.run();
+        // Every shard's socket runs on its own thread; block on the first until stop()
+        shards_.front()->ws.run();
     }
 
     void OrderbookManager::stop()
     {
-        ws_.stop();
+        for (auto &shard : shards_)
+        {
+            shard->ws.stop();
+        }
+        stop_workers();
+    }
+
+    OrderbookManager::Shard &OrderbookManager::least_loaded_shard()
+    {
+        Shard *best = shards_.front().get();
+        for (auto &shard : shards_)
+        {
+            if (shard->tokens.size() < best->tokens.size())
+            {
+                best = shard.get();
+            }
+        }
+        return *best;
     }
 
-    void OrderbookManager::send_subscribe_message()
+    void OrderbookManager::start_workers()
     {
-        if (subscribed_tokens_.empty())
+        if (!config_.ws_shard_workers)
         {
             return;
         }
+        for (auto &shard : shards_)
+        {
+            if (shard->worker.joinable())
+            {
+                continue;
+            }
+            shard->queue.restart();
+            Shard *s = shard.get();
+            shard->worker = std::thread([this, s]()
+                                        { run_worker(*s); });
+        }
+    }
+
+    void OrderbookManager::stop_workers()
+    {
+        for (auto &shard : shards_)
+        {
+            if (!shard->worker.joinable())
+            {
+                continue;
+            }
+            shard->queue.stop();
+            shard->worker.join();
+        }
+    }
+
+    void OrderbookManager::run_worker(Shard &shard)
+    {
+        if (shard.cpu >= 0)
+        {
+#ifdef __linux__
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(shard.cpu, &cpus);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0)
+            {
+                std::cerr << "[OrderbookManager] Failed to pin shard " << shard.index << " to CPU " << shard.cpu << std::endl;
+            }
+#else
+            std::cerr << "[OrderbookManager] CPU pinning not supported on this platform" << std::endl;
+#endif
+        }
+
+        // Frame buffers are recycled by the queue, so steady state does not allocate
+        auto handle = [this, &shard](std::string_view data, uint64_t receive_ns)
+        {
+            latency_->queue.record(now_ns() - receive_ns);
+            handle_message(shard, data, receive_ns);
+        };
+        while (shard.queue.drain(handle))
+        {
+        }
+    }
+
+    ReplayStats OrderbookManager::replay(FeedReader &reader, bool realtime)
+    {
+        ReplayStats stats;
+        FeedFrame frame;
+        uint64_t first_recorded_ns = 0;
+        auto start = std::chrono::steady_clock::now();
+        while (reader.next(frame))
+        {
+            if (realtime)
+            {
+                if (stats.frames == 0)
+                {
+                    first_recorded_ns = frame.receive_ns;
+                }
+                uint64_t offset_ns = frame.receive_ns > first_recorded_ns ? frame.receive_ns - first_recorded_ns : 0;
+                std::this_thread::sleep_until(start + std::chrono::nanoseconds(offset_ns));
+            }
+            // Stamp with the replay clock so the internal latency stages stay meaningful
+            handle_message(*shards_[frame.shard % shards_.size()], frame.data, now_ns());
+            stats.frames++;
+            stats.bytes += frame.data.size();
+        }
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stats.frames_per_sec = stats.seconds > 0 ? stats.frames / stats.seconds : 0.0;
+        return stats;
+    }
+
+    void OrderbookManager::send_subscribe_message(Shard &shard)
+    {
+        std::vector<std::string> tokens;
+        {
+            std::lock_guard<std::mutex> lock(shards_mutex_);
+            tokens = shard.tokens;
+        }
 
+        bool sent = tokens.empty() || send_subscription(shard, "subscribe", tokens);
+        {
+            std::lock_guard<std::mutex> lock(shards_mutex_);
+            shard.subscribed = sent;
+        }
+        subscribed_cv_.notify_all();
+    }
+
+    bool OrderbookManager::send_subscription(Shard &shard, const char *action, const std::vector<std::string> &tokens)
+    {
         // Build subscription message for Polymarket Real-Time Data WebSocket
         // Format matches @polymarket/real-time-data-client:
         // {"action": "subscribe", "subscriptions": [{"topic": "clob_market", "type": "agg_orderbook", "filters": "[token1,token2]"}]}
         json subscribe_msg;
-        subscribe_msg["action"] = "subscribe";
+        subscribe_msg["action"] = action;
 
         json subscription;
         subscription["topic"] = "clob_market";
         subscription["type"] = "agg_orderbook";
-        subscription["filters"] = json(subscribed_tokens_).dump(); // JSON array as string
+        subscription["filters"] = json(tokens).dump(); // JSON array as string
 
         subscribe_msg["subscriptions"] = json::array({subscription});
 
         std::string msg = subscribe_msg.dump();
-        std::cout << "[WS] Sending subscribe: " << subscribed_tokens_.size() << " tokens" << std::endl;
+        std::cout << "[WS] Sending " << action << " (shard " << shard.index << "): " << tokens.size() << " tokens" << std::endl;
 
-        ws_.send(msg);
+        return shard.ws.send(msg);
     }
 
-    void OrderbookManager::handle_message(const std::string &message)
+    void OrderbookManager::handle_message(Shard &shard, std::string_view message, uint64_t receive_ns)
     {
         // Skip empty messages
         if (message.empty() || message == "{}")
@@ -194,227 +833,387 @@ namespace polymarket
             return;
         }
 
-        try
+        // Handles both the Polymarket Real-Time Data format:
+        // {"topic": "clob_market", "type": "agg_orderbook", "payload": {"asset_id": "...", "asks": [...], "bids": [...]}}
+        // and the legacy format: {"event_type": "book", "asset_id": "...", "bids": [...], "asks": [...]}
+        BookFrameParser &parser = shard.parser;
+        shard.receive_ns = receive_ns;
+        uint64_t parse_start_ns = now_ns();
+        bool parsed = parser.parse(message);
+        latency_->parse.record(now_ns() - parse_start_ns);
+        if (!parsed)
         {
-            auto j = json::parse(message);
-
-            // Handle Polymarket Real-Time Data format:
-            // {"topic": "clob_market", "type": "agg_orderbook", "payload": {"asset_id": "...", "asks": [...], "bids": [...]}}
+            shard.parse_errors++;
+            std::cerr << "[WS] Parse error (shard " << shard.index << "): " << parser.error() << std::endl;
+            return;
+        }
 
-            // Check for real-time data format
-            if (j.contains("topic") && j.contains("type") && j.contains("payload"))
+        shard.events.fetch_add(parser.size(), std::memory_order_relaxed);
+        for (size_t i = 0; i < parser.size(); i++)
+        {
+            const auto &event = parser.event(i);
+            if (event.type == WsMessageType::ORDERBOOK_SNAPSHOT)
+            {
+                uint64_t apply_start_ns = now_ns();
+                TokenHandle token = intern_token(event.book.asset_id);
+                TopOfBook top = store_snapshot(token, event.book, event.hash, event.server_timestamp_ms);
+                dispatch_update(shard, token, event.book, top, apply_start_ns, event.server_timestamp_ms);
+            }
+            else if (event.type == WsMessageType::ORDERBOOK_UPDATE)
+            {
+                handle_price_change(shard, event);
+            }
+            else if (event.type == WsMessageType::TICK_SIZE_CHANGE && on_tick_size_cb_)
             {
-                std::string topic = j["topic"].get<std::string>();
-                std::string type = j["type"].get<std::string>();
+                on_tick_size_cb_(event.book.asset_id, std::string(event.old_tick_size), std::string(event.new_tick_size));
+            }
+        }
+    }
 
-                if (topic == "clob_market" && type == "agg_orderbook")
-                {
-                    auto &payload = j["payload"];
-                    if (!payload.contains("asset_id"))
-                    {
-                        return;
-                    }
+    TopOfBook OrderbookManager::store_snapshot(TokenHandle token, const Orderbook &book, std::string_view hash,
+                                               uint64_t server_ts_ms)
+    {
+        std::unique_lock<std::shared_mutex> lock(orderbooks_mutex_);
 
-                    std::string asset_id = payload["asset_id"].get<std::string>();
+        // Copy-assign keeps the stored vectors' capacity, so re-seeding does not allocate
+        BookState &state = book_state(token);
+        state.book = book;
+        state.hash.assign(hash.data(), hash.size());
+        state.server_ts_ms = server_ts_ms;
+        state.seeded = true;
+        state.needs_resync = false;
+        state.epoch = ++book_epochs_;
+        load_ladder(state);
+        publish_snapshot(state);
+        return state.ladder.top();
+    }
 
-                    Orderbook book;
-                    book.asset_id = asset_id;
-                    book.timestamp_ns = now_ns();
+    TokenHandle OrderbookManager::intern_token(std::string_view token_id)
+    {
+        TokenHandle token = tokens_.intern(token_id);
 
-                    // Parse asks
-                    if (payload.contains("asks") && payload["asks"].is_array())
-                    {
-                        for (const auto &ask : payload["asks"])
-                        {
-                            PriceLevel level;
-                            level.price = std::stod(ask["price"].get<std::string>());
-                            level.size = std::stod(ask["size"].get<std::string>());
-                            book.asks.push_back(level);
-                        }
-                    }
+        // Every handle gets its snapshot slot up front, so snapshot_slot(handle) never has to create one
+        {
+            std::shared_lock<std::shared_mutex> lock(snapshots_mutex_);
+            if (token < snapshot_slots_.size())
+            {
+                return token;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(snapshots_mutex_);
+        while (snapshot_slots_.size() <= token)
+        {
+            snapshot_slots_.push_back(std::make_unique<BookSnapshotSlot>());
+        }
+        return token;
+    }
 
-                    // Parse bids
-                    if (payload.contains("bids") && payload["bids"].is_array())
-                    {
-                        for (const auto &bid : payload["bids"])
-                        {
-                            PriceLevel level;
-                            level.price = std::stod(bid["price"].get<std::string>());
-                            level.size = std::stod(bid["size"].get<std::string>());
-                            book.bids.push_back(level);
-                        }
-                    }
+    OrderbookManager::BookState &OrderbookManager::book_state(TokenHandle token)
+    {
+        if (books_.size() <= token)
+        {
+            books_.resize(token + 1);
+        }
 
-                    handle_orderbook_update(asset_id, book);
-                    return;
-                }
-            }
+        BookState &state = books_[token];
+        if (!state.active)
+        {
+            state.active = true;
+            state.book.asset_id = tokens_.id(token);
+            std::shared_lock<std::shared_mutex> lock(snapshots_mutex_);
+            state.snapshot = snapshot_slots_[token].get();
+        }
+        return state;
+    }
+
+    const OrderbookManager::BookState *OrderbookManager::find_book(TokenHandle token) const
+    {
+        return token < books_.size() && books_[token].active ? &books_[token] : nullptr;
+    }
 
-            // Legacy format: {"event_type": "book", "asset_id": "...", "bids": [...], "asks": [...]}
-            if (!j.contains("event_type"))
+    void OrderbookManager::publish_snapshot(const BookState &state)
+    {
+        BookSnapshot snapshot;
+        snapshot.top = state.ladder.top();
+        snapshot.bid_count = static_cast<uint32_t>(std::min(state.book.bids.size(), kSnapshotDepth));
+        snapshot.ask_count = static_cast<uint32_t>(std::min(state.book.asks.size(), kSnapshotDepth));
+        std::copy_n(state.book.bids.begin(), snapshot.bid_count, snapshot.bids);
+        std::copy_n(state.book.asks.begin(), snapshot.ask_count, snapshot.asks);
+        snapshot.timestamp_ns = state.book.timestamp_ns;
+        snapshot.server_ts_ms = state.server_ts_ms;
+        snapshot.needs_resync = state.needs_resync ? 1 : 0;
+        state.snapshot->write(snapshot);
+    }
+
+    void OrderbookManager::load_ladder(BookState &state)
+    {
+        if (state.ladder.load(state.book))
+        {
+            return;
+        }
+        if (state.ladder.tick_size() > kFinestTickSize)
+        {
+            state.ladder = PriceLadder(kFinestTickSize);
+            if (state.ladder.load(state.book))
             {
                 return;
             }
+        }
+        std::cerr << "[OrderbookManager] Price off the tick grid for " << state.book.asset_id.substr(0, 16) << "..." << std::endl;
+    }
+
+    void OrderbookManager::handle_price_change(Shard &shard, const BookEvent &event)
+    {
+        // Changes for the same asset arrive back to back; apply each run and publish once
+        size_t begin = 0;
+        while (begin < event.changes.size())
+        {
+            std::string_view asset_id = event.changes[begin].asset_id;
+            size_t end = begin + 1;
+            while (end < event.changes.size() && event.changes[end].asset_id == asset_id)
+            {
+                end++;
+            }
+            if (!asset_id.empty())
+            {
+                apply_changes(shard, intern_token(asset_id), &event.changes[begin], end - begin,
+                              event.server_timestamp_ms);
+            }
+            begin = end;
+        }
+    }
 
-            std::string event_type = j["event_type"].get<std::string>();
+    void OrderbookManager::apply_changes(Shard &shard, TokenHandle token, const LevelChange *changes, size_t count,
+                                         uint64_t server_ts_ms)
+    {
+        uint64_t apply_start_ns = now_ns();
+        bool applied = false;
+        bool resync = false;
+        TopOfBook top;
 
-            if (event_type == "book" || event_type == "price_change")
+        {
+            std::unique_lock<std::shared_mutex> lock(orderbooks_mutex_);
+            BookState &state = book_state(token);
+
+            if (!state.seeded)
+            {
+                // Delta without a base book: nothing to apply it to
+                resync = !state.needs_resync;
+                state.needs_resync = true;
+                publish_snapshot(state);
+            }
+            else if (server_ts_ms != 0 && server_ts_ms < state.server_ts_ms)
             {
-                if (!j.contains("asset_id"))
+                // Already reflected in a newer snapshot
+                return;
+            }
+            else
+            {
+                if (shard.delta_books.size() <= token)
                 {
-                    return;
+                    shard.delta_books.resize(token + 1);
                 }
+                Shard::DeltaBook &copy = shard.delta_books[token];
+                bool in_step = copy.epoch == state.epoch;
 
-                std::string asset_id = j["asset_id"].get<std::string>();
-
-                Orderbook book;
-                book.asset_id = asset_id;
-                book.timestamp_ns = now_ns();
-
-                // Parse bids
-                if (j.contains("bids") && j["bids"].is_array())
+                std::string_view hash;
+                bool off_grid = false;
+                for (size_t i = 0; i < count; i++)
                 {
-                    for (const auto &bid : j["bids"])
+                    const LevelChange &change = changes[i];
+                    if (change.side == BookSide::BID)
                     {
-                        PriceLevel level;
-                        if (bid.contains("price"))
+                        apply_level(state.book.bids, change.price, change.size, true);
+                        if (in_step)
                         {
-                            if (bid["price"].is_string())
-                            {
-                                level.price = std::stod(bid["price"].get<std::string>());
-                            }
-                            else
-                            {
-                                level.price = bid["price"].get<double>();
-                            }
+                            apply_level(copy.book.bids, change.price, change.size, true);
                         }
-                        if (bid.contains("size"))
+                    }
+                    else
+                    {
+                        apply_level(state.book.asks, change.price, change.size, false);
+                        if (in_step)
                         {
-                            if (bid["size"].is_string())
-                            {
-                                level.size = std::stod(bid["size"].get<std::string>());
-                            }
-                            else
-                            {
-                                level.size = bid["size"].get<double>();
-                            }
+                            apply_level(copy.book.asks, change.price, change.size, false);
                         }
-                        book.bids.push_back(level);
                     }
-                    // Sort bids descending by price
-                    std::sort(book.bids.begin(), book.bids.end(),
-                              [](const PriceLevel &a, const PriceLevel &b)
-                              { return a.price > b.price; });
+                    off_grid |= !state.ladder.set(change.side, change.price, change.size);
+                    if (!change.hash.empty())
+                    {
+                        hash = change.hash;
+                    }
                 }
 
-                // Parse asks
-                if (j.contains("asks") && j["asks"].is_array())
+                if (off_grid)
                 {
-                    for (const auto &ask : j["asks"])
-                    {
-                        PriceLevel level;
-                        if (ask.contains("price"))
-                        {
-                            if (ask["price"].is_string())
-                            {
-                                level.price = std::stod(ask["price"].get<std::string>());
-                            }
-                            else
-                            {
-                                level.price = ask["price"].get<double>();
-                            }
-                        }
-                        if (ask.contains("size"))
-                        {
-                            if (ask["size"].is_string())
-                            {
-                                level.size = std::stod(ask["size"].get<std::string>());
-                            }
-                            else
-                            {
-                                level.size = ask["size"].get<double>();
-                            }
-                        }
-                        book.asks.push_back(level);
-                    }
-                    // Sort asks ascending by price
-                    std::sort(book.asks.begin(), book.asks.end(),
-                              [](const PriceLevel &a, const PriceLevel &b)
-                              { return a.price < b.price; });
+                    load_ladder(state);
+                }
+
+                const LevelChange &last = changes[count - 1];
+                if (last.has_top_of_book && !top_of_book_matches(state.ladder, last.best_bid, last.best_ask) &&
+                    !state.needs_resync)
+                {
+                    state.needs_resync = true;
+                    resync = true;
+                }
+                if (!hash.empty())
+                {
+                    state.hash.assign(hash.data(), hash.size());
                 }
+                if (server_ts_ms != 0)
+                {
+                    state.server_ts_ms = server_ts_ms;
+                }
+                state.book.timestamp_ns = now_ns();
+                publish_snapshot(state);
 
-                handle_orderbook_update(asset_id, book);
+                // Callbacks get the shard's own copy, so they never race with writers of the stored book. It took
+                // the same changes above; only a snapshot stored since the last delta makes it copy the book.
+                if (in_step)
+                {
+                    copy.book.timestamp_ns = state.book.timestamp_ns;
+                }
+                else
+                {
+                    copy.book = state.book;
+                    copy.epoch = state.epoch;
+                }
+                top = state.ladder.top();
+                applied = true;
             }
         }
-        catch (const std::exception &e)
+
+        if (resync)
+        {
+            request_resync(token);
+        }
+        if (applied)
         {
-            std::cerr << "[WS] Parse error: " << e.what() << std::endl;
+            dispatch_update(shard, token, shard.delta_books[token].book, top, apply_start_ns, server_ts_ms);
         }
     }
 
-    void OrderbookManager::handle_orderbook_update(const std::string &asset_id, const Orderbook &book)
+    void OrderbookManager::dispatch_update(Shard &shard, TokenHandle token, const Orderbook &book,
+                                           const TopOfBook &top, uint64_t apply_start_ns, uint64_t server_ts_ms)
     {
-        // Store orderbook
+        uint64_t applied_ns = now_ns();
+        handle_orderbook_update(shard.index, token, book, top, server_ts_ms, shard.receive_ns);
+        uint64_t dispatched_ns = now_ns();
+
+        latency_->apply.record(applied_ns - apply_start_ns);
+        latency_->dispatch.record(dispatched_ns - applied_ns);
+        latency_->internal.record(dispatched_ns - shard.receive_ns);
+        if (server_ts_ms != 0)
         {
-            std::unique_lock<std::shared_mutex> lock(orderbooks_mutex_);
-            orderbooks_[asset_id] = book;
+            // The server stamp is Unix time, so compare it with the wall clock; the receive instant is placed on
+            // it by the (steady) internal interval. Server clock ahead of ours reads as zero rather than wrapping.
+            uint64_t server_ns = server_ts_ms * 1000000;
+            uint64_t dispatched_wall_ns = wall_ns();
+            uint64_t internal_ns = dispatched_ns - shard.receive_ns;
+            uint64_t receive_wall_ns = dispatched_wall_ns > internal_ns ? dispatched_wall_ns - internal_ns : 0;
+            latency_->network.record(receive_wall_ns > server_ns ? receive_wall_ns - server_ns : 0);
+            latency_->end_to_end.record(dispatched_wall_ns > server_ns ? dispatched_wall_ns - server_ns : 0);
         }
+    }
 
-        total_updates_++;
-
-        // Find the condition this token belongs to
-        auto cond_it = token_to_condition_.find(asset_id);
-        if (cond_it == token_to_condition_.end())
+    void OrderbookManager::request_resync(TokenHandle token)
+    {
+        const std::string &asset_id = tokens_.id(token);
+        resyncs_requested_++;
+        std::cerr << "[OrderbookManager] Book out of sync, resync needed: " << asset_id.substr(0, 16) << "..." << std::endl;
+        if (on_resync_cb_)
         {
-            return;
+            on_resync_cb_(asset_id);
         }
+    }
 
-        const std::string &condition_id = cond_it->second;
+    void OrderbookManager::handle_orderbook_update(size_t lane, TokenHandle token, const Orderbook &book,
+                                                   const TopOfBook &top, uint64_t server_ts_ms, uint64_t receive_ns)
+    {
+        total_updates_++;
 
-        // Update market state
+        // Update market state (fields are atomics; the lock only pins the arrays, so get_market() readers are not blocked)
+        UpdateEvent event;
+        event.token = token;
+        event.top = top;
+        event.server_ts_ms = server_ts_ms;
+        event.receive_ns = receive_ns;
         {
-            std::unique_lock<std::shared_mutex> lock(markets_mutex_);
-            auto market_it = markets_.find(condition_id);
-            if (market_it != markets_.end())
+            std::shared_lock<std::shared_mutex> lock(markets_mutex_);
+            if (token < routes_.size())
             {
-                auto &market = *market_it->second;
-
-                if (asset_id == market.token_yes)
+                const TokenRoute &route = routes_[token];
+                if (route.condition < markets_.size() && markets_[route.condition])
                 {
-                    market.best_ask_yes.store(book.best_ask(), std::memory_order_relaxed);
-                    market.best_ask_yes_size.store(book.best_ask_size(), std::memory_order_relaxed);
-                }
-                else if (asset_id == market.token_no)
-                {
-                    market.best_ask_no.store(book.best_ask(), std::memory_order_relaxed);
-                    market.best_ask_no_size.store(book.best_ask_size(), std::memory_order_relaxed);
-                }
+                    auto &market = *markets_[route.condition];
+                    event.condition = route.condition;
+                    event.is_yes = route.is_yes;
+
+                    if (route.is_yes)
+                    {
+                        market.best_ask_yes.store(top.best_ask, std::memory_order_relaxed);
+                        market.best_ask_yes_size.store(top.best_ask_size, std::memory_order_relaxed);
+                    }
+                    else
+                    {
+                        market.best_ask_no.store(top.best_ask, std::memory_order_relaxed);
+                        market.best_ask_no_size.store(top.best_ask_size, std::memory_order_relaxed);
+                    }
+                    event.best_ask_yes = market.best_ask_yes.load(std::memory_order_relaxed);
+                    event.best_ask_no = market.best_ask_no.load(std::memory_order_relaxed);
 
-                market.last_update_ns.store(book.timestamp_ns, std::memory_order_relaxed);
-                market.update_count.fetch_add(1, std::memory_order_relaxed);
+                    market.last_update_ns.store(book.timestamp_ns, std::memory_order_relaxed);
+                    market.update_count.fetch_add(1, std::memory_order_relaxed);
+                }
             }
         }
+        TokenHandle condition = event.condition;
+        bool is_yes = event.is_yes;
 
-        // Callback
+        // Books for tokens outside any subscribed market are kept but not routed
+        if (condition == kInvalidToken)
+        {
+            return;
+        }
+
+        // Callback, then the strategy threads' rings
         if (on_update_cb_)
         {
-            on_update_cb_(asset_id, book);
+            on_update_cb_(book.asset_id, book);
+        }
+        if (!consumers_.empty())
+        {
+            publish_event(lane, event);
+        }
+
+        // Prefix sums of this leg's asks for sizing, then event baskets (O(1) sum update unless the basket
+        // crosses its trigger)
+        {
+            std::lock_guard<std::mutex> lock(arb_mutex_);
+            if (condition < market_depth_.size())
+            {
+                MarketDepth &depth = market_depth_[condition];
+                (is_yes ? depth.yes_asks : depth.no_asks).build(book.asks);
+            }
+            if (has_events_.load(std::memory_order_relaxed))
+            {
+                event_scanner_.update(token, book);
+            }
         }
 
         // Check for arb opportunity
-        check_arb_opportunity(condition_id);
+        check_arb_opportunity(lane, condition, event);
     }
 
-    void OrderbookManager::check_arb_opportunity(const std::string &condition_id)
+    void OrderbookManager::check_arb_opportunity(size_t lane, TokenHandle condition, UpdateEvent &event)
     {
         std::shared_lock<std::shared_mutex> lock(markets_mutex_);
-        auto it = markets_.find(condition_id);
-        if (it == markets_.end())
+        if (condition >= markets_.size() || !markets_[condition] || condition == staged_)
         {
-            return;
+            return; // Unsubscribed, or staged for a rollover and not live yet
         }
 
-        const auto &market = *it->second;
+        const auto &market = *markets_[condition];
         double combined = market.combined();
 
         // Check if both prices are set
@@ -434,6 +1233,31 @@ namespace polymarket
             {
                 on_arb_cb_(market, combined);
             }
+
+            if (on_arb_sizing_cb_ || arb_consumers_)
+            {
+                ArbSizing sizing;
+                {
+                    std::lock_guard<std::mutex> depth_lock(arb_mutex_);
+                    if (condition < market_depth_.size())
+                    {
+                        const MarketDepth &depth = market_depth_[condition];
+                        sizing = size_pair_arb(depth.yes_asks, depth.no_asks, config_.trigger_combined);
+                    }
+                }
+                if (on_arb_sizing_cb_)
+                {
+                    on_arb_sizing_cb_(market, sizing);
+                }
+                if (arb_consumers_)
+                {
+                    event.kind = UpdateKind::ARB;
+                    event.best_ask_yes = ask_yes;
+                    event.best_ask_no = ask_no;
+                    event.sizing = sizing;
+                    publish_event(lane, event);
+                }
+            }
         }
     }
 
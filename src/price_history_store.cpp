@@ -0,0 +1,520 @@
+#include "price_history_store.hpp"
+#include "types.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using json = nlohmann::json;
+
+namespace polymarket
+{
+
+    namespace
+    {
+        constexpr char kTimestampMagic[8] = {'P', 'M', 'H', 'T', 'S', '0', '0', '1'};
+        constexpr char kPriceMagic[8] = {'P', 'M', 'H', 'P', 'X', '0', '0', '1'};
+        constexpr size_t kMinCapacity = 1024;
+
+        // Same header at the start of both files of a series
+        struct SeriesHeader
+        {
+            char magic[8];
+            uint64_t count;        // Points written
+            uint64_t stamp;        // Set when the series is created; both files must match
+            uint64_t covered_from; // Timestamps only
+            uint64_t covered_to;
+            uint64_t reserved[3];
+        };
+        static_assert(sizeof(SeriesHeader) == 64, "series header layout is part of the file format");
+        constexpr size_t kHeaderSize = sizeof(SeriesHeader);
+
+        std::runtime_error io_error(const std::string &what, const std::string &path)
+        {
+            return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+        }
+
+        SeriesHeader &header(char *base)
+        {
+            return *reinterpret_cast<SeriesHeader *>(base);
+        }
+
+        bool read_header(int fd, SeriesHeader &out, size_t file_bytes, const char *magic)
+        {
+            return file_bytes >= kHeaderSize && ::pread(fd, &out, kHeaderSize, 0) == static_cast<ssize_t>(kHeaderSize) &&
+                   std::memcmp(out.magic, magic, sizeof(out.magic)) == 0 &&
+                   out.count <= (file_bytes - kHeaderSize) / sizeof(uint64_t);
+        }
+
+        size_t file_size(int fd)
+        {
+            struct stat st;
+            return ::fstat(fd, &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+        }
+
+        // Collects {"history": [{"t": ..., "p": ...}, ...]} into columns; depth counts open objects and arrays
+        class HistoryHandler : public nlohmann::json_sax<json>
+        {
+        public:
+            HistoryHandler(std::vector<uint64_t> &timestamps, std::vector<double> &prices)
+                : timestamps_(timestamps), prices_(prices)
+            {
+            }
+
+            bool null() override { return true; }
+            bool boolean(bool) override { return true; }
+            bool binary(binary_t &) override { return true; }
+
+            bool number_integer(number_integer_t value) override
+            {
+                return number(static_cast<double>(value), value > 0 ? static_cast<uint64_t>(value) : 0);
+            }
+            bool number_unsigned(number_unsigned_t value) override
+            {
+                return number(static_cast<double>(value), value);
+            }
+            bool number_float(number_float_t value, const string_t &) override
+            {
+                return number(value, value > 0 ? static_cast<uint64_t>(value) : 0);
+            }
+
+            bool string(string_t &value) override
+            {
+                if (in_point() && field_ == Field::PRICE)
+                {
+                    std::from_chars(value.data(), value.data() + value.size(), price_);
+                }
+                return true;
+            }
+
+            bool start_object(std::size_t) override
+            {
+                depth_++;
+                if (in_point())
+                {
+                    field_ = Field::OTHER;
+                    timestamp_ = 0;
+                    price_ = 0.0;
+                    has_timestamp_ = false;
+                }
+                return true;
+            }
+
+            bool end_object() override
+            {
+                if (in_point() && has_timestamp_)
+                {
+                    timestamps_.push_back(timestamp_);
+                    prices_.push_back(price_);
+                }
+                depth_--;
+                return true;
+            }
+
+            bool start_array(std::size_t) override
+            {
+                if (depth_ == 1 && history_key_)
+                {
+                    in_history_ = true;
+                }
+                depth_++;
+                return true;
+            }
+
+            bool end_array() override
+            {
+                depth_--;
+                if (depth_ == 1)
+                {
+                    in_history_ = false;
+                }
+                return true;
+            }
+
+            bool key(string_t &key) override
+            {
+                if (depth_ == 1)
+                {
+                    history_key_ = key == "history";
+                }
+                else if (in_point())
+                {
+                    field_ = key == "t" ? Field::TIMESTAMP : key == "p" ? Field::PRICE
+                                                                          : Field::OTHER;
+                }
+                return true;
+            }
+
+            bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &) override
+            {
+                return false;
+            }
+
+        private:
+            enum class Field
+            {
+                OTHER,
+                TIMESTAMP,
+                PRICE
+            };
+
+            std::vector<uint64_t> &timestamps_;
+            std::vector<double> &prices_;
+            size_t depth_{0};
+            bool history_key_{false};
+            bool in_history_{false};
+            Field field_{Field::OTHER};
+            uint64_t timestamp_{0};
+            double price_{0.0};
+            bool has_timestamp_{false};
+
+            bool in_point() const { return in_history_ && depth_ == 3; }
+
+            bool number(double as_double, uint64_t as_integer)
+            {
+                if (in_point() && field_ == Field::TIMESTAMP)
+                {
+                    timestamp_ = as_integer;
+                    has_timestamp_ = true;
+                }
+                else if (in_point() && field_ == Field::PRICE)
+                {
+                    price_ = as_double;
+                }
+                return true;
+            }
+        };
+    } // namespace
+
+    PriceHistoryView PriceHistoryView::slice(uint64_t from, uint64_t to) const
+    {
+        size_t first = std::lower_bound(timestamps.begin(), timestamps.end(), from) - timestamps.begin();
+        size_t last = to == 0 ? timestamps.size()
+                              : std::upper_bound(timestamps.begin(), timestamps.end(), to) - timestamps.begin();
+        last = std::max(first, last);
+        return PriceHistoryView{timestamps.subspan(first, last - first), prices.subspan(first, last - first)};
+    }
+
+    PriceHistoryStore::PriceHistoryStore(std::string directory) : directory_(std::move(directory))
+    {
+        if (directory_.empty())
+        {
+            directory_ = ".";
+        }
+        if (::mkdir(directory_.c_str(), 0755) != 0 && errno != EEXIST)
+        {
+            throw io_error("Failed to create price history cache", directory_);
+        }
+    }
+
+    PriceHistoryStore::~PriceHistoryStore()
+    {
+        for (auto &[name, series] : series_)
+        {
+            release(*series);
+        }
+        for (auto &[base, bytes] : retired_)
+        {
+            ::munmap(base, bytes);
+        }
+    }
+
+    void PriceHistoryStore::map_column(Column &column, size_t bytes, const std::string &path)
+    {
+        if (::ftruncate(column.fd, static_cast<off_t>(bytes)) != 0)
+        {
+            throw io_error("Failed to extend price history", path);
+        }
+        void *base = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, column.fd, 0);
+        if (base == MAP_FAILED)
+        {
+            throw io_error("Failed to map price history", path);
+        }
+        if (column.base)
+        {
+            retired_.emplace_back(column.base, column.bytes);
+        }
+        column.base = static_cast<char *>(base);
+        column.bytes = bytes;
+    }
+
+    void PriceHistoryStore::reserve(Series &series, size_t capacity)
+    {
+        if (capacity <= series.capacity)
+        {
+            return;
+        }
+        size_t bytes = kHeaderSize + capacity * sizeof(uint64_t);
+        map_column(series.timestamps, bytes, "fd " + std::to_string(series.timestamps.fd));
+        map_column(series.prices, bytes, "fd " + std::to_string(series.prices.fd));
+        series.capacity = capacity;
+    }
+
+    void PriceHistoryStore::release(Series &series)
+    {
+        for (Column *column : {&series.timestamps, &series.prices})
+        {
+            if (column->base)
+            {
+                retired_.emplace_back(column->base, column->bytes);
+                column->base = nullptr;
+            }
+            if (column->fd >= 0)
+            {
+                ::close(column->fd);
+                column->fd = -1;
+            }
+        }
+    }
+
+    std::unique_ptr<PriceHistoryStore::Series> PriceHistoryStore::load(const std::string &path, const std::string &name,
+                                                                       bool truncate)
+    {
+        auto series = std::make_unique<Series>();
+        int flags = O_RDWR | O_CREAT | (truncate ? O_TRUNC : 0);
+        try
+        {
+            series->timestamps.fd = ::open((path + ".ts").c_str(), flags, 0644);
+            series->prices.fd = series->timestamps.fd < 0 ? -1 : ::open((path + ".px").c_str(), flags, 0644);
+            if (series->prices.fd < 0)
+            {
+                throw io_error("Failed to open price history", path);
+            }
+
+            size_t ts_bytes = file_size(series->timestamps.fd);
+            size_t px_bytes = file_size(series->prices.fd);
+            SeriesHeader ts_header{};
+            SeriesHeader px_header{};
+            bool valid = read_header(series->timestamps.fd, ts_header, ts_bytes, kTimestampMagic) &&
+                         read_header(series->prices.fd, px_header, px_bytes, kPriceMagic) &&
+                         ts_header.stamp == px_header.stamp && ts_header.count == px_header.count;
+            if (!valid && (ts_bytes > 0 || px_bytes > 0))
+            {
+                std::cerr << "[PriceHistoryStore] Discarding unreadable cache for " << name << std::endl;
+            }
+
+            size_t capacity = 0;
+            if (valid)
+            {
+                capacity = (std::min(ts_bytes, px_bytes) - kHeaderSize) / sizeof(uint64_t);
+                size_t bytes = kHeaderSize + capacity * sizeof(uint64_t);
+                map_column(series->timestamps, bytes, path + ".ts");
+                map_column(series->prices, bytes, path + ".px");
+                series->capacity = capacity;
+            }
+            else if (::ftruncate(series->timestamps.fd, 0) != 0 || ::ftruncate(series->prices.fd, 0) != 0)
+            {
+                throw io_error("Failed to reset price history", path);
+            }
+            reserve(*series, std::max(capacity, kMinCapacity));
+
+            if (!valid)
+            {
+                SeriesHeader fresh{};
+                fresh.stamp = now_ns();
+                std::memcpy(fresh.magic, kTimestampMagic, sizeof(fresh.magic));
+                header(series->timestamps.base) = fresh;
+                std::memcpy(fresh.magic, kPriceMagic, sizeof(fresh.magic));
+                header(series->prices.base) = fresh;
+            }
+        }
+        catch (...)
+        {
+            release(*series);
+            throw;
+        }
+        return series;
+    }
+
+    PriceHistoryStore::Series &PriceHistoryStore::open_series(const std::string &name)
+    {
+        auto it = series_.find(name);
+        if (it != series_.end())
+        {
+            return *it->second;
+        }
+        if (name.empty() || name.find('/') != std::string::npos)
+        {
+            throw std::runtime_error("Invalid price history series name: " + name);
+        }
+        auto series = load(directory_ + "/" + name, name, false);
+        return *series_.emplace(name, std::move(series)).first->second;
+    }
+
+    PriceHistoryView PriceHistoryStore::view(const std::string &series_name)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Series &series = open_series(series_name);
+        size_t count = header(series.timestamps.base).count;
+        return PriceHistoryView{
+            std::span<const uint64_t>(reinterpret_cast<const uint64_t *>(series.timestamps.base + kHeaderSize), count),
+            std::span<const double>(reinterpret_cast<const double *>(series.prices.base + kHeaderSize), count)};
+    }
+
+    PriceHistoryCoverage PriceHistoryStore::coverage(const std::string &series_name)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const SeriesHeader &h = header(open_series(series_name).timestamps.base);
+        return PriceHistoryCoverage{h.covered_from, h.covered_to};
+    }
+
+    void PriceHistoryStore::append(const std::string &series_name, const uint64_t *timestamps, const double *prices,
+                                   size_t count, uint64_t covered_to)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Series &series = open_series(series_name);
+        size_t size = header(series.timestamps.base).count;
+        if (size + count > series.capacity)
+        {
+            reserve(series, std::max(series.capacity * 2, size + count));
+        }
+
+        auto *ts = reinterpret_cast<uint64_t *>(series.timestamps.base + kHeaderSize);
+        auto *px = reinterpret_cast<double *>(series.prices.base + kHeaderSize);
+        uint64_t last = size > 0 ? ts[size - 1] : 0;
+        size_t written = size;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (written > 0 && timestamps[i] <= last)
+            {
+                continue;
+            }
+            ts[written] = timestamps[i];
+            px[written] = prices[i];
+            last = timestamps[i];
+            written++;
+        }
+
+        // Counts after the data, so a reader of the files never sees unwritten points
+        SeriesHeader &ts_header = header(series.timestamps.base);
+        header(series.prices.base).count = written;
+        ts_header.count = written;
+        ts_header.covered_to = std::max(ts_header.covered_to, covered_to);
+        if (ts_header.covered_from == 0 && size == 0 && written > 0)
+        {
+            ts_header.covered_from = ts[0];
+        }
+    }
+
+    void PriceHistoryStore::replace(const std::string &series_name, const uint64_t *timestamps, const double *prices,
+                                    size_t count, uint64_t covered_from, uint64_t covered_to)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_series(series_name); // Validates the name
+        std::string path = directory_ + "/" + series_name;
+        std::string staging = path + ".new";
+
+        auto fresh = load(staging, series_name, true);
+        reserve(*fresh, count);
+        auto *ts = reinterpret_cast<uint64_t *>(fresh->timestamps.base + kHeaderSize);
+        auto *px = reinterpret_cast<double *>(fresh->prices.base + kHeaderSize);
+        size_t written = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (written > 0 && timestamps[i] <= ts[written - 1])
+            {
+                continue;
+            }
+            ts[written] = timestamps[i];
+            px[written] = prices[i];
+            written++;
+        }
+        SeriesHeader &ts_header = header(fresh->timestamps.base);
+        header(fresh->prices.base).count = written;
+        ts_header.count = written;
+        ts_header.covered_from = covered_from;
+        ts_header.covered_to = covered_to;
+
+        // Views of the old series keep the old files' pages through their mappings
+        if (::rename((staging + ".px").c_str(), (path + ".px").c_str()) != 0 ||
+            ::rename((staging + ".ts").c_str(), (path + ".ts").c_str()) != 0)
+        {
+            int saved = errno;
+            release(*fresh);
+            errno = saved;
+            throw io_error("Failed to replace price history", path);
+        }
+        auto &slot = series_[series_name];
+        release(*slot);
+        slot = std::move(fresh);
+    }
+
+    PriceHistoryView PriceHistoryStore::refresh(const std::string &series, uint64_t start_ts, uint64_t end_ts,
+                                                uint64_t now, uint64_t step, const Fetch &fetch)
+    {
+        uint64_t end = end_ts == 0 || end_ts > now ? now : end_ts;
+        std::vector<uint64_t> timestamps;
+        std::vector<double> prices;
+        PriceHistoryCoverage covered = coverage(series);
+        if (covered.to == 0)
+        {
+            if (fetch(start_ts, end, timestamps, prices))
+            {
+                replace(series, timestamps.data(), prices.data(), timestamps.size(), start_ts, end);
+            }
+            return view(series).slice(start_ts, end_ts);
+        }
+
+        if (start_ts < covered.from && fetch(start_ts, covered.from, timestamps, prices))
+        {
+            // Earlier points go in front of the cached ones, so this is the one case that rewrites the series
+            PriceHistoryView cached = view(series);
+            size_t keep = cached.empty() ? timestamps.size()
+                                         : std::lower_bound(timestamps.begin(), timestamps.end(), cached.timestamps[0]) -
+                                               timestamps.begin();
+            timestamps.resize(keep);
+            prices.resize(keep);
+            timestamps.insert(timestamps.end(), cached.timestamps.begin(), cached.timestamps.end());
+            prices.insert(prices.end(), cached.prices.begin(), cached.prices.end());
+            replace(series, timestamps.data(), prices.data(), timestamps.size(), start_ts, covered.to);
+            covered.from = start_ts;
+        }
+
+        // Open-ended calls wait for the next point to be due; fixed ranges are fetched once
+        if (end > covered.to && (end_ts != 0 || end - covered.to >= step))
+        {
+            // From the last point rather than covered.to: a point stamped before the previous fetch may have been
+            // published after it (the bucket was still open, or the server lagged). append() drops the repeats.
+            PriceHistoryView cached = view(series);
+            uint64_t from = cached.empty() ? covered.from : cached.timestamps.back();
+            timestamps.clear();
+            prices.clear();
+            if (fetch(from, end, timestamps, prices))
+            {
+                append(series, timestamps.data(), prices.data(), timestamps.size(), end);
+            }
+        }
+        return view(series).slice(start_ts, end_ts);
+    }
+
+    void PriceHistoryStore::flush()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &[name, series] : series_)
+        {
+            ::msync(series->timestamps.base, series->timestamps.bytes, MS_SYNC);
+            ::msync(series->prices.base, series->prices.bytes, MS_SYNC);
+        }
+    }
+
+    bool parse_price_history(std::string_view body, std::vector<uint64_t> &timestamps, std::vector<double> &prices)
+    {
+        size_t before = timestamps.size();
+        HistoryHandler handler(timestamps, prices);
+        if (!json::sax_parse(body.begin(), body.end(), &handler))
+        {
+            timestamps.resize(before);
+            prices.resize(before);
+            return false;
+        }
+        return true;
+    }
+
+} // namespace polymarket
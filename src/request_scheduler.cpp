@@ -0,0 +1,310 @@
+#include "request_scheduler.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace polymarket
+{
+
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        struct DefaultLimit
+        {
+            const char *method;
+            const char *path;
+            double burst;      // Requests per 10s window
+            double per_second; // Sustained rate (10-minute limit where one is documented)
+        };
+
+        // Polymarket's documented CLOB limits; override with set_limit() if they change
+        constexpr DefaultLimit kDefaultLimits[] = {
+            // Trading
+            {"POST", "/order", 3500, 60},
+            {"POST", "/orders", 1000, 25},
+            {"DELETE", "/order", 3000, 50},
+            {"DELETE", "/orders", 1000, 25},
+            {"DELETE", "/cancel-all", 250, 10},
+            {"POST", "/cancel-all", 250, 10},
+            {"DELETE", "/cancel-market-orders", 1000, 2.5},
+            {"POST", "/cancel-market-orders", 1000, 2.5},
+            // Market data
+            {"GET", "/book", 1500, 150},
+            {"GET", "/books", 500, 50},
+            {"GET", "/price", 1500, 150},
+            {"GET", "/prices", 500, 50},
+            {"GET", "/midpoint", 1500, 150},
+            {"GET", "/midpoints", 500, 50},
+            {"GET", "/spread", 1500, 150},
+            {"GET", "/spreads", 500, 50},
+            {"GET", "/last-trade-price", 1500, 150},
+            {"GET", "/last-trades-prices", 500, 50},
+            {"GET", "/prices-history", 1000, 100},
+            {"GET", "/markets", 250, 25},
+            {"GET", "/tick-size", 200, 20},
+            // Account
+            {"GET", "/orders", 500, 50},
+            {"GET", "/trades", 500, 50},
+            {"GET", "/balance-allowance", 125, 12.5},
+            {"POST", "/balance-allowance", 20, 2},
+            {"GET", "/auth/api-keys", 100, 10},
+        };
+
+        std::string_view strip_query(std::string_view path)
+        {
+            return path.substr(0, path.find('?'));
+        }
+
+        // "METHOD /path" in a reused buffer
+        const std::string &bucket_key(std::string_view method, std::string_view path)
+        {
+            thread_local std::string key;
+            key.assign(method);
+            key += ' ';
+            key.append(strip_query(path));
+            return key;
+        }
+
+        void refill(double &tokens, double burst, double per_second, Clock::time_point &updated, Clock::time_point now)
+        {
+            double elapsed = std::chrono::duration<double>(now - updated).count();
+            if (elapsed > 0)
+            {
+                tokens = std::min(burst, tokens + elapsed * per_second);
+                updated = now;
+            }
+        }
+
+        // Time until a bucket holds `needed` tokens
+        Clock::duration time_until(double tokens, double needed, double per_second)
+        {
+            if (tokens >= needed)
+            {
+                return Clock::duration::zero();
+            }
+            if (per_second <= 0)
+            {
+                return std::chrono::hours(1);
+            }
+            return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>((needed - tokens) / per_second));
+        }
+
+        bool is_query(RequestLane lane)
+        {
+            return lane == RequestLane::ACCOUNT || lane == RequestLane::MARKET_DATA;
+        }
+    } // namespace
+
+    RequestScheduler::RequestScheduler(RequestSchedulerConfig config) : config_(config)
+    {
+        auto now = Clock::now();
+        global_ = Bucket{config_.global_burst, config_.global_per_second, config_.global_burst, now};
+        for (const auto &limit : kDefaultLimits)
+        {
+            buckets_[bucket_key(limit.method, limit.path)] = Bucket{limit.burst, limit.per_second, limit.burst, now};
+        }
+    }
+
+    void RequestScheduler::set_limit(std::string_view method, std::string_view path, double burst, double per_second)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            buckets_[bucket_key(method, path)] = Bucket{burst, per_second, burst, Clock::now()};
+        }
+        cv_.notify_all();
+    }
+
+    void RequestScheduler::set_enabled(bool enabled)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_.enabled = enabled;
+        }
+        cv_.notify_all();
+    }
+
+    RequestLane RequestScheduler::lane_for(std::string_view method, std::string_view path)
+    {
+        path = strip_query(path);
+        if (method == "DELETE" || path.rfind("/cancel", 0) == 0)
+        {
+            return RequestLane::CANCEL;
+        }
+        if (method == "POST" && (path == "/order" || path == "/orders"))
+        {
+            return RequestLane::ORDER;
+        }
+        for (std::string_view prefix : {"/order", "/trades", "/auth", "/balance-allowance", "/notifications",
+                                        "/rewards/earnings", "/rewards/total-earnings", "/data/"})
+        {
+            if (path.rfind(prefix, 0) == 0)
+            {
+                return RequestLane::ACCOUNT;
+            }
+        }
+        return RequestLane::MARKET_DATA;
+    }
+
+    RequestScheduler::Bucket *RequestScheduler::find_bucket(std::string_view method, std::string_view path)
+    {
+        auto it = buckets_.find(bucket_key(method, path));
+        return it == buckets_.end() ? nullptr : &it->second;
+    }
+
+    bool RequestScheduler::acquire(RequestLane lane, std::string_view method, std::string_view path)
+    {
+        return admit(lane, method, path, is_query(lane) ? config_.query_max_wait : config_.order_max_wait);
+    }
+
+    bool RequestScheduler::try_acquire(RequestLane lane, std::string_view method, std::string_view path)
+    {
+        return admit(lane, method, path, Clock::duration::zero());
+    }
+
+    bool RequestScheduler::admit(RequestLane lane, std::string_view method, std::string_view path,
+                                 Clock::duration max_wait)
+    {
+        size_t index = static_cast<size_t>(lane);
+        LaneCounters &counters = counters_[index];
+        auto start = Clock::now();
+        auto deadline = start + max_wait;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!config_.enabled)
+        {
+            lock.unlock();
+            counters.requests.fetch_add(1, std::memory_order_relaxed);
+            counters.queued.record(0);
+            return true;
+        }
+
+        Bucket *endpoint = find_bucket(method, path);
+        double reserve = is_query(lane) ? config_.query_reserve * global_.burst : 0.0;
+        bool waiting = false;
+        bool admitted = false;
+        bool overrun = false;
+        while (true)
+        {
+            auto now = Clock::now();
+            refill(global_.tokens, global_.burst, global_.per_second, global_.updated, now);
+            if (endpoint)
+            {
+                refill(endpoint->tokens, endpoint->burst, endpoint->per_second, endpoint->updated, now);
+            }
+
+            // A higher lane waiting gets the next tokens
+            bool yield_to_higher = false;
+            for (size_t i = 0; i < index; i++)
+            {
+                yield_to_higher = yield_to_higher || waiting_[i] > 0;
+            }
+
+            Clock::duration wait = std::max(time_until(global_.tokens, 1.0 + reserve, global_.per_second),
+                                            endpoint ? time_until(endpoint->tokens, 1.0, endpoint->per_second)
+                                                     : Clock::duration::zero());
+            if (!yield_to_higher && wait == Clock::duration::zero())
+            {
+                admitted = true;
+                break;
+            }
+            if (now >= deadline || (!yield_to_higher && now + wait > deadline))
+            {
+                // No token in time. Orders and cancels still go out, now rather than at the deadline (the server
+                // is the final judge); queries are dropped
+                admitted = overrun = !is_query(lane) && max_wait > Clock::duration::zero();
+                break;
+            }
+            if (!waiting)
+            {
+                waiting = true;
+                waiting_[index]++;
+            }
+            // Woken early when a higher lane's waiter leaves; otherwise sleep until the tokens are there
+            cv_.wait_until(lock, yield_to_higher ? std::min(deadline, now + std::chrono::milliseconds(1))
+                                                 : std::min(deadline, now + wait));
+        }
+
+        if (admitted)
+        {
+            global_.tokens -= 1.0; // May go negative on an overrun: the debt delays whoever comes next
+            if (endpoint)
+            {
+                endpoint->tokens -= 1.0;
+            }
+        }
+        if (waiting)
+        {
+            waiting_[index]--;
+        }
+        lock.unlock();
+        if (waiting)
+        {
+            cv_.notify_all();
+        }
+
+        if (!admitted)
+        {
+            counters.dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        auto queued = Clock::now() - start;
+        counters.requests.fetch_add(1, std::memory_order_relaxed);
+        counters.queued.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(queued).count()));
+        if (waiting)
+        {
+            counters.throttled.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (overrun)
+        {
+            counters.overruns.fetch_add(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    void RequestScheduler::on_response(RequestLane lane, std::string_view method, std::string_view path,
+                                       long status_code)
+    {
+        if (status_code != 429)
+        {
+            return;
+        }
+        counters_[static_cast<size_t>(lane)].rejected.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(mutex_);
+        Bucket *endpoint = find_bucket(method, path);
+        Bucket &bucket = endpoint ? *endpoint : global_;
+        bucket.tokens = std::min(bucket.tokens, 0.0);
+        bucket.updated = Clock::now();
+        std::cerr << "[RequestScheduler] 429 on " << method << " " << strip_query(path) << ", backing off" << std::endl;
+    }
+
+    RequestSchedulerStats RequestScheduler::stats() const
+    {
+        RequestSchedulerStats stats;
+        for (size_t i = 0; i < kRequestLanes; i++)
+        {
+            const LaneCounters &c = counters_[i];
+            RequestLaneStats &out = stats.lanes[i];
+            out.requests = c.requests.load(std::memory_order_relaxed);
+            out.throttled = c.throttled.load(std::memory_order_relaxed);
+            out.dropped = c.dropped.load(std::memory_order_relaxed);
+            out.overruns = c.overruns.load(std::memory_order_relaxed);
+            out.rejected = c.rejected.load(std::memory_order_relaxed);
+            out.queued = c.queued.summary();
+        }
+        return stats;
+    }
+
+    void RequestScheduler::reset_stats()
+    {
+        for (auto &c : counters_)
+        {
+            c.requests.store(0, std::memory_order_relaxed);
+            c.throttled.store(0, std::memory_order_relaxed);
+            c.dropped.store(0, std::memory_order_relaxed);
+            c.overruns.store(0, std::memory_order_relaxed);
+            c.rejected.store(0, std::memory_order_relaxed);
+            c.queued.reset();
+        }
+    }
+
+} // namespace polymarket
@@ -0,0 +1,47 @@
+#include "token_registry.hpp"
+#include <mutex>
+
+namespace polymarket
+{
+
+    TokenHandle TokenRegistry::intern(std::string_view id)
+    {
+        TokenHandle handle = find(id);
+        if (handle != kInvalidToken)
+        {
+            return handle;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = handles_.find(id);
+        if (it != handles_.end())
+        {
+            return it->second; // Interned by another thread in the meantime
+        }
+
+        handle = static_cast<TokenHandle>(ids_.size());
+        const std::string &stored = ids_.emplace_back(id);
+        handles_.emplace(std::string_view(stored), handle);
+        return handle;
+    }
+
+    TokenHandle TokenRegistry::find(std::string_view id) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = handles_.find(id);
+        return it != handles_.end() ? it->second : kInvalidToken;
+    }
+
+    const std::string &TokenRegistry::id(TokenHandle handle) const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return ids_.at(handle);
+    }
+
+    size_t TokenRegistry::size() const
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return ids_.size();
+    }
+
+} // namespace polymarket
@@ -0,0 +1,133 @@
+#include "update_dispatch.hpp"
+#include <algorithm>
+#include <thread>
+
+namespace polymarket
+{
+
+    namespace
+    {
+        inline void cpu_relax()
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        }
+
+        // Bump a counter only one thread writes, without a locked read-modify-write
+        inline void bump(std::atomic<uint64_t> &counter)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    } // namespace
+
+    UpdateConsumer::UpdateConsumer(UpdateConsumerConfig config, size_t producer_lanes) : config_(config)
+    {
+        size_t count = std::max<size_t>(producer_lanes, 1);
+        lanes_.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            lanes_.push_back(std::make_unique<Lane>(config_.capacity));
+        }
+    }
+
+    bool UpdateConsumer::poll(UpdateEvent &out)
+    {
+        size_t count = lanes_.size();
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t index = next_lane_ + i < count ? next_lane_ + i : next_lane_ + i - count;
+            if (lanes_[index]->ring.try_pop(out))
+            {
+                // Start after this lane next time so a busy shard can't starve the others
+                next_lane_ = index + 1 == count ? 0 : index + 1;
+                bump(consumed_);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool UpdateConsumer::wait(UpdateEvent &out, std::chrono::microseconds timeout)
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (uint32_t spins = 0;; spins++)
+        {
+            if (poll(out))
+            {
+                return true;
+            }
+            if (spins < 128)
+            {
+                cpu_relax();
+                continue;
+            }
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    void UpdateConsumer::publish(size_t lane, const UpdateEvent &event)
+    {
+        size_t shared = lanes_.size() - 1;
+        Lane &target = *lanes_[std::min(lane, shared)];
+        std::unique_lock<std::mutex> lock(shared_lane_mutex_, std::defer_lock);
+        if (lane >= shared)
+        {
+            lock.lock();
+        }
+
+        UpdateEvent stamped = event;
+        stamped.publish_ns = now_ns();
+        if (target.ring.try_push(stamped))
+        {
+            bump(target.published);
+            return;
+        }
+
+        if (config_.overflow == OverflowPolicy::BLOCK)
+        {
+            bump(target.blocked);
+            auto deadline = std::chrono::steady_clock::now() + config_.block_timeout;
+            for (uint32_t spins = 0;; spins++)
+            {
+                if (target.ring.try_push(stamped))
+                {
+                    bump(target.published);
+                    return;
+                }
+                if (spins < 128)
+                {
+                    cpu_relax();
+                    continue;
+                }
+                if (std::chrono::steady_clock::now() >= deadline)
+                {
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+        bump(target.dropped);
+    }
+
+    UpdateConsumerStats UpdateConsumer::stats() const
+    {
+        UpdateConsumerStats stats;
+        for (const auto &lane : lanes_)
+        {
+            stats.published += lane->published.load(std::memory_order_relaxed);
+            stats.dropped += lane->dropped.load(std::memory_order_relaxed);
+            stats.blocked += lane->blocked.load(std::memory_order_relaxed);
+            stats.depth += lane->ring.size();
+        }
+        stats.consumed = consumed_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+} // namespace polymarket
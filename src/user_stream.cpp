@@ -0,0 +1,349 @@
+#include "user_stream.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <iostream>
+
+using json = nlohmann::json;
+
+namespace polymarket
+{
+
+    namespace
+    {
+        // User channel fields are strings, but be lenient with numbers
+        std::string str(const json &j, const char *key)
+        {
+            auto it = j.find(key);
+            if (it == j.end() || it->is_null())
+            {
+                return "";
+            }
+            return it->is_string() ? it->get<std::string>() : it->dump();
+        }
+
+        uint64_t timestamp_ms(const json &j)
+        {
+            std::string ts = str(j, "timestamp");
+            try
+            {
+                return ts.empty() ? 0 : std::stoull(ts);
+            }
+            catch (...)
+            {
+                return 0;
+            }
+        }
+
+        UserTrade parse_trade(const json &j)
+        {
+            UserTrade trade;
+            trade.id = str(j, "id");
+            trade.taker_order_id = str(j, "taker_order_id");
+            trade.market = str(j, "market");
+            trade.asset_id = str(j, "asset_id");
+            trade.side = str(j, "side");
+            trade.outcome = str(j, "outcome");
+            trade.size = str(j, "size");
+            trade.price = str(j, "price");
+            trade.fee_rate_bps = str(j, "fee_rate_bps");
+            trade.status = str(j, "status");
+            trade.owner = str(j, "owner");
+            trade.match_time = str(j, "matchtime");
+            if (trade.match_time.empty())
+            {
+                trade.match_time = str(j, "match_time");
+            }
+            trade.transaction_hash = str(j, "transaction_hash");
+            trade.server_timestamp_ms = timestamp_ms(j);
+            auto makers = j.find("maker_orders");
+            if (makers != j.end() && makers->is_array())
+            {
+                for (const auto &m : *makers)
+                {
+                    MakerFill fill;
+                    fill.order_id = str(m, "order_id");
+                    fill.asset_id = str(m, "asset_id");
+                    fill.outcome = str(m, "outcome");
+                    fill.matched_amount = str(m, "matched_amount");
+                    fill.price = str(m, "price");
+                    fill.owner = str(m, "owner");
+                    trade.maker_orders.push_back(std::move(fill));
+                }
+            }
+            return trade;
+        }
+
+        UserOrderEvent parse_order(const json &j)
+        {
+            UserOrderEvent order;
+            order.id = str(j, "id");
+            order.type = str(j, "type");
+            order.market = str(j, "market");
+            order.asset_id = str(j, "asset_id");
+            order.side = str(j, "side");
+            order.outcome = str(j, "outcome");
+            order.price = str(j, "price");
+            order.original_size = str(j, "original_size");
+            order.size_matched = str(j, "size_matched");
+            order.status = str(j, "status");
+            order.owner = str(j, "owner");
+            order.server_timestamp_ms = timestamp_ms(j);
+            auto trades = j.find("associate_trades");
+            if (trades != j.end() && trades->is_array())
+            {
+                for (const auto &t : *trades)
+                {
+                    if (t.is_string())
+                    {
+                        order.associate_trades.push_back(t.get<std::string>());
+                    }
+                }
+            }
+            return order;
+        }
+    } // namespace
+
+    UserStreamManager::UserStreamManager(const Config &config, const ApiCredentials &creds)
+        : config_(config), creds_(creds)
+    {
+        ws_.set_url(config_.user_ws_url);
+        ws_.set_ping_interval_ms(config_.ws_ping_interval_ms);
+        ws_.set_auto_reconnect(true);
+
+        ws_.on_message([this](const std::string &msg)
+                       { handle_message(msg); });
+
+        ws_.on_connect([this]()
+                       {
+            std::cout << "[UserWS] Connected to user channel" << std::endl;
+            send_subscription(); });
+
+        ws_.on_disconnect([this]()
+                          {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                subscribed_ = false;
+            }
+            std::cout << "[UserWS] Disconnected from user channel" << std::endl; });
+
+        ws_.on_error([](const std::string &error)
+                     { std::cerr << "[UserWS] Error: " << error << std::endl; });
+    }
+
+    UserStreamManager::~UserStreamManager()
+    {
+        stop();
+    }
+
+    void UserStreamManager::subscribe(const std::vector<std::string> &condition_ids)
+    {
+        std::vector<std::string> added;
+        bool live;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto &id : condition_ids)
+            {
+                if (std::find(markets_.begin(), markets_.end(), id) == markets_.end())
+                {
+                    markets_.push_back(id);
+                    added.push_back(id);
+                }
+            }
+            live = subscribed_;
+        }
+        if (live && !added.empty())
+        {
+            send_update("subscribe", added);
+        }
+    }
+
+    void UserStreamManager::unsubscribe(const std::vector<std::string> &condition_ids)
+    {
+        std::vector<std::string> removed;
+        bool live;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto &id : condition_ids)
+            {
+                auto it = std::find(markets_.begin(), markets_.end(), id);
+                if (it != markets_.end())
+                {
+                    markets_.erase(it);
+                    removed.push_back(id);
+                }
+            }
+            live = subscribed_;
+        }
+        if (live && !removed.empty())
+        {
+            send_update("unsubscribe", removed);
+        }
+    }
+
+    std::vector<std::string> UserStreamManager::markets() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return markets_;
+    }
+
+    void UserStreamManager::on_trade(UserTradeCallback callback)
+    {
+        on_trade_cb_ = std::move(callback);
+    }
+
+    void UserStreamManager::on_order(UserOrderCallback callback)
+    {
+        on_order_cb_ = std::move(callback);
+    }
+
+    bool UserStreamManager::connect()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = false;
+        }
+        return ws_.connect();
+    }
+
+    void UserStreamManager::disconnect()
+    {
+        ws_.disconnect();
+    }
+
+    bool UserStreamManager::is_connected() const
+    {
+        return ws_.is_connected();
+    }
+
+    bool UserStreamManager::wait_subscribed(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        subscribed_cv_.wait_for(lock, timeout, [this]()
+                                { return subscribed_ || stopping_; });
+        return subscribed_;
+    }
+
+    void UserStreamManager::run()
+    {
+        ws_.run();
+    }
+
+    void UserStreamManager::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        subscribed_cv_.notify_all();
+        ws_.stop();
+    }
+
+    std::string UserStreamManager::subscription_message(const ApiCredentials &creds,
+                                                        const std::vector<std::string> &condition_ids)
+    {
+        json msg;
+        msg["auth"] = {{"apiKey", creds.api_key}, {"secret", creds.api_secret}, {"passphrase", creds.api_passphrase}};
+        msg["markets"] = condition_ids;
+        msg["type"] = "user";
+        return msg.dump();
+    }
+
+    void UserStreamManager::send_subscription()
+    {
+        std::vector<std::string> markets = this->markets();
+        std::cout << "[UserWS] Subscribing to " << (markets.empty() ? std::string("all") : std::to_string(markets.size()))
+                  << " markets" << std::endl;
+        bool sent = ws_.send(subscription_message(creds_, markets));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            subscribed_ = sent;
+        }
+        subscribed_cv_.notify_all();
+    }
+
+    bool UserStreamManager::send_update(const char *operation, const std::vector<std::string> &condition_ids)
+    {
+        json msg;
+        msg["markets"] = condition_ids;
+        msg["operation"] = operation;
+        return ws_.send(msg.dump());
+    }
+
+    bool UserStreamManager::parse_message(std::string_view message, std::vector<UserTrade> &trades,
+                                          std::vector<UserOrderEvent> &orders)
+    {
+        trades.clear();
+        orders.clear();
+        if (message.empty() || message == "PONG" || message == "PING")
+        {
+            return true;
+        }
+
+        json j = json::parse(message, nullptr, false);
+        if (j.is_discarded())
+        {
+            return false;
+        }
+
+        auto handle = [&](const json &event)
+        {
+            if (!event.is_object())
+            {
+                return;
+            }
+            std::string type = str(event, "event_type");
+            if (type == "trade")
+            {
+                trades.push_back(parse_trade(event));
+            }
+            else if (type == "order")
+            {
+                orders.push_back(parse_order(event));
+            }
+        };
+
+        if (j.is_array())
+        {
+            for (const auto &event : j)
+            {
+                handle(event);
+            }
+        }
+        else
+        {
+            handle(j);
+        }
+        return true;
+    }
+
+    void UserStreamManager::handle_message(const std::string &message)
+    {
+        if (!parse_message(message, trades_, orders_))
+        {
+            parse_errors_++;
+            std::cerr << "[UserWS] Parse error: " << message.substr(0, 200) << std::endl;
+            return;
+        }
+
+        uint64_t receive_ns = ws_.receive_ns();
+        for (auto &trade : trades_)
+        {
+            trade.receive_ns = receive_ns;
+            trades_received_++;
+            if (on_trade_cb_)
+            {
+                on_trade_cb_(trade);
+            }
+        }
+        for (auto &order : orders_)
+        {
+            order.receive_ns = receive_ns;
+            orders_received_++;
+            if (on_order_cb_)
+            {
+                on_order_cb_(order);
+            }
+        }
+    }
+
+} // namespace polymarket
@@ -70,7 +70,8 @@ namespace polymarket
             switch (msg->type)
             {
             case ix::WebSocketMessageType::Open:
-                state_.store(WsState::CONNECTED);
+                connect_count_++;
+                set_state(WsState::CONNECTED);
                 if (on_connect_cb_)
                 {
                     on_connect_cb_();
@@ -78,7 +79,7 @@ namespace polymarket
                 break;
 
             case ix::WebSocketMessageType::Close:
-                state_.store(WsState::DISCONNECTED);
+                set_state(WsState::DISCONNECTED);
                 if (on_disconnect_cb_)
                 {
                     on_disconnect_cb_();
@@ -86,7 +87,7 @@ namespace polymarket
                 break;
 
             case ix::WebSocketMessageType::Error:
-                state_.store(WsState::DISCONNECTED);
+                set_state(WsState::DISCONNECTED);
                 if (on_error_cb_)
                 {
                     on_error_cb_(msg->errorInfo.reason);
@@ -94,6 +95,7 @@ namespace polymarket
                 break;
 
             case ix::WebSocketMessageType::Message:
+                receive_ns_ = now_ns();
                 messages_received_++;
                 bytes_received_ += msg->str.size();
                 if (on_message_cb_)
@@ -109,7 +111,11 @@ namespace polymarket
                 break;
             } });
 
-        state_.store(WsState::CONNECTING);
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            should_stop_.store(false);
+        }
+        set_state(WsState::CONNECTING);
         ws_.start();
 
         return true;
@@ -117,9 +123,18 @@ namespace polymarket
 
     void WebSocketClient::disconnect()
     {
-        state_.store(WsState::CLOSING);
+        set_state(WsState::CLOSING);
         ws_.stop();
-        state_.store(WsState::DISCONNECTED);
+        set_state(WsState::DISCONNECTED);
+    }
+
+    void WebSocketClient::set_state(WsState state)
+    {
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            state_.store(state);
+        }
+        state_cv_.notify_all();
     }
 
     bool WebSocketClient::is_connected() const
@@ -132,6 +147,22 @@ namespace polymarket
         return state_.load();
     }
 
+    bool WebSocketClient::wait_connected(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(state_mutex_);
+        state_cv_.wait_for(lock, timeout, [this]()
+                           { return state_.load() == WsState::CONNECTED || should_stop_.load(); });
+        return state_.load() == WsState::CONNECTED;
+    }
+
+    bool WebSocketClient::wait_connect_count(uint64_t count, std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(state_mutex_);
+        return state_cv_.wait_for(lock, timeout, [this, count]()
+                                  { return connect_count_.load() >= count || should_stop_.load(); }) &&
+               connect_count_.load() >= count;
+    }
+
     bool WebSocketClient::send(const std::string &message)
     {
         if (!is_connected())
@@ -145,30 +176,32 @@ namespace polymarket
 
     void WebSocketClient::run()
     {
+        std::unique_lock<std::mutex> lock(state_mutex_);
         running_.store(true);
         should_stop_.store(false);
 
-        // IXWebSocket runs in its own thread, so we just wait here
-        while (!should_stop_.load())
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
+        // IXWebSocket runs in its own thread, so we just wait here until stop()
+        state_cv_.wait(lock, [this]()
+                       { return should_stop_.load(); });
 
         running_.store(false);
+        lock.unlock();
+        state_cv_.notify_all();
     }
 
     void WebSocketClient::stop()
     {
-        should_stop_.store(true);
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            should_stop_.store(true);
+        }
+        state_cv_.notify_all();
         disconnect();
 
         // Wait for run loop to exit
-        int wait_count = 0;
-        while (running_.load() && wait_count < 100)
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            wait_count++;
-        }
+        std::unique_lock<std::mutex> lock(state_mutex_);
+        state_cv_.wait_for(lock, std::chrono::seconds(1), [this]()
+                           { return !running_.load(); });
     }
 
 } // namespace polymarket
@@ -0,0 +1,48 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "async_http_client.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <iostream>
+
+int main()
+{
+    using namespace polymarket;
+
+    http_global_init();
+    {
+        // Nothing listens on port 1: a transport error, not an HTTP status
+        AsyncHttpClient client;
+        client.set_base_url("http://127.0.0.1:1/");
+        client.set_timeout_ms(2000);
+        auto response = client.get("/", {}, HttpPriority::HIGH).get();
+        assert(!response.error.empty() && response.status_code == 0);
+
+        // The two requests complete in either order: wait for each one, not just the last submitted
+        std::atomic<int> callbacks{0};
+        std::promise<void> called;
+        client.submit("POST", "/order", "{}", {{"POLY_API_KEY", "k"}}, HttpPriority::HIGH, [&](HttpResponse r)
+                      {
+            assert(!r.error.empty());
+            callbacks++;
+            called.set_value(); });
+        auto deleted = client.del("/order", "{}");
+        assert(called.get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+        assert(!deleted.get().error.empty());
+        assert(callbacks == 1);
+
+        auto stats = client.get_stats();
+        assert(stats.submitted == 3 && stats.completed == 3 && stats.failed == 3);
+        assert(stats.queued == 0 && stats.in_flight == 0);
+
+        // After stop() requests fail right away
+        client.stop();
+        response = client.get("/").get();
+        assert(response.error == "Client stopped");
+    }
+    http_global_cleanup();
+
+    std::cout << "test_async_http_client passed\n";
+    return 0;
+}
@@ -0,0 +1,96 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "book_parser.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+int main()
+{
+    using namespace polymarket;
+
+    BookFrameParser parser;
+
+    // Real-time data format: payload before topic, unknown fields skipped
+    std::string rtds =
+        R"({"connection_id":"abc","payload":{"asks":[{"price":"0.54","size":"120.5"},{"price":"0.53","size":"10"}],)"
+        R"("asset_id":"1234","bids":[{"price":"0.51","size":"7"}],"hash":"x","market":"0xm","extra":{"a":[1,2,{"b":"]"}]}},)"
+        R"("timestamp":1753314064237,"topic":"clob_market","type":"agg_orderbook"})";
+    assert(parser.parse(rtds));
+    assert(parser.size() == 1);
+    {
+        const auto &ev = parser.event(0);
+        assert(ev.type == WsMessageType::ORDERBOOK_SNAPSHOT);
+        assert(ev.book.asset_id == "1234");
+        assert(ev.book.asks.size() == 2 && ev.book.bids.size() == 1);
+        assert(ev.book.best_ask() == 0.53);
+        assert(ev.book.best_ask_size() == 10.0);
+        assert(ev.book.best_bid() == 0.51);
+        assert(ev.server_timestamp_ms == 1753314064237ULL);
+    }
+
+    // Other real-time topics are ignored
+    assert(parser.parse(R"({"topic":"activity","type":"trades","payload":{"asset_id":"1"}})"));
+    assert(parser.size() == 0);
+
+    // Market channel array of events, numeric values, sorted best-first
+    std::string legacy =
+        R"([{"event_type":"book","asset_id":"A","bids":[{"price":0.40,"size":5},{"price":"0.45","size":"1"}],)"
+        R"("asks":[{"price":"0.60","size":"2"},{"price":"0.55","size":"3"}],"timestamp":"1700000000000"},)"
+        R"({"event_type":"last_trade_price","asset_id":"A","price":"0.5"},)"
+        R"({"event_type":"price_change","asset_id":"B","bids":[],"asks":[{"price":"0.9","size":"1"}]}])";
+    assert(parser.parse(legacy));
+    assert(parser.size() == 2);
+    {
+        const auto &book = parser.event(0).book;
+        assert(book.asset_id == "A");
+        assert(book.bids[0].price == 0.45 && book.bids[1].price == 0.40);
+        assert(book.asks[0].price == 0.55 && book.asks[0].size == 3.0);
+        assert(parser.event(0).server_timestamp_ms == 1700000000000ULL);
+        assert(parser.event(1).type == WsMessageType::ORDERBOOK_UPDATE);
+        assert(parser.event(1).changes.size() == 1);
+        assert(parser.event(1).changes[0].asset_id == "B" && parser.event(1).changes[0].side == BookSide::ASK);
+    }
+
+    // price_change: per-change assets with server top of book, plus the older "changes" list
+    std::string delta =
+        R"({"market":"0xm","price_changes":[{"asset_id":"A","price":"0.5","size":"200","side":"BUY","hash":"h1",)"
+        R"("best_bid":"0.5","best_ask":"0.55"},{"asset_id":"B","price":"0.6","size":"0","side":"SELL","hash":"h2"}],)"
+        R"("timestamp":"1757908892351","event_type":"price_change"})";
+    assert(parser.parse(delta));
+    assert(parser.size() == 1);
+    {
+        const auto &ev = parser.event(0);
+        assert(ev.type == WsMessageType::ORDERBOOK_UPDATE);
+        assert(ev.changes.size() == 2);
+        assert(ev.changes[0].asset_id == "A" && ev.changes[0].side == BookSide::BID);
+        assert(ev.changes[0].price == 0.5 && ev.changes[0].size == 200.0);
+        assert(ev.changes[0].has_top_of_book && ev.changes[0].best_ask == 0.55);
+        assert(ev.changes[1].asset_id == "B" && ev.changes[1].side == BookSide::ASK && ev.changes[1].size == 0.0);
+        assert(!ev.changes[1].has_top_of_book && ev.changes[1].hash == "h2");
+        assert(ev.server_timestamp_ms == 1757908892351ULL);
+    }
+
+    assert(parser.parse(R"({"asset_id":"C","changes":[{"price":"0.4","side":"SELL","size":"3300"}],"event_type":"price_change","hash":"h3"})"));
+    assert(parser.size() == 1);
+    assert(parser.event(0).changes.size() == 1);
+    assert(parser.event(0).changes[0].asset_id == "C" && parser.event(0).changes[0].hash == "h3");
+    assert(parser.event(0).changes[0].side == BookSide::ASK);
+
+    // tick_size_change carries the new tick; events without an asset are ignored
+    assert(parser.parse(R"({"event_type":"tick_size_change","asset_id":"D","market":"0xm","old_tick_size":"0.01",)"
+                        R"("new_tick_size":"0.001","timestamp":"100"})"));
+    assert(parser.size() == 1);
+    assert(parser.event(0).type == WsMessageType::TICK_SIZE_CHANGE && parser.event(0).book.asset_id == "D");
+    assert(parser.event(0).old_tick_size == "0.01" && parser.event(0).new_tick_size == "0.001");
+    assert(parser.parse(R"({"event_type":"tick_size_change","new_tick_size":"0.001"})"));
+    assert(parser.size() == 0);
+
+    // Malformed frames are rejected as a whole
+    assert(!parser.parse(R"({"event_type":"book","asset_id":"A","bids":[{"price":"abc","size":"1"}]})"));
+    assert(parser.size() == 0 && parser.error() != nullptr);
+    assert(!parser.parse(R"({"event_type":"book","asset_id":"A","bids":[)"));
+    assert(!parser.parse("PONG"));
+
+    std::cout << "test_book_parser passed\n";
+    return 0;
+}
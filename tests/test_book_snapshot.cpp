@@ -0,0 +1,73 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "book_snapshot.hpp"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <thread>
+
+int main()
+{
+    using namespace polymarket;
+
+    BookSnapshotSlot slot;
+    BookSnapshot out;
+    assert(!slot.read(out));
+    assert(slot.version() == 0);
+
+    BookSnapshot snap;
+    snap.top = {0.45, 10.0, 0.55, 20.0};
+    snap.bid_count = 1;
+    snap.bids[0] = {0.45, 10.0};
+    snap.ask_count = 2;
+    snap.asks[0] = {0.55, 20.0};
+    snap.asks[1] = {0.56, 5.0};
+    snap.server_ts_ms = 1700000000000ULL;
+    slot.write(snap);
+    assert(slot.version() == 1);
+    assert(slot.read(out));
+    assert(out.top.best_ask == 0.55 && out.ask_count == 2 && out.asks[1].price == 0.56);
+    assert(out.server_ts_ms == 1700000000000ULL);
+
+    // Readers never observe a half-written snapshot: every field of a write carries the same counter
+    std::atomic<bool> done{false};
+    std::thread writer([&]()
+                       {
+        BookSnapshot s;
+        for (uint64_t n = 1; n <= 200000; n++)
+        {
+            double v = static_cast<double>(n);
+            s.top = {v, v, v, v};
+            s.bid_count = s.ask_count = static_cast<uint32_t>(kSnapshotDepth);
+            for (size_t i = 0; i < kSnapshotDepth; i++)
+            {
+                s.bids[i] = {v, v};
+                s.asks[i] = {v, v};
+            }
+            s.timestamp_ns = n;
+            slot.write(s);
+        }
+        done = true; });
+
+    uint64_t reads = 0;
+    uint64_t last = 0;
+    while (!done.load())
+    {
+        BookSnapshot s;
+        assert(slot.read(s));
+        if (s.timestamp_ns == 0)
+        {
+            continue; // Writer has not started yet
+        }
+        double v = static_cast<double>(s.timestamp_ns);
+        assert(s.timestamp_ns >= last);
+        assert(s.top.best_bid == v && s.top.best_ask_size == v);
+        assert(s.bids[kSnapshotDepth - 1].size == v && s.asks[kSnapshotDepth - 1].price == v);
+        last = s.timestamp_ns;
+        reads++;
+    }
+    writer.join();
+    assert(slot.read(out) && out.timestamp_ns == 200000);
+
+    std::cout << "test_book_snapshot passed (" << reads << " concurrent reads)\n";
+    return 0;
+}
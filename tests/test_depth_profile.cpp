@@ -0,0 +1,83 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "depth_profile.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace polymarket;
+
+namespace
+{
+    bool near(double a, double b)
+    {
+        return std::fabs(a - b) < 1e-9;
+    }
+
+    DepthProfile profile(const std::vector<PriceLevel> &levels)
+    {
+        DepthProfile p;
+        p.build(levels);
+        return p;
+    }
+} // namespace
+
+int main()
+{
+    DepthProfile yes = profile({{0.40, 100}, {0.42, 50}, {0.45, 200}});
+    DepthProfile no = profile({{0.50, 80}, {0.55, 100}});
+
+    // Prefix sums and multi-level VWAP
+    {
+        assert(yes.count == 3 && near(yes.total_size(), 350));
+        assert(yes.level_for(100) == 0 && yes.level_for(100.5) == 1 && yes.level_for(1000) == 3);
+        assert(near(yes.cost(120), 100 * 0.40 + 20 * 0.42));
+        assert(near(yes.vwap(120), (100 * 0.40 + 20 * 0.42) / 120));
+        assert(near(yes.vwap(1000), (40 + 21 + 90) / 350.0)); // Capped at the known depth
+        assert(yes.limit_price(120) == 0.42 && yes.limit_price(1000) == 0.45);
+
+        std::vector<PriceLevel> deep;
+        for (int i = 0; i < 40; i++)
+        {
+            deep.push_back({0.30 + i * 0.01, 10});
+        }
+        assert(profile(deep).count == kDepthLevels && near(profile(deep).total_size(), 10.0 * kDepthLevels));
+    }
+
+    // Walks both legs while the marginal pair is below the trigger: 0.90, 0.95, 0.97 pass, 1.00 doesn't
+    {
+        ArbSizing s = size_pair_arb(yes, no, 0.98);
+        assert(near(s.size, 150));
+        assert(near(s.vwap_yes, (40 + 50 * 0.42) / 150) && near(s.vwap_no, (40 + 70 * 0.55) / 150));
+        assert(s.limit_yes == 0.42 && s.limit_no == 0.55);
+        assert(near(s.cost, 61 + 78.5) && near(s.edge, 150 - 139.5));
+    }
+
+    // The trigger caps the size at the last pair below it
+    {
+        ArbSizing s = size_pair_arb(yes, no, 0.955);
+        assert(near(s.size, 100) && s.limit_yes == 0.40 && s.limit_no == 0.55);
+        assert(near(s.vwap_yes, 0.40) && near(s.vwap_no, (40 + 20 * 0.55) / 100));
+
+        ArbSizing none = size_pair_arb(yes, no, 0.90); // Best pair not strictly below
+        assert(none.size == 0 && none.cost == 0 && none.limit_yes == 0 && none.limit_no == 0);
+    }
+
+    // Depth runs out on one leg before the trigger does
+    {
+        ArbSizing s = size_pair_arb(yes, no, 2.0);
+        assert(near(s.size, 180) && s.limit_no == 0.55 && s.limit_yes == 0.45);
+    }
+
+    // An empty side sizes nothing
+    {
+        DepthProfile empty = profile({});
+        assert(empty.total_size() == 0 && empty.limit_price(10) == 0 && empty.cost(10) == 0);
+        ArbSizing s = size_pair_arb(yes, empty, 0.99);
+        assert(s.size == 0 && s.edge == 0 && s.vwap_yes == 0);
+        assert(size_pair_arb(empty, no, 0.99).size == 0);
+    }
+
+    std::cout << "test_depth_profile passed\n";
+    return 0;
+}
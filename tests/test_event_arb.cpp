@@ -0,0 +1,103 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "event_arb.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+    bool near(double a, double b)
+    {
+        return std::fabs(a - b) < 1e-9;
+    }
+
+    polymarket::Orderbook book(std::vector<polymarket::PriceLevel> bids, std::vector<polymarket::PriceLevel> asks)
+    {
+        polymarket::Orderbook b;
+        b.bids = std::move(bids);
+        b.asks = std::move(asks);
+        return b;
+    }
+}
+
+int main()
+{
+    using namespace polymarket;
+
+    EventArbScanner scanner(0.98, 1.02);
+    size_t event = scanner.add_event("E", {0, 1, 2});
+    assert(scanner.event_count() == 1);
+
+    int fired = 0;
+    double last_size = 0, last_notional = 0, last_edge = 0, last_limit0 = 0;
+    bool last_buy = false;
+    scanner.on_opportunity([&](const EventArbOpportunity &opp)
+                           {
+        fired++;
+        last_buy = opp.buy;
+        last_size = opp.size;
+        last_notional = opp.notional;
+        last_edge = opp.edge;
+        assert(opp.legs.size() == 3 && opp.event_id == "E");
+        last_limit0 = opp.legs[0].limit_price; });
+
+    // No sum until every leg quotes
+    scanner.update(0, book({{0.30, 10}}, {{0.31, 100}, {0.33, 50}}));
+    scanner.update(1, book({{0.30, 10}}, {{0.32, 40}, {0.34, 100}}));
+    assert(scanner.sum_asks(event) == 0.0 && fired == 0);
+
+    // 0.31 + 0.32 + 0.30 = 0.93 < 0.98: walk depth
+    scanner.update(2, book({{0.29, 10}}, {{0.30, 60}, {0.35, 100}}));
+    assert(near(scanner.sum_asks(event), 0.93) && near(scanner.sum_bids(event), 0.89));
+    assert(fired == 1 && last_buy);
+    // 40 @ 0.93, leg 1 -> 0.34: 20 @ 0.95, leg 2 -> 0.35: 40 @ 1.00 stops (100 total for leg 0 at 0.31)
+    assert(near(last_size, 60.0));
+    assert(near(last_notional, 40 * 0.93 + 20 * 0.95));
+    assert(near(last_edge, 60.0 - (40 * 0.93 + 20 * 0.95)));
+    assert(near(last_limit0, 0.31));
+
+    // Leg update moves the sum by the difference only
+    scanner.update(0, book({{0.30, 10}}, {{0.40, 100}}));
+    assert(near(scanner.sum_asks(event), 1.02) && fired == 1);
+
+    // Depth limited by known levels: a single-level leg caps the basket
+    scanner.update(0, book({{0.30, 10}}, {{0.31, 5}}));
+    assert(fired == 2 && near(last_size, 5.0));
+
+    // Empty side drops out of the sum
+    scanner.update(0, book({{0.30, 10}}, {}));
+    assert(scanner.sum_asks(event) == 0.0 && fired == 2);
+
+    // Sell basket: bids sum above 1.02
+    scanner.update(0, book({{0.40, 10}, {0.30, 10}}, {{0.41, 10}}));
+    scanner.update(1, book({{0.35, 20}}, {{0.36, 10}}));
+    scanner.update(2, book({{0.30, 15}}, {{0.31, 10}}));
+    // 1.05 for 10, then leg 0 -> 0.30: 0.95 stops
+    assert(!last_buy && near(last_size, 10.0) && near(last_notional, 10.5) && near(last_edge, 0.5));
+
+    // Tokens outside any event are ignored
+    int before = fired;
+    scanner.update(7, book({{0.99, 1}}, {{0.01, 1}}));
+    assert(fired == before);
+
+    // Partial baskets are rejected whole: missing leg, leg taken by another event, leg listed twice, no legs
+    size_t events_before = scanner.event_count();
+    assert(scanner.add_event("missing", {3, kInvalidToken, 4}) == EventArbScanner::kRejectedEvent);
+    assert(scanner.add_event("taken", {5, 2}) == EventArbScanner::kRejectedEvent);
+    assert(scanner.add_event("twice", {6, 6}) == EventArbScanner::kRejectedEvent);
+    assert(scanner.add_event("empty", {}) == EventArbScanner::kRejectedEvent);
+    assert(scanner.event_count() == events_before);
+
+    // None of their tokens was claimed, so they still register as a full event
+    size_t second = scanner.add_event("F", {3, 4, 5});
+    assert(second == 1 && scanner.event_count() == 2);
+    before = fired;
+    scanner.update(3, book({}, {{0.40, 10}}));
+    scanner.update(4, book({}, {{0.40, 10}}));
+    assert(scanner.sum_asks(second) == 0.0);
+    scanner.update(5, book({}, {{0.40, 10}}));
+    assert(near(scanner.sum_asks(second), 1.20) && fired == before);
+
+    std::cout << "test_event_arb passed\n";
+    return 0;
+}
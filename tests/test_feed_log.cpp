@@ -0,0 +1,234 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "feed_log.hpp"
+#include "orderbook.hpp"
+#include <cassert>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace polymarket;
+
+namespace
+{
+    std::string snapshot_frame(const std::string &token, const std::string &ask, const std::string &bid, int ts)
+    {
+        return R"({"event_type":"book","asset_id":")" + token + R"(","bids":[{"price":")" + bid +
+               R"(","size":"100"}],"asks":[{"price":")" + ask + R"(","size":"100"}],"timestamp":")" +
+               std::to_string(1700000000000 + ts) + "\"}";
+    }
+
+    std::string delta_frame(const std::string &token, const std::string &price, const std::string &size, int ts)
+    {
+        return R"({"event_type":"price_change","price_changes":[{"asset_id":")" + token + R"(","price":")" + price +
+               R"(","size":")" + size + R"(","side":"SELL"}],"timestamp":")" + std::to_string(1700000000000 + ts) + "\"}";
+    }
+} // namespace
+
+int main()
+{
+    std::string path = "/tmp/test_feed_log_" + std::to_string(::getpid()) + ".bin";
+
+    // Record: a tiny chunk size forces several remaps
+    std::vector<std::string> frames = {
+        snapshot_frame("101", "0.55", "0.50", 1),
+        snapshot_frame("102", "0.44", "0.40", 2),
+        delta_frame("101", "0.53", "50", 3),
+        delta_frame("101", "0.53", "0", 4),
+        "{}",
+        "x", // Odd lengths exercise the padding
+    };
+    {
+        FeedRecorder recorder(path, 64);
+        uint64_t ns = 1000;
+        for (size_t i = 0; i < frames.size(); i++)
+        {
+            recorder.append(i % 2, ns, frames[i]);
+            ns += 1000000; // 1ms apart
+        }
+        recorder.append(0, ns, ""); // Ignored
+        assert(recorder.frames() == frames.size());
+        recorder.flush();
+    }
+
+    // Read back in order, byte for byte
+    {
+        FeedReader reader(path);
+        FeedFrame frame;
+        for (size_t i = 0; i < frames.size(); i++)
+        {
+            assert(reader.next(frame));
+            assert(frame.data == frames[i]);
+            assert(frame.shard == i % 2);
+            assert(frame.receive_ns == 1000 + i * 1000000);
+        }
+        assert(!reader.next(frame));
+        reader.rewind();
+        assert(reader.next(frame) && frame.data == frames[0]);
+    }
+
+    // Replay into a manager: same books as the live path would build
+    {
+        Config config;
+        config.ws_shards = 2;
+        OrderbookManager mgr(config);
+        MarketState market;
+        market.condition_id = "0xcond";
+        market.token_yes = "101";
+        market.token_no = "102";
+        mgr.subscribe(market);
+
+        size_t arbs = 0;
+        mgr.on_arb_opportunity([&](const LiveMarketState &, double)
+                               { arbs++; });
+
+        FeedReader reader(path);
+        ReplayStats stats = mgr.replay(reader);
+        assert(stats.frames == frames.size());
+        assert(stats.frames_per_sec > 0);
+
+        auto yes = mgr.get_top_of_book("101");
+        assert(yes && yes->best_ask == 0.55 && yes->best_bid == 0.50);
+        assert(mgr.get_top_of_book("102")->best_ask == 0.44);
+        assert(arbs > 0); // 0.53 + 0.44 below the trigger while the delta was live
+
+        auto shards = mgr.shard_stats();
+        assert(shards[0].parse_errors + shards[1].parse_errors == 1); // The "x" frame
+
+        // Server-stamped stages compare Unix times, whatever epoch the internal clock has
+        auto latency = mgr.get_latency_stats();
+        uint64_t since_stamp_ns = wall_ns() - 1700000000000ULL * 1000000;
+        assert(latency.end_to_end.count > 0 && latency.end_to_end.min_ns > since_stamp_ns / 2);
+        assert(latency.network.min_ns > since_stamp_ns / 2 && latency.network.max_ns <= latency.end_to_end.max_ns);
+
+        // Replaying again is deterministic
+        uint64_t updates = mgr.total_updates();
+        reader.rewind();
+        mgr.replay(reader);
+        assert(mgr.total_updates() == 2 * updates);
+        assert(mgr.get_top_of_book("101")->best_ask == 0.55);
+
+        // Realtime replay keeps the recorded gaps (5ms first to last)
+        reader.rewind();
+        auto start = std::chrono::steady_clock::now();
+        mgr.replay(reader, true);
+        assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(5));
+    }
+
+    // Callbacks on deltas see the stored book, also after a snapshot from outside the feed replaced it
+    {
+        Config config;
+        OrderbookManager mgr(config);
+        MarketState market;
+        market.condition_id = "0xcond";
+        market.token_yes = "101";
+        market.token_no = "102";
+        mgr.subscribe(market);
+
+        std::vector<PriceLevel> seen_asks;
+        mgr.on_orderbook_update([&](const std::string &asset_id, const Orderbook &book)
+                                {
+                                    if (asset_id == "101")
+                                    {
+                                        seen_asks = book.asks;
+                                    }
+                                });
+        auto replay_frames = [&](const std::vector<std::string> &batch)
+        {
+            {
+                FeedRecorder recorder(path);
+                for (const auto &frame : batch)
+                {
+                    recorder.append(0, 1000, frame);
+                }
+            }
+            FeedReader reader(path);
+            mgr.replay(reader);
+        };
+        auto matches_stored = [&]()
+        {
+            auto stored = mgr.get_orderbook("101");
+            if (!stored || stored->asks.size() != seen_asks.size())
+            {
+                return false;
+            }
+            for (size_t i = 0; i < seen_asks.size(); i++)
+            {
+                if (stored->asks[i].price != seen_asks[i].price || stored->asks[i].size != seen_asks[i].size)
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        replay_frames({snapshot_frame("101", "0.55", "0.50", 1), delta_frame("101", "0.53", "50", 2),
+                       delta_frame("101", "0.54", "20", 3)});
+        assert(seen_asks.size() == 3 && seen_asks[0].price == 0.53 && matches_stored());
+
+        Orderbook rest;
+        rest.asset_id = "101";
+        rest.bids = {{0.40, 10.0}};
+        rest.asks = {{0.70, 10.0}, {0.65, 30.0}};
+        mgr.apply_snapshot(rest, "", 1700000000010);
+        replay_frames({delta_frame("101", "0.65", "0", 11), delta_frame("101", "0.66", "5", 12)});
+        assert(seen_asks.size() == 2 && seen_asks[0].price == 0.66 && seen_asks[1].price == 0.70 && matches_stored());
+    }
+
+    // Reject files that aren't feed logs
+    {
+        std::FILE *f = std::fopen(path.c_str(), "wb");
+        std::fputs("not a feed log at all", f);
+        std::fclose(f);
+        bool threw = false;
+        try
+        {
+            FeedReader reader(path);
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Out of file space (a file size limit stands in for a full disk): recording stops, the process keeps going
+    {
+        std::signal(SIGXFSZ, SIG_IGN);
+        rlimit saved{};
+        ::getrlimit(RLIMIT_FSIZE, &saved);
+        rlimit small = saved;
+        small.rlim_cur = 16384;
+        ::setrlimit(RLIMIT_FSIZE, &small);
+        {
+            FeedRecorder recorder(path, 4096);
+            std::string frame(1000, 'x');
+            for (int i = 0; i < 40; i++)
+            {
+                recorder.append(0, i, frame);
+            }
+            assert(recorder.failed() && recorder.frames() > 0 && recorder.frames() < 40);
+            assert(recorder.dropped() == 40 - recorder.frames() && recorder.bytes() <= 16384);
+        }
+        ::setrlimit(RLIMIT_FSIZE, &saved);
+
+        FeedReader reader(path);
+        FeedFrame frame;
+        uint64_t read = 0;
+        while (reader.next(frame))
+        {
+            assert(frame.data.size() == 1000);
+            read++;
+        }
+        assert(read > 0 && read < 40);
+    }
+
+    std::remove(path.c_str());
+    std::cout << "test_feed_log passed" << std::endl;
+    return 0;
+}
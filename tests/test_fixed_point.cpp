@@ -0,0 +1,67 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "fixed_point.hpp"
+#include "order_signer.hpp"
+#include <cassert>
+#include <iostream>
+
+int main()
+{
+    using namespace polymarket;
+
+    // Parsing and formatting
+    assert(Fixed6::parse("0.55")->raw() == 550000);
+    assert(Fixed6::parse("12")->raw() == 12000000);
+    assert(Fixed6::parse("-0.000001")->raw() == -1);
+    assert(Fixed6::parse(".5")->raw() == 500000);
+    assert(Fixed6::parse("0.0000005")->raw() == 1); // Half a micro rounds away from zero
+    assert(Fixed6::parse("0.0000005", Rounding::DOWN)->raw() == 0);
+    assert(Fixed6::parse("-0.0000001", Rounding::DOWN)->raw() == -1);
+    assert(!Fixed6::parse("") && !Fixed6::parse("-") && !Fixed6::parse("1.2.3") && !Fixed6::parse("1e-2"));
+    assert(!Fixed6::parse("99999999999999999999"));
+    assert(Fixed6::parse("0.010")->to_string() == "0.01");
+    assert(Fixed6::from_raw(3000000).to_string() == "3");
+    assert(Fixed6::from_raw(-1).to_string() == "-0.000001");
+    assert(Fixed6::from_raw(0).to_string() == "0");
+    assert(Fixed6::parse("0.001")->decimals() == 3 && Fixed6::parse("7")->decimals() == 0);
+
+    // Doubles: binary noise next to a micro is not a fraction of one
+    assert(Fixed6::from_double(1.23, Rounding::DOWN).raw() == 1230000);
+    assert(Fixed6::from_double(0.1 + 0.2, Rounding::DOWN).raw() == 300000);
+    assert(Fixed6::from_double(3.0299999999999998, Rounding::DOWN).raw() == 3030000);
+    assert(Fixed6::from_double(0.0000015, Rounding::DOWN).raw() == 1);
+    assert(Fixed6::from_double(0.0000015, Rounding::UP).raw() == 2);
+
+    // Rounding to fewer decimals
+    Fixed6 x = *Fixed6::parse("2.345");
+    assert(x.round(2, Rounding::DOWN).raw() == 2340000);
+    assert(x.round(2, Rounding::UP).raw() == 2350000);
+    assert(x.round(2, Rounding::NEAREST).raw() == 2350000);
+    assert(Fixed6::parse("-2.345")->round(2, Rounding::DOWN).raw() == -2350000);
+    assert(x.round(0, Rounding::NEAREST).raw() == 2000000 && x.round(6, Rounding::DOWN) == x);
+
+    // Products and quotients round once, from the exact value
+    Fixed6 shares = *Fixed6::parse("21.73");
+    Fixed6 price = *Fixed6::parse("0.46");
+    assert(Fixed6::mul(shares, price).raw() == 9995800);
+    assert(Fixed6::mul(shares, price, Rounding::NEAREST, 2).raw() == 10000000);
+    assert(Fixed6::mul(*Fixed6::parse("0.125"), *Fixed6::parse("0.1"), Rounding::NEAREST, 2).raw() == 10000);
+    assert(Fixed6::div(*Fixed6::parse("1"), *Fixed6::parse("3")).raw() == 333333);
+    assert(Fixed6::div(*Fixed6::parse("1"), *Fixed6::parse("3"), Rounding::UP).raw() == 333334);
+    assert(Fixed6::div(*Fixed6::parse("-1"), *Fixed6::parse("3")).raw() == -333334);
+    assert(Fixed6::ratio(7, -2, Rounding::NEAREST).raw() == -4);
+
+    // Large notionals keep every digit
+    Fixed6 big = Fixed6::from_raw(9000000000000000000);
+    assert(Fixed6::mul(big, *Fixed6::parse("0.5")).raw() == 4500000000000000000);
+    assert((big - big + Fixed6::from_raw(5)).raw() == 5 && Fixed6::from_raw(1) < Fixed6::from_raw(2));
+
+    // to_wei at 6 decimals goes through Fixed6
+    assert(to_wei(1.23, 6) == "1230000");
+    assert(to_wei(0.9999999, 6) == "999999");
+    assert(to_wei(0.9999999, 6, false) == "1000000");
+    assert(to_wei(21.73 * 0.46, 6) == "9995800");
+    assert(to_wei(0.0, 6) == "0");
+
+    std::cout << "test_fixed_point passed\n";
+    return 0;
+}
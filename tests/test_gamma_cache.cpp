@@ -0,0 +1,145 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "gamma_cache.hpp"
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace polymarket;
+
+namespace
+{
+    // Fake Gamma: records every request and holds its callback until answer() is called
+    struct FakeGamma
+    {
+        std::vector<std::string> paths;
+        std::vector<HttpCallback> held;
+        bool immediate = false; // Answer from inside submit, like a stopped client
+        long status = 200;
+
+        GammaCache::Submit submit()
+        {
+            return [this](const std::string &path, HttpCallback callback)
+            {
+                paths.push_back(path);
+                if (immediate)
+                {
+                    callback(response(path));
+                }
+                else
+                {
+                    held.push_back(std::move(callback));
+                }
+            };
+        }
+
+        // "listed" slugs have a market, anything else is an empty /events array
+        HttpResponse response(const std::string &path) const
+        {
+            if (status != 200)
+            {
+                return HttpResponse{status, "", "unavailable", 1.0};
+            }
+            return HttpResponse{200, path.find("listed") != std::string::npos ? path : "[]", "", 1.0};
+        }
+
+        void answer()
+        {
+            auto callbacks = std::move(held);
+            held.clear();
+            for (size_t i = 0; i < callbacks.size(); i++)
+            {
+                callbacks[i](response(paths[paths.size() - callbacks.size() + i]));
+            }
+        }
+    };
+
+    std::optional<MarketState> parse(const std::string &body, const std::string &ticker)
+    {
+        if (body == "[]")
+        {
+            return std::nullopt;
+        }
+        MarketState market;
+        market.slug = body.substr(body.find('=') + 1);
+        market.symbol = ticker;
+        return market;
+    }
+} // namespace
+
+int main()
+{
+    constexpr int kHitTtl = 3600;
+    constexpr int kMissTtl = 30;
+    constexpr uint64_t kNow = 1700000000;
+
+    // Lookups in flight are shared, not requested twice; results keep query order and skip unlisted slugs
+    {
+        FakeGamma gamma;
+        GammaCache cache(gamma.submit(), parse, kHitTtl, kMissTtl);
+        GammaCache::Query query = {{"btc-listed-1", "btc"}, {"eth-missing-1", "eth"}, {"sol-listed-1", "sol"}};
+
+        assert(cache.lookup(query, false, kNow).empty()); // Prefetch: starts the requests only
+        assert(gamma.paths.size() == 3 && gamma.paths[0] == "/events?slug=btc-listed-1");
+        assert(cache.size() == 3);
+
+        auto waiting = std::async(std::launch::async, [&]()
+                                  { return cache.lookup(query, true, kNow + 1); });
+        // The second lookup waits on the first one's requests instead of sending its own
+        assert(waiting.wait_for(std::chrono::milliseconds(50)) == std::future_status::timeout);
+        assert(gamma.paths.size() == 3);
+
+        cache.clear(); // In-flight entries survive a clear
+        assert(cache.size() == 3);
+
+        gamma.answer();
+        auto markets = waiting.get();
+        assert(markets.size() == 2);
+        assert(markets[0].slug == "btc-listed-1" && markets[0].symbol == "btc");
+        assert(markets[1].slug == "sol-listed-1" && markets[1].symbol == "sol");
+
+        // Served from the cache, misses included
+        assert(cache.lookup(query, true, kNow + 10).size() == 2);
+        assert(gamma.paths.size() == 3);
+
+        // Misses expire after kMissTtl and are asked again; hits stay until kHitTtl
+        gamma.immediate = true;
+        assert(cache.lookup(query, true, kNow + kMissTtl).size() == 2);
+        assert(gamma.paths.size() == 4 && gamma.paths[3] == "/events?slug=eth-missing-1");
+        assert(cache.lookup(query, true, kNow + kHitTtl - 1).size() == 2);
+        assert(gamma.paths.size() == 5 && gamma.paths[4] == "/events?slug=eth-missing-1");
+        assert(cache.lookup(query, true, kNow + kHitTtl).size() == 2);
+        assert(gamma.paths.size() == 7 && gamma.paths[5] == "/events?slug=btc-listed-1" &&
+               gamma.paths[6] == "/events?slug=sol-listed-1");
+
+        // Expired entries are dropped even when not asked for again
+        cache.lookup({}, true, kNow + 10 * kHitTtl);
+        assert(cache.size() == 0);
+    }
+
+    // Transport and HTTP errors are not cached; clear() drops finished entries
+    {
+        FakeGamma gamma;
+        gamma.immediate = true;
+        GammaCache cache(gamma.submit(), parse, kHitTtl, kMissTtl);
+        GammaCache::Query query = {{"btc-listed-2", "btc"}};
+
+        gamma.status = 503;
+        assert(cache.lookup(query, true, kNow).empty());
+        assert(cache.size() == 0);
+        assert(cache.lookup(query, true, kNow).empty());
+        assert(gamma.paths.size() == 2);
+
+        gamma.status = 200;
+        assert(cache.lookup(query, true, kNow).size() == 1);
+        assert(cache.lookup(query, true, kNow).size() == 1 && gamma.paths.size() == 3);
+        cache.clear();
+        assert(cache.size() == 0);
+        assert(cache.lookup(query, true, kNow).size() == 1 && gamma.paths.size() == 4);
+    }
+
+    std::cout << "test_gamma_cache passed\n";
+    return 0;
+}
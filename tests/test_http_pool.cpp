@@ -0,0 +1,77 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "http_pool.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+int main()
+{
+    using namespace polymarket;
+
+    http_global_init();
+    {
+        HttpPool pool;
+
+        // One persistent client per base URL
+        HttpClient &a = pool.client("http://127.0.0.1:1");
+        HttpClient &b = pool.client("http://127.0.0.1:1");
+        HttpClient &c = pool.client("http://127.0.0.1:2");
+        assert(&a == &b && &a != &c);
+
+        // Attached hosts come first and are listed once, even when a client() client shares the URL
+        HttpClient own;
+        own.set_base_url("http://127.0.0.1:1");
+        pool.attach(own, "http://127.0.0.1:1");
+        pool.attach(own, "http://127.0.0.1:1");
+
+        // Async clients go on the same share
+        AsyncHttpClient async;
+        async.set_base_url("http://127.0.0.1:3");
+        pool.attach(async, "http://127.0.0.1:3");
+        auto hosts = pool.hosts();
+        assert(hosts.size() == 3);
+        assert(hosts[0] == "http://127.0.0.1:1" && hosts[1] == "http://127.0.0.1:3");
+        assert(std::find(hosts.begin(), hosts.end(), "http://127.0.0.1:2") != hosts.end());
+
+        // Nothing listens on ports 1, 2 and 3
+        own.set_timeout_ms(2000);
+        assert(!own.get("/").ok());
+        async.set_timeout_ms(2000);
+        auto failed = async.get("/").get();
+        assert(failed.status_code == 0 && !failed.error.empty());
+
+        // Warming goes through the attached clients themselves, not a pool-owned copy of the host
+        uint64_t submitted = async.get_stats().submitted;
+        assert(pool.warm_all() == 0);
+        assert(async.get_stats().submitted == submitted + 1);
+        assert(pool.hosts().size() == 3);
+
+        pool.start_heartbeat(1);
+        assert(pool.is_heartbeat_running());
+        pool.start_heartbeat(1); // Already running
+        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+        pool.stop_heartbeat();
+        assert(!pool.is_heartbeat_running());
+        assert(async.get_stats().submitted >= submitted + 2);
+
+        // A detached client is no longer warmed, and its host goes with its last client
+        pool.detach(async);
+        submitted = async.get_stats().submitted;
+        pool.warm_all();
+        assert(async.get_stats().submitted == submitted);
+        hosts = pool.hosts();
+        assert(hosts.size() == 2 && std::find(hosts.begin(), hosts.end(), "http://127.0.0.1:3") == hosts.end());
+
+        // shutdown() drops client() clients; attached hosts stay until detached
+        pool.shutdown();
+        assert(pool.hosts().size() == 1 && pool.hosts()[0] == "http://127.0.0.1:1");
+        pool.detach(own);
+        assert(pool.hosts().empty());
+    }
+    http_global_cleanup();
+
+    std::cout << "test_http_pool passed\n";
+    return 0;
+}
@@ -0,0 +1,63 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "latency_histogram.hpp"
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main()
+{
+    using namespace polymarket;
+
+    // Buckets are contiguous and every value lands in a bucket whose upper bound is within ~3%
+    const uint64_t values[] = {0, 1, 63, 64, 65, 127, 128, 1000, 123456789, UINT64_MAX};
+    for (uint64_t v : values)
+    {
+        size_t bucket = LatencyHistogram::bucket_for(v);
+        assert(bucket < LatencyHistogram::kBuckets);
+        uint64_t upper = LatencyHistogram::bucket_upper(bucket);
+        assert(upper >= v && upper - v <= v / 32);
+        assert(bucket == 0 || LatencyHistogram::bucket_upper(bucket - 1) < v);
+    }
+    assert(LatencyHistogram::bucket_for(UINT64_MAX) == LatencyHistogram::kBuckets - 1);
+
+    LatencyHistogram h;
+    assert(h.percentile(0.5) == 0 && h.summary().count == 0);
+
+    // 1..1000 us
+    for (uint64_t i = 1; i <= 1000; i++)
+    {
+        h.record(i * 1000);
+    }
+    LatencySummary s = h.summary();
+    assert(s.count == 1000 && s.min_ns == 1000 && s.max_ns == 1000000);
+    assert(s.mean_ns == 500500.0);
+    assert(s.p50_ns >= 500000 && s.p50_ns <= 500000 * 33 / 32);
+    assert(s.p99_ns >= 990000 && s.p99_ns <= 990000 * 33 / 32);
+    assert(s.p999_ns >= 999000 && s.p999_ns <= 1000000);
+    assert(h.percentile(1.0) == 1000000 && h.percentile(0.0) <= 1000 * 33 / 32);
+
+    h.reset();
+    assert(h.count() == 0 && h.percentile(0.99) == 0);
+
+    // Concurrent writers lose nothing
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&h, t]()
+                             {
+            for (uint64_t i = 0; i < 10000; i++)
+            {
+                h.record(t * 10000 + i);
+            } });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    s = h.summary();
+    assert(s.count == 40000 && s.min_ns == 0 && s.max_ns == 39999);
+
+    std::cout << "test_latency_histogram passed\n";
+    return 0;
+}
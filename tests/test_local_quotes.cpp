@@ -0,0 +1,84 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "clob_client.hpp"
+#include "orderbook.hpp"
+#include <cassert>
+#include <chrono>
+#include <iostream>
+
+using namespace polymarket;
+
+namespace
+{
+    Orderbook book(const std::string &token, double bid, double ask, uint64_t timestamp_ns)
+    {
+        Orderbook b;
+        b.asset_id = token;
+        b.bids = {{bid, 100.0}, {bid - 0.01, 50.0}};
+        b.asks = {{ask, 80.0}, {ask + 0.01, 40.0}};
+        b.timestamp_ns = timestamp_ns;
+        return b;
+    }
+
+    bool near(double a, double b)
+    {
+        return a > b - 1e-9 && a < b + 1e-9;
+    }
+} // namespace
+
+int main()
+{
+    http_global_init();
+    {
+        Config config;
+        OrderbookManager mgr(config);
+        MarketState market;
+        market.condition_id = "0xcond";
+        market.token_yes = "101";
+        market.token_no = "102";
+        mgr.subscribe(market);
+        mgr.apply_snapshot(book("101", 0.45, 0.48, now_ns()));
+        mgr.apply_snapshot(book("102", 0.50, 0.54, now_ns() - 60ull * 1000000000ull)); // A minute old
+
+        // Nothing listens here: every REST fallback fails, so an answer can only have come from the book
+        ClobClient client("http://127.0.0.1:1", 137);
+        client.set_timeout_ms(2000);
+        assert(!client.get_midpoint("101"));
+
+        client.attach_orderbook(&mgr, std::chrono::seconds(5));
+        auto mid = client.get_midpoint("101");
+        assert(mid && mid->source == QuoteSource::LOCAL_BOOK && near(mid->mid, 0.465) && mid->age_ns < 5000000000ull);
+        auto spread = client.get_spread("101");
+        assert(spread && near(spread->spread, 0.03) && spread->source == QuoteSource::LOCAL_BOOK);
+        auto buy = client.get_price("101", "buy");
+        auto sell = client.get_price("101", "SELL");
+        assert(buy && buy->price == 0.45 && sell && sell->price == 0.48);
+
+        // Stale and unknown tokens go to REST (and fail here); batches keep request order for the local answers
+        assert(!client.get_midpoint("102") && !client.get_price("999"));
+        auto mids = client.get_midpoints({"999", "101", "102"});
+        assert(mids.size() == 1 && mids[0].token_id == "101" && mids[0].source == QuoteSource::LOCAL_BOOK);
+        auto age = client.get_spreads({"101"})[0].age_ns;
+        assert(age > 0);
+
+        // A longer max age accepts the old book and reports how old it is
+        client.attach_orderbook(&mgr, std::chrono::minutes(5));
+        auto prices = client.get_prices({"102", "101"}, "sell");
+        assert(prices.size() == 2 && prices[0].token_id == "102" && prices[0].price == 0.54);
+        assert(prices[0].age_ns >= 60ull * 1000000000ull && prices[1].age_ns < prices[0].age_ns);
+
+        // One-sided and unsubscribed books are not answered locally
+        Orderbook no_asks = book("101", 0.45, 0.48, now_ns());
+        no_asks.asks.clear();
+        mgr.apply_snapshot(no_asks);
+        assert(!client.get_spread("101"));
+        mgr.unsubscribe("102");
+        assert(!client.get_price("102", "sell"));
+
+        client.attach_orderbook(nullptr);
+        assert(client.get_midpoints({"101"}).empty());
+    }
+    http_global_cleanup();
+
+    std::cout << "test_local_quotes passed\n";
+    return 0;
+}
@@ -0,0 +1,189 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "market_pager.hpp"
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace polymarket;
+
+namespace
+{
+    std::string market(const std::string &id, bool active, bool closed, bool neg_risk, const std::string &tag)
+    {
+        return "{\"enable_order_book\": true, \"active\": " + std::string(active ? "true" : "false") +
+               ", \"closed\": " + (closed ? "true" : "false") + ", \"condition_id\": \"" + id +
+               "\", \"question\": \"Will " + id + " happen?\", \"market_slug\": \"" + id + "-slug\"" +
+               ", \"minimum_tick_size\": 0.01, \"neg_risk\": " + (neg_risk ? "true" : "false") +
+               ", \"neg_risk_market_id\": " + (neg_risk ? "\"0xevent\"" : "\"\"") +
+               ", \"rewards\": {\"rates\": null, \"min_size\": 5}" +
+               ", \"tokens\": [{\"token_id\": \"" + id + "1\", \"outcome\": \"Yes\", \"price\": 0.5, \"winner\": false}," +
+               " {\"token_id\": \"" + id + "2\", \"outcome\": \"No\", \"price\": 0.5, \"winner\": false}]" +
+               ", \"tags\": [\"All\", \"" + tag + "\"]}";
+    }
+
+    std::string page(const std::vector<std::string> &markets, const std::string &next_cursor)
+    {
+        std::string body = "{\"limit\": 2, \"count\": " + std::to_string(markets.size()) + ", \"data\": [";
+        for (size_t i = 0; i < markets.size(); i++)
+        {
+            body += (i ? ", " : "") + markets[i];
+        }
+        return body + "], \"next_cursor\": \"" + next_cursor + "\"}";
+    }
+
+    // Serves canned pages by path and records the order they were asked for
+    struct FakeListing
+    {
+        std::map<std::string, HttpResponse> pages;
+        std::vector<std::string> requested;
+
+        MarketPager::Fetch fetch()
+        {
+            return [this](const std::string &path)
+            {
+                requested.push_back(path);
+                std::promise<HttpResponse> promise;
+                auto it = pages.find(path);
+                promise.set_value(it != pages.end() ? it->second : HttpResponse{404, "", "not found", 0.0});
+                return promise.get_future();
+            };
+        }
+    };
+
+    HttpResponse ok(std::string body)
+    {
+        return HttpResponse{200, std::move(body), "", 1.0};
+    }
+} // namespace
+
+int main()
+{
+    // Parsing: fields, tokens and tags; both response shapes
+    {
+        std::vector<ClobMarket> out;
+        std::string cursor;
+        size_t skipped = 99;
+        assert(MarketPager::parse_page(page({market("0xa", true, false, true, "Politics")}, "MTAw"), {}, out, cursor,
+                                       &skipped));
+        assert(cursor == "MTAw" && skipped == 0 && out.size() == 1);
+        const ClobMarket &m = out[0];
+        assert(m.condition_id == "0xa" && m.question == "Will 0xa happen?" && m.market_slug == "0xa-slug");
+        assert(m.active && !m.closed && m.neg_risk && m.neg_risk_market_id == "0xevent");
+        assert(m.token_yes() == "0xa1" && m.token_no() == "0xa2" && m.tokens.size() == 2);
+        assert(m.tags.size() == 2 && m.tags[1] == "Politics");
+
+        assert(MarketPager::parse_page("[" + market("0xb", false, true, false, "Sports") + "]", {}, out, cursor));
+        assert(out.size() == 1 && out[0].condition_id == "0xb" && out[0].closed && cursor.empty());
+
+        assert(MarketPager::parse_page("{\"data\": [], \"next_cursor\": null}", {}, out, cursor));
+        assert(out.empty() && cursor.empty());
+        assert(!MarketPager::parse_page("{\"data\": [{\"condition_id\": \"0xc\"", {}, out, cursor));
+        assert(out.empty());
+    }
+
+    // Filters drop markets during the parse
+    {
+        std::string body = page({market("0x1", true, false, false, "Sports"),
+                                 market("0x2", false, true, false, "Sports"),
+                                 market("0x3", true, false, true, "Politics"),
+                                 market("0x4", true, true, true, "Sports")},
+                                "Mg==");
+        std::vector<ClobMarket> out;
+        std::string cursor;
+        size_t skipped = 0;
+
+        MarketFilter active;
+        active.active_only = true;
+        assert(MarketPager::parse_page(body, active, out, cursor, &skipped));
+        assert(out.size() == 2 && out[0].condition_id == "0x1" && out[1].condition_id == "0x3" && skipped == 2);
+        assert(out[1].question == "Will 0x3 happen?" && out[1].tokens.size() == 2); // Not clobbered by the rejects
+
+        MarketFilter neg_risk_sports;
+        neg_risk_sports.neg_risk = true;
+        neg_risk_sports.tag = "Sports";
+        assert(MarketPager::parse_page(body, neg_risk_sports, out, cursor, &skipped));
+        assert(out.size() == 1 && out[0].condition_id == "0x4" && skipped == 3);
+
+        MarketFilter custom;
+        custom.tradable_only = true;
+        custom.predicate = [](const ClobMarket &m)
+        { return m.condition_id != "0x1"; };
+        assert(MarketPager::parse_page(body, custom, out, cursor, &skipped));
+        assert(out.size() == 3 && out[0].condition_id == "0x2" && cursor == "Mg==");
+    }
+
+    // Cursor scan: finds the top-level cursor wherever it is, ignores escaped text
+    {
+        assert(MarketPager::scan_cursor("{\"next_cursor\" : \"NA==\", \"data\": []}") == std::string("NA=="));
+        assert(MarketPager::scan_cursor("{\"data\": [], \"next_cursor\": \"LTE=\"}") == std::string("LTE="));
+        assert(!MarketPager::scan_cursor("{\"data\": [], \"next_cursor\": null}"));
+        assert(!MarketPager::scan_cursor("[{\"question\": \"\\\"next_cursor\\\"\"}]"));
+        assert(MarketPager::is_end_cursor("LTE=") && MarketPager::is_end_cursor("") && !MarketPager::is_end_cursor("MA=="));
+    }
+
+    // Pager: page N+1 is requested before page N is handed out, and the walk ends at the end cursor
+    {
+        FakeListing listing;
+        listing.pages["/markets"] = ok(page({market("0x1", true, false, false, "A"), market("0x2", false, true, false, "A")}, "Mg=="));
+        listing.pages["/markets?next_cursor=Mg=="] = ok(page({market("0x3", true, false, false, "A"), market("0x4", true, false, false, "A")}, "NA=="));
+        listing.pages["/markets?next_cursor=NA=="] = ok(page({market("0x5", true, false, false, "A")}, "LTE="));
+
+        MarketFilter filter;
+        filter.active_only = true;
+        MarketPager pager(listing.fetch(), "/markets", filter);
+        std::vector<ClobMarket> out;
+        assert(pager.next(out) && out.size() == 1 && out[0].condition_id == "0x1");
+        assert(listing.requested.size() == 2 && listing.requested[1] == "/markets?next_cursor=Mg==");
+        assert(pager.cursor() == "Mg==" && !pager.done());
+
+        auto rest = pager.collect();
+        assert(rest.size() == 3 && rest[0].condition_id == "0x3" && rest[2].condition_id == "0x5");
+        assert(pager.done() && pager.error().empty() && !pager.next(out));
+        assert(listing.requested.size() == 3); // Nothing asked for past the end cursor
+        auto stats = pager.stats();
+        assert(stats.pages == 3 && stats.markets == 5 && stats.skipped == 1 && stats.prefetched == 2);
+        assert(stats.refetched == 0);
+    }
+
+    // A limit stops the walk and trims the last page
+    {
+        FakeListing listing;
+        listing.pages["/sampling-markets"] = ok(page({market("0x1", true, false, false, "A"), market("0x2", true, false, false, "A")}, "Mg=="));
+        listing.pages["/sampling-markets?next_cursor=Mg=="] = ok(page({market("0x3", true, false, false, "A"), market("0x4", true, false, false, "A")}, "NA=="));
+        MarketPager pager(listing.fetch(), "/sampling-markets", {}, 3);
+        auto markets = pager.collect();
+        assert(markets.size() == 3 && markets[2].condition_id == "0x3" && pager.done());
+        // The second page already covers what is left, so the third is never requested
+        assert(listing.requested.size() == 2);
+    }
+
+    // A nested "next_cursor" fools the scan: the prefetch is thrown away and the real next page requested
+    {
+        FakeListing listing;
+        std::string tricky = "{\"next_cursor\": \"Mg==\", \"data\": [{\"condition_id\": \"0x1\", \"active\": true, "
+                             "\"meta\": {\"next_cursor\": \"Wlo=\"}}]}";
+        listing.pages["/markets"] = ok(tricky);
+        listing.pages["/markets?next_cursor=Mg=="] = ok(page({market("0x2", true, false, false, "A")}, "LTE="));
+        MarketPager pager(listing.fetch(), "/markets");
+        auto markets = pager.collect();
+        assert(markets.size() == 2 && markets[1].condition_id == "0x2");
+        assert(pager.stats().refetched == 1);
+        assert(listing.requested.size() == 3 && listing.requested[1] == "/markets?next_cursor=Wlo=");
+        assert(listing.requested[2] == "/markets?next_cursor=Mg==");
+    }
+
+    // A failed request ends the walk with an error, keeping what came before
+    {
+        FakeListing listing;
+        listing.pages["/markets"] = ok(page({market("0x1", true, false, false, "A")}, "Mg=="));
+        listing.pages["/markets?next_cursor=Mg=="] = HttpResponse{500, "", "server error", 1.0};
+        MarketPager pager(listing.fetch(), "/markets");
+        auto markets = pager.collect();
+        assert(markets.size() == 1 && pager.done() && pager.error().find("500") != std::string::npos);
+    }
+
+    std::cout << "test_market_pager passed\n";
+    return 0;
+}
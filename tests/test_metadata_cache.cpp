@@ -0,0 +1,88 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "clob_client.hpp"
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+int main()
+{
+    using namespace polymarket;
+
+    http_global_init();
+    {
+        // Nothing listens on port 1, so every metadata GET fails
+        ClobClient client("http://127.0.0.1:1", 137, "0x4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318",
+                          ApiCredentials{});
+        client.set_timeout_ms(2000);
+
+        assert(client.warm_metadata({"111", "222"}) == 0);
+        assert(!client.cached_metadata("111") || !client.cached_metadata("111")->complete());
+
+        // tick_size_change events write through; an empty tick only invalidates
+        client.on_tick_size_change("111", "0.001");
+        assert(client.cached_metadata("111")->tick_size == "0.001");
+        client.on_tick_size_change("111", "");
+        assert(!client.cached_metadata("111")->tick_size);
+        client.on_tick_size_change("111", "0.01");
+        client.invalidate_metadata("111");
+        assert(!client.cached_metadata("111"));
+
+        // By default a neg_risk miss throws instead of calling the API
+        CreateOrderParams params;
+        params.token_id = "111";
+        params.price = 0.5;
+        params.size = 10;
+        params.side = OrderSide::BUY;
+        bool threw = false;
+        try
+        {
+            client.create_order(params);
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+
+        // The caller's value never needs the cache
+        params.neg_risk = true;
+        auto order = client.create_order(params);
+        assert(order.token_id == "111" && !order.signature.empty());
+
+        // Market orders are never signed over a guessed tick size or fee rate: a miss throws, with or without the
+        // opt-in blocking fallback (its GET fails here)
+        CreateMarketOrderParams market;
+        market.token_id = "111";
+        market.amount = 10;
+        market.side = OrderSide::BUY;
+        market.price = 0.5;
+        market.neg_risk = true;
+        auto market_error = [&]() -> std::string
+        {
+            try
+            {
+                client.create_market_order_v2(market);
+            }
+            catch (const std::runtime_error &e)
+            {
+                return e.what();
+            }
+            return "";
+        };
+        assert(market_error().find("tick size") != std::string::npos); // Nothing cached
+        client.on_tick_size_change("111", "0.01");
+        assert(market_error().find("fee rate") != std::string::npos); // Tick size cached, fee rate still unknown
+        client.set_metadata_fallback(true);
+        assert(market_error() == "failed to fetch fee rate for token 111"); // The fallback GET fails too
+        client.invalidate_metadata("111");
+        assert(market_error() == "failed to fetch tick size for token 111");
+
+        client.clear_metadata();
+        assert(!client.cached_metadata("111"));
+    }
+    http_global_cleanup();
+
+    std::cout << "test_metadata_cache passed\n";
+    return 0;
+}
@@ -0,0 +1,99 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "order_json.hpp"
+#include <nlohmann/json.hpp>
+#include <cassert>
+#include <iostream>
+
+namespace
+{
+    using namespace polymarket;
+
+    // The ordered_json tree ClobClient::post_order built before the direct writer
+    std::string dom_payload(const SignedOrder &order, const std::string &owner, const std::string &order_type, bool post_only)
+    {
+        nlohmann::ordered_json body;
+        nlohmann::ordered_json order_json;
+        order_json["salt"] = std::stoll(order.salt);
+        order_json["maker"] = order.maker;
+        order_json["signer"] = order.signer;
+        order_json["taker"] = order.taker;
+        order_json["tokenId"] = order.token_id;
+        order_json["makerAmount"] = order.maker_amount;
+        order_json["takerAmount"] = order.taker_amount;
+        order_json["side"] = order.side == 0 ? "BUY" : "SELL";
+        order_json["expiration"] = order.expiration;
+        order_json["nonce"] = order.nonce;
+        order_json["feeRateBps"] = order.fee_rate_bps;
+        order_json["signatureType"] = order.signature_type;
+        order_json["signature"] = order.signature;
+        body["order"] = order_json;
+        body["owner"] = owner;
+        body["orderType"] = order_type;
+        body["deferExec"] = false;
+        if (post_only)
+        {
+            body["postOnly"] = true;
+        }
+        return body.dump();
+    }
+}
+
+int main()
+{
+    SignedOrder order;
+    order.salt = "123456789012";
+    order.maker = "0x90F79bf6EB2c4f870365E785982E1f101E93b906";
+    order.signer = order.maker;
+    order.taker = "0x0000000000000000000000000000000000000000";
+    order.token_id = "28537688195618790236576003993608298766895159067143553592678106718799385303898";
+    order.maker_amount = "2300000";
+    order.taker_amount = "5000000";
+    order.expiration = "0";
+    order.nonce = "0";
+    order.fee_rate_bps = "0";
+    order.side = 0;
+    order.signature_type = 2;
+    order.signature = "0x" + std::string(130, 'a');
+
+    std::string out;
+    append_order_payload(out, order, "00000000-1111-2222-3333-444444444444", "GTC", false);
+    assert(out == dom_payload(order, "00000000-1111-2222-3333-444444444444", "GTC", false));
+
+    // Appends, and matches for SELL / postOnly / other order types
+    order.side = 1;
+    order.salt = "7";
+    std::string second;
+    append_order_payload(second, order, "key", "FOK", true);
+    assert(second == dom_payload(order, "key", "FOK", true));
+    out.clear();
+    append_order_payload(out, order, "key", "FOK", false);
+    append_order_payload(out, order, "key", "FOK", true);
+    assert(out == dom_payload(order, "key", "FOK", false) + second);
+
+    // Escaping follows dump()
+    const std::string awkward = std::string("q\"b\\s/\b\f\n\r\t") + '\x01' + '\x1f' + "\xc3\xa9";
+    out.clear();
+    append_json_string(out, awkward);
+    assert(out == nlohmann::json(awkward).dump());
+
+    // Negative salts round trip; malformed ones still throw
+    order.salt = "-42";
+    out.clear();
+    append_order_payload(out, order, "key", "GTD", false);
+    assert(out == dom_payload(order, "key", "GTD", false));
+
+    bool threw = false;
+    order.salt = "salt";
+    try
+    {
+        append_order_payload(out, order, "key", "GTC", false);
+    }
+    catch (const std::invalid_argument &)
+    {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "test_order_json passed\n";
+    return 0;
+}
@@ -0,0 +1,162 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "order_manager.hpp"
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace polymarket;
+
+namespace
+{
+    SignedOrder order(int i)
+    {
+        SignedOrder o;
+        o.salt = std::to_string(1000 + i);
+        o.maker = "0x90F79bf6EB2c4f870365E785982E1f101E93b906";
+        o.signer = o.maker;
+        o.taker = "0x0000000000000000000000000000000000000000";
+        o.token_id = "111";
+        o.maker_amount = "2500000";
+        o.taker_amount = "5000000";
+        o.expiration = "0";
+        o.nonce = "0";
+        o.fee_rate_bps = "0";
+        o.side = 0;
+        o.signature_type = 0;
+        o.signature = "0x00";
+        return o;
+    }
+
+    UserOrderEvent event(const std::string &id, const std::string &type, const std::string &matched)
+    {
+        UserOrderEvent e;
+        e.id = id;
+        e.type = type;
+        e.market = "0xm";
+        e.asset_id = "111";
+        e.side = "BUY";
+        e.price = "0.5";
+        e.original_size = "10";
+        e.size_matched = matched;
+        return e;
+    }
+} // namespace
+
+int main()
+{
+    http_global_init();
+    {
+        // Nothing listens on port 1, so every batch fails in transport; the counters show what went on the wire
+        ClobClient client("http://127.0.0.1:1", 137, "0x4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318",
+                          ApiCredentials{"key", "c2VjcmV0", "pass"});
+        client.set_timeout_ms(2000);
+
+        OrderManagerConfig config;
+        config.coalesce_window = std::chrono::milliseconds(50);
+        OrderManager mgr(client, config);
+
+        // A burst of cancels goes out as one request; repeats are dropped
+        for (int i = 0; i < 10; i++)
+        {
+            assert(mgr.cancel("0xc" + std::to_string(i)));
+        }
+        assert(!mgr.cancel("0xc3"));
+        assert(mgr.wait_idle(std::chrono::seconds(10)));
+        auto stats = mgr.stats();
+        assert(stats.cancels == 11 && stats.cancels_suppressed == 1);
+        assert(stats.cancel_requests == 1 && stats.cancel_errors == 1);
+        assert(mgr.cancel("0xc3")); // The failed cancel can be retried
+        assert(mgr.wait_idle(std::chrono::seconds(10)));
+
+        // State from the user channel: a filled order is neither canceled nor replaced
+        mgr.on_user_order(event("0xa", "PLACEMENT", "0"));
+        assert(mgr.order("0xa")->state == OrderState::LIVE);
+        assert(mgr.live_orders().size() == 1);
+        mgr.on_user_order(event("0xa", "UPDATE", "4"));
+        assert(mgr.order("0xa")->state == OrderState::LIVE && mgr.order("0xa")->size_matched == 4);
+        mgr.on_user_order(event("0xa", "UPDATE", "10"));
+        assert(mgr.order("0xa")->state == OrderState::FILLED);
+        assert(!mgr.cancel("0xa"));
+        auto rejected = mgr.replace("0xa", order(1));
+        assert(rejected.wait_for(std::chrono::seconds(0)) == std::future_status::ready && !rejected.get().success);
+        assert(mgr.live_orders().empty());
+
+        // Requotes of one order inside the window: only the latest replacement is kept, and it waits for the cancel
+        stats = mgr.stats();
+        mgr.on_user_order(event("0xb", "PLACEMENT", "0"));
+        auto first = mgr.replace("0xb", order(2));
+        auto second = mgr.replace("0xb", order(3));
+        auto plain = mgr.post(order(4));
+        OrderResponse superseded = first.get();
+        assert(!superseded.success && superseded.error_msg.find("superseded") != std::string::npos);
+        assert(mgr.order("0xb")->state == OrderState::CANCEL_PENDING);
+        OrderResponse unconfirmed = second.get();
+        assert(!unconfirmed.success && unconfirmed.error_msg.find("not confirmed") != std::string::npos);
+        assert(!plain.get().success); // Transport failure
+        assert(mgr.wait_idle(std::chrono::seconds(10)));
+        auto after = mgr.stats();
+        assert(after.posts_superseded == 1 && after.replaces_aborted == stats.replaces_aborted + 1);
+        // The cancel failed, so only the plain post went out: the old order is still ours and nothing replaced it
+        assert(after.post_requests == stats.post_requests + 1 && after.cancel_requests == stats.cancel_requests + 1);
+        assert(mgr.order("0xb")->state == OrderState::LIVE);
+
+        // post_orders_async reports a transport error on every order of the batch
+        {
+            std::vector<BatchOrderEntry> batch = {{order(4), OrderType::GTC}, {order(5), OrderType::GTC}};
+            auto responses = client.post_orders_async(batch).get();
+            assert(responses.size() == 2);
+            for (const auto &r : responses)
+            {
+                assert(!r.success && !r.error_msg.empty() && r.order_id.empty());
+            }
+        }
+
+        // A cancel made moot by the user channel before the flush never goes out
+        config.coalesce_window = std::chrono::seconds(10);
+        {
+            OrderManager slow(client, config);
+            slow.on_user_order(event("0xd", "PLACEMENT", "0"));
+            assert(slow.cancel("0xd"));
+            slow.on_user_order(event("0xd", "CANCELLATION", "0"));
+            slow.flush();
+            assert(slow.wait_idle(std::chrono::seconds(10)));
+            auto s = slow.stats();
+            assert(s.cancel_requests == 0 && s.cancels_suppressed == 1);
+            assert(slow.order("0xd")->state == OrderState::CANCELED);
+
+            // A replaced order that fills before the flush keeps its exposure: the replacement is not posted
+            slow.on_user_order(event("0xe", "PLACEMENT", "0"));
+            auto replaced = slow.replace("0xe", order(6));
+            slow.on_user_order(event("0xe", "UPDATE", "10"));
+            slow.flush();
+            OrderResponse filled = replaced.get();
+            assert(!filled.success && filled.error_msg.find("filled before it was canceled") != std::string::npos);
+            assert(slow.wait_idle(std::chrono::seconds(10)));
+            s = slow.stats();
+            assert(s.post_requests == 0 && s.cancel_requests == 0 && s.replaces_aborted == 1);
+
+            // Posts are split into POST /orders batches of at most 15
+            std::vector<std::future<OrderResponse>> futures;
+            for (int i = 0; i < 20; i++)
+            {
+                futures.push_back(slow.post(order(10 + i)));
+            }
+            slow.flush();
+            for (auto &f : futures)
+            {
+                OrderResponse r = f.get();
+                assert(!r.success && !r.error_msg.empty());
+                assert(r.error_msg.find("no response") == std::string::npos); // The transport error, per order
+            }
+            assert(slow.wait_idle(std::chrono::seconds(10)));
+            assert(slow.stats().post_requests == 2);
+
+        }
+    }
+    http_global_cleanup();
+
+    std::cout << "test_order_manager passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,110 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "order_pool.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+int main()
+{
+    using namespace polymarket;
+
+    OrderSigner signer("0x4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318", 137);
+
+    OrderPoolConfig config;
+    config.levels = 3;
+    config.sizes_usdc = {5.0, 10.0};
+    config.ttl_sec = 3600;
+    OrderPool pool(signer, config);
+
+    // Nothing is signed until a leg has a price
+    pool.set_legs({"111", "222"});
+    assert(pool.wait_ready(std::chrono::seconds(5)));
+    assert(pool.stats().ready == 0);
+
+    pool.update_price("111", 0.45);
+    pool.update_price("222", 0.52);
+    pool.update_price("999", 0.10); // Not a leg
+    assert(pool.wait_ready(std::chrono::seconds(10)));
+    assert(pool.stats().ready == 2 * 3 * 2);
+
+    // Largest size that fits, signed over the arb path's amounts
+    double shares = OrderPool::shares_for(10.0, 0.46);
+    assert(shares == 21.73);
+    auto big = pool.take("111", 0.46, 100);
+    assert(big);
+    assert(big->token_id == "111" && big->side == static_cast<int>(OrderSide::BUY));
+    assert(big->maker_amount == to_wei(std::round(shares * 0.46 * 100) / 100, 6));
+    assert(big->taker_amount == to_wei(shares, 6));
+    assert(std::stoull(big->expiration) >= now_sec() + 3500);
+
+    OrderData data;
+    data.maker = signer.address();
+    data.taker = "0x0000000000000000000000000000000000000000";
+    data.token_id = "111";
+    data.maker_amount = big->maker_amount;
+    data.taker_amount = big->taker_amount;
+    data.side = OrderSide::BUY;
+    data.fee_rate_bps = "0";
+    data.nonce = "0";
+    data.signer = signer.address();
+    data.expiration = big->expiration;
+    data.signature_type = SignatureType::EOA;
+    assert(signer.sign_order_with_salt(data, NEG_RISK_EXCHANGE_ADDRESS, big->salt).signature == big->signature);
+
+    auto small = pool.take("111", 0.46, 15);
+    assert(small && small->taker_amount == to_wei(OrderPool::shares_for(5.0, 0.46), 6));
+    assert(small->salt != big->salt);
+
+    // Off the grid, unknown token, or too small
+    assert(!pool.take("111", 0.50, 100));
+    assert(!pool.take("999", 0.46, 100));
+    assert(!pool.take("222", 0.52, 1));
+    assert(!pool.take("111", 0.465, 100)); // Between ticks: not snapped to the 0.47 order
+    assert(pool.stats().hits == 2 && pool.stats().misses == 4);
+
+    // Taken orders are replaced with fresh salts
+    assert(pool.wait_ready(std::chrono::seconds(10)));
+    assert(pool.stats().ready == 12);
+    auto again = pool.take("111", 0.46, 100);
+    assert(again && again->salt != big->salt);
+
+    // The grid follows the ask
+    pool.update_price("111", 0.47);
+    assert(pool.wait_ready(std::chrono::seconds(10)));
+    assert(!pool.take("111", 0.46, 100));
+    assert(pool.take("111", 0.49, 100));
+
+    // A nonce bump drops every order signed before it
+    pool.set_nonce("1");
+    assert(pool.wait_ready(std::chrono::seconds(10)));
+    auto renonced = pool.take("222", 0.52, 100);
+    assert(renonced);
+    data.token_id = "222";
+    data.nonce = "1";
+    data.maker_amount = renonced->maker_amount;
+    data.taker_amount = renonced->taker_amount;
+    data.expiration = renonced->expiration;
+    assert(signer.sign_order_with_salt(data, NEG_RISK_EXCHANGE_ADDRESS, renonced->salt).signature == renonced->signature);
+
+    // Staging the next market's legs keeps the current ones; dropping them later keeps the staged ones
+    assert(pool.wait_ready(std::chrono::seconds(10)));
+    size_t ready = pool.stats().ready;
+    pool.set_legs({"111", "222", "333", "444"});
+    assert(pool.stats().ready == ready);
+    pool.update_price("333", 0.40);
+    assert(pool.wait_ready(std::chrono::seconds(10)));
+    size_t staged = pool.stats().ready - ready;
+    assert(staged > 0);
+
+    pool.set_legs({"333", "444"});
+    assert(!pool.take("222", 0.52, 100));
+    assert(pool.stats().ready == staged);
+    assert(pool.take("333", 0.40, 100));
+
+    // Rollover to unrelated legs drops everything
+    pool.set_legs({"555"});
+    assert(pool.stats().ready == 0);
+
+    std::cout << "test_order_pool passed\n";
+    return 0;
+}
@@ -0,0 +1,223 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "clob_client.hpp"
+#include "order_signer.hpp"
+#include <cassert>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace polymarket;
+
+// Known-answer vectors for the order and L2 signing paths. The expected digests and signatures were computed
+// outside this library (keccak-256, EIP-712 encoding, RFC 6979 secp256k1 signing with low-s and HMAC-SHA256),
+// so they pin the encoding as well as changes to it.
+namespace
+{
+    constexpr const char *kKey = "0x4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318";
+    constexpr const char *kAddress = "0x2c7536E3605D9C16a7a3D7b1898e529396a65c23"; // kKey's address
+    constexpr const char *kZeroAddress = "0x0000000000000000000000000000000000000000";
+
+    OrderData unsigned_order(const SignedOrder &o)
+    {
+        OrderData order;
+        order.maker = o.maker;
+        order.signer = o.signer;
+        order.taker = o.taker;
+        order.token_id = o.token_id;
+        order.maker_amount = o.maker_amount;
+        order.taker_amount = o.taker_amount;
+        order.side = static_cast<OrderSide>(o.side);
+        order.fee_rate_bps = o.fee_rate_bps;
+        order.nonce = o.nonce;
+        order.expiration = o.expiration;
+        order.signature_type = static_cast<SignatureType>(o.signature_type);
+        return order;
+    }
+
+    // A batch result matches what the serial path signs for the same order, exchange and salt
+    void assert_serial(OrderSigner &serial, const SignedOrder &o, const std::string &exchange)
+    {
+        SignedOrder expected = serial.sign_order_with_salt(unsigned_order(o), exchange, o.salt);
+        assert(o.signature == expected.signature && o.signature.size() == 2 + 65 * 2);
+    }
+} // namespace
+
+int main()
+{
+    OrderSigner signer(kKey, 137);
+    assert(signer.address() == kAddress); // EIP-55 checksummed
+
+    // Plain EOA buy on the CTF exchange
+    {
+        OrderData order;
+        order.maker = kAddress;
+        order.signer = kAddress;
+        order.taker = kZeroAddress;
+        order.token_id = "71321045679252212594626385532706912750332728571942532289631379312455583992563";
+        order.maker_amount = "4600000";
+        order.taker_amount = "10000000";
+        order.side = OrderSide::BUY;
+        order.fee_rate_bps = "0";
+        order.nonce = "0";
+        order.expiration = "0";
+        order.signature_type = SignatureType::EOA;
+
+        auto digest = signer.order_digest(order, EXCHANGE_ADDRESS, "479249096354");
+        assert(to_hex(digest) == "0x25589d6245ad478a22c9f8ca765c374fd479f6d6212a15bfb338b611ec12cbaf");
+
+        SignedOrder signed_order = signer.sign_order_with_salt(order, EXCHANGE_ADDRESS, "479249096354");
+        assert(signed_order.salt == "479249096354");
+        assert(signed_order.signature ==
+               "0xec7b3d5191218db3bb12fff703a7acfb44f48dbca6290815609d9f9fa5c7d20e"
+               "0ec781929e07a85d6b318c8abc0ea34d76b624fdb11bbfd957c465995bb653c81c");
+        assert(signer.sign_hash(digest) == signed_order.signature);
+    }
+
+    // Safe-wallet sell on the neg-risk exchange: fee, nonce and expiry set, maker distinct from signer
+    {
+        OrderData order;
+        order.maker = "0xd8dA6BF26964aF9D7eEd9e03E53415D37aA96045";
+        order.signer = kAddress;
+        order.taker = kZeroAddress;
+        order.token_id = "52114319501245915516055106046884209969926127482827954674443846427813813222426";
+        order.maker_amount = "25000000";
+        order.taker_amount = "13750000";
+        order.side = OrderSide::SELL;
+        order.fee_rate_bps = "1000";
+        order.nonce = "7";
+        order.expiration = "1735689600";
+        order.signature_type = SignatureType::POLY_GNOSIS_SAFE;
+
+        auto digest = signer.order_digest(order, NEG_RISK_EXCHANGE_ADDRESS, "1234567890123");
+        assert(to_hex(digest) == "0xb525d84f44bef34bf851e943bd8958b1e0af102842d89fd096c18a86858c3abd");
+        assert(signer.sign_order_with_salt(order, NEG_RISK_EXCHANGE_ADDRESS, "1234567890123").signature ==
+               "0xe32c42a2489df55c5d3cccd55ef718fe14a9aae7632898505e7aee8e59604c87"
+               "3c6c446e45f8364ec2537e1a3b5e765493f10ec8a91512b2653244f5164f80971b");
+
+        // The verifying contract is part of the domain
+        assert(signer.order_digest(order, EXCHANGE_ADDRESS, "1234567890123") != digest);
+    }
+
+    // L2 HMAC: URL-safe base64 of HMAC-SHA256(base64-decoded secret, timestamp + method + path + body)
+    {
+        ApiCredentials creds{"key", "c2VjcmV0LWtleS1mb3ItdGVzdHM_-w==", "pass"};
+        auto headers = signer.generate_l2_headers(creds, "POST", "/order", "{\"order\":1}", 1700000000);
+        assert(headers.poly_signature == "U0ndHEI3K_gPxhWwwsB7qaLmjt1uYCKz_KRa0l34_Og=");
+        assert(headers.poly_timestamp == "1700000000" && headers.poly_api_key == "key" && headers.poly_passphrase == "pass");
+        assert(headers.poly_address == signer.address());
+
+        // The cached MAC context is re-initialised per request, not carried over from the last message
+        assert(signer.generate_l2_headers(creds, "GET", "/data/orders", "", 1700000000).poly_signature ==
+               "CTcmEMJG1EFFelxGhQyztxlYmSWe1bZe89Ns7csCxyM=");
+
+        // A new secret replaces the cached key; the standard alphabet decodes to the same key as the URL-safe one
+        ApiCredentials other{"key", "c2VjcmV0", "pass"};
+        assert(signer.generate_l2_headers(other, "DELETE", "/order", "{\"orderID\":\"0xabc\"}", 1700000001).poly_signature ==
+               "1uEk1XYcKtoHNzm83Q5ZmZRtmaHB_UxG-iRo9YEJGp4=");
+        ApiCredentials standard{"key", "c2VjcmV0LWtleS1mb3ItdGVzdHM/+w==", "pass"};
+        assert(signer.generate_l2_headers(standard, "POST", "/order", "{\"order\":1}", 1700000000).poly_signature ==
+               "U0ndHEI3K_gPxhWwwsB7qaLmjt1uYCKz_KRa0l34_Og=");
+    }
+
+    // Batches: pooled signing gives the serial signatures, in input order, with one salt per order
+    {
+        std::vector<OrderData> orders(37);
+        std::vector<std::string> exchanges;
+        for (size_t i = 0; i < orders.size(); i++)
+        {
+            OrderData &order = orders[i];
+            order.maker = kAddress;
+            order.signer = kAddress;
+            order.taker = kZeroAddress;
+            order.token_id = std::to_string(1000 + i);
+            order.maker_amount = std::to_string(1000000 + i * 10000);
+            order.taker_amount = "2000000";
+            order.side = i % 2 ? OrderSide::SELL : OrderSide::BUY;
+            order.fee_rate_bps = "0";
+            order.nonce = "0";
+            order.expiration = "0";
+            order.signature_type = SignatureType::EOA;
+            exchanges.push_back(i % 3 ? EXCHANGE_ADDRESS : NEG_RISK_EXCHANGE_ADDRESS);
+        }
+
+        OrderSigner serial(kKey, 137);
+        serial.set_signing_threads(0);
+        for (size_t threads : {0, 1, 3})
+        {
+            OrderSigner pooled(kKey, 137);
+            pooled.set_signing_threads(threads);
+            for (int round = 0; round < 3; round++) // The pool is reused across batches
+            {
+                auto batch = pooled.sign_orders(orders, exchanges);
+                assert(batch.size() == orders.size());
+                std::set<std::string> salts;
+                for (size_t i = 0; i < batch.size(); i++)
+                {
+                    assert(batch[i].token_id == orders[i].token_id && batch[i].maker_amount == orders[i].maker_amount);
+                    assert_serial(serial, batch[i], exchanges[i]);
+                    salts.insert(batch[i].salt);
+                }
+                assert(salts.size() == batch.size());
+
+                auto same = pooled.sign_orders(orders, NEG_RISK_EXCHANGE_ADDRESS);
+                for (size_t i = 0; i < same.size(); i++)
+                {
+                    assert(same[i].token_id == orders[i].token_id);
+                    assert_serial(serial, same[i], NEG_RISK_EXCHANGE_ADDRESS);
+                }
+            }
+
+            assert(pooled.sign_orders(std::span<const OrderData>(), EXCHANGE_ADDRESS).empty());
+            bool threw = false;
+            try
+            {
+                pooled.sign_orders(orders, std::span<const std::string>(exchanges.data(), 2));
+            }
+            catch (const std::invalid_argument &)
+            {
+                threw = true;
+            }
+            assert(threw);
+        }
+    }
+
+    // ClobClient::create_orders signs the batch like create_order does, one exchange per order's neg_risk
+    http_global_init();
+    {
+        // Nothing listens on port 1; neg_risk is given, so no request is made
+        ClobClient client("http://127.0.0.1:1", 137, kKey, ApiCredentials{"key", "c2VjcmV0", "pass"});
+        client.set_timeout_ms(2000);
+
+        std::vector<CreateOrderParams> params;
+        for (int i = 0; i < 9; i++)
+        {
+            CreateOrderParams p;
+            p.token_id = std::to_string(500 + i);
+            p.price = 0.40 + i * 0.01;
+            p.size = 10 + i;
+            p.side = i % 2 ? OrderSide::SELL : OrderSide::BUY;
+            p.neg_risk = i % 3 == 0;
+            params.push_back(p);
+        }
+
+        auto batch = client.create_orders(params);
+        assert(batch.size() == params.size());
+        OrderSigner serial(kKey, 137);
+        for (size_t i = 0; i < batch.size(); i++)
+        {
+            SignedOrder single = client.create_order(params[i]);
+            assert(batch[i].token_id == single.token_id && batch[i].side == single.side);
+            assert(batch[i].maker_amount == single.maker_amount && batch[i].taker_amount == single.taker_amount);
+            assert(batch[i].maker == single.maker && batch[i].signer == single.signer);
+            const std::string &exchange = *params[i].neg_risk ? NEG_RISK_EXCHANGE_ADDRESS : EXCHANGE_ADDRESS;
+            assert_serial(serial, batch[i], exchange);
+            assert_serial(serial, single, exchange);
+        }
+    }
+    http_global_cleanup();
+
+    std::cout << "test_order_signer passed\n";
+    return 0;
+}
@@ -0,0 +1,170 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "clob_client.hpp"
+#include "price_history_store.hpp"
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+using namespace polymarket;
+
+int main()
+{
+    // Parsing: numeric and string prices, other fields skipped, malformed bodies leave the columns alone
+    {
+        std::vector<uint64_t> ts;
+        std::vector<double> px;
+        assert(parse_price_history("{\"history\": [{\"t\": 1700000000, \"p\": 0.52}, {\"t\": 1700000060, \"p\": \"0.535\"},"
+                                   " {\"p\": 0.9}, {\"t\": 1700000120, \"p\": 1, \"extra\": {\"t\": 5}}]}",
+                                   ts, px));
+        assert(ts.size() == 3 && ts[0] == 1700000000 && ts[2] == 1700000120);
+        assert(px[0] == 0.52 && px[1] == 0.535 && px[2] == 1.0);
+        assert(!parse_price_history("{\"history\": [{\"t\": 1", ts, px) && ts.size() == 3);
+        assert(parse_price_history("{\"history\": []}", ts, px) && ts.size() == 3);
+    }
+
+    std::string dir = "/tmp/test_price_history_" + std::to_string(::getpid());
+    {
+        PriceHistoryStore store(dir);
+        assert(store.view("101-1m").empty() && store.coverage("101-1m").to == 0);
+
+        std::vector<uint64_t> ts = {100, 160, 220};
+        std::vector<double> px = {0.5, 0.51, 0.52};
+        store.replace("101-1m", ts.data(), px.data(), ts.size(), 90, 230);
+        PriceHistoryView first = store.view("101-1m");
+        assert(first.size() == 3 && first.timestamps[1] == 160 && first.prices[2] == 0.52);
+        auto coverage = store.coverage("101-1m");
+        assert(coverage.from == 90 && coverage.to == 230);
+
+        // Appends skip what is already there and grow the files without moving existing views
+        std::vector<uint64_t> more;
+        std::vector<double> more_px;
+        for (uint64_t i = 0; i < 3000; i++)
+        {
+            more.push_back(220 + i * 60);
+            more_px.push_back(0.5 + static_cast<double>(i % 100) / 1000.0);
+        }
+        store.append("101-1m", more.data(), more_px.data(), more.size(), 220 + 3000 * 60);
+        PriceHistoryView grown = store.view("101-1m");
+        assert(grown.size() == 3002 && grown.timestamps[3] == 280);
+        assert(first.size() == 3 && first.timestamps[2] == 220 && first.prices[0] == 0.5);
+
+        PriceHistoryView window = grown.slice(280, 400);
+        assert(window.size() == 3 && window.timestamps[0] == 280 && window.timestamps[2] == 400);
+        assert(grown.slice(1000000).empty() && grown.slice(0, 50).empty() && grown.slice(0).size() == 3002);
+
+        // Replace swaps the files; the old view still reads the old points
+        std::vector<uint64_t> other = {10, 20};
+        std::vector<double> other_px = {0.1, 0.2};
+        store.replace("101-1m", other.data(), other_px.data(), other.size(), 0, 30);
+        assert(store.view("101-1m").size() == 2 && grown.size() == 3002 && grown.timestamps[3001] == 220 + 2999 * 60);
+
+        store.append("102-1m", other.data(), other_px.data(), other.size(), 30);
+        store.flush();
+
+        bool threw = false;
+        try
+        {
+            store.view("../escape");
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // Series persist across stores; files that don't agree are discarded
+    {
+        std::FILE *f = std::fopen((dir + "/102-1m.px").c_str(), "r+b");
+        assert(f);
+        std::fwrite("garbage!", 1, 8, f);
+        std::fclose(f);
+
+        PriceHistoryStore store(dir);
+        PriceHistoryView view = store.view("101-1m");
+        assert(view.size() == 2 && view.timestamps[1] == 20 && view.prices[1] == 0.2);
+        assert(store.coverage("101-1m").to == 30);
+        assert(store.view("102-1m").empty() && store.coverage("102-1m").to == 0);
+    }
+
+    // Refresh: starts at the last cached point, so a point published after the previous fetch still lands
+    {
+        struct Published
+        {
+            uint64_t t;
+            double p;
+            uint64_t at; // When the fake server starts returning it
+        };
+        std::vector<Published> server = {{880, 0.5, 900}, {940, 0.51, 960}, {960, 0.52, 1100}, {1060, 0.53, 1100}};
+        uint64_t now = 1000;
+        std::vector<std::pair<uint64_t, uint64_t>> requested;
+        PriceHistoryStore::Fetch fetch = [&](uint64_t from, uint64_t to, std::vector<uint64_t> &ts, std::vector<double> &px)
+        {
+            requested.emplace_back(from, to);
+            for (const auto &point : server)
+            {
+                if (point.t >= from && point.t <= to && point.at <= now)
+                {
+                    ts.push_back(point.t);
+                    px.push_back(point.p);
+                }
+            }
+            return true;
+        };
+
+        PriceHistoryStore store(dir);
+        assert(store.refresh("late-1m", 800, 0, now, 60, fetch).size() == 2);
+        now = 1030; // Not a full step since the last fetch: served from the cache
+        assert(store.refresh("late-1m", 800, 0, now, 60, fetch).size() == 2 && requested.size() == 1);
+
+        now = 1100;
+        PriceHistoryView view = store.refresh("late-1m", 800, 0, now, 60, fetch);
+        assert(requested.size() == 2 && requested[1] == std::make_pair(uint64_t{940}, uint64_t{1100}));
+        assert(view.size() == 4 && view.timestamps[2] == 960 && view.prices[2] == 0.52 && view.timestamps[3] == 1060);
+
+        // Fixed ranges inside the coverage are never refetched; an earlier start fetches only the gap before it
+        assert(store.refresh("late-1m", 900, 1000, now, 60, fetch).size() == 2 && requested.size() == 2);
+        server.insert(server.begin(), Published{700, 0.4, 0});
+        assert(store.refresh("late-1m", 600, 1100, now, 60, fetch).size() == 5 && requested.size() == 3);
+        assert(requested[2] == std::make_pair(uint64_t{600}, uint64_t{800}) && store.coverage("late-1m").from == 600);
+    }
+
+    // ClobClient answers covered ranges from the cache without a request (nothing listens on this port)
+    http_global_init();
+    {
+        ClobClient client("http://127.0.0.1:1", 137);
+        client.set_timeout_ms(2000);
+        bool threw = false;
+        try
+        {
+            client.get_prices_history_cached("101", 0, 30);
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+
+        {
+            PriceHistoryStore seed(dir);
+            std::vector<uint64_t> ts = {1700000000, 1700000060, 1700000120};
+            std::vector<double> px = {0.4, 0.41, 0.42};
+            seed.replace("555-1m", ts.data(), px.data(), ts.size(), 1699999990, 1700000200);
+        }
+        client.set_prices_history_cache(dir);
+        PriceHistoryView view = client.get_prices_history_cached("555", 1700000000, 1700000100);
+        assert(view.size() == 2 && view.prices[1] == 0.41);
+        // Past the coverage the refresh fails here, and the cached points come back as they are
+        assert(client.get_prices_history_cached("555", 1700000000).size() == 3);
+        assert(client.get_prices_history_cached("556", 1700000000).empty());
+    }
+    http_global_cleanup();
+
+    std::filesystem::remove_all(dir);
+    std::cout << "test_price_history_store passed\n";
+    return 0;
+}
@@ -0,0 +1,81 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "price_ladder.hpp"
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+    bool near(double a, double b)
+    {
+        return std::fabs(a - b) < 1e-9;
+    }
+}
+
+int main()
+{
+    using namespace polymarket;
+
+    PriceLadder ladder;
+    assert(ladder.num_ticks() == 1001);
+    assert(!ladder.has_bids() && !ladder.has_asks());
+    assert(ladder.best_bid() == 0.0 && ladder.best_ask() == 1.0);
+
+    // Grid mapping
+    assert(ladder.to_tick(0.0) == 0 && ladder.to_tick(1.0) == 1000);
+    assert(ladder.to_tick(0.53) == 530);
+    assert(ladder.to_tick(0.5305) == -1);
+    assert(ladder.to_tick(1.5) == -1 && ladder.to_tick(-0.01) == -1);
+
+    // Best levels tracked incrementally
+    assert(ladder.set(BookSide::ASK, 0.55, 3));
+    assert(ladder.set(BookSide::ASK, 0.60, 2));
+    assert(ladder.set(BookSide::ASK, 0.53, 10));
+    assert(ladder.set(BookSide::BID, 0.45, 1));
+    assert(ladder.set(BookSide::BID, 0.40, 5));
+    assert(!ladder.set(BookSide::BID, 0.4005, 5));
+    assert(near(ladder.best_ask(), 0.53) && ladder.best_ask_size() == 10.0);
+    assert(near(ladder.best_bid(), 0.45) && ladder.best_bid_size() == 1.0);
+    assert(ladder.level_count(BookSide::ASK) == 3 && ladder.level_count(BookSide::BID) == 2);
+    assert(ladder.size_at(BookSide::ASK, 0.60) == 2.0 && ladder.size_at(BookSide::ASK, 0.61) == 0.0);
+
+    // Removing the best level walks to the next one; resizing does not add a level
+    ladder.set(BookSide::ASK, 0.53, 0);
+    assert(near(ladder.best_ask(), 0.55) && ladder.level_count(BookSide::ASK) == 2);
+    ladder.set(BookSide::BID, 0.45, 0);
+    ladder.set(BookSide::BID, 0.40, 7);
+    assert(near(ladder.best_bid(), 0.40) && ladder.best_bid_size() == 7.0 && ladder.level_count(BookSide::BID) == 1);
+    ladder.set(BookSide::BID, 0.40, 0);
+    assert(!ladder.has_bids() && ladder.best_bid() == 0.0);
+
+    // Cumulative depth
+    DepthSum asks = ladder.ask_depth_to(0.58);
+    assert(near(asks.size, 3.0) && near(asks.notional, 0.55 * 3));
+    asks = ladder.ask_depth_to(1.0);
+    assert(near(asks.size, 5.0) && near(asks.notional, 0.55 * 3 + 0.60 * 2));
+    assert(near(asks.vwap(), (0.55 * 3 + 0.60 * 2) / 5.0));
+    assert(ladder.ask_depth_to(0.5).size == 0.0);
+
+    // Loading a book replaces the contents
+    Orderbook book;
+    book.bids = {{0.31, 4}, {0.30, 6}, {0.29, 1}};
+    book.asks = {{0.35, 2}};
+    assert(ladder.load(book));
+    assert(near(ladder.best_bid(), 0.31) && near(ladder.best_ask(), 0.35));
+    assert(ladder.size_at(BookSide::ASK, 0.55) == 0.0 && ladder.level_count(BookSide::ASK) == 1);
+    DepthSum bids = ladder.bid_depth_to(0.30);
+    assert(near(bids.size, 10.0) && near(bids.notional, 0.31 * 4 + 0.30 * 6));
+    TopOfBook top = ladder.top();
+    assert(near(top.best_bid, 0.31) && top.best_bid_size == 4.0 && top.best_ask_size == 2.0);
+
+    // Off-grid books are rejected; a finer ladder takes them
+    book.asks = {{0.3505, 2}};
+    assert(!ladder.load(book));
+    assert(!ladder.has_bids() && !ladder.has_asks());
+    PriceLadder fine(0.0001);
+    assert(fine.num_ticks() == 10001);
+    assert(fine.load(book) && near(fine.best_ask(), 0.3505));
+
+    std::cout << "test_price_ladder passed\n";
+    return 0;
+}
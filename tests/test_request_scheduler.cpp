@@ -0,0 +1,153 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "clob_client.hpp"
+#include "request_scheduler.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace polymarket;
+
+int main()
+{
+    // Lanes from method and path
+    assert(RequestScheduler::lane_for("DELETE", "/order") == RequestLane::CANCEL);
+    assert(RequestScheduler::lane_for("POST", "/cancel-all") == RequestLane::CANCEL);
+    assert(RequestScheduler::lane_for("POST", "/orders") == RequestLane::ORDER);
+    assert(RequestScheduler::lane_for("GET", "/orders?market=0x1") == RequestLane::ACCOUNT);
+    assert(RequestScheduler::lane_for("GET", "/data/trades") == RequestLane::ACCOUNT);
+    assert(RequestScheduler::lane_for("GET", "/book?token_id=1") == RequestLane::MARKET_DATA);
+    assert(RequestScheduler::lane_for("GET", "/markets/0xabc") == RequestLane::MARKET_DATA);
+
+    RequestSchedulerConfig config;
+    config.query_max_wait = std::chrono::milliseconds(20);
+
+    // A query past its endpoint's burst is dropped as soon as the bucket can't refill in time
+    {
+        RequestScheduler scheduler(config);
+        scheduler.set_limit("GET", "/book", 3, 0.001);
+        for (int i = 0; i < 3; i++)
+        {
+            assert(scheduler.acquire("GET", "/book?token_id=" + std::to_string(i)));
+        }
+        assert(!scheduler.acquire("GET", "/book?token_id=9"));
+        assert(scheduler.acquire("GET", "/books")); // Separate bucket
+        auto lane = scheduler.stats().lane(RequestLane::MARKET_DATA);
+        assert(lane.requests == 4 && lane.dropped == 1 && lane.throttled == 0);
+    }
+
+    // A query that fits its wait blocks until the bucket refills
+    {
+        RequestScheduler scheduler(config);
+        scheduler.set_limit("GET", "/midpoint", 1, 200); // A token every 5ms
+        assert(scheduler.acquire("GET", "/midpoint"));
+        auto start = std::chrono::steady_clock::now();
+        assert(scheduler.acquire("GET", "/midpoint"));
+        assert(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(3));
+        auto lane = scheduler.stats().lane(RequestLane::MARKET_DATA);
+        assert(lane.requests == 2 && lane.throttled == 1 && lane.queued.max_ns >= 3000000);
+    }
+
+    // Orders are never dropped: out of tokens they go out anyway and count as overruns
+    {
+        RequestScheduler scheduler(config);
+        scheduler.set_limit("POST", "/order", 1, 0.001);
+        assert(scheduler.acquire("POST", "/order"));
+        assert(scheduler.acquire("POST", "/order"));
+        auto lane = scheduler.stats().lane(RequestLane::ORDER);
+        assert(lane.requests == 2 && lane.overruns == 1);
+        assert(!scheduler.try_acquire(RequestLane::ORDER, "POST", "/order")); // try_acquire never overruns
+    }
+
+    // Queries leave the reserved share of the shared bucket to orders
+    {
+        RequestSchedulerConfig small = config;
+        small.global_burst = 10;
+        small.global_per_second = 0.001;
+        small.query_reserve = 0.5;
+        RequestScheduler scheduler(small);
+        int queries = 0;
+        while (scheduler.try_acquire(RequestLane::MARKET_DATA, "GET", "/price"))
+        {
+            queries++;
+        }
+        assert(queries == 5);
+        for (int i = 0; i < 5; i++)
+        {
+            assert(scheduler.try_acquire(RequestLane::ORDER, "POST", "/order"));
+        }
+        assert(!scheduler.try_acquire(RequestLane::CANCEL, "DELETE", "/order"));
+    }
+
+    // While an order waits for the shared bucket, a query queued after it doesn't take the next token
+    {
+        RequestSchedulerConfig shared = config;
+        shared.global_burst = 1;
+        shared.global_per_second = 20; // A token every 50ms
+        shared.query_reserve = 0;
+        shared.query_max_wait = std::chrono::milliseconds(500);
+        RequestScheduler scheduler(shared);
+        assert(scheduler.acquire("GET", "/spread"));
+
+        std::atomic<int> finished{0};
+        int order_rank = 0;
+        std::thread order([&]()
+                          {
+            assert(scheduler.acquire("POST", "/order"));
+            order_rank = ++finished; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        assert(scheduler.acquire("GET", "/spread"));
+        int query_rank = ++finished;
+        order.join();
+        assert(order_rank == 1 && query_rank == 2);
+        assert(scheduler.stats().lane(RequestLane::ORDER).throttled == 1);
+    }
+
+    // A 429 empties the endpoint's bucket
+    {
+        RequestScheduler scheduler(config);
+        scheduler.set_limit("GET", "/prices", 10, 0.001);
+        assert(scheduler.try_acquire(RequestLane::MARKET_DATA, "GET", "/prices"));
+        scheduler.on_response(RequestLane::MARKET_DATA, "GET", "/prices?side=BUY", 429);
+        assert(!scheduler.try_acquire(RequestLane::MARKET_DATA, "GET", "/prices"));
+        assert(scheduler.stats().lane(RequestLane::MARKET_DATA).rejected == 1);
+        scheduler.reset_stats();
+        assert(scheduler.stats().lane(RequestLane::MARKET_DATA).requests == 0);
+
+        scheduler.set_enabled(false);
+        assert(scheduler.try_acquire(RequestLane::MARKET_DATA, "GET", "/prices"));
+    }
+
+    // ClobClient routes every request through its scheduler; a dropped query never reaches the network
+    http_global_init();
+    {
+        ClobClient client("http://127.0.0.1:1", 137);
+        client.set_timeout_ms(2000);
+        client.scheduler().set_limit("GET", "/book", 1, 0.001);
+        assert(!client.get_order_book("123"));
+        assert(!client.get_order_book("123"));
+        auto lane = client.get_scheduler_stats().lane(RequestLane::MARKET_DATA);
+        assert(lane.requests == 1 && lane.dropped == 1);
+    }
+
+    // Blocking cancels go out as POST but are admitted as cancels and draw from the DELETE buckets
+    {
+        ClobClient client("http://127.0.0.1:1", 137, "0x4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318",
+                          ApiCredentials{"key", "c2VjcmV0", "pass"});
+        client.set_timeout_ms(2000);
+        client.scheduler().set_limit("POST", "/order", 1, 0.001);
+        client.scheduler().set_limit("DELETE", "/order", 10, 0.001);
+        assert(!client.cancel_order("0x1"));
+        assert(!client.cancel_orders({"0x2", "0x3"}));
+        auto stats = client.get_scheduler_stats();
+        assert(stats.lane(RequestLane::CANCEL).requests == 2 && stats.lane(RequestLane::ORDER).requests == 0);
+        // The order bucket was left alone
+        assert(client.scheduler().try_acquire(RequestLane::ORDER, "POST", "/order"));
+        assert(!client.scheduler().try_acquire(RequestLane::ORDER, "POST", "/order"));
+    }
+    http_global_cleanup();
+
+    std::cout << "test_request_scheduler passed\n";
+    return 0;
+}
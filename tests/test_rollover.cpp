@@ -0,0 +1,93 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "orderbook.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace polymarket;
+
+namespace
+{
+    MarketState market(const std::string &id)
+    {
+        MarketState m;
+        m.slug = "btc-updown-15m-" + id;
+        m.symbol = "btc";
+        m.condition_id = "0xcond" + id;
+        m.token_yes = id + "1";
+        m.token_no = id + "2";
+        return m;
+    }
+
+    Orderbook book(const std::string &token_id, double ask)
+    {
+        Orderbook b;
+        b.asset_id = token_id;
+        b.asks = {PriceLevel{ask, 100.0}};
+        b.bids = {PriceLevel{ask - 0.02, 100.0}};
+        b.timestamp_ns = now_ns();
+        return b;
+    }
+} // namespace
+
+int main()
+{
+    // Never connected: subscriptions are only recorded, books come from apply_snapshot()
+    Config config;
+    OrderbookManager mgr(config);
+
+    std::vector<std::string> arbs;
+    size_t updates = 0;
+    mgr.on_arb_opportunity([&](const LiveMarketState &m, double)
+                           { arbs.push_back(m.condition_id); });
+    mgr.on_orderbook_update([&](const std::string &, const Orderbook &)
+                            { updates++; });
+
+    MarketState current = market("100");
+    MarketState next = market("200");
+    mgr.subscribe(current);
+    mgr.apply_snapshot(book(current.token_yes, 0.45));
+    mgr.apply_snapshot(book(current.token_no, 0.50));
+    assert(arbs.size() == 1 && arbs[0] == current.condition_id);
+
+    // The staged market is kept hot but raises no arb callbacks
+    mgr.stage_market(next);
+    assert(mgr.staged_condition_id() == next.condition_id);
+    updates = 0;
+    mgr.apply_snapshot(book(next.token_yes, 0.40));
+    mgr.apply_snapshot(book(next.token_no, 0.40));
+    assert(updates == 2 && arbs.size() == 1);
+    assert(mgr.get_top_of_book(next.token_yes)->best_ask == 0.40);
+    assert(mgr.get_market(next.condition_id).best_ask_no == 0.40);
+
+    // Promotion makes it live and retires the current market in one step
+    assert(mgr.promote_staged(current.condition_id));
+    assert(mgr.staged_condition_id().empty());
+    assert(mgr.get_market(current.condition_id).condition_id.empty());
+    assert(!mgr.get_top_of_book(current.token_yes));
+    assert(mgr.get_top_of_book(next.token_yes)->best_ask == 0.40); // Still hot
+    mgr.apply_snapshot(book(next.token_no, 0.41));
+    assert(arbs.size() == 2 && arbs[1] == next.condition_id);
+
+    // Updates for the retired market are no longer routed
+    updates = 0;
+    mgr.apply_snapshot(book(current.token_yes, 0.30));
+    assert(updates == 0 && arbs.size() == 2);
+
+    assert(!mgr.promote_staged(next.condition_id)); // Nothing staged
+
+    // Staging a different market replaces the staged one
+    MarketState later = market("300");
+    MarketState latest = market("400");
+    mgr.stage_market(later);
+    mgr.stage_market(latest);
+    assert(mgr.staged_condition_id() == latest.condition_id);
+    assert(mgr.get_market(later.condition_id).condition_id.empty());
+
+    mgr.unsubscribe_all();
+    assert(mgr.staged_condition_id().empty());
+
+    std::cout << "test_rollover passed\n";
+    return 0;
+}
@@ -0,0 +1,111 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "token_registry.hpp"
+#include <cassert>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace polymarket;
+
+namespace
+{
+    // Token ids are 70+ digit decimals; keep the test ids as long so none fit the small-string buffer
+    std::string token(int n)
+    {
+        return "7132104567925221259462638553270691275033272857194253228963137931245558399" + std::to_string(n);
+    }
+} // namespace
+
+int main()
+{
+    // Dense handles in intern order, stable across repeats
+    {
+        TokenRegistry registry;
+        assert(registry.size() == 0 && registry.find(token(0)) == kInvalidToken);
+
+        assert(registry.intern(token(0)) == 0);
+        assert(registry.intern(token(1)) == 1);
+        assert(registry.intern(token(0)) == 0);
+        assert(registry.size() == 2);
+        assert(registry.find(token(1)) == 1 && registry.find(token(2)) == kInvalidToken);
+        assert(registry.id(0) == token(0) && registry.id(1) == token(1));
+
+        // Lookups by view don't need the caller's string to outlive the call
+        std::string key = token(1);
+        std::string_view view(key);
+        assert(registry.find(view.substr(0, view.size() - 1)) == kInvalidToken);
+        assert(registry.find(view) == 1);
+        key.assign(key.size(), 'x');
+        assert(registry.find(token(1)) == 1 && registry.id(1) == token(1));
+
+        bool threw = false;
+        try
+        {
+            registry.id(2);
+        }
+        catch (const std::out_of_range &)
+        {
+            threw = true;
+        }
+        assert(threw);
+    }
+
+    // id() references and the map's views survive growth
+    {
+        TokenRegistry registry;
+        const std::string &first = registry.id(registry.intern(token(0)));
+        for (int i = 1; i < 10000; i++)
+        {
+            assert(registry.intern(token(i)) == static_cast<TokenHandle>(i));
+        }
+        assert(&first == &registry.id(0) && first == token(0));
+        for (int i = 0; i < 10000; i += 97)
+        {
+            assert(registry.find(token(i)) == static_cast<TokenHandle>(i));
+        }
+    }
+
+    // Concurrent interns of overlapping ids agree on one handle per id, and finds see what was interned
+    {
+        TokenRegistry registry;
+        constexpr int kThreads = 4;
+        constexpr int kIds = 2000;
+        std::vector<std::vector<TokenHandle>> seen(kThreads, std::vector<TokenHandle>(kIds));
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; t++)
+        {
+            threads.emplace_back([&, t]()
+                                 {
+                for (int k = 0; k < kIds; k++)
+                {
+                    int i = (k * 7 + t * 500) % kIds; // Different start and stride per thread
+                    TokenHandle handle = registry.intern(token(i));
+                    assert(handle != kInvalidToken);
+                    assert(registry.find(token(i)) == handle && registry.id(handle) == token(i));
+                    seen[t][i] = handle;
+                } });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        assert(registry.size() == kIds);
+        std::set<TokenHandle> handles;
+        for (int i = 0; i < kIds; i++)
+        {
+            for (int t = 1; t < kThreads; t++)
+            {
+                assert(seen[t][i] == seen[0][i]);
+            }
+            handles.insert(seen[0][i]);
+        }
+        assert(handles.size() == kIds && *handles.rbegin() == kIds - 1);
+    }
+
+    std::cout << "test_token_registry passed\n";
+    return 0;
+}
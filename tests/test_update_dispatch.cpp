@@ -0,0 +1,170 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "orderbook.hpp"
+#include "spsc_ring.hpp"
+#include "update_dispatch.hpp"
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace polymarket;
+
+namespace
+{
+    Orderbook book(const std::string &token, double ask, double bid)
+    {
+        Orderbook b;
+        b.asset_id = token;
+        b.asks = {{ask, 100.0}};
+        b.bids = {{bid, 100.0}};
+        b.timestamp_ns = now_ns();
+        return b;
+    }
+} // namespace
+
+int main()
+{
+    // Ring: power-of-two capacity, FIFO across the wrap, full and empty are reported
+    {
+        SpscRing<uint64_t> ring(5);
+        assert(ring.capacity() == 8);
+        uint64_t value = 0;
+        assert(!ring.try_pop(value));
+        for (uint64_t round = 0; round < 3; round++)
+        {
+            for (uint64_t i = 0; i < 8; i++)
+            {
+                assert(ring.try_push(round * 8 + i));
+            }
+            assert(!ring.try_push(99) && ring.size() == 8);
+            for (uint64_t i = 0; i < 8; i++)
+            {
+                assert(ring.try_pop(value) && value == round * 8 + i);
+            }
+            assert(!ring.try_pop(value) && ring.size() == 0);
+        }
+    }
+
+    // Ring across threads: every value arrives once, in order
+    {
+        SpscRing<uint64_t> ring(64);
+        constexpr uint64_t kCount = 200000;
+        std::thread producer([&ring]()
+                             {
+            for (uint64_t i = 0; i < kCount;)
+            {
+                if (ring.try_push(i))
+                {
+                    i++;
+                }
+            } });
+        uint64_t expected = 0;
+        uint64_t value = 0;
+        while (expected < kCount)
+        {
+            if (ring.try_pop(value))
+            {
+                assert(value == expected);
+                expected++;
+            }
+        }
+        producer.join();
+    }
+
+    // Consumer: DROP counts what a full lane loses, lanes are drained round-robin
+    {
+        UpdateConsumerConfig config;
+        config.capacity = 4;
+        UpdateConsumer consumer(config, 3);
+        assert(consumer.lanes() == 3);
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            UpdateEvent event;
+            event.token = i;
+            consumer.publish(0, event);
+        }
+        UpdateEvent shared;
+        shared.token = 100;
+        consumer.publish(7, shared); // Out of range lands in the shared lane
+        auto stats = consumer.stats();
+        assert(stats.published == 5 && stats.dropped == 2 && stats.depth == 5);
+
+        UpdateEvent out;
+        assert(consumer.poll(out) && out.token == 0);
+        assert(consumer.poll(out) && out.token == 100); // Next lane with data, not lane 0 again
+        assert(consumer.poll(out) && out.token == 1);
+        assert(out.publish_ns != 0);
+        size_t drained = consumer.drain([](const UpdateEvent &e)
+                                        { assert(e.token == 2 || e.token == 3); });
+        assert(drained == 2 && !consumer.poll(out));
+        assert(!consumer.wait(out, std::chrono::microseconds(200)));
+        assert(consumer.stats().consumed == 5);
+    }
+
+    // BLOCK: the producer waits for room instead of dropping while the consumer keeps up
+    {
+        UpdateConsumerConfig config;
+        config.capacity = 2;
+        config.overflow = OverflowPolicy::BLOCK;
+        config.block_timeout = std::chrono::seconds(5);
+        UpdateConsumer consumer(config, 2);
+        constexpr uint32_t kCount = 10000;
+        std::thread producer([&consumer]()
+                             {
+            for (uint32_t i = 0; i < kCount; i++)
+            {
+                UpdateEvent event;
+                event.token = i;
+                consumer.publish(0, event);
+            } });
+        UpdateEvent out;
+        for (uint32_t i = 0; i < kCount; i++)
+        {
+            assert(consumer.wait(out, std::chrono::seconds(5)) && out.token == i);
+        }
+        producer.join();
+        auto stats = consumer.stats();
+        assert(stats.published == kCount && stats.dropped == 0 && stats.consumed == kCount);
+    }
+
+    // OrderbookManager publishes routed book updates and arb triggers to each consumer's rings
+    {
+        Config config;
+        config.ws_shards = 2;
+        config.trigger_combined = 0.98;
+        OrderbookManager mgr(config);
+        MarketState market;
+        market.condition_id = "0xcond";
+        market.token_yes = "101";
+        market.token_no = "102";
+        mgr.subscribe(market);
+
+        UpdateConsumer &all = mgr.add_consumer();
+        UpdateConsumerConfig arbs_only;
+        arbs_only.books = false;
+        UpdateConsumer &arbs = mgr.add_consumer(arbs_only);
+        assert(all.lanes() == 3);
+
+        mgr.apply_snapshot(book("101", 0.50, 0.45));
+        mgr.apply_snapshot(book("102", 0.45, 0.40)); // 0.95 < 0.98
+        mgr.apply_snapshot(book("999", 0.50, 0.45)); // Not routed
+
+        UpdateEvent event;
+        assert(all.poll(event) && event.kind == UpdateKind::BOOK);
+        assert(mgr.tokens().id(event.token) == "101" && event.is_yes);
+        assert(mgr.conditions().id(event.condition) == "0xcond");
+        assert(event.top.best_ask == 0.50 && event.best_ask_no == 0.0 && event.receive_ns == 0);
+        assert(all.poll(event) && event.kind == UpdateKind::BOOK && mgr.tokens().id(event.token) == "102");
+        assert(!event.is_yes && event.best_ask_yes == 0.50 && event.best_ask_no == 0.45);
+        assert(all.poll(event) && event.kind == UpdateKind::ARB);
+        assert(event.combined() > 0.949 && event.combined() < 0.951 && event.sizing.size == 100.0);
+        assert(!all.poll(event));
+
+        assert(arbs.poll(event) && event.kind == UpdateKind::ARB && !arbs.poll(event));
+        assert(arbs.stats().published == 1 && all.stats().published == 3);
+    }
+
+    std::cout << "test_update_dispatch passed\n";
+    return 0;
+}
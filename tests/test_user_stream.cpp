@@ -0,0 +1,71 @@
+#undef NDEBUG // keep asserts active in Release builds
+#include "user_stream.hpp"
+#include <nlohmann/json.hpp>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace polymarket;
+
+int main()
+{
+    std::vector<UserTrade> trades;
+    std::vector<UserOrderEvent> orders;
+
+    // Trade with one of our orders on the maker side
+    assert(UserStreamManager::parse_message(
+        R"({"asset_id":"52114319501245915516055106046884209969926127482827954674443846427813813222426","event_type":"trade",)"
+        R"("id":"28c4d2eb-bbea-40e7-a9f0-b2fdb56b2c2e","last_update":"1672290701","maker_orders":[{"asset_id":"5211",)"
+        R"("matched_amount":"10","order_id":"0xff354cd7","outcome":"YES","owner":"9180014b","price":"0.57"}],)"
+        R"("market":"0xbd31dc8a","matchtime":"1672290701","outcome":"YES","owner":"9180014b","price":"0.57",)"
+        R"("side":"BUY","size":"10","status":"MATCHED","taker_order_id":"0x06bc63e3","timestamp":"1672290701000",)"
+        R"("trade_owner":"9180014b","type":"TRADE"})",
+        trades, orders));
+    assert(trades.size() == 1 && orders.empty());
+    const UserTrade &trade = trades[0];
+    assert(trade.id == "28c4d2eb-bbea-40e7-a9f0-b2fdb56b2c2e");
+    assert(trade.market == "0xbd31dc8a" && trade.side == "BUY" && trade.status == "MATCHED");
+    assert(trade.size == "10" && trade.price == "0.57" && trade.taker_order_id == "0x06bc63e3");
+    assert(trade.match_time == "1672290701" && trade.server_timestamp_ms == 1672290701000ULL);
+    assert(trade.maker_orders.size() == 1);
+    assert(trade.maker_orders[0].order_id == "0xff354cd7" && trade.maker_orders[0].matched_amount == "10");
+
+    // Order events, batched in an array alongside an unknown type
+    assert(UserStreamManager::parse_message(
+        R"([{"asset_id":"5211","associate_trades":null,"event_type":"order","id":"0xff354cd7",)"
+        R"("market":"0xbd31dc8a","original_size":"10","outcome":"YES","owner":"9180014b","price":"0.57",)"
+        R"("side":"SELL","size_matched":"0","timestamp":"1672290687000","type":"PLACEMENT"},)"
+        R"({"event_type":"order","id":"0xff354cd7","type":"UPDATE","size_matched":"4","price":0.57,)"
+        R"("associate_trades":["28c4d2eb"]},)"
+        R"({"event_type":"something_new","id":"x"}])",
+        trades, orders));
+    assert(trades.empty() && orders.size() == 2);
+    assert(orders[0].type == "PLACEMENT" && orders[0].side == "SELL" && orders[0].original_size == "10");
+    assert(orders[0].associate_trades.empty() && orders[0].server_timestamp_ms == 1672290687000ULL);
+    assert(orders[1].type == "UPDATE" && orders[1].size_matched == "4" && orders[1].price == "0.57");
+    assert(orders[1].associate_trades.size() == 1 && orders[1].associate_trades[0] == "28c4d2eb");
+
+    // Keepalive replies are skipped, garbage is an error
+    assert(UserStreamManager::parse_message("PONG", trades, orders) && trades.empty() && orders.empty());
+    assert(!UserStreamManager::parse_message("{\"event_type\":", trades, orders));
+
+    // Subscription carries the L2 credentials and the market filter
+    ApiCredentials creds{"key", "secret", "pass"};
+    auto sub = nlohmann::json::parse(UserStreamManager::subscription_message(creds, {"0xa", "0xb"}));
+    assert(sub["type"] == "user");
+    assert(sub["auth"]["apiKey"] == "key" && sub["auth"]["secret"] == "secret" && sub["auth"]["passphrase"] == "pass");
+    assert(sub["markets"].size() == 2 && sub["markets"][1] == "0xb");
+
+    // Never connected: the filter is only recorded and nothing counts as subscribed
+    Config config;
+    UserStreamManager stream(config, creds);
+    stream.subscribe({"0xa", "0xb", "0xa"});
+    stream.unsubscribe({"0xb", "0xc"});
+    assert(stream.markets() == std::vector<std::string>{"0xa"});
+    assert(!stream.wait_subscribed(std::chrono::milliseconds(10)));
+    assert(stream.trades_received() == 0 && stream.parse_errors() == 0);
+
+    std::cout << "test_user_stream passed" << std::endl;
+    return 0;
+}
@@ -1,3 +1,4 @@
+#undef NDEBUG // keep asserts active in Release builds
 #include "order_signer.hpp"
 #include <cassert>
 #include <iostream>
@@ -14,6 +15,12 @@ int main()
     auto salt = generate_salt();
     assert(!salt.empty());
 
+    // Hex round trip (table-driven encoder/decoder)
+    auto bytes = from_hex("0x00ff10Ab");
+    assert(bytes.size() == 4 && bytes[1] == 0xff && bytes[3] == 0xab);
+    assert(to_hex(bytes) == "0x00ff10ab");
+    assert(from_hex("00ff").size() == 2);
+
     std::cout << "test_utils passed\n";
     return 0;
 }